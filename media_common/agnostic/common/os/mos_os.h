@@ -518,6 +518,7 @@ class CommandList;
 class CmdBufMgrNext;
 class MosCpInterface;
 class MosDecompression;
+class MosAsyncLockQueue;
 
 //!
 //! \brief Structure to Unified  InDirectState Dump Info
@@ -542,6 +543,9 @@ struct MosStreamState
     CommandList        *currentCmdList          = nullptr;  //<! Command list used in async mode
     CmdBufMgrNext      *currentCmdBufMgr        = nullptr;  //<! Cmd buffer manager used in async mode
     MosDecompression   *mosDecompression        = nullptr;  //<! Decompression State used for decompress
+    MosAsyncLockQueue  *asyncLockQueue          = nullptr;  //<! Locks waiting for the GPU to release their resource
+    uint32_t            vdboxWorkload           = 0;        //<! Size of the current video frame for VDBox balancing, 0 if unknown
+    uint32_t            vdboxFrameId            = 0;        //<! Counts the frames reported by SetVdboxWorkload, 0 if none
     bool                enableDecomp            = false;    //<! Set true in StreamState init. If false then not inited
     bool                postponedExecution      = false;    //!< Indicate if the stream is work in postponed execution mode. This flag is only used in aync mode.
 
@@ -1403,6 +1407,18 @@ typedef struct _MOS_INTERFACE
         PMOS_INTERFACE              pOsInterface,
         int32_t                     priority);
 
+    //!
+    //! \brief    Set size of the next video submissions
+    //!
+    //! \param    [in] pOsInterface
+    //!           pointer to the current gpu context
+    //! \param    [in] workload
+    //!           relative size of the work, used to balance streams across VDBoxes
+    //!
+    void (*pfnSetVdboxWorkload)(
+        PMOS_INTERFACE              pOsInterface,
+        uint32_t                    workload);
+
     //!
     //! \brief  Set slice count to shared memory and KMD
     //! \param  [in] pOsInterface
@@ -72,6 +72,16 @@
 //!
 #define __MEDIA_USER_FEATURE_VALUE_SESSION_ID_REG_PATH_ENABLE           "Enable Session Id Reg Path"
 
+//!
+//! \brief Keys for media, read by release builds
+//!
+#define __MEDIA_USER_FEATURE_VALUE_GPU_FRAME_TIMING                     "Media GPU Frame Timing"
+#define __MEDIA_USER_FEATURE_VALUE_PROCESS_MEMORY_PEAK                  "Media Process Memory Peak"
+#define __MEDIA_USER_FEATURE_VALUE_CONTEXT_MEMORY_BUDGET                "Media Context Memory Budget"
+#define __MEDIA_USER_FEATURE_VALUE_PROCESS_MEMORY_LIMIT                 "Media Process Memory Limit"
+#define __MEDIA_USER_FEATURE_MCPY_CPU_COPY                              "MCPY CPU Copy"
+#define __MEDIA_USER_FEATURE_MCPY_CONCURRENT_ENGINES                    "MCPY Concurrent Engines"
+
 #if (_DEBUG || _RELEASE_INTERNAL)
 
 //!
@@ -444,6 +454,7 @@
 #if (_DEBUG || _RELEASE_INTERNAL)
 #define __MEDIA_USER_FEATURE_VALUE_NULLHW_PROXY_REPEAT_COUNT                    "NULL HW Proxy Repeat Count"
 #define __MEDIA_USER_FEATURE_VALUE_NULLHW_PROXY_REPEAT_COUNT_FILE              "NULL HW Proxy Repeat Count File"
+#define __MEDIA_USER_FEATURE_VALUE_SW_BUFMGR_ENABLE                             "Software Bufmgr Enable"
 #endif
 #define __MEDIA_USER_FEATURE_VALUE_MOCKADAPTOR_PLATFORM                         "MockAdaptor Platform"
 #define __MEDIA_USER_FEATURE_VALUE_MOCKADAPTOR_STEPPING                         "MockAdaptor Stepping"
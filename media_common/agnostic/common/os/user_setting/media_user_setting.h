@@ -35,6 +35,8 @@
 //！             ReadUserSetting(value, "User Setting", MediaUserSetting::Device, m_osInterface->pOsContext, true, true);
 //!           If you don't want to provide the customized default value:
 //!              ReadUserSetting(value, "User Setting", MediaUserSetting::Device, m_osInterface->pOsContext);
+//!           In release builds the value of an item is resolved from the registry and the environment by
+//!           its first read and later reads return it without locking, debug builds read it every time.
 //!           3) If you want to write specific media user setting to configuration path, call:
 //!              WriteUserSetting("User Setting", MediaUserSetting::Value(false), m_osInterface->pOsContext)
 //!           If you just want to report the value of specific setting item, need to call like:
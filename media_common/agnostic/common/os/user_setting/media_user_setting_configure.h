@@ -169,10 +169,11 @@ public:
     //!
     inline bool IsDefinitionExist(const std::string &itemName)
     {
-        bool ret = false;
+        bool   ret  = false;
+        size_t hash = MakeHash(itemName);
         for (auto &defs : m_definitions)
         {
-            auto it = defs.find(MakeHash(itemName));
+            auto it = defs.find(hash);
             if (it != defs.end())
             {
                 ret = true;
@@ -30,6 +30,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <atomic>
 #include <iosfwd>
 #include "mos_defs_specific.h"
 #include "media_user_setting_value.h"
@@ -156,7 +157,81 @@ public:
     //!           the custom path
     //!
     bool UseStatePath() const { return m_statePath; }
+
+    //!
+    //! \brief    Get the generation of the cached value
+    //! \details  Taken by a reader before it resolves the value, and passed to
+    //!           SetCachedValue to keep it.
+    //! \return   uint32_t
+    //!           the number of ResetCachedValue calls
+    //!
+    uint32_t CacheGeneration() const { return m_cacheGeneration.load(std::memory_order_acquire); }
+
+    //!
+    //! \brief    Get the value resolved by the first read of the item
+    //! \details  Lock free, the resolved value is published as an immutable snapshot
+    //!           which stays alive while a reader copies from it. A snapshot resolved
+    //!           before the last ResetCachedValue is not returned.
+    //! \param    [out] value
+    //!           The resolved value, only valid if status is MOS_STATUS_SUCCESS
+    //! \param    [out] status
+    //!           The status of the first read
+    //! \return   bool
+    //!           true if the item has been resolved, otherwise false
+    //!
+    bool GetCachedValue(Value &value, MOS_STATUS &status) const
+    {
+        std::shared_ptr<const CachedValue> cached = std::atomic_load(&m_cachedValue);
+        if (cached == nullptr || cached->generation != CacheGeneration())
+        {
+            return false;
+        }
+        value  = cached->value;
+        status = cached->status;
+        return true;
+    }
+
+    //!
+    //! \brief    Keep the value resolved by the first read of the item
+    //! \details  A value resolved before a concurrent ResetCachedValue may be stale,
+    //!           it is dropped here or, if the reset comes after this check, by
+    //!           GetCachedValue.
+    //! \param    [in] value
+    //!           The resolved value
+    //! \param    [in] status
+    //!           The status of the read
+    //! \param    [in] generation
+    //!           CacheGeneration before the value was resolved
+    //! \return   bool
+    //!           true if the value is kept, false if the cache was reset meanwhile
+    //!
+    bool SetCachedValue(const Value &value, MOS_STATUS status, uint32_t generation)
+    {
+        if (generation != CacheGeneration())
+        {
+            return false;
+        }
+        std::shared_ptr<const CachedValue> cached = std::make_shared<const CachedValue>(CachedValue{value, status, generation});
+        std::atomic_store(&m_cachedValue, cached);
+        return true;
+    }
+
+    //!
+    //! \brief    Drop the resolved value, the next read goes to the registry again
+    //!
+    void ResetCachedValue()
+    {
+        m_cacheGeneration.fetch_add(1, std::memory_order_acq_rel);
+        std::atomic_store(&m_cachedValue, std::shared_ptr<const CachedValue>());
+    }
 private:
+    struct CachedValue
+    {
+        Value      value;
+        MOS_STATUS status;
+        uint32_t   generation;
+    };
+
     //!
     //! \brief    Set the values of definition
     //! \param    [in] Definition
@@ -173,6 +248,8 @@ private:
     std::string m_subPath{};    //!< custome path is a relative path, it could be null
     UFKEY_NEXT m_rootKey{};    //!< root key
     bool m_statePath      = true;    //!< Whether the item read from a specific path
+    std::shared_ptr<const CachedValue> m_cachedValue{};  //!< Value and status resolved by the first read, null until then
+    std::atomic<uint32_t>              m_cacheGeneration{0};  //!< Incremented by each ResetCachedValue
 };
 
 using Definitions = std::map<std::size_t, std::shared_ptr<Definition>>;
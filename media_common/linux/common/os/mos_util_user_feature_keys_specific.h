@@ -41,6 +41,10 @@
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_SOFTPIN       "Enable Softpin"
 #define __MEDIA_USER_FEATURE_VALUE_DISABLE_KMD_WATCHDOG "Disable KMD Watchdog"
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_VM_BIND       "Enable VM Bind"
+#define __MEDIA_USER_FEATURE_VALUE_ENABLE_VDBOX_BALANCER "Enable VDBox Balancer"
+#define __MEDIA_USER_FEATURE_VALUE_VDBOX_BALANCER_LOAD  "VDBox Balancer Load"
+#define __MEDIA_USER_FEATURE_VALUE_SYSMEM_PLACEMENT     "Media Sysmem Placement"
+#define __MEDIA_USER_FEATURE_VALUE_SYSMEM_PLACEMENT_BENCH "Media Sysmem Placement Bench"
 
 // Reg key for Pxp
 #define __MEDIA_USER_FEATURE_VALUE_PXP_SIDELOAD_HUC_MANIFEST "SideloadHucManifest"
@@ -42,6 +42,7 @@
 #include "cm_vebox_rt.h"
 #include "cm_execution_adv.h"
 #include "vp_common.h"
+#include "mos_worker_pool.h"
 
 // Used by GPUCopy
 #define BLOCK_PIXEL_WIDTH            (32)
@@ -56,6 +57,10 @@
 //Used by unaligned copy
 #define BLOCK_WIDTH                  (64)
 #define PAGE_ALIGNED                 (0x1000)
+//Used by CPU to CPU copy path selection
+#define CPU2CPU_CALIBRATION_SIZE     (1024*1024)
+#define CPU2CPU_MIN_BYTES_PER_THREAD (512*1024)
+#define CPU2CPU_MAX_COPY_THREADS     (8)
 
 #define GPUCOPY_KERNEL_LOCK(a) ((a)->locked = true)
 #define GPUCOPY_KERNEL_UNLOCK(a) ((a)->locked = false)
@@ -117,6 +122,13 @@ int32_t CmQueueRT::Destroy(CmQueueRT* &queue )
         return CM_FAILURE;
     }
 
+    // The calibration enqueues GPU copies on this queue
+    if (queue->m_cpu2cpuCopyCalibrationThread)
+    {
+        MosUtilities::MosWaitThread(queue->m_cpu2cpuCopyCalibrationThread);
+        queue->m_cpu2cpuCopyCalibrationThread = 0;
+    }
+
     uint32_t result = queue->CleanQueue();
 
     queue->DestroyComputeGpuContext();
@@ -155,6 +167,10 @@ CmQueueRT::CmQueueRT(CmDeviceRT *device,
     m_syncBufferHandle(INVALID_SYNC_BUFFER_HANDLE)
 {
     MOS_ZeroMemory(&m_mosVeHintParams, sizeof(m_mosVeHintParams));
+    MOS_ZeroMemory(&m_cpu2cpuCopyCosts, sizeof(m_cpu2cpuCopyCosts));
+    m_cpu2cpuCopyCalibrated        = false;
+    m_cpu2cpuCopyCalibrationStarted = false;
+    m_cpu2cpuCopyCalibrationThread = 0;
     MosUtilities::MosQueryPerformanceFrequency(&m_CPUperformanceFrequency);
 }
 
@@ -2094,11 +2110,15 @@ finish:
 }
 
 //*-----------------------------------------------------------------------------
-//! Enqueue an task, which contains one pre-defined kernel to copy from system memory to system memory
-//! This is a non-blocking call. i.e. it returns immediately without waiting for
-//! GPU to finish the execution of the task.
+//! Copy from system memory to system memory, either by CPU or by a pre-defined GPU copy kernel.
+//! The cheaper path is chosen by a cost model: CPU copy bandwidth, GPU copy setup latency and
+//! GPU copy bandwidth. The first copy large enough for the GPU path starts measuring them on a
+//! background thread, copies take the GPU path until the measure is done. The measuring copies
+//! and the GPU copies of this function are serialized, so they never share the queue.
+//! Large CPU copies are split over the MOS worker pool.
+//! When GPU is used, this is a non-blocking call unless CM_FASTCOPY_OPTION_BLOCKING is set.
 //! A CmEvent is generated each time a task is enqueued. The CmEvent can be used to check if the task finishs.
-//! If the size is less than 1KB,  CPU is used to do the copy and event will be set as nullptr .
+//! If CPU is used to do the copy, the copy is done when the call returns and event will be set as nullptr.
 //!
 //! INPUT:
 //!     1) Pointer to the system memory as copy destination
@@ -2107,7 +2127,7 @@ finish:
 //!     4) Option passed from user, blocking copy, non-blocking copy or disable turbo boost
 //!     5) Reference to the pointer to CMEvent
 //! OUTPUT:
-//!     CM_SUCCESS if the task is successfully enqueued and the CmEvent is generated;
+//!     CM_SUCCESS if the copy is done or the task is successfully enqueued and the CmEvent is generated;
 //!     CM_OUT_OF_HOST_MEMORY if out of host memery;
 //!     CM_GPUCOPY_INVALID_SYSMEM if the sysMem is not 16-byte aligned or is NULL.
 //!     CM_GPUCOPY_OUT_OF_RESOURCE if runtime run out of BufferUP.
@@ -2124,6 +2144,66 @@ CM_RT_API int32_t CmQueueRT::EnqueueCopyCPUToCPU( unsigned char* dstSysMem, unsi
         return CM_NOT_IMPLEMENTED;
     }
 
+    size_t inputLinearAddress  = (size_t )srcSysMem;
+    size_t outputLinearAddress = (size_t )dstSysMem;
+
+    if((inputLinearAddress & 0xf) || (outputLinearAddress & 0xf) ||
+        (inputLinearAddress == 0) || (outputLinearAddress == 0))
+    {
+        CM_ASSERTMESSAGE("Error: Start address of system memory is not 16-byte aligned.");
+        return CM_GPUCOPY_INVALID_SYSMEM;
+    }
+
+    uint32_t cpuThreadCount = 1;
+    if (size / BYTE_COPY_ONE_THREAD == 0)
+    {
+        //if the size of data is less than data copied per thread ( 4K), use CPU to copy it instead of GPU.
+        CopyByCpu(dstSysMem, srcSysMem, size, cpuThreadCount);
+        event = nullptr;
+        return CM_SUCCESS;
+    }
+
+    // Same limit as the GPU copy kernel, whichever path is taken
+    if (((size + (inputLinearAddress & (PAGE_ALIGNED - 1))) > CM_MAX_1D_SURF_WIDTH) ||
+        ((size + (outputLinearAddress & (PAGE_ALIGNED - 1))) > CM_MAX_1D_SURF_WIDTH))
+    {
+        CM_ASSERTMESSAGE("Error: Invalid copy size.");
+        return CM_GPUCOPY_INVALID_SIZE;
+    }
+
+    StartCpu2CpuCopyCalibration();
+
+    if (IsCpuPreferredForCopy(size, option, cpuThreadCount))
+    {
+        CopyByCpu(dstSysMem, srcSysMem, size, cpuThreadCount);
+        event = nullptr;
+        return CM_SUCCESS;
+    }
+
+    int32_t hr = CM_SUCCESS;
+    {
+        CLock locker(m_criticalSectionCpu2CpuCopy);
+        hr = EnqueueCopyCPUToCPUByGpu(dstSysMem, srcSysMem, size, option & ~CM_FASTCOPY_OPTION_BLOCKING, event);
+    }
+    if (hr != CM_SUCCESS)
+    {
+        return hr;
+    }
+
+    if ((option & CM_FASTCOPY_OPTION_BLOCKING) && (event))
+    {
+        hr = event->WaitForTaskFinished();
+    }
+
+    return hr;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Copy from system memory to system memory with the GPU copy kernel
+//| Returns:    Result of the operation.
+//*-----------------------------------------------------------------------------
+int32_t CmQueueRT::EnqueueCopyCPUToCPUByGpu( unsigned char* dstSysMem, unsigned char* srcSysMem, uint32_t size, uint32_t option, CmEvent* & event )
+{
     int hr = CM_SUCCESS;
     size_t inputLinearAddress  = (size_t )srcSysMem;
     size_t outputLinearAddress = (size_t )dstSysMem;
@@ -2148,13 +2228,6 @@ CM_RT_API int32_t CmQueueRT::EnqueueCopyCPUToCPU( unsigned char* dstSysMem, unsi
     uint32_t        cpuMemcopySize        = 0;
     CM_GPUCOPY_KERNEL *gpuCopyKernelParam     = nullptr;
 
-    if((inputLinearAddress & 0xf) || (outputLinearAddress & 0xf) ||
-        (inputLinearAddress == 0) || (outputLinearAddress == 0))
-    {
-        CM_ASSERTMESSAGE("Error: Start address of system memory is not 16-byte aligned.");
-        return CM_GPUCOPY_INVALID_SYSMEM;
-    }
-
     // Get page aligned address
     if (sizeof (void *) == 8 ) //64-bit
     {
@@ -2181,17 +2254,6 @@ CM_RT_API int32_t CmQueueRT::EnqueueCopyCPUToCPU( unsigned char* dstSysMem, unsi
     threadHeight = 0;
     threadNum = size / BYTE_COPY_ONE_THREAD; // each thread copys 32 x 4 x32 bytes = 1K
 
-    if( threadNum == 0)
-    {
-        //if the size of data is less than data copied per thread ( 4K), use CPU to copy it instead of GPU.
-        CmFastMemCopy((void *)(outputLinearAddress),
-                      (void *)(inputLinearAddress),
-                      size); //SSE copy used in CMRT.
-
-        event = nullptr;
-        return CM_SUCCESS;
-    }
-
     //Calculate proper thread space's width and height
     threadWidth  = 1;
     threadHeight = threadNum/threadWidth;
@@ -2296,6 +2358,151 @@ finish:
 }
 
 
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Start the calibration of CPU to CPU copy costs once per queue
+//| Returns:    None.
+//*-----------------------------------------------------------------------------
+void CmQueueRT::StartCpu2CpuCopyCalibration()
+{
+    if (m_cpu2cpuCopyCalibrationStarted.exchange(true))
+    {
+        return;
+    }
+
+    // Loading the copy kernel and timing copies takes milliseconds, keep it off the copy.
+    // If the thread can not be created the queue stays uncalibrated and uses the GPU.
+    m_cpu2cpuCopyCalibrationThread = MosUtilities::MosCreateThread((void *)Cpu2CpuCopyCalibrationThread, this);
+}
+
+void CmQueueRT::Cpu2CpuCopyCalibrationThread(void *queue)
+{
+    static_cast<CmQueueRT *>(queue)->CalibrateCpu2CpuCopy();
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Calibrate the costs of CPU copy and GPU copy kernel once per queue
+//| Returns:    None.
+//*-----------------------------------------------------------------------------
+void CmQueueRT::CalibrateCpu2CpuCopy()
+{
+    // Defaults are used if calibration fails: always prefer GPU as before.
+    double cpuBytesPerUs = 1.0;
+    double gpuBytesPerUs = 1.0e9;
+    double gpuSubmitUs   = 0.0;
+    double gpuLatencyUs  = 0.0;
+
+    unsigned char *src = (unsigned char *)MOS_AlignedAllocMemory(CPU2CPU_CALIBRATION_SIZE, PAGE_ALIGNED);
+    unsigned char *dst = (unsigned char *)MOS_AlignedAllocMemory(CPU2CPU_CALIBRATION_SIZE, PAGE_ALIGNED);
+    if (src && dst)
+    {
+        uint64_t t0 = 0, t1 = 0, t2 = 0;
+        CmEvent *event = nullptr;
+
+        // CPU: first copy warms up caches and page tables, second one is timed.
+        MOS_FillMemory(src, CPU2CPU_CALIBRATION_SIZE, 0x5a);
+        CmFastMemCopy(dst, src, CPU2CPU_CALIBRATION_SIZE);
+        MosUtilities::MosQueryPerformanceCounter(&t0);
+        CmFastMemCopy(dst, src, CPU2CPU_CALIBRATION_SIZE);
+        MosUtilities::MosQueryPerformanceCounter(&t1);
+        if (t1 > t0)
+        {
+            cpuBytesPerUs = (double)CPU2CPU_CALIBRATION_SIZE * m_CPUperformanceFrequency / ((t1 - t0) * 1000000.0);
+        }
+
+        // GPU: minimal copy gives setup latency, full size copy gives bandwidth.
+        // The first GPU copy also loads the copy kernel, so it is not timed.
+        // Copies of the application wait until the measure is done.
+        CLock  copyLocker(m_criticalSectionCpu2CpuCopy);
+        double smallCopyUs = 0.0;
+        if (EnqueueCopyCPUToCPUByGpu(dst, src, BYTE_COPY_ONE_THREAD, CM_FASTCOPY_OPTION_BLOCKING, event) == CM_SUCCESS)
+        {
+            DestroyEventFast(event);
+
+            MosUtilities::MosQueryPerformanceCounter(&t0);
+            if (EnqueueCopyCPUToCPUByGpu(dst, src, BYTE_COPY_ONE_THREAD, CM_FASTCOPY_OPTION_NONBLOCKING, event) == CM_SUCCESS && event)
+            {
+                MosUtilities::MosQueryPerformanceCounter(&t1);
+                event->WaitForTaskFinished();
+                MosUtilities::MosQueryPerformanceCounter(&t2);
+                DestroyEventFast(event);
+
+                gpuSubmitUs  = (double)(t1 - t0) * 1000000.0 / m_CPUperformanceFrequency;
+                gpuLatencyUs = (double)(t2 - t0) * 1000000.0 / m_CPUperformanceFrequency;
+                smallCopyUs  = gpuLatencyUs;
+            }
+
+            MosUtilities::MosQueryPerformanceCounter(&t0);
+            if (EnqueueCopyCPUToCPUByGpu(dst, src, CPU2CPU_CALIBRATION_SIZE, CM_FASTCOPY_OPTION_BLOCKING, event) == CM_SUCCESS)
+            {
+                MosUtilities::MosQueryPerformanceCounter(&t1);
+                DestroyEventFast(event);
+
+                double largeCopyUs = (double)(t1 - t0) * 1000000.0 / m_CPUperformanceFrequency;
+                if (largeCopyUs > smallCopyUs)
+                {
+                    gpuBytesPerUs = (double)(CPU2CPU_CALIBRATION_SIZE - BYTE_COPY_ONE_THREAD) / (largeCopyUs - smallCopyUs);
+                }
+            }
+        }
+    }
+    MOS_AlignedFreeMemory(src);
+    MOS_AlignedFreeMemory(dst);
+
+    CM_NORMALMESSAGE("CPU2CPU copy calibration: cpu %f B/us, gpu %f B/us, gpu submit %f us, gpu latency %f us.",
+        cpuBytesPerUs, gpuBytesPerUs, gpuSubmitUs, gpuLatencyUs);
+
+    // Costs are written once, before the flag is published, and only read after it
+    m_cpu2cpuCopyCosts.cpuBytesPerUs = cpuBytesPerUs;
+    m_cpu2cpuCopyCosts.gpuBytesPerUs = gpuBytesPerUs;
+    m_cpu2cpuCopyCosts.gpuSubmitUs   = gpuSubmitUs;
+    m_cpu2cpuCopyCosts.gpuLatencyUs  = gpuLatencyUs;
+    m_cpu2cpuCopyCalibrated.store(true, std::memory_order_release);
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Estimate whether CPU copy is cheaper than the GPU copy kernel
+//|             For non-blocking copy, only the CPU time spent on submission is
+//|             compared since GPU copy runs asynchronously.
+//| Returns:    True if CPU copy is preferred, and the CPU thread count to use.
+//*-----------------------------------------------------------------------------
+bool CmQueueRT::IsCpuPreferredForCopy(uint32_t size, uint32_t option, uint32_t &threadCount)
+{
+    threadCount = MOS_MIN(MOS_MAX(size / CPU2CPU_MIN_BYTES_PER_THREAD, 1), CPU2CPU_MAX_COPY_THREADS);
+    threadCount = MOS_MIN(threadCount, MosWorkerPool::GetMaxThreadNum());
+
+    if (!m_cpu2cpuCopyCalibrated.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    double cpuCostUs = (double)size / (m_cpu2cpuCopyCosts.cpuBytesPerUs * threadCount);
+    double gpuCostUs = m_cpu2cpuCopyCosts.gpuSubmitUs;
+    if (option & CM_FASTCOPY_OPTION_BLOCKING)
+    {
+        gpuCostUs = m_cpu2cpuCopyCosts.gpuLatencyUs + (double)size / m_cpu2cpuCopyCosts.gpuBytesPerUs;
+    }
+
+    return cpuCostUs < gpuCostUs;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Copy by CPU, splitting the copy over the MOS worker pool if asked
+//| Returns:    None.
+//*-----------------------------------------------------------------------------
+void CmQueueRT::CopyByCpu(unsigned char* dstSysMem, unsigned char* srcSysMem, uint32_t size, uint32_t threadCount)
+{
+    // Ranges are cut on cache lines
+    uint32_t lineNum  = MOS_ALIGN_CEIL(size, 64) / 64;
+    uint32_t chunkNum = MOS_MIN(MOS_MAX(threadCount, 1), lineNum);
+    MosWorkerPool::GetInstance().Run(lineNum, chunkNum, [=](uint32_t, uint32_t begin, uint32_t end) {
+        uint32_t offset = begin * 64;
+        uint32_t bytes  = MOS_MIN(end * 64, size) - offset;
+        CmFastMemCopy(dstSysMem + offset, srcSysMem + offset, bytes);
+        return MOS_STATUS_SUCCESS;
+    });
+}
+
 //worker thread for video buffer copy to/from system memory
 //support wait event and provide notification event
 void BufferCopyThread(void* threadData)
@@ -29,6 +29,7 @@
 
 #include "cm_queue.h"
 
+#include <atomic>
 #include <queue>
 
 #include "cm_array.h"
@@ -57,6 +58,19 @@ struct CM_GPUCOPY_KERNEL
     bool locked;
 };
 
+//!
+//! \brief    Cost model of EnqueueCopyCPUToCPU.
+//! \details  Measured once per queue on a background thread started by the first
+//!           copy which is large enough for the GPU path.
+//!
+struct CM_CPU2CPU_COPY_COSTS
+{
+    double   cpuBytesPerUs;         // single thread CPU copy bandwidth
+    double   gpuBytesPerUs;         // GPU copy kernel bandwidth
+    double   gpuSubmitUs;           // CPU time to set up and submit a GPU copy
+    double   gpuLatencyUs;          // submit to completion time of a minimal GPU copy
+};
+
 class ThreadSafeQueue
 {
 public:
@@ -336,6 +350,25 @@ protected:
 
     int32_t RegisterSyncEvent();
 
+    int32_t EnqueueCopyCPUToCPUByGpu(unsigned char *dstSysMem,
+                                     unsigned char *srcSysMem,
+                                     uint32_t size,
+                                     uint32_t option,
+                                     CmEvent *&event);
+
+    void StartCpu2CpuCopyCalibration();
+
+    void CalibrateCpu2CpuCopy();
+
+    static void Cpu2CpuCopyCalibrationThread(void *queue);
+
+    bool IsCpuPreferredForCopy(uint32_t size, uint32_t option, uint32_t &threadCount);
+
+    void CopyByCpu(unsigned char *dstSysMem,
+                   unsigned char *srcSysMem,
+                   uint32_t size,
+                   uint32_t threadCount);
+
 
     CmDeviceRT *m_device;
     ThreadSafeQueue m_enqueuedTasks;
@@ -366,6 +399,12 @@ protected:
     uint32_t m_trackerIndex;
     uint32_t m_fastTrackerIndex;
 
+    CM_CPU2CPU_COPY_COSTS m_cpu2cpuCopyCosts;  // Valid once m_cpu2cpuCopyCalibrated is set
+    CSync m_criticalSectionCpu2CpuCopy;     // Serialize the calibration and the GPU copies of EnqueueCopyCPUToCPU
+    std::atomic<bool> m_cpu2cpuCopyCalibrated;
+    std::atomic<bool> m_cpu2cpuCopyCalibrationStarted;
+    MOS_THREADHANDLE  m_cpu2cpuCopyCalibrationThread;
+
 private:
     static const uint32_t INVALID_SYNC_BUFFER_HANDLE = 0xDEADBEEF;
 
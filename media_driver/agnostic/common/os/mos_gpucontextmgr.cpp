@@ -35,6 +35,7 @@ GpuContextMgr::GpuContextMgr(GT_SYSTEM_INFO *gtSystemInfo, OsContext *osContext)
 
     m_gpuContextArrayMutex = MosUtilities::MosCreateMutex();
     MOS_OS_CHK_NULL_NO_STATUS_RETURN(m_gpuContextArrayMutex);
+    MosUtilities::MosSetMutexName(m_gpuContextArrayMutex, "GpuContextMgr.ContextArray");
 
     MosUtilities::MosLockMutex(m_gpuContextArrayMutex);
     m_gpuContextArray.clear();
@@ -1406,15 +1406,15 @@ static VAStatus DdiMedia_HeapInitialize(
     mediaCtx->pMfeCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
 
     // init the mutexs
-    DdiMediaUtil_InitMutex(&mediaCtx->SurfaceMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->BufferMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->ImageMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->DecoderMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->EncoderMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->VpMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->ProtMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->CmMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->MfeMutex);
+    DdiMediaUtil_InitMutex(&mediaCtx->SurfaceMutex, "Ddi.SurfaceMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->BufferMutex, "Ddi.BufferMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->ImageMutex, "Ddi.ImageMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->DecoderMutex, "Ddi.DecoderMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->EncoderMutex, "Ddi.EncoderMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->VpMutex, "Ddi.VpMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->ProtMutex, "Ddi.ProtMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->CmMutex, "Ddi.CmMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->MfeMutex, "Ddi.MfeMutex");
 
     return VA_STATUS_SUCCESS;
 }
@@ -2046,8 +2046,8 @@ VAStatus DdiMedia_InitMediaContext (
     }
 
 #if !defined(ANDROID) && defined(X11_FOUND)
-    DdiMediaUtil_InitMutex(&mediaCtx->PutSurfaceRenderMutex);
-    DdiMediaUtil_InitMutex(&mediaCtx->PutSurfaceSwapBufferMutex);
+    DdiMediaUtil_InitMutex(&mediaCtx->PutSurfaceRenderMutex, "Ddi.PutSurfaceRenderMutex");
+    DdiMediaUtil_InitMutex(&mediaCtx->PutSurfaceSwapBufferMutex, "Ddi.PutSurfaceSwapBufferMutex");
 
     // try to open X11 lib, if fail, assume no X11 environment
     if (VA_STATUS_SUCCESS != DdiMedia_ConnectX11(mediaCtx))
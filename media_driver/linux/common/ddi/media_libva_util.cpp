@@ -1587,13 +1587,18 @@ VAStatus DdiMediaUtil_FillPositionToRect(RECT *rect, int16_t offset_x, int16_t o
     return VA_STATUS_SUCCESS;
 }
 
-void DdiMediaUtil_InitMutex(PMEDIA_MUTEX_T  mutex)
+void DdiMediaUtil_InitMutex(PMEDIA_MUTEX_T  mutex, const char *name)
 {
     pthread_mutex_init(mutex, nullptr);
+    if (name)
+    {
+        MosUtilities::MosSetMutexName(mutex, name);
+    }
 }
 
 void DdiMediaUtil_DestroyMutex(PMEDIA_MUTEX_T  mutex)
 {
+    MosUtilities::MosRetireMutex(mutex);
     int32_t ret = pthread_mutex_destroy(mutex);
     if(ret != 0)
     {
@@ -1603,8 +1608,8 @@ void DdiMediaUtil_DestroyMutex(PMEDIA_MUTEX_T  mutex)
 
 void DdiMediaUtil_LockMutex(PMEDIA_MUTEX_T  mutex)
 {
-    int32_t ret = pthread_mutex_lock(mutex);
-    if(ret != 0)
+    MOS_STATUS ret = MosUtilities::MosLockMutex(mutex);
+    if(ret != MOS_STATUS_SUCCESS)
     {
         DDI_NORMALMESSAGE("can't lock the mutex!\n");
     }
@@ -1612,8 +1617,8 @@ void DdiMediaUtil_LockMutex(PMEDIA_MUTEX_T  mutex)
 
 void DdiMediaUtil_UnLockMutex(PMEDIA_MUTEX_T  mutex)
 {
-    int32_t ret = pthread_mutex_unlock(mutex);
-    if(ret != 0)
+    MOS_STATUS ret = MosUtilities::MosUnlockMutex(mutex);
+    if(ret != MOS_STATUS_SUCCESS)
     {
         DDI_NORMALMESSAGE("can't unlock the mutex!\n");
     }
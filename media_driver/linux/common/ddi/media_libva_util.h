@@ -147,8 +147,10 @@ void     DdiMediaUtil_FreeBuffer(DDI_MEDIA_BUFFER  *buf);
 //! 
 //! \param  [in] mutex
 //!         Pointer to media mutex thread
+//! \param  [in] name
+//!         Lock name reported by the MOS lock profiler, optional
 //!
-void     DdiMediaUtil_InitMutex(PMEDIA_MUTEX_T  mutex);
+void     DdiMediaUtil_InitMutex(PMEDIA_MUTEX_T  mutex, const char *name = nullptr);
 
 //!
 //! \brief  Destroy mutex
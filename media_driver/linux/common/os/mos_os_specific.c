@@ -6839,6 +6839,25 @@ void Mos_Specific_SetGpuPriority(
     }
 }
 
+//!
+//! \brief  Set size of the next video submissions
+//! \param  [in] pOsInterface
+//!         Pointer to OS interface
+//! \param  [in] workload
+//!         relative size of the work, used to balance streams across VDBoxes
+//!
+void Mos_Specific_SetVdboxWorkload(
+        PMOS_INTERFACE              pOsInterface,
+        uint32_t                    workload)
+{
+    MOS_OS_ASSERT(pOsInterface);
+
+    if (pOsInterface->apoMosEnabled)
+    {
+        MosInterface::SetVdboxWorkload(pOsInterface->osStreamState, workload);
+    }
+}
+
 //!
 //! \brief  Set slice count to shared memory and KMD
 //! \param  [in] pOsInterface
@@ -7277,6 +7296,7 @@ MOS_STATUS Mos_Specific_InitInterface(
     pOsInterface->pfnGetResourceIndex                       = Mos_Specific_GetResourceIndex;
     pOsInterface->pfnGetGpuPriority                         = Mos_Specific_GetGpuPriority;
     pOsInterface->pfnSetGpuPriority                         = Mos_Specific_SetGpuPriority;
+    pOsInterface->pfnSetVdboxWorkload                       = Mos_Specific_SetVdboxWorkload;
     pOsInterface->pfnIsSetMarkerEnabled                     = Mos_Specific_IsSetMarkerEnabled;
     pOsInterface->pfnGetMarkerResource                      = Mos_Specific_GetMarkerResource;
     pOsInterface->pfnNotifyStreamIndexSharing               = Mos_Specific_NotifyStreamIndexSharing;
@@ -408,8 +408,17 @@ mosdrmIoctl(int fd, unsigned long request, void *arg)
     return ret;
 }
 #endif
+static uint64_t g_drmMockIoctlCount = 0;
+
+// Number of ioctls issued by the driver since load, queried by the devult benchmark mode.
+extern "C" drm_export uint64_t drmMockGetIoctlCount(void)
+{
+    return __atomic_load_n(&g_drmMockIoctlCount, __ATOMIC_RELAXED);
+}
+
 int drmIoctl(int fd, unsigned long request, void *arg)
 {
+    __atomic_fetch_add(&g_drmMockIoctlCount, 1, __ATOMIC_RELAXED);
     return mosdrmIoctl(fd,request,arg);
 }
 
@@ -0,0 +1,506 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <dlfcn.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "ddi_test_perf.h"
+
+using namespace std;
+
+typedef uint64_t (*DrmMockGetIoctlCountFunc)();
+
+uint32_t    g_perfFrames     = 0;
+const char *g_perfOutputPath = PERF_DEFAULT_OUTPUT_PATH;
+
+TEST_F(MediaPerfDdiTest, PerfDecodeAVC)
+{
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("AVC-Long");
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platform], pDecData->GetFeatureID()))
+        {
+            DecodePerf(pDecData, "Decode-AVC", platform);
+        }
+    }
+    delete pDecData;
+}
+
+TEST_F(MediaPerfDdiTest, PerfDecodeHEVC)
+{
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("HEVC-Long");
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platform], pDecData->GetFeatureID()))
+        {
+            DecodePerf(pDecData, "Decode-HEVC", platform);
+        }
+    }
+    delete pDecData;
+}
+
+TEST_F(MediaPerfDdiTest, PerfEncodeAVC)
+{
+    EncTestData *pEncData = m_encTestFactory.GetEncTestData("AVC-DualPipe");
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        if (m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platform], pEncData->GetFeatureID()))
+        {
+            EncodePerf(pEncData, "Encode-AVC", platform);
+        }
+    }
+    delete pEncData;
+}
+
+TEST_F(MediaPerfDdiTest, PerfEncodeHEVC)
+{
+    EncTestData *pEncData = m_encTestFactory.GetEncTestData("HEVC-DualPipe");
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        if (m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platform], pEncData->GetFeatureID()))
+        {
+            EncodePerf(pEncData, "Encode-HEVC", platform);
+        }
+    }
+    delete pEncData;
+}
+
+TEST_F(MediaPerfDdiTest, PerfVpBlit1080p)
+{
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        VpBlitPerf(1920, 1080, "VP-Blit-1080p", platform);
+    }
+}
+
+TEST_F(MediaPerfDdiTest, PerfVpScalingLadder1080p)
+{
+    // 1:N ABR ladder, every output has its own scale factor.
+    const vector<pair<uint32_t, uint32_t>> outputs = {
+        {1280, 720}, {960, 540}, {640, 360}, {480, 270}, {320, 180}};
+
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        VpLadderPerf(1920, 1080, outputs, "VP-Ladder-1080p", platform);
+    }
+}
+
+void PerfRecorder::Capture(PerfSnapshot &snapshot) const
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    snapshot.cpuNs  = static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+    snapshot.wallNs = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+#if defined(__x86_64__) || defined(__i386__)
+    snapshot.cycles = __rdtsc();
+#else
+    snapshot.cycles = 0;
+#endif
+
+    const DriverSymbols &syms = m_loader.GetDriverSymbols();
+    snapshot.memNinja    = syms.MOS_GetMemNinjaCounter ? syms.MOS_GetMemNinjaCounter() : 0;
+    snapshot.memNinjaGfx = syms.MOS_GetMemNinjaCounterGfx ? syms.MOS_GetMemNinjaCounterGfx() : 0;
+
+    // Only available when libdrm_mock is preloaded.
+    static DrmMockGetIoctlCountFunc getIoctlCount =
+        (DrmMockGetIoctlCountFunc)dlsym(RTLD_DEFAULT, "drmMockGetIoctlCount");
+    snapshot.ioctls = getIoctlCount ? static_cast<int64_t>(getIoctlCount()) : -1;
+}
+
+void PerfRecorder::Report(const string &workload, Platform_t platform) const
+{
+    if (m_frames == 0)
+    {
+        return;
+    }
+
+    double frames         = static_cast<double>(m_frames);
+    double wallUsPerFrame = (m_end.wallNs - m_begin.wallNs) / 1000.0 / frames;
+    double cpuUsPerFrame  = (m_end.cpuNs - m_begin.cpuNs) / 1000.0 / frames;
+    double cyclesPerFrame = (m_end.cycles - m_begin.cycles) / frames;
+    double allocPerFrame  = (m_end.memNinja - m_begin.memNinja) / frames;
+    double gfxAllocPerFrame = (m_end.memNinjaGfx - m_begin.memNinjaGfx) / frames;
+    double ioctlsPerFrame = (m_begin.ioctls < 0) ? -1.0 : (m_end.ioctls - m_begin.ioctls) / frames;
+
+    ofstream out(g_perfOutputPath, ios_base::app);
+    out << "{\"platform\":\"" << g_platformName[platform] << "\""
+        << ",\"workload\":\"" << workload << "\""
+        << ",\"frames\":" << m_frames
+        << ",\"wall_us_per_frame\":" << wallUsPerFrame
+        << ",\"cpu_us_per_frame\":" << cpuUsPerFrame
+        << ",\"tsc_cycles_per_frame\":" << cyclesPerFrame
+        << ",\"mem_ninja_delta_per_frame\":" << allocPerFrame
+        << ",\"mem_ninja_gfx_delta_per_frame\":" << gfxAllocPerFrame
+        << ",\"ioctls_per_frame\":" << ioctlsPerFrame
+        << "}" << endl;
+
+    TEST_COUT << g_platformName[platform] << " " << workload << ": "
+        << wallUsPerFrame << " us wall, " << cpuUsPerFrame << " us cpu, "
+        << ioctlsPerFrame << " ioctls per frame over " << m_frames << " frames" << endl;
+}
+
+void MediaPerfDdiTest::TimeFrames(PerfRecorder &recorder, const function<void(uint32_t)> &runFrame)
+{
+    // Warm-up frames are excluded from the measurement.
+    for (uint32_t frame = 0; frame < g_perfFrames + PERF_WARMUP_FRAMES; frame++)
+    {
+        if (frame == PERF_WARMUP_FRAMES)
+        {
+            recorder.Begin();
+        }
+        runFrame(frame);
+    }
+    recorder.End(g_perfFrames);
+}
+
+void MediaPerfDdiTest::CodecPerf(const PerfCodecData &data, const function<void(VAContextID, int)> &renderFrame,
+    const string &workload, Platform_t platform)
+{
+    VAConfigID      config_id;
+    VAContextID     context_id;
+    PerfRecorder    recorder(m_driverLoader);
+
+    // No validation during timing, it would dominate the per-frame cost.
+    CmdValidator::GpuCmdsValidationInit(nullptr, platform);
+
+    int ret = m_driverLoader.InitDriver(platform);
+    ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateConfig(&m_driverLoader.m_ctx,
+        data.featureId.profile, data.featureId.entrypoint,
+        &data.confAttrib[0], data.confAttrib.size(), &config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+        data.width, data.height, &data.resources[0], data.resources.size(),
+        data.surfAttrib.empty() ? nullptr : &data.surfAttrib[0], data.surfAttrib.size());
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id, data.width,
+        data.height, VA_PROGRESSIVE, &data.resources[0], data.resources.size(), &context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
+
+    TimeFrames(recorder, [&](uint32_t frame) {
+        // Loop over the sample sequence.
+        int i = frame % data.numFrames;
+
+        ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id, data.resources[0]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaBeginPicture" << endl;
+
+        renderFrame(context_id, i);
+
+        ret = m_driverLoader.m_ctx.vtable->vaEndPicture(&m_driverLoader.m_ctx, context_id);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaSyncSurface(&m_driverLoader.m_ctx, data.resources[0]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaSyncSurface" << endl;
+
+        for (int j = 0; j < data.compBufs[i].size(); j++)
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, data.compBufs[i][j].bufID);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+        }
+    });
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, &data.resources[0], data.resources.size());
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyConfig(&m_driverLoader.m_ctx, config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyConfig" << endl;
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+
+    recorder.Report(workload, platform);
+}
+
+void MediaPerfDdiTest::DecodePerf(DecTestData *pDecData, const string &workload, Platform_t platform)
+{
+    vector<VASurfaceAttrib> noSurfAttrib;
+    PerfCodecData data = {pDecData->GetFeatureID(), pDecData->GetWidth(), pDecData->GetHeight(),
+        pDecData->GetConfAttrib(), noSurfAttrib, pDecData->GetResources(), pDecData->GetCompBuffers(),
+        pDecData->m_num_frames};
+
+    CodecPerf(data, [&](VAContextID context_id, int i) {
+        vector<vector<CompBufConif>> &compBufs = data.compBufs;
+        int ret = VA_STATUS_SUCCESS;
+        for (int j = 0; j < compBufs[i].size(); j++)
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
+                compBufs[i][j].bufType, compBufs[i][j].bufSize, 1, compBufs[i][j].pData, &compBufs[i][j].bufID);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+        }
+
+        pDecData->UpdateCompBuffers(i);
+        for (int j = 0; j < compBufs[i].size(); j++)
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaRenderPicture(&m_driverLoader.m_ctx,
+                context_id, &compBufs[i][j].bufID, 1);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaRenderPicture" << endl;
+        }
+    }, workload, platform);
+}
+
+void MediaPerfDdiTest::EncodePerf(EncTestData *pEncData, const string &workload, Platform_t platform)
+{
+    PerfCodecData data = {pEncData->GetFeatureID(), pEncData->GetWidth(), pEncData->GetHeight(),
+        pEncData->GetConfAttrib(), pEncData->GetSurfAttrib(), pEncData->GetResources(), pEncData->GetCompBuffers(),
+        pEncData->m_num_frames};
+
+    CodecPerf(data, [&](VAContextID context_id, int i) {
+        vector<vector<CompBufConif>> &compBufs = data.compBufs;
+
+        // compBufs[i][0] is the coded buffer, it is created but never rendered.
+        int ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id, compBufs[i][0].bufType,
+            compBufs[i][0].bufSize, 1, compBufs[i][0].pData, &compBufs[i][0].bufID);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+        pEncData->UpdateCompBuffers(i);
+        for (int j = 1; j < compBufs[i].size(); j++)
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
+                compBufs[i][j].bufType, compBufs[i][j].bufSize, 1, compBufs[i][j].pData, &compBufs[i][j].bufID);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+            ret = m_driverLoader.m_ctx.vtable->vaRenderPicture(&m_driverLoader.m_ctx,
+                context_id, &compBufs[i][j].bufID, 1);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaRenderPicture" << endl;
+        }
+    }, workload, platform);
+}
+
+void MediaPerfDdiTest::VpBlitPerf(uint32_t width, uint32_t height, const string &workload, Platform_t platform)
+{
+    VAConfigID   config_id;
+    VAContextID  context_id;
+    VASurfaceID  surfaces[2];
+    VABufferID   pipelineBufId;
+    PerfRecorder recorder(m_driverLoader);
+
+    CmdValidator::GpuCmdsValidationInit(nullptr, platform);
+
+    int ret = m_driverLoader.InitDriver(platform);
+    ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateConfig(&m_driverLoader.m_ctx,
+        VAProfileNone, VAEntrypointVideoProc, nullptr, 0, &config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+        width, height, surfaces, 2, nullptr, 0);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id, width,
+        height, VA_PROGRESSIVE, &surfaces[1], 1, &context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
+
+    VARectangle rect = {0, 0, static_cast<uint16_t>(width), static_cast<uint16_t>(height)};
+    VAProcPipelineParameterBuffer pipelineParam = {};
+    pipelineParam.surface              = surfaces[0];
+    pipelineParam.surface_region       = &rect;
+    pipelineParam.output_region        = &rect;
+    pipelineParam.surface_color_standard = VAProcColorStandardBT601;
+    pipelineParam.output_color_standard  = VAProcColorStandardBT601;
+
+    TimeFrames(recorder, [&](uint32_t frame) {
+        ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id, surfaces[1]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaBeginPicture" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
+            VAProcPipelineParameterBufferType, sizeof(pipelineParam), 1, &pipelineParam, &pipelineBufId);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaRenderPicture(&m_driverLoader.m_ctx, context_id, &pipelineBufId, 1);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaRenderPicture" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaEndPicture(&m_driverLoader.m_ctx, context_id);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaSyncSurface(&m_driverLoader.m_ctx, surfaces[1]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaSyncSurface" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, pipelineBufId);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+    });
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, surfaces, 2);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyConfig(&m_driverLoader.m_ctx, config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyConfig" << endl;
+
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+
+    recorder.Report(workload, platform);
+}
+
+void MediaPerfDdiTest::VpLadderPerf(uint32_t width, uint32_t height, const vector<pair<uint32_t, uint32_t>> &outputs,
+    const string &workload, Platform_t platform)
+{
+    VAConfigID          config_id;
+    VAContextID         context_id;
+    VASurfaceID         input;
+    vector<VASurfaceID> targets(outputs.size());
+    VABufferID          pipelineBufId;
+    PerfRecorder        recorder(m_driverLoader);
+
+    CmdValidator::GpuCmdsValidationInit(nullptr, platform);
+
+    int ret = m_driverLoader.InitDriver(platform);
+    ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateConfig(&m_driverLoader.m_ctx,
+        VAProfileNone, VAEntrypointVideoProc, nullptr, 0, &config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+        width, height, &input, 1, nullptr, 0);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+
+    for (uint32_t i = 0; i < outputs.size(); i++)
+    {
+        ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+            outputs[i].first, outputs[i].second, &targets[i], 1, nullptr, 0);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+    }
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id, width,
+        height, VA_PROGRESSIVE, &targets[0], targets.size(), &context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
+
+    VARectangle srcRect = {0, 0, static_cast<uint16_t>(width), static_cast<uint16_t>(height)};
+    VAProcPipelineParameterBuffer pipelineParam = {};
+    pipelineParam.surface                = input;
+    pipelineParam.surface_region         = &srcRect;
+    pipelineParam.surface_color_standard = VAProcColorStandardBT601;
+    pipelineParam.output_color_standard  = VAProcColorStandardBT601;
+    pipelineParam.filter_flags           = VA_FILTER_SCALING_HQ;
+
+    TimeFrames(recorder, [&](uint32_t frame) {
+        for (uint32_t i = 0; i < outputs.size(); i++)
+        {
+            VARectangle dstRect = {0, 0, static_cast<uint16_t>(outputs[i].first), static_cast<uint16_t>(outputs[i].second)};
+            pipelineParam.output_region = &dstRect;
+
+            ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id, targets[i]);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaBeginPicture" << endl;
+
+            ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
+                VAProcPipelineParameterBufferType, sizeof(pipelineParam), 1, &pipelineParam, &pipelineBufId);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+            ret = m_driverLoader.m_ctx.vtable->vaRenderPicture(&m_driverLoader.m_ctx, context_id, &pipelineBufId, 1);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaRenderPicture" << endl;
+
+            ret = m_driverLoader.m_ctx.vtable->vaEndPicture(&m_driverLoader.m_ctx, context_id);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
+
+            ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, pipelineBufId);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+        }
+
+        for (auto target : targets)
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaSyncSurface(&m_driverLoader.m_ctx, target);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaSyncSurface" << endl;
+        }
+    });
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, &targets[0], targets.size());
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, &input, 1);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyConfig(&m_driverLoader.m_ctx, config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyConfig" << endl;
+
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+
+    recorder.Report(workload, platform);
+}
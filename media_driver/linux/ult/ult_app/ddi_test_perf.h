@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef __DDI_TEST_PERF_H__
+#define __DDI_TEST_PERF_H__
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ddi_test_decode.h"
+#include "ddi_test_encode.h"
+
+#define PERF_DEFAULT_FRAMES      100
+#define PERF_WARMUP_FRAMES       2
+#define PERF_DEFAULT_OUTPUT_PATH "./devult_perf.json"
+
+// Set from the command line, zero frames disables the benchmark tests.
+extern uint32_t    g_perfFrames;
+extern const char *g_perfOutputPath;
+
+struct PerfSnapshot
+{
+    uint64_t wallNs;
+    uint64_t cpuNs;
+    uint64_t cycles;
+    int64_t  memNinja;
+    int64_t  memNinjaGfx;
+    int64_t  ioctls;
+};
+
+class PerfRecorder
+{
+public:
+
+    PerfRecorder(const DriverDllLoader &loader) : m_loader(loader) { }
+
+    void Begin() { Capture(m_begin); }
+
+    void End(uint32_t frames) { Capture(m_end); m_frames = frames; }
+
+    // Append one JSON object per line to g_perfOutputPath and echo a summary.
+    void Report(const std::string &workload, Platform_t platform) const;
+
+private:
+
+    void Capture(PerfSnapshot &snapshot) const;
+
+private:
+
+    const DriverDllLoader &m_loader;
+    PerfSnapshot          m_begin  = {};
+    PerfSnapshot          m_end    = {};
+    uint32_t              m_frames = 0;
+};
+
+// What the decode and encode timing loops need from DecTestData/EncTestData.
+struct PerfCodecData
+{
+    FeatureID                               featureId;
+    uint32_t                                width;
+    uint32_t                                height;
+    std::vector<VAConfigAttrib>             &confAttrib;
+    std::vector<VASurfaceAttrib>            &surfAttrib;
+    std::vector<VASurfaceID>                &resources;
+    std::vector<std::vector<CompBufConif>>  &compBufs;
+    int                                     numFrames;
+};
+
+class MediaPerfDdiTest : public testing::Test
+{
+protected:
+
+    virtual void SetUp()
+    {
+        if (g_perfFrames == 0)
+        {
+            GTEST_SKIP() << "Benchmark mode is disabled, run devult with --benchmark";
+        }
+    }
+
+    virtual void TearDown() { }
+
+    // Run PERF_WARMUP_FRAMES untimed frames, then time g_perfFrames frames.
+    void TimeFrames(PerfRecorder &recorder, const std::function<void(uint32_t frame)> &runFrame);
+
+    // Shared decode/encode setup, timing loop and teardown. renderFrame creates
+    // and renders the parameter buffers of sample frame i between Begin/EndPicture.
+    void CodecPerf(const PerfCodecData &data, const std::function<void(VAContextID context, int i)> &renderFrame,
+        const std::string &workload, Platform_t platform);
+
+    void DecodePerf(DecTestData *pDecData, const std::string &workload, Platform_t platform);
+
+    void EncodePerf(EncTestData *pEncData, const std::string &workload, Platform_t platform);
+
+    void VpBlitPerf(uint32_t width, uint32_t height, const std::string &workload, Platform_t platform);
+
+    void VpLadderPerf(uint32_t width, uint32_t height, const std::vector<std::pair<uint32_t, uint32_t>> &outputs,
+        const std::string &workload, Platform_t platform);
+
+protected:
+
+    DriverDllLoader     m_driverLoader;
+    DecTestDataFactory  m_decDataFactory;
+    EncTestDataFactory  m_encTestFactory;
+    DecodeTestConfig    m_decTestCfg;
+    EncodeTestConfig    m_encTestCfg;
+};
+
+#endif // __DDI_TEST_PERF_H__
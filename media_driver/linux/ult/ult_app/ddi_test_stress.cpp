@@ -0,0 +1,280 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include "ddi_test_stress.h"
+
+using namespace std;
+
+uint32_t    g_stressThreads    = 0;
+uint32_t    g_stressIterations = STRESS_DEFAULT_ITERATIONS;
+const char *g_stressOutputPath = STRESS_DEFAULT_OUTPUT_PATH;
+
+TEST_F(MediaStressDdiTest, StressDecodeAVC)
+{
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("AVC-Long");
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platform], pDecData->GetFeatureID()))
+        {
+            DecodeStress("AVC-Long", platform);
+        }
+    }
+    delete pDecData;
+}
+
+TEST_F(MediaStressDdiTest, StressDecodeHEVC)
+{
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("HEVC-Long");
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platform], pDecData->GetFeatureID()))
+        {
+            DecodeStress("HEVC-Long", platform);
+        }
+    }
+    delete pDecData;
+}
+
+TEST_F(MediaStressDdiTest, StressVpBlit)
+{
+    for (auto platform : m_driverLoader.GetPlatforms())
+    {
+        VpBlitStress(640, 480, platform);
+    }
+}
+
+void MediaStressDdiTest::PrintReport(const string &workload, Platform_t platform)
+{
+    ifstream in(g_stressOutputPath);
+    if (!in.is_open())
+    {
+        TEST_COUT << g_platformName[platform] << " " << workload
+            << ": no lock contention report, is " << STRESS_LOCK_PROFILER_ENV << " honored by this driver?" << endl;
+        return;
+    }
+
+    TEST_COUT << g_platformName[platform] << " " << workload << ": " << g_stressThreads << " threads x "
+        << g_stressIterations << " iterations, lock contention report " << g_stressOutputPath << endl;
+    string line;
+    while (getline(in, line))
+    {
+        cout << "    " << line << endl;
+    }
+}
+
+void MediaStressDdiTest::DecodeStress(const string &clip, Platform_t platform)
+{
+    // Validation keeps per-platform global state, it is not meant for concurrent submissions.
+    CmdValidator::GpuCmdsValidationInit(nullptr, platform);
+
+    // The driver rewrites the report on vaTerminate, drop the previous run's so it is never echoed.
+    remove(g_stressOutputPath);
+
+    int ret = m_driverLoader.InitDriver(platform);
+    ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    VADriverContext *ctx = &m_driverLoader.m_ctx;
+    atomic<uint32_t> failures(0);
+
+    auto worker = [&]() {
+        // Each thread owns its clip so buffer IDs and surfaces are never shared.
+        DecTestData    *pDecData = m_decDataFactory.GetDecTestData(clip);
+        VAConfigID      config_id;
+        VAContextID     context_id;
+
+        VAStatus status = ctx->vtable->vaCreateConfig(ctx, pDecData->GetFeatureID().profile,
+            pDecData->GetFeatureID().entrypoint, (VAConfigAttrib *)&(pDecData->GetConfAttrib()[0]),
+            pDecData->GetConfAttrib().size(), &config_id);
+        if (status != VA_STATUS_SUCCESS)
+        {
+            failures++;
+            delete pDecData;
+            return;
+        }
+
+        vector<VASurfaceID>          &resources = pDecData->GetResources();
+        vector<vector<CompBufConif>> &compBufs  = pDecData->GetCompBuffers();
+        for (uint32_t iter = 0; iter < g_stressIterations; iter++)
+        {
+            status = ctx->vtable->vaCreateSurfaces2(ctx, VA_RT_FORMAT_YUV420, pDecData->GetWidth(),
+                pDecData->GetHeight(), &resources[0], resources.size(), nullptr, 0);
+            if (status != VA_STATUS_SUCCESS)
+            {
+                failures++;
+                break;
+            }
+
+            status = ctx->vtable->vaCreateContext(ctx, config_id, pDecData->GetWidth(), pDecData->GetHeight(),
+                VA_PROGRESSIVE, &resources[0], resources.size(), &context_id);
+            if (status != VA_STATUS_SUCCESS)
+            {
+                failures++;
+                ctx->vtable->vaDestroySurfaces(ctx, &resources[0], resources.size());
+                break;
+            }
+
+            for (int i = 0; i < pDecData->m_num_frames; i++)
+            {
+                status |= ctx->vtable->vaBeginPicture(ctx, context_id, resources[0]);
+                for (int j = 0; j < compBufs[i].size(); j++)
+                {
+                    status |= ctx->vtable->vaCreateBuffer(ctx, context_id, compBufs[i][j].bufType,
+                        compBufs[i][j].bufSize, 1, compBufs[i][j].pData, &compBufs[i][j].bufID);
+                }
+                pDecData->UpdateCompBuffers(i);
+                for (int j = 0; j < compBufs[i].size(); j++)
+                {
+                    status |= ctx->vtable->vaRenderPicture(ctx, context_id, &compBufs[i][j].bufID, 1);
+                }
+                status |= ctx->vtable->vaEndPicture(ctx, context_id);
+                status |= ctx->vtable->vaSyncSurface(ctx, resources[0]);
+                for (int j = 0; j < compBufs[i].size(); j++)
+                {
+                    ctx->vtable->vaDestroyBuffer(ctx, compBufs[i][j].bufID);
+                }
+            }
+            if (status != VA_STATUS_SUCCESS)
+            {
+                failures++;
+            }
+
+            ctx->vtable->vaDestroyContext(ctx, context_id);
+            ctx->vtable->vaDestroySurfaces(ctx, &resources[0], resources.size());
+        }
+
+        ctx->vtable->vaDestroyConfig(ctx, config_id);
+        delete pDecData;
+    };
+
+    vector<thread> threads;
+    for (uint32_t t = 0; t < g_stressThreads; t++)
+    {
+        threads.emplace_back(worker);
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(0u, failures.load()) << "Platform = " << g_platformName[platform]
+        << ", Failed workload = Decode " << clip << endl;
+
+    // The driver writes the report when MOS utilities are closed on vaTerminate.
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+
+    PrintReport("Decode " + clip, platform);
+}
+
+void MediaStressDdiTest::VpBlitStress(uint32_t width, uint32_t height, Platform_t platform)
+{
+    CmdValidator::GpuCmdsValidationInit(nullptr, platform);
+
+    // The driver rewrites the report on vaTerminate, drop the previous run's so it is never echoed.
+    remove(g_stressOutputPath);
+
+    int ret = m_driverLoader.InitDriver(platform);
+    ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    VADriverContext *ctx = &m_driverLoader.m_ctx;
+    VAConfigID       config_id;
+    ret = ctx->vtable->vaCreateConfig(ctx, VAProfileNone, VAEntrypointVideoProc, nullptr, 0, &config_id);
+    ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+    atomic<uint32_t> failures(0);
+
+    auto worker = [&]() {
+        VASurfaceID surfaces[2];
+        VAContextID context_id;
+        VABufferID  pipelineBufId;
+        VARectangle rect = {0, 0, static_cast<uint16_t>(width), static_cast<uint16_t>(height)};
+
+        for (uint32_t iter = 0; iter < g_stressIterations; iter++)
+        {
+            VAStatus status = ctx->vtable->vaCreateSurfaces2(ctx, VA_RT_FORMAT_YUV420, width, height,
+                surfaces, 2, nullptr, 0);
+            if (status != VA_STATUS_SUCCESS)
+            {
+                failures++;
+                break;
+            }
+
+            status = ctx->vtable->vaCreateContext(ctx, config_id, width, height, VA_PROGRESSIVE,
+                &surfaces[1], 1, &context_id);
+            if (status != VA_STATUS_SUCCESS)
+            {
+                failures++;
+                ctx->vtable->vaDestroySurfaces(ctx, surfaces, 2);
+                break;
+            }
+
+            VAProcPipelineParameterBuffer pipelineParam = {};
+            pipelineParam.surface                = surfaces[0];
+            pipelineParam.surface_region         = &rect;
+            pipelineParam.output_region          = &rect;
+            pipelineParam.surface_color_standard = VAProcColorStandardBT601;
+            pipelineParam.output_color_standard  = VAProcColorStandardBT601;
+
+            status |= ctx->vtable->vaBeginPicture(ctx, context_id, surfaces[1]);
+            status |= ctx->vtable->vaCreateBuffer(ctx, context_id, VAProcPipelineParameterBufferType,
+                sizeof(pipelineParam), 1, &pipelineParam, &pipelineBufId);
+            status |= ctx->vtable->vaRenderPicture(ctx, context_id, &pipelineBufId, 1);
+            status |= ctx->vtable->vaEndPicture(ctx, context_id);
+            status |= ctx->vtable->vaSyncSurface(ctx, surfaces[1]);
+            ctx->vtable->vaDestroyBuffer(ctx, pipelineBufId);
+            if (status != VA_STATUS_SUCCESS)
+            {
+                failures++;
+            }
+
+            ctx->vtable->vaDestroyContext(ctx, context_id);
+            ctx->vtable->vaDestroySurfaces(ctx, surfaces, 2);
+        }
+    };
+
+    vector<thread> threads;
+    for (uint32_t t = 0; t < g_stressThreads; t++)
+    {
+        threads.emplace_back(worker);
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(0u, failures.load()) << "Platform = " << g_platformName[platform]
+        << ", Failed workload = VP blit" << endl;
+
+    ctx->vtable->vaDestroyConfig(ctx, config_id);
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+
+    PrintReport("VP blit", platform);
+}
@@ -0,0 +1,70 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef __DDI_TEST_STRESS_H__
+#define __DDI_TEST_STRESS_H__
+
+#include <string>
+#include "ddi_test_decode.h"
+
+#define STRESS_DEFAULT_THREADS     4
+#define STRESS_DEFAULT_ITERATIONS  8
+#define STRESS_DEFAULT_OUTPUT_PATH "./devult_lock_contention.txt"
+
+// Environment variable read by the driver's MOS lock profiler when it is loaded.
+#define STRESS_LOCK_PROFILER_ENV   "MEDIA_LOCK_PROFILER_LOG"
+
+// Set from the command line, zero threads disables the stress tests.
+extern uint32_t    g_stressThreads;
+extern uint32_t    g_stressIterations;
+extern const char *g_stressOutputPath;
+
+class MediaStressDdiTest : public testing::Test
+{
+protected:
+
+    virtual void SetUp()
+    {
+        if (g_stressThreads == 0)
+        {
+            GTEST_SKIP() << "Stress mode is disabled, run devult with --stress";
+        }
+    }
+
+    virtual void TearDown() { }
+
+    // Spin g_stressThreads threads on one VA display, each running
+    // create context / render / sync / destroy loops with its own clip.
+    void DecodeStress(const std::string &clip, Platform_t platform);
+
+    void VpBlitStress(uint32_t width, uint32_t height, Platform_t platform);
+
+    // Echo the report written by the driver on vaTerminate.
+    void PrintReport(const std::string &workload, Platform_t platform);
+
+protected:
+
+    DriverDllLoader     m_driverLoader;
+    DecTestDataFactory  m_decDataFactory;
+    DecodeTestConfig    m_decTestCfg;
+};
+
+#endif // __DDI_TEST_STRESS_H__
@@ -22,7 +22,10 @@
 #include <cctype>
 #include <string>
 #include <stdio.h>
+#include <stdlib.h>
 #include "devconfig.h"
+#include "ddi_test_perf.h"
+#include "ddi_test_stress.h"
 #include "gtest/gtest.h"
 
 using namespace std;
@@ -41,11 +44,19 @@ int main(int argc, char *argv[])
         return -1;
     }
 
+    if (g_stressThreads > 0)
+    {
+        // The driver only reads this when it is loaded, set it before any test opens it.
+        setenv(STRESS_LOCK_PROFILER_ENV, g_stressOutputPath, 1);
+    }
+
     return RUN_ALL_TESTS();
 }
 
 static bool ParsePlatform(const char *str);
 static bool ParseDriverPath(const char *str);
+static bool ParseBenchmark(const char *str);
+static bool ParseStress(const char *str);
 
 static bool ParseCmd(int argc, char *argv[])
 {
@@ -54,17 +65,26 @@ static bool ParseCmd(int argc, char *argv[])
 
     for (int i = 1; i < argc; i++)
     {
-        if (ParseDriverPath(argv[i]) == false && ParsePlatform(argv[i]) == false)
+        if (ParseDriverPath(argv[i]) == false && ParsePlatform(argv[i]) == false &&
+            ParseBenchmark(argv[i]) == false && ParseStress(argv[i]) == false)
         {
             printf("ERROR\n    Bad command line parameter!\n\n");
-            printf("USAGE\n    devult [driver_path] [platform_name...]\n\n");
+            printf("USAGE\n    devult [driver_path] [platform_name...] [--benchmark[=frames]] [--benchmark_out=path]\n"
+                "           [--stress[=threads]] [--stress_iters=N] [--stress_out=path]\n\n");
             printf("DESCRIPTION\n    [driver_path]     : Use default driver relative path if not specify driver_path.\n"
-                "    [platform_name...]: Select zero or more items from {SKL, BXT, BDW}.\n\n");
+                "    [platform_name...]: Select zero or more items from {SKL, BXT, BDW}.\n"
+                "    --benchmark       : Run the MediaPerfDdiTest per-frame CPU cost tests, default 100 frames.\n"
+                "    --benchmark_out   : JSON lines result file, default ./devult_perf.json.\n"
+                "    --stress          : Run the MediaStressDdiTest multi-thread lock contention tests, default 4 threads.\n"
+                "    --stress_iters    : Create/render/sync/destroy iterations per thread, default 8.\n"
+                "    --stress_out      : Lock contention report file, default ./devult_lock_contention.txt.\n\n");
             printf("EXAMPLE\n    devult\n"
                 "    devult ./build/media_driver/iHD_drv_video.so\n"
                 "    devult skl\n"
                 "    devult ./build/media_driver/iHD_drv_video.so skl\n"
-                "    devult ./build/media_driver/iHD_drv_video.so skl\n\n");
+                "    devult ./build/media_driver/iHD_drv_video.so skl\n"
+                "    devult --gtest_filter=MediaPerfDdiTest.* --benchmark=500 skl\n"
+                "    devult --gtest_filter=MediaStressDdiTest.* --stress=8 --stress_iters=32 skl\n\n");
             return false;
         }
     }
@@ -103,3 +123,75 @@ static bool ParseDriverPath(const char *str)
 
     return false;
 }
+
+static bool ParseBenchmark(const char *str)
+{
+    const char *framesOpt = "--benchmark";
+    const char *outOpt    = "--benchmark_out=";
+
+    if (strncmp(str, outOpt, strlen(outOpt)) == 0)
+    {
+        g_perfOutputPath = str + strlen(outOpt);
+        return true;
+    }
+
+    if (strcmp(str, framesOpt) == 0)
+    {
+        g_perfFrames = PERF_DEFAULT_FRAMES;
+        return true;
+    }
+
+    if (strncmp(str, framesOpt, strlen(framesOpt)) == 0 && str[strlen(framesOpt)] == '=')
+    {
+        int frames = atoi(str + strlen(framesOpt) + 1);
+        if (frames > 0)
+        {
+            g_perfFrames = frames;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool ParseStress(const char *str)
+{
+    const char *threadsOpt = "--stress";
+    const char *itersOpt   = "--stress_iters=";
+    const char *outOpt     = "--stress_out=";
+
+    if (strncmp(str, outOpt, strlen(outOpt)) == 0)
+    {
+        g_stressOutputPath = str + strlen(outOpt);
+        return true;
+    }
+
+    if (strncmp(str, itersOpt, strlen(itersOpt)) == 0)
+    {
+        int iters = atoi(str + strlen(itersOpt));
+        if (iters > 0)
+        {
+            g_stressIterations = iters;
+            return true;
+        }
+        return false;
+    }
+
+    if (strcmp(str, threadsOpt) == 0)
+    {
+        g_stressThreads = STRESS_DEFAULT_THREADS;
+        return true;
+    }
+
+    if (strncmp(str, threadsOpt, strlen(threadsOpt)) == 0 && str[strlen(threadsOpt)] == '=')
+    {
+        int threads = atoi(str + strlen(threadsOpt) + 1);
+        if (threads > 0)
+        {
+            g_stressThreads = threads;
+            return true;
+        }
+    }
+
+    return false;
+}
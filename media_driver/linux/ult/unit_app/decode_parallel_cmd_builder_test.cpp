@@ -0,0 +1,197 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "decode_parallel_cmd_builder.h"
+
+using namespace std;
+using namespace decode;
+
+// Ranges of 8 units at most 4 ways, as the HEVC long format packet builds its slices
+class DecodeParallelCmdBuilderTest : public testing::Test, protected DecodeParallelCmdBuilder
+{
+protected:
+    DecodeParallelCmdBuilderTest() : DecodeParallelCmdBuilder(4, 8)
+    {
+    }
+
+    static const uint32_t m_unitNum     = 200;
+    static const uint32_t m_maxUnitDw   = 8;
+    static const uint32_t m_bufferDw    = 4096;
+
+    // Unit u emits a command of 1 to 8 dwords, so ranges have uneven sizes.
+    static MOS_STATUS AddUnitCmd(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t unit)
+    {
+        uint32_t dwNum = unit % m_maxUnitDw + 1;
+        if (cmdBuffer.iRemaining < (int32_t)(dwNum * sizeof(uint32_t)))
+        {
+            return MOS_STATUS_NO_SPACE;
+        }
+        for (uint32_t i = 0; i < dwNum; i++)
+        {
+            *cmdBuffer.pCmdPtr++ = (unit << 8) | i;
+        }
+        cmdBuffer.iOffset += dwNum * sizeof(uint32_t);
+        cmdBuffer.iRemaining -= dwNum * sizeof(uint32_t);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static MOS_STATUS AddUnitCmds(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t begin, uint32_t end)
+    {
+        for (uint32_t unit = begin; unit < end; unit++)
+        {
+            MOS_STATUS status = AddUnitCmd(cmdBuffer, unit);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static void InitBuffer(MOS_COMMAND_BUFFER &cmdBuffer, vector<uint32_t> &storage)
+    {
+        storage.assign(m_bufferDw, 0);
+        memset(&cmdBuffer, 0, sizeof(cmdBuffer));
+        cmdBuffer.pCmdBase   = storage.data();
+        cmdBuffer.pCmdPtr    = storage.data();
+        cmdBuffer.iRemaining = (int32_t)(storage.size() * sizeof(uint32_t));
+    }
+
+    void SetUp() override
+    {
+        InitBuffer(m_serial, m_serialStorage);
+        ASSERT_EQ(MOS_STATUS_SUCCESS, AddUnitCmds(m_serial, 0, m_unitNum));
+    }
+
+    void ExpectSameAsSerial(const MOS_COMMAND_BUFFER &cmdBuffer, const vector<uint32_t> &storage)
+    {
+        ASSERT_EQ(m_serial.iOffset, cmdBuffer.iOffset);
+        EXPECT_EQ(m_serial.iRemaining, cmdBuffer.iRemaining);
+        EXPECT_EQ(m_serial.pCmdPtr - m_serial.pCmdBase, cmdBuffer.pCmdPtr - cmdBuffer.pCmdBase);
+        EXPECT_EQ(0, memcmp(m_serialStorage.data(), storage.data(), m_serial.iOffset));
+    }
+
+    MOS_COMMAND_BUFFER m_serial = {};
+    vector<uint32_t>   m_serialStorage;
+};
+
+TEST_F(DecodeParallelCmdBuilderTest, ParallelMatchesSerial)
+{
+    MOS_COMMAND_BUFFER cmdBuffer;
+    vector<uint32_t>   storage;
+    vector<uint32_t>   unitRange(m_unitNum, 0xffffffff);
+    InitBuffer(cmdBuffer, storage);
+
+    MOS_STATUS status = Build(cmdBuffer, m_unitNum, m_maxUnitDw * sizeof(uint32_t),
+        [&](uint32_t rangeIdx, MOS_COMMAND_BUFFER &buffer, uint32_t begin, uint32_t end) {
+            for (uint32_t unit = begin; unit < end; unit++)
+            {
+                unitRange[unit] = rangeIdx;
+            }
+            return AddUnitCmds(buffer, begin, end);
+        });
+    EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+    ExpectSameAsSerial(cmdBuffer, storage);
+
+    EXPECT_EQ(1u, m_parallelCount);
+    EXPECT_EQ(0u, m_serialCount);
+    EXPECT_EQ(0u, unitRange[0]);
+    EXPECT_EQ(m_rangeNum - 1, unitRange[m_unitNum - 1]);
+}
+
+TEST_F(DecodeParallelCmdBuilderTest, SmallJobIsSerial)
+{
+    m_minUnitsPerRange = m_unitNum;
+    MOS_COMMAND_BUFFER cmdBuffer;
+    vector<uint32_t>   storage;
+    InitBuffer(cmdBuffer, storage);
+
+    MOS_STATUS status = Build(cmdBuffer, m_unitNum, m_maxUnitDw * sizeof(uint32_t),
+        [&](uint32_t rangeIdx, MOS_COMMAND_BUFFER &buffer, uint32_t begin, uint32_t end) {
+            EXPECT_EQ(0u, rangeIdx);
+            return AddUnitCmds(buffer, begin, end);
+        });
+    EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+    ExpectSameAsSerial(cmdBuffer, storage);
+    EXPECT_EQ(0u, m_parallelCount);
+    EXPECT_EQ(1u, m_serialCount);
+}
+
+TEST_F(DecodeParallelCmdBuilderTest, UndersizedUnitFallsBackToSerial)
+{
+    MOS_COMMAND_BUFFER cmdBuffer;
+    vector<uint32_t>   storage;
+    InitBuffer(cmdBuffer, storage);
+
+    // One dword per unit is too small for the scratch buffers of ranges 1..3
+    MOS_STATUS status = Build(cmdBuffer, m_unitNum, sizeof(uint32_t),
+        [&](uint32_t rangeIdx, MOS_COMMAND_BUFFER &buffer, uint32_t begin, uint32_t end) {
+            return AddUnitCmds(buffer, begin, end);
+        });
+    EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+    ExpectSameAsSerial(cmdBuffer, storage);
+    EXPECT_EQ(1u, m_fallbackCount);
+    EXPECT_EQ(1u, m_serialCount);
+}
+
+TEST_F(DecodeParallelCmdBuilderTest, FailingRangeFallsBackToSerial)
+{
+    MOS_COMMAND_BUFFER cmdBuffer;
+    vector<uint32_t>   storage;
+    InitBuffer(cmdBuffer, storage);
+
+    MOS_STATUS status = Build(cmdBuffer, m_unitNum, m_maxUnitDw * sizeof(uint32_t),
+        [&](uint32_t rangeIdx, MOS_COMMAND_BUFFER &buffer, uint32_t begin, uint32_t end) {
+            if (rangeIdx == 2)
+            {
+                return MOS_STATUS_UNKNOWN;
+            }
+            return AddUnitCmds(buffer, begin, end);
+        });
+    EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+    ExpectSameAsSerial(cmdBuffer, storage);
+    EXPECT_EQ(1u, m_fallbackCount);
+    EXPECT_EQ(0u, m_parallelCount);
+}
+
+TEST_F(DecodeParallelCmdBuilderTest, VerifyModeKeepsMatchingStream)
+{
+    MOS_COMMAND_BUFFER cmdBuffer;
+    vector<uint32_t>   storage;
+    InitBuffer(cmdBuffer, storage);
+    SetVerifyMode(true);
+
+    for (uint32_t frame = 0; frame < 4; frame++)
+    {
+        InitBuffer(cmdBuffer, storage);
+        MOS_STATUS status = Build(cmdBuffer, m_unitNum, m_maxUnitDw * sizeof(uint32_t),
+            [&](uint32_t rangeIdx, MOS_COMMAND_BUFFER &buffer, uint32_t begin, uint32_t end) {
+                return AddUnitCmds(buffer, begin, end);
+            });
+        EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+        ExpectSameAsSerial(cmdBuffer, storage);
+    }
+    EXPECT_EQ(4u, m_parallelCount);
+    EXPECT_EQ(0u, m_mismatchCount);
+}
@@ -0,0 +1,199 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "gtest/gtest.h"
+#include "decode_sub_pipeline.h"
+
+using namespace decode;
+
+// Stands in for a packet whose Init allocates its resources, like the VP9 HuC
+// probability update packet allocating its DMEM and probability save buffers.
+class FakeDecodePacket : public MediaPacket
+{
+public:
+    FakeDecodePacket(uint32_t &initNum, uint32_t &deleteNum, bool failInit)
+        : MediaPacket(nullptr), m_initNum(initNum), m_deleteNum(deleteNum), m_failInit(failInit)
+    {
+    }
+
+    ~FakeDecodePacket()
+    {
+        m_deleteNum++;
+    }
+
+    MOS_STATUS Init() override
+    {
+        m_initNum++;
+        return m_failInit ? MOS_STATUS_NO_SPACE : MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS Destroy() override { return MOS_STATUS_SUCCESS; }
+    MOS_STATUS Prepare() override { return MOS_STATUS_SUCCESS; }
+
+    uint32_t &m_initNum;
+    uint32_t &m_deleteNum;
+    bool      m_failInit = false;
+};
+
+class DecodeSubPipelineTest : public testing::Test, protected DecodeSubPipeline
+{
+protected:
+    enum
+    {
+        eagerPacketId = 1,
+        lazyPacketId  = 2,
+    };
+
+    DecodeSubPipelineTest() : DecodeSubPipeline(nullptr, nullptr, 1)
+    {
+    }
+
+    MOS_STATUS Init(CodechalSetting &settings) override { return MOS_STATUS_SUCCESS; }
+    MOS_STATUS Prepare(DecodePipelineParams &params) override { return MOS_STATUS_SUCCESS; }
+    MediaFunction GetMediaFunction() override { return VdboxDecodeFunc; }
+    void InitScalabilityPars(PMOS_INTERFACE osInterface) override {}
+
+    // Registers a packet the way the sub pipelines do for rarely used packets
+    void RegisterLazy(uint32_t packetId, bool failInit = false)
+    {
+        EXPECT_EQ(MOS_STATUS_SUCCESS, RegisterPacket(packetId, [this, failInit]() -> MediaPacket * {
+            m_createNum++;
+            return MOS_New(FakeDecodePacket, m_initNum, m_deleteNum, failInit);
+        }));
+    }
+
+    uint32_t m_createNum = 0;
+    uint32_t m_initNum   = 0;
+    uint32_t m_deleteNum = 0;
+};
+
+TEST_F(DecodeSubPipelineTest, LazyPacketIsNotCreatedUntilActivated)
+{
+    RegisterLazy(lazyPacketId);
+
+    EXPECT_EQ(0u, m_createNum);
+    EXPECT_EQ(0u, m_initNum);
+    EXPECT_TRUE(GetPacketList().empty());
+    EXPECT_TRUE(GetActivePackets().empty());
+}
+
+TEST_F(DecodeSubPipelineTest, FirstActivationCreatesAndInitializesThePacket)
+{
+    RegisterLazy(lazyPacketId);
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, ActivatePacket(lazyPacketId, true, 0, 0));
+    EXPECT_EQ(1u, m_createNum);
+    EXPECT_EQ(1u, m_initNum);
+
+    ASSERT_EQ(1u, GetActivePackets().size());
+    PacketProperty &prop = GetActivePackets()[0];
+    EXPECT_EQ((uint32_t)lazyPacketId, prop.packetId);
+    EXPECT_EQ(GetPacketList()[lazyPacketId], prop.packet);
+    EXPECT_TRUE(prop.immediateSubmit);
+}
+
+TEST_F(DecodeSubPipelineTest, LaterActivationsReuseThePacket)
+{
+    RegisterLazy(lazyPacketId);
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, ActivatePacket(lazyPacketId, false, 0, 0));
+    MediaPacket *packet = GetActivePackets()[0].packet;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Reset());
+
+    // Next frame, and a second pipe of the same frame
+    EXPECT_EQ(MOS_STATUS_SUCCESS, ActivatePacket(lazyPacketId, false, 0, 0, 2));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, ActivatePacket(lazyPacketId, false, 0, 1, 2));
+    ASSERT_EQ(2u, GetActivePackets().size());
+    EXPECT_EQ(packet, GetActivePackets()[0].packet);
+    EXPECT_EQ(packet, GetActivePackets()[1].packet);
+    EXPECT_EQ(1u, m_createNum);
+    EXPECT_EQ(1u, m_initNum);
+}
+
+TEST_F(DecodeSubPipelineTest, EagerPacketIsKeptOverCreator)
+{
+    uint32_t eagerInitNum   = 0;
+    uint32_t eagerDeleteNum = 0;
+    FakeDecodePacket *eager = MOS_New(FakeDecodePacket, eagerInitNum, eagerDeleteNum, false);
+    ASSERT_NE(nullptr, eager);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, RegisterPacket(eagerPacketId, *eager));
+
+    // A creator for an id which already has its packet is ignored
+    RegisterLazy(eagerPacketId);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, ActivatePacket(eagerPacketId, false, 0, 0));
+    EXPECT_EQ(eager, GetActivePackets()[0].packet);
+    EXPECT_EQ(0u, m_createNum);
+    // Eagerly registered packets are initialized by their owner
+    EXPECT_EQ(0u, eagerInitNum);
+
+    // The sub pipeline owns it from here
+    GetPacketList().erase(eagerPacketId);
+    MOS_Delete(eager);
+    EXPECT_EQ(1u, eagerDeleteNum);
+}
+
+TEST_F(DecodeSubPipelineTest, FailedInitDropsThePacket)
+{
+    RegisterLazy(lazyPacketId, true);
+
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, ActivatePacket(lazyPacketId, false, 0, 0));
+    EXPECT_TRUE(GetActivePackets().empty());
+    EXPECT_TRUE(GetPacketList().empty());
+    EXPECT_EQ(1u, m_initNum);
+    EXPECT_EQ(1u, m_deleteNum);
+
+    // The creator is kept, a later frame retries
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, ActivatePacket(lazyPacketId, false, 0, 0));
+    EXPECT_EQ(2u, m_createNum);
+    EXPECT_EQ(2u, m_deleteNum);
+}
+
+TEST_F(DecodeSubPipelineTest, UnknownPacketFailsActivation)
+{
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, ActivatePacket(lazyPacketId, false, 0, 0));
+    EXPECT_TRUE(GetActivePackets().empty());
+}
+
+TEST_F(DecodeSubPipelineTest, CreatedPacketIsDeletedWithTheSubPipeline)
+{
+    uint32_t deleteNum = 0;
+    {
+        class SubPipeline : public DecodeSubPipeline
+        {
+        public:
+            SubPipeline() : DecodeSubPipeline(nullptr, nullptr, 1) {}
+            MOS_STATUS Init(CodechalSetting &settings) override { return MOS_STATUS_SUCCESS; }
+            MOS_STATUS Prepare(DecodePipelineParams &params) override { return MOS_STATUS_SUCCESS; }
+            MediaFunction GetMediaFunction() override { return VdboxDecodeFunc; }
+            void InitScalabilityPars(PMOS_INTERFACE osInterface) override {}
+            using DecodeSubPipeline::ActivatePacket;
+            using DecodeSubPipeline::RegisterPacket;
+        } subPipeline;
+
+        uint32_t initNum = 0;
+        EXPECT_EQ(MOS_STATUS_SUCCESS, subPipeline.RegisterPacket(lazyPacketId, [&]() -> MediaPacket * {
+            return MOS_New(FakeDecodePacket, initNum, deleteNum, false);
+        }));
+        EXPECT_EQ(MOS_STATUS_SUCCESS, subPipeline.ActivatePacket(lazyPacketId, false, 0, 0));
+        EXPECT_EQ(0u, deleteNum);
+    }
+    EXPECT_EQ(1u, deleteNum);
+}
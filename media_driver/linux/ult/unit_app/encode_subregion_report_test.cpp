@@ -0,0 +1,195 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "encode_status_report.h"
+
+using namespace std;
+using namespace encode;
+
+// The subregion buffer and the completed count are host memory the test writes the
+// way the GPU would, the packets get their addresses from GetSubregionAddress and
+// the DDI reads them back through GetSubregionReport while the picture encodes.
+class EncodeSubregionReportTest : public testing::Test, protected EncoderStatusReport
+{
+protected:
+    struct Entry
+    {
+        uint32_t offset;
+        uint32_t tag;
+    };
+
+    EncodeSubregionReportTest() : EncoderStatusReport(nullptr, nullptr, false, false, false)
+    {
+    }
+
+    void SetUp() override
+    {
+        m_gpuSubregions.assign(m_statusNum * ENCODE_SUBREGION_REPORT_MAX_NUM, {});
+        m_gpuCompleted   = 0;
+        m_completedCount = &m_gpuCompleted;
+        m_dataSubregion  = m_gpuSubregions.data();
+        m_subregionBuf   = &m_resource;
+    }
+
+    void TearDown() override
+    {
+        // Not allocated through m_allocator, keep Destroy away from them
+        m_completedCount = nullptr;
+        m_dataSubregion  = nullptr;
+        m_subregionBuf   = nullptr;
+    }
+
+    // Adds the subregion reports of a picture, then submits it
+    vector<Entry> Submit(uint32_t subregionNum)
+    {
+        vector<Entry> entries;
+        for (uint32_t i = 0; i < subregionNum; i++)
+        {
+            PMOS_RESOURCE resource = nullptr;
+            Entry         entry    = {};
+            EXPECT_EQ(MOS_STATUS_SUCCESS, GetSubregionAddress(i, resource, entry.offset, entry.tag));
+            EXPECT_EQ(&m_resource, resource);
+            entries.push_back(entry);
+        }
+        EXPECT_EQ(MOS_STATUS_SUCCESS, Reset());
+        return entries;
+    }
+
+    void GpuWrite(const Entry &entry, uint32_t bitstreamEnd)
+    {
+        uint8_t *base = (uint8_t *)m_gpuSubregions.data();
+        *(uint32_t *)(base + entry.offset + CODECHAL_OFFSETOF(EncodeSubregionStatus, bitstreamEnd)) = bitstreamEnd;
+        *(uint32_t *)(base + entry.offset + CODECHAL_OFFSETOF(EncodeSubregionStatus, tag))          = entry.tag;
+    }
+
+    EncodeSubregionReport Query(uint32_t pendingIndex)
+    {
+        EncodeSubregionReport report = {};
+        EXPECT_EQ(MOS_STATUS_SUCCESS, GetSubregionReport(pendingIndex, report));
+        return report;
+    }
+
+    MOS_RESOURCE                  m_resource     = {};
+    vector<EncodeSubregionStatus> m_gpuSubregions;
+    uint32_t                      m_gpuCompleted = 0;
+};
+
+TEST_F(EncodeSubregionReportTest, PartialPictureReportsTheCompletedPrefix)
+{
+    vector<Entry> slices = Submit(4);
+
+    EncodeSubregionReport report = Query(0);
+    EXPECT_EQ(4u, report.subregionNum);
+    EXPECT_EQ(0u, report.completedNum);
+    EXPECT_FALSE(report.frameCompleted);
+
+    GpuWrite(slices[0], 100);
+    GpuWrite(slices[1], 250);
+    report = Query(0);
+    EXPECT_EQ(2u, report.completedNum);
+    EXPECT_EQ(100u, report.bitstreamEnd[0]);
+    EXPECT_EQ(250u, report.bitstreamEnd[1]);
+    EXPECT_FALSE(report.frameCompleted);
+
+    // Only a prefix is handed out, a later slice alone does not extend it
+    GpuWrite(slices[3], 600);
+    EXPECT_EQ(2u, Query(0).completedNum);
+
+    GpuWrite(slices[2], 400);
+    report = Query(0);
+    EXPECT_EQ(4u, report.completedNum);
+    EXPECT_EQ(400u, report.bitstreamEnd[2]);
+    EXPECT_EQ(600u, report.bitstreamEnd[3]);
+    EXPECT_FALSE(report.frameCompleted);
+
+    m_gpuCompleted = 1;
+    EXPECT_TRUE(Query(0).frameCompleted);
+}
+
+TEST_F(EncodeSubregionReportTest, PendingPicturesAreQueriedInSubmissionOrder)
+{
+    vector<Entry> first  = Submit(2);
+    vector<Entry> second = Submit(3);
+
+    GpuWrite(first[0], 10);
+    GpuWrite(first[1], 20);
+    m_gpuCompleted = 1;
+    GpuWrite(second[0], 30);
+
+    EncodeSubregionReport report = Query(0);
+    EXPECT_EQ(2u, report.subregionNum);
+    EXPECT_EQ(2u, report.completedNum);
+    EXPECT_TRUE(report.frameCompleted);
+
+    report = Query(1);
+    EXPECT_EQ(3u, report.subregionNum);
+    EXPECT_EQ(1u, report.completedNum);
+    EXPECT_EQ(30u, report.bitstreamEnd[0]);
+    EXPECT_FALSE(report.frameCompleted);
+
+    report = {};
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, GetSubregionReport(2, report));
+
+    // Once the first picture is collected the second one is next
+    m_reportedCount++;
+    EXPECT_EQ(3u, Query(0).subregionNum);
+}
+
+TEST_F(EncodeSubregionReportTest, ReusedSlotIgnoresTheOldPicture)
+{
+    vector<Entry> old = Submit(3);
+    GpuWrite(old[0], 10);
+    GpuWrite(old[1], 20);
+    GpuWrite(old[2], 30);
+    m_gpuCompleted  = 1;
+    m_reportedCount = 1;
+
+    // Skip ahead until the next picture uses the slot again, Reset clears its count
+    m_submittedCount = m_statusNum - 1;
+    m_reportedCount  = m_statusNum - 1;
+    m_gpuCompleted   = m_statusNum - 1;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Reset());
+    m_reportedCount = m_statusNum;
+    m_gpuCompleted  = m_statusNum;
+
+    vector<Entry> slices = Submit(2);
+    EXPECT_EQ(old[0].offset, slices[0].offset);
+    EXPECT_NE(old[0].tag, slices[0].tag);
+
+    EncodeSubregionReport report = Query(0);
+    EXPECT_EQ(2u, report.subregionNum);
+    EXPECT_EQ(0u, report.completedNum);
+    EXPECT_FALSE(report.frameCompleted);
+
+    GpuWrite(slices[0], 50);
+    EXPECT_EQ(1u, Query(0).completedNum);
+}
+
+TEST_F(EncodeSubregionReportTest, SubregionsBeyondTheLastEntryShareIt)
+{
+    vector<Entry> slices = Submit(ENCODE_SUBREGION_REPORT_MAX_NUM + 6);
+    EXPECT_EQ(slices[ENCODE_SUBREGION_REPORT_MAX_NUM - 1].offset, slices.back().offset);
+
+    // The count is capped, the DDI only hands out such pictures whole
+    EXPECT_EQ((uint32_t)ENCODE_SUBREGION_REPORT_MAX_NUM, Query(0).subregionNum);
+}
@@ -0,0 +1,338 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_allocator.h"
+#include "mos_bufmgr_priv.h"
+#include "mos_memory_usage.h"
+
+using namespace std;
+
+// Allocations get a real GMM buffer resource info of the requested size behind a fake
+// buffer object, so the allocator accounts them as it does on HW. The placement
+// asked from the os interface is recorded per allocation.
+class MediaAllocatorBudgetTest : public testing::Test, protected Allocator
+{
+protected:
+    static constexpr uint64_t MB = 1024 * 1024;
+
+    MediaAllocatorBudgetTest() : Allocator(nullptr)
+    {
+    }
+
+    void SetUp() override
+    {
+        s_test = this;
+
+        PLATFORM platform           = {};
+        platform.eProductFamily     = IGFX_TIGERLAKE_LP;
+        platform.eRenderCoreFamily  = IGFX_GEN12_CORE;
+        platform.eDisplayCoreFamily = IGFX_GEN12_CORE;
+        platform.usDeviceID         = 0x9A49;
+
+        GMM_SKU_FEATURE_TABLE skuTable = {};
+        GMM_WA_TABLE          waTable  = {};
+        GMM_GT_SYSTEM_INFO    gtInfo   = {};
+        gtInfo.SliceCount              = 1;
+        gtInfo.SubSliceCount           = 6;
+        gtInfo.EUCount                 = 96;
+
+        GMM_INIT_IN_ARGS gmmInitArgs = {};
+        gmmInitArgs.Platform         = platform;
+        gmmInitArgs.pSkuTable        = &skuTable;
+        gmmInitArgs.pWaTable         = &waTable;
+        gmmInitArgs.pGtSysInfo       = &gtInfo;
+        gmmInitArgs.ClientType       = (GMM_CLIENT)GMM_LIBVA_LINUX;
+        ASSERT_EQ(GMM_SUCCESS, InitializeGmm(&gmmInitArgs, &m_gmmOutArgs));
+        ASSERT_NE(nullptr, m_gmmOutArgs.pGmmClientContext);
+
+        m_bufmgr.bo_busy = [](mos_linux_bo *bo) -> int {
+            return s_test->m_busy.count(bo) ? 1 : 0;
+        };
+
+        m_os.apoMosEnabled       = true;
+        m_os.osStreamState       = &m_streamState;
+        m_os.pfnAllocateResource = Allocate;
+        m_os.pfnFreeResource     = Free;
+        m_os.pfnLockResource     = [](PMOS_INTERFACE, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS) -> void * {
+            return resource->bo;
+        };
+        m_os.pfnUnlockResource = [](PMOS_INTERFACE, PMOS_RESOURCE) -> MOS_STATUS {
+            return MOS_STATUS_SUCCESS;
+        };
+        m_osInterface = &m_os;
+
+        MosMemoryUsage::Get(m_before);
+    }
+
+    void TearDown() override
+    {
+        // What the destructor does while the os interface is still there
+        DestroyAllResources();
+        EXPECT_EQ(0u, m_boNum);
+        m_osInterface = nullptr;
+
+        MosMemoryUsage::Usage after;
+        MosMemoryUsage::Get(after);
+        EXPECT_EQ(m_before.usedBytes, after.usedBytes);
+        EXPECT_EQ(m_before.spilledBytes, after.spilledBytes);
+
+        GmmAdapterDestroy(&m_gmmOutArgs);
+        s_test = nullptr;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static MOS_STATUS Allocate(PMOS_INTERFACE, PMOS_ALLOC_GFXRES_PARAMS params, const char *, const char *, int32_t, PMOS_RESOURCE resource)
+#else
+    static MOS_STATUS Allocate(PMOS_INTERFACE, PMOS_ALLOC_GFXRES_PARAMS params, PMOS_RESOURCE resource)
+#endif
+    {
+        GMM_RESCREATE_PARAMS gmmParams = {};
+        gmmParams.BaseWidth            = params->dwBytes;
+        gmmParams.BaseHeight           = 1;
+        gmmParams.ArraySize            = 1;
+        gmmParams.Type                 = RESOURCE_BUFFER;
+        gmmParams.Format               = GMM_FORMAT_GENERIC_8BIT;
+        gmmParams.Flags.Gpu.State      = 1;
+        gmmParams.Flags.Info.Linear    = 1;
+
+        resource->pGmmResInfo = s_test->m_gmmOutArgs.pGmmClientContext->CreateResInfoObject(&gmmParams);
+        EXPECT_NE(nullptr, resource->pGmmResInfo);
+
+        mos_linux_bo *bo = MOS_New(mos_linux_bo);
+        MOS_ZeroMemory(bo, sizeof(*bo));
+        bo->size     = params->dwBytes;
+        bo->bufmgr   = &s_test->m_bufmgr;
+        resource->bo = bo;
+        s_test->m_boNum++;
+        s_test->m_memTypes.push_back(params->dwMemType);
+        return MOS_STATUS_SUCCESS;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static void Free(PMOS_INTERFACE, const char *, const char *, int32_t, PMOS_RESOURCE resource)
+#else
+    static void Free(PMOS_INTERFACE, PMOS_RESOURCE resource)
+#endif
+    {
+        s_test->m_gmmOutArgs.pGmmClientContext->DestroyResInfoObject(resource->pGmmResInfo);
+        s_test->m_busy.erase(resource->bo);
+        MOS_Delete(resource->bo);
+        s_test->m_boNum--;
+        resource->pGmmResInfo = nullptr;
+        resource->bo          = nullptr;
+    }
+
+    MOS_BUFFER *Buffer(uint64_t bytes, MOS_COMPONENT component = COMPONENT_Decode, const char *name = "BudgetTestBuffer")
+    {
+        MOS_ALLOC_GFXRES_PARAMS param;
+        MOS_ZeroMemory(&param, sizeof(param));
+        param.Type     = MOS_GFXRES_BUFFER;
+        param.Format   = Format_Buffer;
+        param.dwBytes  = (uint32_t)bytes;
+        param.pBufName = name;
+
+        MOS_BUFFER *buffer = AllocateBuffer(param, false, component);
+        EXPECT_NE(nullptr, buffer);
+        EXPECT_EQ(MOS_MEMPOOL_VIDEOMEMORY, param.dwMemType);
+        return buffer;
+    }
+
+    // Placement the os interface was asked for by the last allocation
+    int32_t LastMemType()
+    {
+        return m_memTypes.empty() ? -1 : m_memTypes.back();
+    }
+
+    uint64_t PurposeBytes(MOS_COMPONENT component, const char *purpose)
+    {
+        auto it = m_purposeBytes.find(MemoryPurpose(component, purpose));
+        return it == m_purposeBytes.end() ? 0 : it->second;
+    }
+
+    static MediaAllocatorBudgetTest *s_test;
+
+    GMM_INIT_OUT_ARGS     m_gmmOutArgs  = {};
+    mos_bufmgr            m_bufmgr;
+    MosStreamState        m_streamState = {};
+    MOS_INTERFACE         m_os          = {};
+    MosMemoryUsage::Usage m_before;
+    set<mos_linux_bo *>   m_busy;
+    vector<int32_t>       m_memTypes;
+    uint32_t              m_boNum = 0;
+};
+
+MediaAllocatorBudgetTest *MediaAllocatorBudgetTest::s_test = nullptr;
+constexpr uint64_t        MediaAllocatorBudgetTest::MB;
+
+TEST_F(MediaAllocatorBudgetTest, BufferOverBudgetGoesToSystemMemory)
+{
+    m_memoryBudget = 10 * MB;
+
+    MOS_BUFFER *first = Buffer(8 * MB);
+    EXPECT_EQ(MOS_MEMPOOL_VIDEOMEMORY, LastMemType());
+
+    // Exactly filling the budget still fits
+    Buffer(2 * MB);
+    EXPECT_EQ(MOS_MEMPOOL_VIDEOMEMORY, LastMemType());
+    Buffer(1 * MB);
+    EXPECT_EQ(MOS_MEMPOOL_SYSTEMMEMORY, LastMemType());
+    EXPECT_EQ(1 * MB, m_spilledBytes);
+
+    MosMemoryUsage::Usage usage;
+    MosMemoryUsage::Get(usage);
+    EXPECT_EQ(m_before.usedBytes + 11 * MB, usage.usedBytes);
+    EXPECT_EQ(m_before.spilledBytes + 1 * MB, usage.spilledBytes);
+
+    // Freeing makes room again
+    EXPECT_EQ(MOS_STATUS_SUCCESS, DestroyBuffer(first));
+    Buffer(4 * MB);
+    EXPECT_EQ(MOS_MEMPOOL_VIDEOMEMORY, LastMemType());
+    EXPECT_EQ(11 * MB, m_peakBytes);
+}
+
+TEST_F(MediaAllocatorBudgetTest, OnlyPlainBuffersMove)
+{
+    m_memoryBudget = 1 * MB;
+    Buffer(1 * MB);
+
+    MOS_ALLOC_GFXRES_PARAMS param;
+    MOS_ZeroMemory(&param, sizeof(param));
+    param.Type     = MOS_GFXRES_BUFFER;
+    param.Format   = Format_Buffer;
+    param.dwBytes  = (uint32_t)MB;
+    param.pBufName = "BudgetTestBuffer";
+
+    // Compressed or explicitly placed resources keep their placement
+    param.bIsCompressible = true;
+    EXPECT_NE(nullptr, AllocateBuffer(param, false, COMPONENT_Decode));
+    EXPECT_EQ(MOS_MEMPOOL_VIDEOMEMORY, LastMemType());
+
+    param.bIsCompressible = false;
+    param.dwMemType       = MOS_MEMPOOL_DEVICEMEMORY;
+    EXPECT_NE(nullptr, AllocateResource(param, false, COMPONENT_Decode));
+    EXPECT_EQ(MOS_MEMPOOL_DEVICEMEMORY, LastMemType());
+    EXPECT_EQ(0u, m_spilledBytes);
+
+    // Resources go through the same check as buffers
+    param.dwMemType = MOS_MEMPOOL_VIDEOMEMORY;
+    EXPECT_NE(nullptr, AllocateResource(param, false, COMPONENT_Decode));
+    EXPECT_EQ(MOS_MEMPOOL_SYSTEMMEMORY, LastMemType());
+    EXPECT_EQ(MOS_MEMPOOL_VIDEOMEMORY, param.dwMemType);
+}
+
+TEST_F(MediaAllocatorBudgetTest, NoBudgetNeverSpills)
+{
+    Buffer(64 * MB);
+    Buffer(64 * MB);
+    EXPECT_EQ(MOS_MEMPOOL_VIDEOMEMORY, LastMemType());
+    EXPECT_EQ(0u, m_spilledBytes);
+}
+
+TEST_F(MediaAllocatorBudgetTest, SpareBackingsCountAgainstTheBudget)
+{
+    m_memoryBudget = 4 * MB;
+
+    MOS_ALLOC_GFXRES_PARAMS param;
+    MOS_ZeroMemory(&param, sizeof(param));
+    param.Type         = MOS_GFXRES_BUFFER;
+    param.Format       = Format_Buffer;
+    param.dwBytes      = (uint32_t)(2 * MB);
+    param.pBufName     = "BudgetTestDmem";
+    MOS_BUFFER *buffer = AllocateBuffer(param, false, COMPONENT_Decode);
+    ASSERT_NE(nullptr, buffer);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, EnableOrphaning(&buffer->OsResource, param, 2));
+
+    // A write while the GPU reads it adds a backing of the same size
+    m_busy.insert(buffer->OsResource.bo);
+    MOS_LOCK_PARAMS flags;
+    MOS_ZeroMemory(&flags, sizeof(flags));
+    flags.WriteOnly = 1;
+    EXPECT_NE(nullptr, Lock(&buffer->OsResource, &flags));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, UnLock(&buffer->OsResource));
+    EXPECT_EQ(2u, m_boNum);
+    EXPECT_EQ(4 * MB, m_peakBytes);
+
+    MosMemoryUsage::Usage usage;
+    MosMemoryUsage::Get(usage);
+    EXPECT_EQ(m_before.usedBytes + 4 * MB, usage.usedBytes);
+
+    Buffer(1);
+    EXPECT_EQ(MOS_MEMPOOL_SYSTEMMEMORY, LastMemType());
+
+    // Destroying the buffer returns its spare backing as well
+    EXPECT_EQ(MOS_STATUS_SUCCESS, DestroyBuffer(buffer));
+    MosMemoryUsage::Get(usage);
+    EXPECT_EQ(m_before.usedBytes + m_usedBytes, usage.usedBytes);
+    Buffer(2 * MB);
+    EXPECT_EQ(MOS_MEMPOOL_VIDEOMEMORY, LastMemType());
+}
+
+TEST_F(MediaAllocatorBudgetTest, UsagePerComponentAndPurpose)
+{
+    MOS_BUFFER *mv = Buffer(3 * MB, COMPONENT_Decode, "MvTemporalBuffer");
+    Buffer(3 * MB, COMPONENT_Decode, "MvTemporalBuffer");
+    Buffer(1 * MB, COMPONENT_Decode, "BitstreamBuffer");
+    Buffer(2 * MB, COMPONENT_Encode, "MvTemporalBuffer");
+    EXPECT_EQ(6 * MB, PurposeBytes(COMPONENT_Decode, "MvTemporalBuffer"));
+    EXPECT_EQ(1 * MB, PurposeBytes(COMPONENT_Decode, "BitstreamBuffer"));
+    EXPECT_EQ(2 * MB, PurposeBytes(COMPONENT_Encode, "MvTemporalBuffer"));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, DestroyBuffer(mv));
+    EXPECT_EQ(3 * MB, PurposeBytes(COMPONENT_Decode, "MvTemporalBuffer"));
+    EXPECT_EQ(6 * MB, m_usedBytes);
+
+    // Names of freed buffers do not pile up
+    MOS_BUFFER *scratch = Buffer(1 * MB, COMPONENT_VPCommon, "ScratchBuffer");
+    EXPECT_EQ(4u, m_purposeBytes.size());
+    EXPECT_EQ(MOS_STATUS_SUCCESS, DestroyBuffer(scratch));
+    EXPECT_EQ(3u, m_purposeBytes.size());
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, DestroyAllResources());
+    EXPECT_TRUE(m_purposeBytes.empty());
+    EXPECT_EQ(0u, m_usedBytes);
+}
+
+TEST_F(MediaAllocatorBudgetTest, AdmissionFollowsLiveUsage)
+{
+    uint64_t limit = m_before.usedBytes + 16 * MB;
+    EXPECT_FALSE(MosMemoryUsage::IsOverLimit(limit));
+
+    MOS_BUFFER *buffer = Buffer(16 * MB);
+    EXPECT_TRUE(MosMemoryUsage::IsOverLimit(limit));
+    EXPECT_FALSE(MosMemoryUsage::IsOverLimit(0));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, DestroyBuffer(buffer));
+    EXPECT_FALSE(MosMemoryUsage::IsOverLimit(limit));
+
+    // Destroying the context's allocator admits new contexts again
+    Buffer(16 * MB);
+    EXPECT_TRUE(MosMemoryUsage::IsOverLimit(limit));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, DestroyAllResources());
+    EXPECT_FALSE(MosMemoryUsage::IsOverLimit(limit));
+
+    // The process peak is kept
+    MosMemoryUsage::Usage usage;
+    MosMemoryUsage::Get(usage);
+    EXPECT_GE(usage.peakBytes, limit);
+}
@@ -0,0 +1,272 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <map>
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_allocator.h"
+#include "mos_bufmgr_priv.h"
+
+using namespace std;
+
+// The allocations are host memory behind fake buffer objects. Their busy state comes
+// from the bo_busy hook of the buffer manager, which is what MosInterface::IsResourceBusy
+// asks. The test marks a buffer object busy the way a submitted command buffer would.
+class MediaAllocatorOrphanTest : public testing::Test
+{
+protected:
+    static constexpr uint32_t m_size = 64;
+
+    void SetUp() override
+    {
+        s_test = this;
+
+        m_bufmgr.bo_busy = [](mos_linux_bo *bo) -> int {
+            return s_test->m_busy.count(bo) ? 1 : 0;
+        };
+
+        m_osInterface.apoMosEnabled       = true;
+        m_osInterface.osStreamState       = &m_streamState;
+        m_osInterface.pfnAllocateResource = Allocate;
+        m_osInterface.pfnFreeResource     = Free;
+        m_osInterface.pfnLockResource     = [](PMOS_INTERFACE, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS) -> void * {
+            s_test->m_lockedBo.push_back(resource->bo);
+            return s_test->m_memory[resource->bo].data();
+        };
+        m_osInterface.pfnUnlockResource = [](PMOS_INTERFACE, PMOS_RESOURCE) -> MOS_STATUS {
+            return MOS_STATUS_SUCCESS;
+        };
+
+        m_allocator = MOS_New(Allocator, &m_osInterface);
+        ASSERT_NE(nullptr, m_allocator);
+    }
+
+    void TearDown() override
+    {
+        MOS_Delete(m_allocator);
+        EXPECT_TRUE(m_memory.empty());
+        s_test = nullptr;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static MOS_STATUS Allocate(PMOS_INTERFACE, PMOS_ALLOC_GFXRES_PARAMS params, const char *, const char *, int32_t, PMOS_RESOURCE resource)
+#else
+    static MOS_STATUS Allocate(PMOS_INTERFACE, PMOS_ALLOC_GFXRES_PARAMS params, PMOS_RESOURCE resource)
+#endif
+    {
+        mos_linux_bo *bo = MOS_New(mos_linux_bo);
+        MOS_ZeroMemory(bo, sizeof(*bo));
+        bo->size   = params->dwBytes;
+        bo->bufmgr = &s_test->m_bufmgr;
+        s_test->m_memory[bo].assign(params->dwBytes, 0);
+        s_test->m_allocNum++;
+        resource->bo = bo;
+        return MOS_STATUS_SUCCESS;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static void Free(PMOS_INTERFACE, const char *, const char *, int32_t, PMOS_RESOURCE resource)
+#else
+    static void Free(PMOS_INTERFACE, PMOS_RESOURCE resource)
+#endif
+    {
+        s_test->m_memory.erase(resource->bo);
+        s_test->m_busy.erase(resource->bo);
+        MOS_Delete(resource->bo);
+        resource->bo = nullptr;
+    }
+
+    MOS_BUFFER *AllocateOrphanable(uint32_t maxBackingNum)
+    {
+        MOS_ALLOC_GFXRES_PARAMS param;
+        MOS_ZeroMemory(&param, sizeof(param));
+        param.Type     = MOS_GFXRES_BUFFER;
+        param.Format   = Format_Buffer;
+        param.dwBytes  = m_size;
+        param.pBufName = "OrphanTestBuffer";
+
+        MOS_BUFFER *buffer = m_allocator->AllocateBuffer(param, false, COMPONENT_Decode);
+        EXPECT_NE(nullptr, buffer);
+        if (buffer)
+        {
+            EXPECT_EQ(MOS_STATUS_SUCCESS, m_allocator->EnableOrphaning(&buffer->OsResource, param, maxBackingNum));
+        }
+        return buffer;
+    }
+
+    // Rewrites the whole buffer the way a per frame DMEM update does
+    void Write(MOS_BUFFER *buffer, uint8_t value)
+    {
+        MOS_LOCK_PARAMS flags;
+        MOS_ZeroMemory(&flags, sizeof(flags));
+        flags.WriteOnly = 1;
+        uint8_t *data   = (uint8_t *)m_allocator->Lock(&buffer->OsResource, &flags);
+        ASSERT_NE(nullptr, data);
+        memset(data, value, m_size);
+        EXPECT_EQ(MOS_STATUS_SUCCESS, m_allocator->UnLock(&buffer->OsResource));
+    }
+
+    // What the GPU reads when it executes a command referencing the buffer now
+    uint8_t Content(MOS_BUFFER *buffer)
+    {
+        return m_memory[buffer->OsResource.bo][0];
+    }
+
+    static MediaAllocatorOrphanTest *s_test;
+
+    mos_bufmgr                          m_bufmgr;
+    MosStreamState                      m_streamState = {};
+    MOS_INTERFACE                       m_osInterface = {};
+    Allocator                          *m_allocator   = nullptr;
+    map<mos_linux_bo *, vector<uint8_t>> m_memory;
+    set<mos_linux_bo *>                 m_busy;
+    vector<mos_linux_bo *>              m_lockedBo;
+    uint32_t                            m_allocNum = 0;
+};
+
+MediaAllocatorOrphanTest *MediaAllocatorOrphanTest::s_test = nullptr;
+constexpr uint32_t        MediaAllocatorOrphanTest::m_size;
+
+TEST_F(MediaAllocatorOrphanTest, IdleBufferIsWrittenInPlace)
+{
+    MOS_BUFFER   *buffer = AllocateOrphanable(8);
+    mos_linux_bo *bo     = buffer->OsResource.bo;
+
+    Write(buffer, 1);
+    Write(buffer, 2);
+    EXPECT_EQ(bo, buffer->OsResource.bo);
+    EXPECT_EQ(1u, m_allocNum);
+    EXPECT_EQ(2, Content(buffer));
+}
+
+TEST_F(MediaAllocatorOrphanTest, BusyBufferSwitchesToANewAllocation)
+{
+    MOS_BUFFER   *buffer = AllocateOrphanable(8);
+    mos_linux_bo *first  = buffer->OsResource.bo;
+    Write(buffer, 1);
+
+    // The previous frame still reads it, the next frame gets its own allocation
+    m_busy.insert(first);
+    Write(buffer, 2);
+    EXPECT_NE(first, buffer->OsResource.bo);
+    EXPECT_EQ(buffer->OsResource.bo, m_lockedBo.back());
+    EXPECT_EQ(2u, m_allocNum);
+    EXPECT_EQ(2, Content(buffer));
+    EXPECT_EQ(1, m_memory[first][0]);
+}
+
+TEST_F(MediaAllocatorOrphanTest, IdleSpareIsRecycled)
+{
+    MOS_BUFFER   *buffer = AllocateOrphanable(8);
+    mos_linux_bo *first  = buffer->OsResource.bo;
+    m_busy.insert(first);
+    Write(buffer, 1);
+    mos_linux_bo *second = buffer->OsResource.bo;
+
+    // The first frame retired, the second one is in flight
+    m_busy.clear();
+    m_busy.insert(second);
+    Write(buffer, 2);
+    EXPECT_EQ(first, buffer->OsResource.bo);
+    EXPECT_EQ(2u, m_allocNum);
+
+    // Both in flight, a third allocation is added
+    m_busy.insert(first);
+    Write(buffer, 3);
+    EXPECT_NE(first, buffer->OsResource.bo);
+    EXPECT_NE(second, buffer->OsResource.bo);
+    EXPECT_EQ(3u, m_allocNum);
+}
+
+TEST_F(MediaAllocatorOrphanTest, LockWaitsOnceAllBackingsAreBusy)
+{
+    MOS_BUFFER   *buffer = AllocateOrphanable(2);
+    mos_linux_bo *first  = buffer->OsResource.bo;
+    m_busy.insert(first);
+    Write(buffer, 1);
+    mos_linux_bo *second = buffer->OsResource.bo;
+    m_busy.insert(second);
+
+    Write(buffer, 2);
+    EXPECT_EQ(second, buffer->OsResource.bo);
+    EXPECT_EQ(second, m_lockedBo.back());
+    EXPECT_EQ(2u, m_allocNum);
+}
+
+TEST_F(MediaAllocatorOrphanTest, ReadLockKeepsTheAllocation)
+{
+    MOS_BUFFER   *buffer = AllocateOrphanable(8);
+    mos_linux_bo *bo     = buffer->OsResource.bo;
+    m_busy.insert(bo);
+
+    MOS_LOCK_PARAMS flags;
+    MOS_ZeroMemory(&flags, sizeof(flags));
+    flags.ReadOnly = 1;
+    EXPECT_NE(nullptr, m_allocator->Lock(&buffer->OsResource, &flags));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_allocator->UnLock(&buffer->OsResource));
+    EXPECT_EQ(bo, buffer->OsResource.bo);
+    EXPECT_EQ(1u, m_allocNum);
+}
+
+TEST_F(MediaAllocatorOrphanTest, PlainBufferIsNeverOrphaned)
+{
+    MOS_ALLOC_GFXRES_PARAMS param;
+    MOS_ZeroMemory(&param, sizeof(param));
+    param.Type     = MOS_GFXRES_BUFFER;
+    param.Format   = Format_Buffer;
+    param.dwBytes  = m_size;
+    param.pBufName = "PlainTestBuffer";
+    MOS_BUFFER *buffer = m_allocator->AllocateBuffer(param, false, COMPONENT_Decode);
+    ASSERT_NE(nullptr, buffer);
+    mos_linux_bo *bo = buffer->OsResource.bo;
+
+    m_busy.insert(bo);
+    Write(buffer, 1);
+    EXPECT_EQ(bo, buffer->OsResource.bo);
+    EXPECT_EQ(1u, m_allocNum);
+}
+
+TEST_F(MediaAllocatorOrphanTest, OrphaningNeedsApoMos)
+{
+    m_osInterface.apoMosEnabled = false;
+    MOS_BUFFER   *buffer        = AllocateOrphanable(8);
+    mos_linux_bo *bo            = buffer->OsResource.bo;
+
+    m_busy.insert(bo);
+    Write(buffer, 1);
+    EXPECT_EQ(bo, buffer->OsResource.bo);
+    EXPECT_EQ(1u, m_allocNum);
+}
+
+TEST_F(MediaAllocatorOrphanTest, DestroyFreesEveryBacking)
+{
+    MOS_BUFFER *buffer = AllocateOrphanable(8);
+    m_busy.insert(buffer->OsResource.bo);
+    Write(buffer, 1);
+    m_busy.insert(buffer->OsResource.bo);
+    Write(buffer, 2);
+    EXPECT_EQ(3u, m_allocNum);
+    EXPECT_EQ(3u, m_memory.size());
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_allocator->DestroyBuffer(buffer));
+    EXPECT_TRUE(m_memory.empty());
+}
@@ -0,0 +1,386 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_copy_cpu.h"
+#include "mos_utilities.h"
+
+using namespace std;
+
+// Surfaces are real GMM NV12 resources backed by host memory, locked through a
+// MOS_INTERFACE which hands out that memory. TileY content is checked against
+// MosSwizzleData.
+class MediaCpuCopyTest : public testing::Test
+{
+protected:
+    static constexpr uint32_t m_width  = 256;
+    static constexpr uint32_t m_height = 128;
+
+    struct Surface
+    {
+        MOS_SURFACE     details = {};
+        vector<uint8_t> data;
+    };
+
+    void SetUp() override
+    {
+        PLATFORM platform           = {};
+        platform.eProductFamily     = IGFX_TIGERLAKE_LP;
+        platform.eRenderCoreFamily  = IGFX_GEN12_CORE;
+        platform.eDisplayCoreFamily = IGFX_GEN12_CORE;
+        platform.usDeviceID         = 0x9A49;
+
+        GMM_SKU_FEATURE_TABLE skuTable = {};
+        GMM_WA_TABLE          waTable  = {};
+        GMM_GT_SYSTEM_INFO    gtInfo   = {};
+        skuTable.FtrTileY              = 1;
+        gtInfo.SliceCount              = 1;
+        gtInfo.SubSliceCount           = 6;
+        gtInfo.EUCount                 = 96;
+
+        GMM_INIT_IN_ARGS gmmInitArgs = {};
+        gmmInitArgs.Platform         = platform;
+        gmmInitArgs.pSkuTable        = &skuTable;
+        gmmInitArgs.pWaTable         = &waTable;
+        gmmInitArgs.pGtSysInfo       = &gtInfo;
+        gmmInitArgs.ClientType       = (GMM_CLIENT)GMM_LIBVA_LINUX;
+        ASSERT_EQ(GMM_SUCCESS, InitializeGmm(&gmmInitArgs, &m_gmmOutArgs));
+        ASSERT_NE(nullptr, m_gmmOutArgs.pGmmClientContext);
+
+        m_osInterface.pfnLockResource   = Lock;
+        m_osInterface.pfnUnlockResource = Unlock;
+    }
+
+    void TearDown() override
+    {
+        for (auto resInfo : m_resInfos)
+        {
+            m_gmmOutArgs.pGmmClientContext->DestroyResInfoObject(resInfo);
+        }
+        GmmAdapterDestroy(&m_gmmOutArgs);
+    }
+
+    static void *Lock(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS flags)
+    {
+        EXPECT_TRUE(flags->TiledAsTiled);
+        return resource->pData;
+    }
+
+    static MOS_STATUS Unlock(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Fills the surface details the way MosInterface::GetResourceInfo does
+    void CreateSurface(bool tiled, Surface &surface)
+    {
+        GMM_RESCREATE_PARAMS gmmParams = {};
+        gmmParams.BaseWidth            = m_width;
+        gmmParams.BaseHeight           = m_height;
+        gmmParams.ArraySize            = 1;
+        gmmParams.Type                 = RESOURCE_2D;
+        gmmParams.Format               = GMM_FORMAT_NV12;
+        gmmParams.Flags.Gpu.Video      = 1;
+        gmmParams.Flags.Info.Linear    = !tiled;
+        gmmParams.Flags.Info.TiledY    = tiled;
+
+        GMM_RESOURCE_INFO *resInfo = m_gmmOutArgs.pGmmClientContext->CreateResInfoObject(&gmmParams);
+        ASSERT_NE(nullptr, resInfo);
+        m_resInfos.push_back(resInfo);
+
+        GMM_REQ_OFFSET_INFO reqInfo = {};
+        reqInfo.ReqRender           = true;
+        reqInfo.Plane               = GMM_PLANE_U;
+        reqInfo.Frame               = GMM_DISPLAY_BASE;
+        resInfo->GetOffset(reqInfo);
+
+        MOS_SURFACE &details                 = surface.details;
+        details.Format                       = Format_NV12;
+        details.dwWidth                      = m_width;
+        details.dwHeight                     = m_height;
+        details.dwPitch                      = (uint32_t)resInfo->GetRenderPitch();
+        details.dwSize                       = (uint32_t)resInfo->GetSizeSurface();
+        details.TileType                     = tiled ? MOS_TILE_Y : MOS_TILE_LINEAR;
+        details.UPlaneOffset.iSurfaceOffset  = reqInfo.Render.Offset;
+        details.OsResource.pGmmResInfo       = resInfo;
+        details.OsResource.TileType          = details.TileType;
+
+        ASSERT_EQ(tiled ? GMM_TILED_Y : GMM_NOT_TILED, resInfo->GetTileType());
+        ASSERT_EQ(0u, details.dwSize % details.dwPitch);
+        surface.data.assign(details.dwSize, 0);
+        details.OsResource.pData = surface.data.data();
+    }
+
+    static uint8_t Pixel(uint32_t plane, uint32_t x, uint32_t y)
+    {
+        return (uint8_t)(plane * 101 + x * 7 + y * 13 + 1);
+    }
+
+    // Pixels of the surface content as a linear buffer of the same pitch
+    static vector<uint8_t> ToLinear(Surface &surface)
+    {
+        MOS_SURFACE &details = surface.details;
+        if (details.TileType == MOS_TILE_LINEAR)
+        {
+            return surface.data;
+        }
+        vector<uint8_t> linear(details.dwSize);
+        MosUtilities::MosSwizzleData(surface.data.data(), linear.data(), MOS_TILE_Y, MOS_TILE_LINEAR, details.dwSize / details.dwPitch, details.dwPitch, 0);
+        return linear;
+    }
+
+    static void Fill(Surface &surface)
+    {
+        MOS_SURFACE    &details = surface.details;
+        vector<uint8_t> linear(details.dwSize);
+        for (uint32_t plane = 0; plane < 2; plane++)
+        {
+            uint32_t base = plane ? details.UPlaneOffset.iSurfaceOffset : 0;
+            for (uint32_t y = 0; y < (plane ? m_height / 2 : m_height); y++)
+            {
+                for (uint32_t x = 0; x < m_width; x++)
+                {
+                    linear[base + y * details.dwPitch + x] = Pixel(plane, x, y);
+                }
+            }
+        }
+        if (details.TileType == MOS_TILE_LINEAR)
+        {
+            surface.data = linear;
+            details.OsResource.pData = surface.data.data();
+        }
+        else
+        {
+            MosUtilities::MosSwizzleData(linear.data(), surface.data.data(), MOS_TILE_LINEAR, MOS_TILE_Y, details.dwSize / details.dwPitch, details.dwPitch, 0);
+        }
+    }
+
+    // Counts the pixels of the first rows which do not match the source, rows below
+    // must be left untouched
+    static uint32_t CountMismatches(Surface &surface, uint32_t rows)
+    {
+        MOS_SURFACE    &details = surface.details;
+        vector<uint8_t> linear  = ToLinear(surface);
+        uint32_t        count   = 0;
+        for (uint32_t plane = 0; plane < 2; plane++)
+        {
+            uint32_t base       = plane ? details.UPlaneOffset.iSurfaceOffset : 0;
+            uint32_t planeRows  = plane ? (rows + 1) / 2 : rows;
+            for (uint32_t y = 0; y < (plane ? m_height / 2 : m_height); y++)
+            {
+                for (uint32_t x = 0; x < m_width; x++)
+                {
+                    uint8_t expected = y < planeRows ? Pixel(plane, x, y) : 0;
+                    count += linear[base + y * details.dwPitch + x] != expected;
+                }
+            }
+        }
+        return count;
+    }
+
+    void Copy(bool srcTiled, bool dstTiled, uint32_t height)
+    {
+        Surface src, dst;
+        CreateSurface(srcTiled, src);
+        CreateSurface(dstTiled, dst);
+        Fill(src);
+
+        MediaCpuCopy cpuCopy(&m_osInterface);
+        ASSERT_TRUE(cpuCopy.IsCopySupported(src.details, dst.details));
+        ASSERT_EQ(MOS_STATUS_SUCCESS, cpuCopy.SurfaceCopy(src.details, dst.details, 0, height));
+        EXPECT_EQ(0u, CountMismatches(dst, height ? height : m_height));
+    }
+
+    // Checks a region copy of width x height pixels from the region at srcX, srcY of the
+    // source to dstX, dstY of dst, whose other pixels must stay 0
+    static uint32_t CountRegionMismatches(Surface &dst, uint32_t dstX, uint32_t dstY, uint32_t srcX, uint32_t srcY, uint32_t width, uint32_t height)
+    {
+        MOS_SURFACE    &details = dst.details;
+        vector<uint8_t> linear  = ToLinear(dst);
+        uint32_t        count   = 0;
+        for (uint32_t plane = 0; plane < 2; plane++)
+        {
+            uint32_t base    = plane ? details.UPlaneOffset.iSurfaceOffset : 0;
+            uint32_t rows    = plane ? (height + 1) / 2 : height;
+            uint32_t dstRow0 = plane ? dstY / 2 : dstY;
+            uint32_t srcRow0 = plane ? srcY / 2 : srcY;
+            for (uint32_t y = 0; y < (plane ? m_height / 2 : m_height); y++)
+            {
+                for (uint32_t x = 0; x < details.dwPitch; x++)
+                {
+                    bool    inRegion = y >= dstRow0 && y < dstRow0 + rows && x >= dstX && x < dstX + width;
+                    uint8_t expected = inRegion ? Pixel(plane, x - dstX + srcX, y - dstRow0 + srcRow0) : 0;
+                    count += linear[base + y * details.dwPitch + x] != expected;
+                }
+            }
+        }
+        return count;
+    }
+
+    GMM_INIT_OUT_ARGS           m_gmmOutArgs  = {};
+    MOS_INTERFACE               m_osInterface = {};
+    vector<GMM_RESOURCE_INFO *> m_resInfos;
+};
+
+constexpr uint32_t MediaCpuCopyTest::m_width;
+constexpr uint32_t MediaCpuCopyTest::m_height;
+
+TEST_F(MediaCpuCopyTest, LinearToLinear)
+{
+    Copy(false, false, 0);
+}
+
+TEST_F(MediaCpuCopyTest, LinearToTileY)
+{
+    Copy(false, true, 0);
+}
+
+TEST_F(MediaCpuCopyTest, TileYToLinear)
+{
+    Copy(true, false, 0);
+}
+
+TEST_F(MediaCpuCopyTest, TileYToTileY)
+{
+    Copy(true, true, 0);
+}
+
+TEST_F(MediaCpuCopyTest, PartialHeightStopsAtTheRegion)
+{
+    // Not a multiple of the band height, the chroma rows round up
+    Copy(false, true, 75);
+    Copy(true, false, 75);
+}
+
+TEST_F(MediaCpuCopyTest, TiledOffsetIsRejected)
+{
+    Surface src, dst;
+    CreateSurface(true, src);
+    CreateSurface(false, dst);
+
+    // An offset inside the tiled plane has no linear row and column
+    src.details.dwOffset = 16 * src.details.dwPitch + 64;
+    MediaCpuCopy cpuCopy(&m_osInterface);
+    EXPECT_FALSE(cpuCopy.IsCopySupported(src.details, dst.details));
+    EXPECT_NE(MOS_STATUS_SUCCESS, cpuCopy.SurfaceCopy(src.details, dst.details));
+
+    // The same offset into the linear side is a region origin
+    src.details.dwOffset = 0;
+    dst.details.dwOffset = 16 * dst.details.dwPitch;
+    EXPECT_TRUE(cpuCopy.IsCopySupported(src.details, dst.details));
+}
+
+TEST_F(MediaCpuCopyTest, BandsCoverEveryRowOnce)
+{
+    // Around the band height, the chroma rows of odd heights round up
+    for (uint32_t height : {1u, 63u, 64u, 65u, 127u})
+    {
+        Copy(false, false, height);
+        Copy(true, true, height);
+    }
+}
+
+TEST_F(MediaCpuCopyTest, LinearRegionCopyTouchesOnlyTheRegion)
+{
+    const uint32_t width = 20, height = 70, srcX = 6, srcY = 12, dstX = 40, dstY = 30;
+
+    Surface src, dst;
+    CreateSurface(false, src);
+    CreateSurface(false, dst);
+    Fill(src);
+
+    // The region starts at dwOffset in the first plane, its chroma follows the subsampling
+    src.details.dwOffset = srcY * src.details.dwPitch + srcX;
+    dst.details.dwOffset = dstY * dst.details.dwPitch + dstX;
+    MediaCpuCopy cpuCopy(&m_osInterface);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, cpuCopy.SurfaceCopy(src.details, dst.details, width, height));
+    EXPECT_EQ(0u, CountRegionMismatches(dst, dstX, dstY, srcX, srcY, width, height));
+}
+
+TEST_F(MediaCpuCopyTest, LinearRegionToTileY)
+{
+    const uint32_t width = 64, height = 70, srcX = 16, srcY = 10;
+
+    Surface src, dst;
+    CreateSurface(false, src);
+    CreateSurface(true, dst);
+    Fill(src);
+
+    src.details.dwOffset = srcY * src.details.dwPitch + srcX;
+    MediaCpuCopy cpuCopy(&m_osInterface);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, cpuCopy.SurfaceCopy(src.details, dst.details, width, height));
+    EXPECT_EQ(0u, CountRegionMismatches(dst, 0, 0, srcX, srcY, width, height));
+}
+
+TEST_F(MediaCpuCopyTest, RegionBeyondThePitchIsRejected)
+{
+    Surface src, dst;
+    CreateSurface(false, src);
+    CreateSurface(false, dst);
+    Fill(src);
+
+    // The region starts 64 pixels before the end of the destination rows
+    uint32_t dstX        = dst.details.dwPitch - 64;
+    dst.details.dwOffset = dstX;
+    MediaCpuCopy cpuCopy(&m_osInterface);
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, cpuCopy.SurfaceCopy(src.details, dst.details, 65, 16));
+    EXPECT_EQ(0u, CountRegionMismatches(dst, 0, 0, 0, 0, 0, 0));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cpuCopy.SurfaceCopy(src.details, dst.details, 64, 16));
+    EXPECT_EQ(0u, CountRegionMismatches(dst, dstX, 0, 0, 0, 64, 16));
+}
+
+TEST_F(MediaCpuCopyTest, LinearChromaFollowsLumaWithoutPlaneOffsets)
+{
+    Surface src, dst;
+    CreateSurface(false, src);
+    CreateSurface(false, dst);
+    ASSERT_EQ(src.details.dwPitch * m_height, (uint32_t)src.details.UPlaneOffset.iSurfaceOffset);
+    Fill(src);
+
+    // Linear buffers carry no plane offsets
+    MOS_SURFACE srcDetails                = src.details;
+    MOS_SURFACE dstDetails                = dst.details;
+    srcDetails.UPlaneOffset.iSurfaceOffset = 0;
+    dstDetails.UPlaneOffset.iSurfaceOffset = 0;
+    MediaCpuCopy cpuCopy(&m_osInterface);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, cpuCopy.SurfaceCopy(srcDetails, dstDetails));
+    EXPECT_EQ(0u, CountMismatches(dst, m_height));
+}
+
+TEST_F(MediaCpuCopyTest, TiledPlanesMustStartAtARow)
+{
+    Surface tiled, linear;
+    CreateSurface(true, tiled);
+    CreateSurface(false, linear);
+
+    // The GMM CPU blit of a tiled plane starts at a row
+    tiled.details.UPlaneOffset.iSurfaceOffset += 128;
+    MediaCpuCopy cpuCopy(&m_osInterface);
+    EXPECT_FALSE(cpuCopy.IsCopySupported(tiled.details, linear.details));
+    EXPECT_FALSE(cpuCopy.IsCopySupported(linear.details, tiled.details));
+
+    // Linear planes may start anywhere
+    linear.details.UPlaneOffset.iSurfaceOffset += 128;
+    tiled.details.UPlaneOffset.iSurfaceOffset -= 128;
+    EXPECT_TRUE(cpuCopy.IsCopySupported(tiled.details, linear.details));
+}
@@ -0,0 +1,401 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <pthread.h>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_copy.h"
+#include "mos_utilities.h"
+
+using namespace std;
+
+// Copies are dispatched by MediaCopyBaseState to engine copies which only record
+// the engine and the mutexes held, without HW. The os interface is the one the
+// engines without an interface of their own share, it records decompressions.
+class MediaCopyDispatchTest : public testing::Test, protected MediaCopyBaseState
+{
+protected:
+    struct Copy
+    {
+        MCPY_ENGINE engine;
+        bool        engineMutexHeld;
+        bool        sharedMutexHeld;
+    };
+
+    void SetUp() override
+    {
+        m_test = this;
+
+        m_osInterface = (PMOS_INTERFACE)MOS_AllocAndZeroMemory(sizeof(MOS_INTERFACE));
+        ASSERT_NE(nullptr, m_osInterface);
+        m_osInterface->pfnDestroy                = Destroy;
+        m_osInterface->pfnGetResourceInfo        = GetResourceInfo;
+        m_osInterface->pfnDecompResource         = DecompResource;
+        m_osInterface->pfnGetWaTable             = GetWaTable;
+        m_osInterface->pfnGetUserSettingInstance = GetUserSettingInstance;
+
+        m_inUseGPUMutex = MosUtilities::MosCreateMutex();
+        ASSERT_NE(nullptr, m_inUseGPUMutex);
+        m_cpuCopyMutex = MosUtilities::MosCreateMutex();
+        ASSERT_NE(nullptr, m_cpuCopyMutex);
+        m_engineLoadMutex = MosUtilities::MosCreateMutex();
+        ASSERT_NE(nullptr, m_engineLoadMutex);
+
+        m_src.TileType = MOS_TILE_LINEAR;
+        m_dst.TileType = MOS_TILE_Y;
+    }
+
+    void TearDown() override
+    {
+        m_test = nullptr;
+    }
+
+    // Gives an engine an interface of its own, as with concurrent engines
+    void UseEngineInterface(MCPY_ENGINE engine)
+    {
+        EngineContext &context = m_engines[engine];
+        context.osInterface    = (PMOS_INTERFACE)MOS_AllocAndZeroMemory(sizeof(MOS_INTERFACE));
+        ASSERT_NE(nullptr, context.osInterface);
+        context.osInterface->pfnDestroy = Destroy;
+        context.mutex                   = MosUtilities::MosCreateMutex();
+        ASSERT_NE(nullptr, context.mutex);
+    }
+
+    void UseBltInterface()
+    {
+        UseEngineInterface(MCPY_ENGINE_BLT);
+    }
+
+    // Concurrent engines with interfaces of their own for VEBOX, BLT and render
+    void UseConcurrentEngines()
+    {
+        m_concurrentEngines = true;
+        for (MCPY_ENGINE engine : {MCPY_ENGINE_VEBOX, MCPY_ENGINE_BLT, MCPY_ENGINE_RENDER})
+        {
+            UseEngineInterface(engine);
+        }
+    }
+
+    // Engine a 1080p NV12 copy without method preference moves to from preferred
+    MCPY_ENGINE Select(MCPY_ENGINE preferred, MCPY_ENGINE_CAPS caps = {1, 1, 1, 0}, uint32_t width = 1920)
+    {
+        MOS_SURFACE src = {};
+        src.dwWidth     = width;
+        src.dwHeight    = 1080;
+        src.dwPitch     = width;
+        src.TileType    = MOS_TILE_LINEAR;
+        MOS_SURFACE dst = src;
+        dst.TileType    = MOS_TILE_Y;
+
+        MCPY_ENGINE engine = preferred;
+        SelectLeastLoadedEngine(engine, caps, src, dst);
+        return engine;
+    }
+
+    static bool IsHeld(PMOS_MUTEX mutex)
+    {
+        if (pthread_mutex_trylock(mutex) != 0)
+        {
+            return true;
+        }
+        pthread_mutex_unlock(mutex);
+        return false;
+    }
+
+    MOS_STATUS Dispatch(MCPY_ENGINE engine, MOS_RESOURCE_MMC_MODE dstMmc)
+    {
+        MCPY_STATE_PARAMS src = {&m_src, MOS_MMC_DISABLED, MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false};
+        MCPY_STATE_PARAMS dst = {&m_dst, dstMmc, MOS_TILE_Y, MCPY_CPMODE_CLEAR, false};
+        return TaskDispatch(src, dst, engine);
+    }
+
+    MOS_STATUS Check(MOS_FORMAT format, MCPY_METHOD method, MCPY_ENGINE_CAPS &caps)
+    {
+        MCPY_STATE_PARAMS src = {&m_src, MOS_MMC_DISABLED, MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false};
+        MCPY_STATE_PARAMS dst = {&m_dst, MOS_MMC_DISABLED, MOS_TILE_Y, MCPY_CPMODE_CLEAR, false};
+        caps                  = {1, 1, 1, 0};
+        return CapabilityCheck(format, src, dst, caps, method);
+    }
+
+    MOS_STATUS Record(MCPY_ENGINE engine)
+    {
+        Copy copy            = {};
+        copy.engine          = engine;
+        copy.engineMutexHeld = IsHeld(GetEngineMutex(engine));
+        copy.sharedMutexHeld = IsHeld(m_inUseGPUMutex);
+        m_copies.push_back(copy);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS MediaBltCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst) override
+    {
+        return Record(MCPY_ENGINE_BLT);
+    }
+
+    MOS_STATUS MediaRenderCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst) override
+    {
+        return Record(MCPY_ENGINE_RENDER);
+    }
+
+    MOS_STATUS MediaVeboxCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst) override
+    {
+        return Record(MCPY_ENGINE_VEBOX);
+    }
+
+    bool IsVeboxCopySupported(PMOS_RESOURCE src, PMOS_RESOURCE dst) override
+    {
+        return true;
+    }
+
+    bool RenderFormatSupportCheck(PMOS_RESOURCE src, PMOS_RESOURCE dst) override
+    {
+        return true;
+    }
+
+    static void Destroy(PMOS_INTERFACE osInterface, int32_t destroyVscVppDeviceTag)
+    {
+    }
+
+    static MOS_STATUS GetResourceInfo(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_SURFACE details)
+    {
+        details->TileType = resource->TileType;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static MOS_STATUS DecompResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        EXPECT_EQ(&m_test->m_dst, resource);
+        m_test->m_decompSharedMutexHeld.push_back(IsHeld(m_test->m_inUseGPUMutex));
+        m_test->m_decompEngineMutexHeld.push_back(IsHeld(m_test->GetEngineMutex(MCPY_ENGINE_BLT)));
+        return m_test->m_decompStatus;
+    }
+
+    static MEDIA_WA_TABLE *GetWaTable(PMOS_INTERFACE osInterface)
+    {
+        return &m_test->m_waTable;
+    }
+
+    static MediaUserSettingSharedPtr GetUserSettingInstance(PMOS_INTERFACE osInterface)
+    {
+        return nullptr;
+    }
+
+    static MediaCopyDispatchTest *m_test;
+
+    MOS_RESOURCE   m_src          = {};
+    MOS_RESOURCE   m_dst          = {};
+    MEDIA_WA_TABLE m_waTable;
+    MOS_STATUS     m_decompStatus = MOS_STATUS_SUCCESS;
+    vector<Copy>   m_copies;
+    vector<bool>   m_decompSharedMutexHeld;
+    vector<bool>   m_decompEngineMutexHeld;
+};
+
+MediaCopyDispatchTest *MediaCopyDispatchTest::m_test = nullptr;
+
+TEST_F(MediaCopyDispatchTest, EachEngineCopiesUnderItsMutex)
+{
+    for (MCPY_ENGINE engine : {MCPY_ENGINE_VEBOX, MCPY_ENGINE_BLT, MCPY_ENGINE_RENDER})
+    {
+        EXPECT_EQ(MOS_STATUS_SUCCESS, Dispatch(engine, MOS_MMC_DISABLED));
+    }
+
+    ASSERT_EQ(3u, m_copies.size());
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, m_copies[0].engine);
+    EXPECT_EQ(MCPY_ENGINE_BLT, m_copies[1].engine);
+    EXPECT_EQ(MCPY_ENGINE_RENDER, m_copies[2].engine);
+    for (auto &copy : m_copies)
+    {
+        // Without interfaces of their own, the engines share the mutex
+        EXPECT_TRUE(copy.engineMutexHeld);
+        EXPECT_TRUE(copy.sharedMutexHeld);
+    }
+    EXPECT_TRUE(m_decompSharedMutexHeld.empty());
+    EXPECT_FALSE(IsHeld(m_inUseGPUMutex));
+}
+
+TEST_F(MediaCopyDispatchTest, BltWithItsInterfaceDoesNotHoldTheSharedMutex)
+{
+    UseBltInterface();
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Dispatch(MCPY_ENGINE_BLT, MOS_MMC_DISABLED));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Dispatch(MCPY_ENGINE_VEBOX, MOS_MMC_DISABLED));
+
+    ASSERT_EQ(2u, m_copies.size());
+    EXPECT_TRUE(m_copies[0].engineMutexHeld);
+    EXPECT_FALSE(m_copies[0].sharedMutexHeld);
+    EXPECT_TRUE(m_copies[1].sharedMutexHeld);
+    EXPECT_FALSE(IsHeld(m_engines[MCPY_ENGINE_BLT].mutex));
+}
+
+TEST_F(MediaCopyDispatchTest, DecompressionGoesThroughTheSharedInterface)
+{
+    UseBltInterface();
+
+    // Only a render compressed tiled destination is decompressed
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Dispatch(MCPY_ENGINE_BLT, MOS_MMC_MC));
+    EXPECT_TRUE(m_decompSharedMutexHeld.empty());
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Dispatch(MCPY_ENGINE_BLT, MOS_MMC_RC));
+    ASSERT_EQ(1u, m_decompSharedMutexHeld.size());
+
+    // The shared os interface is serialized with the copies of the engines sharing it
+    EXPECT_TRUE(m_decompSharedMutexHeld[0]);
+    EXPECT_FALSE(m_decompEngineMutexHeld[0]);
+    ASSERT_EQ(2u, m_copies.size());
+    EXPECT_FALSE(IsHeld(m_inUseGPUMutex));
+
+    // Other engines do not decompress
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Dispatch(MCPY_ENGINE_VEBOX, MOS_MMC_RC));
+    EXPECT_EQ(1u, m_decompSharedMutexHeld.size());
+}
+
+TEST_F(MediaCopyDispatchTest, DecompressionWaitsForTheSharedInterface)
+{
+    UseBltInterface();
+
+    MosUtilities::MosLockMutex(m_inUseGPUMutex);
+    thread copy([this] { Dispatch(MCPY_ENGINE_BLT, MOS_MMC_RC); });
+    this_thread::sleep_for(chrono::milliseconds(20));
+    // Still waiting to decompress, the BLT copy is not started
+    EXPECT_TRUE(m_decompSharedMutexHeld.empty());
+    EXPECT_TRUE(m_copies.empty());
+    MosUtilities::MosUnlockMutex(m_inUseGPUMutex);
+    copy.join();
+
+    EXPECT_EQ(1u, m_decompSharedMutexHeld.size());
+    EXPECT_EQ(1u, m_copies.size());
+}
+
+TEST_F(MediaCopyDispatchTest, FailedDecompressionSkipsTheCopy)
+{
+    UseBltInterface();
+    m_decompStatus = MOS_STATUS_UNKNOWN;
+
+    EXPECT_EQ(MOS_STATUS_UNKNOWN, Dispatch(MCPY_ENGINE_BLT, MOS_MMC_RC));
+    EXPECT_EQ(1u, m_decompSharedMutexHeld.size());
+    EXPECT_TRUE(m_copies.empty());
+    EXPECT_FALSE(IsHeld(m_inUseGPUMutex));
+    EXPECT_FALSE(IsHeld(m_engines[MCPY_ENGINE_BLT].mutex));
+}
+
+TEST_F(MediaCopyDispatchTest, RenderFallbackIsPerCopy)
+{
+    MEDIA_WR_WA(&m_waTable, Wa_16024792527_OptionB, 1);
+
+    MCPY_ENGINE_CAPS caps   = {};
+    MCPY_ENGINE      engine = MCPY_ENGINE_BLT;
+    MCPY_METHOD      method = MCPY_METHOD_DEFAULT;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Check(Format_Y210, method, caps));
+    EXPECT_FALSE(caps.engineRender);
+    EXPECT_TRUE(caps.renderFallbackToBlt);
+
+    // A following copy of another format keeps render, and is not reported as a fallback
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Check(Format_NV12, method, caps));
+    EXPECT_TRUE(caps.engineRender);
+    EXPECT_FALSE(caps.renderFallbackToBlt);
+    method = MCPY_METHOD_PERFORMANCE;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Check(Format_NV12, method, caps));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CopyEnigneSelect(method, engine, caps));
+    EXPECT_EQ(MCPY_ENGINE_RENDER, engine);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Dispatch(engine, MOS_MMC_DISABLED));
+    ASSERT_EQ(1u, m_copies.size());
+    EXPECT_EQ(MCPY_ENGINE_RENDER, m_copies[0].engine);
+}
+
+TEST_F(MediaCopyDispatchTest, IdleEnginesKeepTheMethodEngine)
+{
+    UseConcurrentEngines();
+    EXPECT_EQ(MCPY_ENGINE_BLT, Select(MCPY_ENGINE_BLT));
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, Select(MCPY_ENGINE_VEBOX));
+}
+
+TEST_F(MediaCopyDispatchTest, CopyMovesOnlyToClearlyLessLoadedEngine)
+{
+    const uint32_t mb = 1 << 20;
+    UseConcurrentEngines();
+    AddEngineLoad(MCPY_ENGINE_BLT, 10 * mb);
+    AddEngineLoad(MCPY_ENGINE_VEBOX, 6 * mb);
+    AddEngineLoad(MCPY_ENGINE_RENDER, 6 * mb);
+
+    // Similar loads do not trade copies
+    EXPECT_EQ(MCPY_ENGINE_BLT, Select(MCPY_ENGINE_BLT));
+
+    AddEngineLoad(MCPY_ENGINE_RENDER, 0);
+    AddEngineLoad(MCPY_ENGINE_BLT, 10 * mb);
+    // VEBOX and render carry less than half of BLT, the first one found wins
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, Select(MCPY_ENGINE_BLT));
+
+    EXPECT_EQ(2u, m_engines[MCPY_ENGINE_BLT].copyNum);
+    EXPECT_EQ(1u, m_engines[MCPY_ENGINE_VEBOX].copyNum);
+    EXPECT_EQ(2u, m_engines[MCPY_ENGINE_RENDER].copyNum);
+}
+
+TEST_F(MediaCopyDispatchTest, CopyMovesOnlyToCapableEnginesWithTheirInterface)
+{
+    m_concurrentEngines = true;
+    UseEngineInterface(MCPY_ENGINE_BLT);
+    UseEngineInterface(MCPY_ENGINE_RENDER);
+    AddEngineLoad(MCPY_ENGINE_BLT, 20 << 20);
+
+    // VEBOX shares the os interface, its copies would wait behind the others
+    EXPECT_EQ(MCPY_ENGINE_RENDER, Select(MCPY_ENGINE_BLT));
+    EXPECT_EQ(MCPY_ENGINE_BLT, Select(MCPY_ENGINE_BLT, {1, 1, 0, 0}));
+
+    UseEngineInterface(MCPY_ENGINE_VEBOX);
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, Select(MCPY_ENGINE_BLT));
+    // Too narrow for VEBOX
+    EXPECT_EQ(MCPY_ENGINE_RENDER, Select(MCPY_ENGINE_BLT, {1, 1, 1, 0}, 32));
+}
+
+TEST_F(MediaCopyDispatchTest, LightlyLoadedEngineKeepsItsCopies)
+{
+    UseConcurrentEngines();
+    AddEngineLoad(MCPY_ENGINE_BLT, 512 << 10);
+    EXPECT_EQ(MCPY_ENGINE_BLT, Select(MCPY_ENGINE_BLT));
+
+    AddEngineLoad(MCPY_ENGINE_BLT, 1 << 20);
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, Select(MCPY_ENGINE_BLT));
+}
+
+TEST_F(MediaCopyDispatchTest, EngineLoadDecays)
+{
+    UseConcurrentEngines();
+    AddEngineLoad(MCPY_ENGINE_BLT, 4 << 20);
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, Select(MCPY_ENGINE_BLT));
+
+    // A busy engine keeps its copies again once it drained
+    this_thread::sleep_for(chrono::milliseconds((int)(5 * m_engineLoadDecayMs)));
+    EXPECT_EQ(MCPY_ENGINE_BLT, Select(MCPY_ENGINE_BLT));
+    EXPECT_LT(m_engines[MCPY_ENGINE_BLT].load, (double)(4 << 20) / 100);
+    EXPECT_EQ(1u, m_engines[MCPY_ENGINE_BLT].copyNum);
+}
+
+TEST_F(MediaCopyDispatchTest, SharedInterfaceKeepsTheMethodEngine)
+{
+    UseEngineInterface(MCPY_ENGINE_VEBOX);
+    UseEngineInterface(MCPY_ENGINE_BLT);
+    AddEngineLoad(MCPY_ENGINE_BLT, 20 << 20);
+
+    // Without concurrent engines no load is accounted and copies never move
+    EXPECT_EQ(0u, m_engines[MCPY_ENGINE_BLT].copyNum);
+    m_engines[MCPY_ENGINE_BLT].load = 20 << 20;
+    EXPECT_EQ(MCPY_ENGINE_BLT, Select(MCPY_ENGINE_BLT));
+}
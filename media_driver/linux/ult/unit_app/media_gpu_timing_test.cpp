@@ -0,0 +1,260 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_gpu_timing.h"
+#include "mos_os.h"
+
+using namespace std;
+
+// The timestamp buffer is host memory handed out by a fake MOS_INTERFACE, the test
+// writes the timestamps the GPU would store at the returned offsets.
+class MediaGpuTimingTest : public testing::Test
+{
+protected:
+    static constexpr uint32_t m_frameNum    = 4;
+    static constexpr uint32_t m_tsFrequency = 1000000;  // 1 tick per us
+
+    // "Media GPU Frame Timing" is read from the device settings, which the test has not
+    class EnabledGpuTiming : public MediaGpuTiming
+    {
+    public:
+        EnabledGpuTiming(PMOS_INTERFACE osInterface) : MediaGpuTiming(osInterface, MediaGpuTimingTest::m_frameNum)
+        {
+            m_enabled = true;
+        }
+        bool IsFramePending() const { return m_framePending; }
+        uint32_t GetReportedFrame() const { return m_reportedFrame; }
+    };
+
+    void SetUp() override
+    {
+        m_osInterface.pfnAllocateResource  = Allocate;
+        m_osInterface.pfnFreeResource      = Free;
+        m_osInterface.pfnLockResource      = Lock;
+        m_osInterface.pfnUnlockResource    = Unlock;
+        m_osInterface.pfnSkipResourceSync  = SkipSync;
+        m_osInterface.pfnGetTsFrequency    = GetTsFrequency;
+        m_osInterface.pfnGetGpuStatusTag     = GetStatusTag;
+        m_osInterface.pfnGetGpuStatusSyncTag = GetStatusSyncTag;
+        m_memory.clear();
+        m_statusTag     = 1;
+        m_statusSyncTag = 0;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static MOS_STATUS Allocate(PMOS_INTERFACE osInterface, PMOS_ALLOC_GFXRES_PARAMS params, const char *functionName, const char *filename, int32_t line, PMOS_RESOURCE resource)
+#else
+    static MOS_STATUS Allocate(PMOS_INTERFACE osInterface, PMOS_ALLOC_GFXRES_PARAMS params, PMOS_RESOURCE resource)
+#endif
+    {
+        EXPECT_EQ(MOS_MEMPOOL_SYSTEMMEMORY, params->dwMemType);
+        m_memory.assign(params->dwBytes, 0xcd);
+        resource->pData = m_memory.data();
+        return MOS_STATUS_SUCCESS;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static void Free(PMOS_INTERFACE osInterface, const char *functionName, const char *filename, int32_t line, PMOS_RESOURCE resource)
+#else
+    static void Free(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+#endif
+    {
+        resource->pData = nullptr;
+    }
+
+    static void *Lock(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS flags)
+    {
+        EXPECT_TRUE(flags->WriteOnly);
+        return resource->pData;
+    }
+
+    static MOS_STATUS Unlock(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static MOS_STATUS SkipSync(PMOS_RESOURCE resource)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static uint32_t GetTsFrequency(PMOS_INTERFACE osInterface)
+    {
+        return m_tsFrequency;
+    }
+
+    static uint32_t GetStatusTag(PMOS_INTERFACE osInterface, MOS_GPU_CONTEXT gpuContext)
+    {
+        return m_statusTag;
+    }
+
+    static uint32_t GetStatusSyncTag(PMOS_INTERFACE osInterface, MOS_GPU_CONTEXT gpuContext)
+    {
+        return m_statusSyncTag;
+    }
+
+    // Stores a timestamp the way the post sync write of the engine does
+    void Store(MediaGpuTiming &timing, uint32_t frame, MediaGpuTiming::Engine engine, bool start, uint64_t ts)
+    {
+        PMOS_RESOURCE resource = nullptr;
+        uint32_t      offset   = 0;
+        ASSERT_EQ(MOS_STATUS_SUCCESS, timing.GetAddress(frame, engine, MOS_GPU_CONTEXT_VIDEO, start, resource, offset));
+        if (resource)
+        {
+            ASSERT_LE(offset + sizeof(uint64_t), m_memory.size());
+            *(uint64_t *)&m_memory[offset] = ts;
+        }
+    }
+
+    MOS_INTERFACE          m_osInterface = {};
+    static vector<uint8_t> m_memory;
+    static uint32_t        m_statusTag;
+    static uint32_t        m_statusSyncTag;
+};
+
+constexpr uint32_t MediaGpuTimingTest::m_frameNum;
+constexpr uint32_t MediaGpuTimingTest::m_tsFrequency;
+vector<uint8_t>    MediaGpuTimingTest::m_memory;
+uint32_t           MediaGpuTimingTest::m_statusTag     = 1;
+uint32_t           MediaGpuTimingTest::m_statusSyncTag = 0;
+
+TEST_F(MediaGpuTimingTest, DisabledStoresNothing)
+{
+    MediaGpuTiming timing(&m_osInterface, m_frameNum);
+    EXPECT_FALSE(timing.IsEnabled());
+
+    PMOS_RESOURCE resource = nullptr;
+    uint32_t      offset   = 0;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, timing.GetAddress(0, MediaGpuTiming::engineVdbox, MOS_GPU_CONTEXT_VIDEO, true, resource, offset));
+    EXPECT_EQ(nullptr, resource);
+    EXPECT_TRUE(m_memory.empty());
+}
+
+TEST_F(MediaGpuTimingTest, EngineOfGpuContext)
+{
+    EXPECT_EQ(MediaGpuTiming::engineRender, MediaGpuTiming::GetEngine(MOS_GPU_CONTEXT_RENDER));
+    EXPECT_EQ(MediaGpuTiming::engineRender, MediaGpuTiming::GetEngine(MOS_GPU_CONTEXT_COMPUTE));
+    EXPECT_EQ(MediaGpuTiming::engineVdbox, MediaGpuTiming::GetEngine(MOS_GPU_CONTEXT_VIDEO));
+    EXPECT_EQ(MediaGpuTiming::engineVebox, MediaGpuTiming::GetEngine(MOS_GPU_CONTEXT_VEBOX));
+    EXPECT_EQ(MediaGpuTiming::engineBlt, MediaGpuTiming::GetEngine(MOS_GPU_CONTEXT_BLT));
+}
+
+TEST_F(MediaGpuTimingTest, FirstStartAndLastEndPerEngine)
+{
+    EnabledGpuTiming timing(&m_osInterface);
+
+    // Two packets of the frame on VDBox, one on VEBOX driving SFC
+    Store(timing, 1, MediaGpuTiming::engineVdbox, true, 1000);
+    Store(timing, 1, MediaGpuTiming::engineVdbox, false, 3000);
+    Store(timing, 1, MediaGpuTiming::engineVdbox, true, 5000);
+    Store(timing, 1, MediaGpuTiming::engineVdbox, false, 8000);
+    Store(timing, 1, MediaGpuTiming::engineVebox, true, 9000);
+    Store(timing, 1, MediaGpuTiming::engineSfc, true, 9000);
+    Store(timing, 1, MediaGpuTiming::engineVebox, false, 9500);
+    Store(timing, 1, MediaGpuTiming::engineSfc, false, 9500);
+
+    uint64_t timeNs[MediaGpuTiming::engineNum] = {};
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.GetEngineTimes(1, timeNs));
+    EXPECT_EQ(7000000u, timeNs[MediaGpuTiming::engineVdbox]);
+    EXPECT_EQ(500000u, timeNs[MediaGpuTiming::engineVebox]);
+    EXPECT_EQ(500000u, timeNs[MediaGpuTiming::engineSfc]);
+    EXPECT_EQ(0u, timeNs[MediaGpuTiming::engineRender]);
+    EXPECT_EQ(0u, timeNs[MediaGpuTiming::engineBlt]);
+
+    // Another frame has no times
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.GetEngineTimes(2, timeNs));
+    EXPECT_EQ(0u, timeNs[MediaGpuTiming::engineVdbox]);
+}
+
+TEST_F(MediaGpuTimingTest, ReusedSlotIsCleared)
+{
+    EnabledGpuTiming timing(&m_osInterface);
+
+    Store(timing, 0, MediaGpuTiming::engineRender, true, 100);
+    Store(timing, 0, MediaGpuTiming::engineRender, false, 200);
+    Store(timing, 0, MediaGpuTiming::engineVdbox, true, 100);
+    Store(timing, 0, MediaGpuTiming::engineVdbox, false, 400);
+
+    // Same slot, the start of the new frame is stored and the old engines are gone
+    Store(timing, m_frameNum, MediaGpuTiming::engineRender, true, 1000);
+    Store(timing, m_frameNum, MediaGpuTiming::engineRender, false, 1300);
+
+    uint64_t timeNs[MediaGpuTiming::engineNum] = {};
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.GetEngineTimes(m_frameNum, timeNs));
+    EXPECT_EQ(300000u, timeNs[MediaGpuTiming::engineRender]);
+    EXPECT_EQ(0u, timeNs[MediaGpuTiming::engineVdbox]);
+
+    // The old frame is not reported with the new frame's times
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.GetEngineTimes(0, timeNs));
+    EXPECT_EQ(0u, timeNs[MediaGpuTiming::engineRender]);
+}
+
+TEST_F(MediaGpuTimingTest, FramesAreReportedWhenTheGpuCompletedThem)
+{
+    EnabledGpuTiming timing(&m_osInterface);
+
+    // Submitting frame 1 increments the tag of the context to 2
+    Store(timing, 1, MediaGpuTiming::engineVebox, true, 100);
+    Store(timing, 1, MediaGpuTiming::engineVebox, false, 200);
+    m_statusTag = 2;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.EndFrame(1));
+
+    Store(timing, 2, MediaGpuTiming::engineVebox, true, 300);
+    Store(timing, 2, MediaGpuTiming::engineVebox, false, 400);
+    m_statusTag = 3;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.EndFrame(2));
+
+    m_statusSyncTag = 0;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.ReportCompletedFrames(COMPONENT_VPCommon));
+    EXPECT_TRUE(timing.IsFramePending());
+    EXPECT_EQ(1u, timing.GetReportedFrame());
+
+    // Frame 1 completed, frame 2 did not
+    m_statusSyncTag = 1;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.ReportCompletedFrames(COMPONENT_VPCommon));
+    EXPECT_TRUE(timing.IsFramePending());
+    EXPECT_EQ(2u, timing.GetReportedFrame());
+
+    m_statusSyncTag = 2;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.ReportCompletedFrames(COMPONENT_VPCommon));
+    EXPECT_FALSE(timing.IsFramePending());
+    EXPECT_EQ(3u, timing.GetReportedFrame());
+}
+
+TEST_F(MediaGpuTimingTest, OverwrittenFramesAreSkipped)
+{
+    EnabledGpuTiming timing(&m_osInterface);
+
+    for (uint32_t frame = 0; frame < 3 * m_frameNum; frame++)
+    {
+        Store(timing, frame, MediaGpuTiming::engineVdbox, true, 100);
+        Store(timing, frame, MediaGpuTiming::engineVdbox, false, 200);
+        m_statusTag = frame + 2;
+        ASSERT_EQ(MOS_STATUS_SUCCESS, timing.EndFrame(frame));
+    }
+
+    m_statusSyncTag = 3 * m_frameNum + 1;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, timing.ReportCompletedFrames(COMPONENT_Decode));
+    EXPECT_FALSE(timing.IsFramePending());
+    EXPECT_EQ(3 * m_frameNum, timing.GetReportedFrame());
+}
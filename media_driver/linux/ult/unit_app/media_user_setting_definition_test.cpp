@@ -0,0 +1,277 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_user_setting_configure.h"
+#include "media_user_setting_definition.h"
+
+using namespace std;
+using namespace MediaUserSetting;
+using namespace MediaUserSetting::Internal;
+
+static Definition CreateDefinition(const string &name)
+{
+    return Definition(name, Value((uint32_t)0), false, false, false, "", UFKEY_NEXT(), true);
+}
+
+TEST(MediaUserSettingDefinitionTest, CacheSetAndReset)
+{
+    Definition def    = CreateDefinition("Cache Test Key");
+    Value      value;
+    MOS_STATUS status = MOS_STATUS_UNKNOWN;
+
+    EXPECT_FALSE(def.GetCachedValue(value, status));
+
+    EXPECT_TRUE(def.SetCachedValue(Value((uint32_t)7), MOS_STATUS_SUCCESS, def.CacheGeneration()));
+    ASSERT_TRUE(def.GetCachedValue(value, status));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+    EXPECT_EQ(7u, value.Get<uint32_t>());
+
+    // A failed resolve is cached too, the caller applies the default
+    EXPECT_TRUE(def.SetCachedValue(Value(), MOS_STATUS_USER_FEATURE_KEY_READ_FAILED, def.CacheGeneration()));
+    ASSERT_TRUE(def.GetCachedValue(value, status));
+    EXPECT_EQ(MOS_STATUS_USER_FEATURE_KEY_READ_FAILED, status);
+
+    def.ResetCachedValue();
+    EXPECT_FALSE(def.GetCachedValue(value, status));
+}
+
+TEST(MediaUserSettingDefinitionTest, ValueResolvedBeforeResetIsNotKept)
+{
+    Definition def    = CreateDefinition("Cache Generation Key");
+    Value      value;
+    MOS_STATUS status = MOS_STATUS_UNKNOWN;
+
+    // The reset comes while the reader resolves the value
+    uint32_t generation = def.CacheGeneration();
+    def.ResetCachedValue();
+    EXPECT_FALSE(def.SetCachedValue(Value((uint32_t)1), MOS_STATUS_SUCCESS, generation));
+    EXPECT_FALSE(def.GetCachedValue(value, status));
+
+    // The reset comes after the reader checked the generation
+    generation = def.CacheGeneration();
+    EXPECT_TRUE(def.SetCachedValue(Value((uint32_t)2), MOS_STATUS_SUCCESS, generation));
+    def.ResetCachedValue();
+    EXPECT_FALSE(def.GetCachedValue(value, status));
+}
+
+TEST(MediaUserSettingDefinitionTest, ConcurrentReadsSeeWholeSnapshots)
+{
+    Definition     def = CreateDefinition("Cache Race Key");
+    atomic<bool>   stop(false);
+    atomic<uint32_t> torn(0);
+    vector<thread> readers;
+
+    // Every published value is paired with its own status, a reader mixing two
+    // snapshots would see a value with the wrong status
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        readers.emplace_back([&]() {
+            Value      value;
+            MOS_STATUS status = MOS_STATUS_UNKNOWN;
+            while (!stop)
+            {
+                if (def.GetCachedValue(value, status))
+                {
+                    const string &str = value.ConstString();
+                    bool          odd = !str.empty() && ((str.back() - '0') & 1);
+                    if ((status == MOS_STATUS_SUCCESS) == odd)
+                    {
+                        torn++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        // Long strings do not fit the small string buffer, a torn copy would read freed memory
+        string str = string(64, 'x') + to_string(i);
+        def.SetCachedValue(Value(str), (i & 1) ? MOS_STATUS_UNKNOWN : MOS_STATUS_SUCCESS, def.CacheGeneration());
+        if ((i & 7) == 0)
+        {
+            def.ResetCachedValue();
+        }
+    }
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(0u, torn.load());
+}
+
+// Configure as release builds use it, reading the in memory registry without a file
+class MediaUserSettingConfigureTest : public testing::Test
+{
+protected:
+    class ReleaseConfigure : public Configure
+    {
+    public:
+        ReleaseConfigure()
+        {
+            m_isDebugMode = false;
+        }
+
+        ~ReleaseConfigure()
+        {
+            // Do not write the report file when the configure is destroyed
+            m_regBufferMap.erase(USER_SETTING_REPORT_PATH);
+        }
+
+        // Changes the registry behind the configure, as an application writing the file would
+        void SetConfigValue(const string &name, const Value &value)
+        {
+            UFKEY_NEXT key = {};
+            m_mutexLock.Lock();
+            ASSERT_EQ(MOS_STATUS_SUCCESS, MosUtilities::MosCreateRegKey(m_rootKey, m_configPath, KEY_WRITE, &key, m_regBufferMap));
+            EXPECT_EQ(MOS_STATUS_SUCCESS, MosUtilities::MosSetRegValue(key, name, value, m_regBufferMap));
+            MosUtilities::MosCloseRegKey(key);
+            m_mutexLock.Unlock();
+        }
+    };
+
+    MOS_STATUS Register(const string &name)
+    {
+        return m_configure.Register(name, Group::Device, Value((uint32_t)3), false, false, false, "", true);
+    }
+
+    uint32_t Read(const string &name, MOS_STATUS &status)
+    {
+        Value value;
+        status = m_configure.Read(value, name, Group::Device, Value(), false);
+        return value.Get<uint32_t>();
+    }
+
+    ReleaseConfigure m_configure;
+};
+
+TEST_F(MediaUserSettingConfigureTest, ReadIsCachedUntilTheItemIsWritten)
+{
+    const string name   = "Configure Cache Test Key";
+    MOS_STATUS   status = MOS_STATUS_SUCCESS;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Register(name));
+
+    EXPECT_EQ(3u, Read(name, status));
+    EXPECT_NE(MOS_STATUS_SUCCESS, status);
+
+    // Not seen, the first resolve is cached
+    m_configure.SetConfigValue(name, Value((uint32_t)9));
+    EXPECT_EQ(3u, Read(name, status));
+    EXPECT_NE(MOS_STATUS_SUCCESS, status);
+
+    // Writing goes to the report path, not the path read from, and still drops the cache
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_configure.Write(name, Value((uint32_t)5), Group::Device, false));
+    EXPECT_EQ(9u, Read(name, status));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+
+    EXPECT_EQ(MOS_STATUS_INVALID_HANDLE, m_configure.Write("Configure Unknown Key", Value((uint32_t)5), Group::Device, false));
+    Value value;
+    EXPECT_EQ(MOS_STATUS_INVALID_HANDLE, m_configure.Read(value, "Configure Unknown Key", Group::Device, Value(), false));
+}
+
+TEST_F(MediaUserSettingConfigureTest, ReadAfterConcurrentWriteSeesTheNewValue)
+{
+    const string   name = "Configure Race Key";
+    const uint32_t last = 20000;
+    uint32_t       stale = 0;
+    atomic<bool>   stop(false);
+    vector<thread> readers;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Register(name));
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        readers.emplace_back([&]() {
+            MOS_STATUS status = MOS_STATUS_SUCCESS;
+            while (!stop)
+            {
+                Read(name, status);
+            }
+        });
+    }
+
+    // A reader resolving the previous value while a write resets the cache must
+    // not keep it
+    MOS_STATUS status = MOS_STATUS_UNKNOWN;
+    for (uint32_t i = 1; i <= last; i++)
+    {
+        m_configure.SetConfigValue(name, Value(i));
+        EXPECT_EQ(MOS_STATUS_SUCCESS, m_configure.Write(name, Value(i), Group::Device, false));
+        stale += Read(name, status) != i;
+    }
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(0u, stale);
+}
+
+TEST_F(MediaUserSettingConfigureTest, RegisterCostOfAContext)
+{
+    // Each codec context declares its keys again on the device configure, only the
+    // first context adds them
+    const uint32_t keyNum = 450;
+    vector<string> names;
+    for (uint32_t i = 0; i < keyNum; i++)
+    {
+        names.push_back("Configure Context Key " + to_string(i));
+    }
+
+    auto start = chrono::steady_clock::now();
+    for (auto &name : names)
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, Register(name));
+    }
+    auto firstUs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (auto &name : names)
+    {
+        ASSERT_EQ(MOS_STATUS_FILE_EXISTS, Register(name));
+    }
+    auto againUs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+    start             = chrono::steady_clock::now();
+    for (auto &name : names)
+    {
+        EXPECT_EQ(3u, Read(name, status));
+    }
+    auto firstReadUs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (auto &name : names)
+    {
+        EXPECT_EQ(3u, Read(name, status));
+    }
+    auto cachedReadUs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    RecordProperty("FirstRegisterUs", (int)firstUs);
+    RecordProperty("RegisterAgainUs", (int)againUs);
+    RecordProperty("FirstReadUs", (int)firstReadUs);
+    RecordProperty("CachedReadUs", (int)cachedReadUs);
+}
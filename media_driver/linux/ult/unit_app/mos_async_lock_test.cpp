@@ -0,0 +1,283 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <map>
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_async_lock.h"
+
+using namespace std;
+
+// The buffer objects are host memory, a resource is told apart by its bo pointer
+// like the driver does through the bo handle. The test marks a buffer busy the way
+// a submitted command buffer would, and clears it once the "GPU" retired it.
+class MosAsyncLockTest : public testing::Test, protected MosAsyncLockQueue
+{
+protected:
+    MosAsyncLockTest() : MosAsyncLockQueue(nullptr)
+    {
+    }
+
+    ~MosAsyncLockTest()
+    {
+        // The base destructor would serve leftovers through MosInterface
+        Process(nullptr, true);
+    }
+
+    uint64_t GetKey(MOS_RESOURCE_HANDLE resource) override
+    {
+        return (uint64_t)(uintptr_t)resource->bo;
+    }
+
+    bool IsBusy(MOS_RESOURCE_HANDLE resource) override
+    {
+        return m_busy.count(GetKey(resource)) != 0;
+    }
+
+    void *Lock(MOS_RESOURCE_HANDLE resource, MOS_LOCK_PARAMS *flags) override
+    {
+        uint64_t key = GetKey(resource);
+        if (m_busy.count(key))
+        {
+            // A plain lock waits until the GPU is done
+            m_stalls++;
+            m_busy.erase(key);
+        }
+        if (m_failing.count(key))
+        {
+            return nullptr;
+        }
+        m_locked++;
+        return m_memory[key].data();
+    }
+
+    MOS_STATUS Unlock(MOS_RESOURCE_HANDLE resource) override
+    {
+        m_unlocked++;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_RESOURCE Resource(uint32_t index)
+    {
+        MOS_RESOURCE resource = {};
+        resource.bo           = (MOS_LINUX_BO *)(uintptr_t)(0x1000 * (index + 1));
+        m_memory[GetKey(&resource)].assign(16, 0);
+        return resource;
+    }
+
+    uint8_t *Memory(MOS_RESOURCE &resource)
+    {
+        return m_memory[GetKey(&resource)].data();
+    }
+
+    // Queues a write of value to byte offset of resource, records the serve order
+    MOS_STATUS Write(MOS_RESOURCE &resource, uint32_t offset, uint8_t value)
+    {
+        MOS_LOCK_PARAMS flags = {};
+        flags.WriteOnly       = 1;
+        return Add(&resource, flags, [this, offset, value](void *data) {
+            m_served.push_back(value);
+            if (data)
+            {
+                ((uint8_t *)data)[offset] = value;
+            }
+        });
+    }
+
+    map<uint64_t, vector<uint8_t>> m_memory;
+    set<uint64_t>                  m_busy;
+    set<uint64_t>                  m_failing;
+    vector<uint8_t>                m_served;
+    uint32_t                       m_stalls   = 0;
+    uint32_t                       m_locked   = 0;
+    uint32_t                       m_unlocked = 0;
+};
+
+TEST_F(MosAsyncLockTest, IdleResourceIsServedRightAway)
+{
+    MOS_RESOURCE resource = Resource(0);
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(resource, 3, 7));
+    EXPECT_EQ(0u, GetPendingNum());
+    EXPECT_EQ(7, Memory(resource)[3]);
+    EXPECT_EQ(1u, m_locked);
+    EXPECT_EQ(1u, m_unlocked);
+    EXPECT_EQ(0u, m_stalls);
+}
+
+TEST_F(MosAsyncLockTest, BusyResourceIsServedOnceIdle)
+{
+    MOS_RESOURCE resource = Resource(0);
+    m_busy.insert(GetKey(&resource));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(resource, 0, 1));
+    EXPECT_EQ(1u, GetPendingNum());
+    EXPECT_EQ(0, Memory(resource)[0]);
+
+    // Polling leaves it queued while the GPU still uses it
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Process(nullptr, false));
+    EXPECT_EQ(1u, GetPendingNum());
+
+    m_busy.clear();
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Process(nullptr, false));
+    EXPECT_EQ(0u, GetPendingNum());
+    EXPECT_EQ(1, Memory(resource)[0]);
+    EXPECT_EQ(0u, m_stalls);
+}
+
+TEST_F(MosAsyncLockTest, QueuedLocksAreServedWhenTheNextOneIsAdded)
+{
+    MOS_RESOURCE busy = Resource(0);
+    MOS_RESOURCE idle = Resource(1);
+    m_busy.insert(GetKey(&busy));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(busy, 0, 1));
+    m_busy.clear();
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(idle, 0, 2));
+
+    EXPECT_EQ(0u, GetPendingNum());
+    EXPECT_EQ(1, Memory(busy)[0]);
+    EXPECT_EQ(2, Memory(idle)[0]);
+}
+
+TEST_F(MosAsyncLockTest, LocksOfAResourceKeepTheirOrder)
+{
+    MOS_RESOURCE resource = Resource(0);
+    m_busy.insert(GetKey(&resource));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(resource, 0, 1));
+    m_busy.clear();
+
+    // Idle now, but an earlier lock of it is still queued
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(resource, 0, 2));
+    EXPECT_EQ(0u, GetPendingNum());
+    ASSERT_EQ(2u, m_served.size());
+    EXPECT_EQ(1, m_served[0]);
+    EXPECT_EQ(2, m_served[1]);
+    EXPECT_EQ(2, Memory(resource)[0]);
+}
+
+TEST_F(MosAsyncLockTest, BusyResourceDoesNotHoldBackOthers)
+{
+    MOS_RESOURCE busy = Resource(0);
+    MOS_RESOURCE idle = Resource(1);
+    m_busy.insert(GetKey(&busy));
+    m_busy.insert(GetKey(&idle));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(busy, 0, 1));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(idle, 0, 2));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(busy, 1, 3));
+    EXPECT_EQ(3u, GetPendingNum());
+
+    m_busy.erase(GetKey(&idle));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Process(nullptr, false));
+    EXPECT_EQ(2u, GetPendingNum());
+    ASSERT_EQ(1u, m_served.size());
+    EXPECT_EQ(2, m_served[0]);
+}
+
+TEST_F(MosAsyncLockTest, WaitServesBusyResources)
+{
+    MOS_RESOURCE first  = Resource(0);
+    MOS_RESOURCE second = Resource(1);
+    m_busy.insert(GetKey(&first));
+    m_busy.insert(GetKey(&second));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(first, 0, 1));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(second, 0, 2));
+
+    // A plain lock or free of one resource only waits for its own locks
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Process(&second, true));
+    EXPECT_EQ(1u, GetPendingNum());
+    EXPECT_EQ(2, Memory(second)[0]);
+    EXPECT_EQ(0, Memory(first)[0]);
+    EXPECT_EQ(1u, m_stalls);
+
+    // Submission waits for all of them
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Process(nullptr, true));
+    EXPECT_EQ(0u, GetPendingNum());
+    EXPECT_EQ(1, Memory(first)[0]);
+    EXPECT_EQ(2u, m_stalls);
+}
+
+TEST_F(MosAsyncLockTest, CopiesOfAResourceShareTheQueue)
+{
+    MOS_RESOURCE resource = Resource(0);
+    m_busy.insert(GetKey(&resource));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(resource, 0, 1));
+
+    // The queue keeps its own copy, the caller's one may go away
+    MOS_RESOURCE copy = resource;
+    resource          = {};
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Process(&copy, true));
+    EXPECT_EQ(0u, GetPendingNum());
+    EXPECT_EQ(1, Memory(copy)[0]);
+}
+
+TEST_F(MosAsyncLockTest, FailedLockReportsNullAndKeepsServing)
+{
+    MOS_RESOURCE failing = Resource(0);
+    MOS_RESOURCE good    = Resource(1);
+    m_failing.insert(GetKey(&failing));
+
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, Write(failing, 0, 1));
+    ASSERT_EQ(1u, m_served.size());
+
+    m_busy.insert(GetKey(&failing));
+    m_busy.insert(GetKey(&good));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(failing, 0, 2));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Write(good, 0, 3));
+
+    // The failure is reported by the call serving it, the other lock still completes
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, Process(nullptr, true));
+    EXPECT_EQ(0u, GetPendingNum());
+    EXPECT_EQ(3u, m_served.size());
+    EXPECT_EQ(3, Memory(good)[0]);
+    // Only successful locks are unlocked
+    EXPECT_EQ(1u, m_unlocked);
+}
+
+TEST_F(MosAsyncLockTest, CallbackMayQueueAnotherLock)
+{
+    MOS_RESOURCE first  = Resource(0);
+    MOS_RESOURCE second = Resource(1);
+    m_busy.insert(GetKey(&first));
+
+    MOS_LOCK_PARAMS flags = {};
+    flags.WriteOnly       = 1;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Add(&first, flags, [&](void *data) {
+        ((uint8_t *)data)[0] = 1;
+        EXPECT_EQ(MOS_STATUS_SUCCESS, Write(second, 0, 2));
+    }));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Process(nullptr, true));
+    EXPECT_EQ(0u, GetPendingNum());
+    EXPECT_EQ(1, Memory(first)[0]);
+    EXPECT_EQ(2, Memory(second)[0]);
+}
+
+TEST_F(MosAsyncLockTest, InvalidParameters)
+{
+    MOS_RESOURCE    resource = Resource(0);
+    MOS_LOCK_PARAMS flags    = {};
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, Add(nullptr, flags, [](void *) {}));
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, Add(&resource, flags, nullptr));
+    EXPECT_EQ(0u, GetPendingNum());
+}
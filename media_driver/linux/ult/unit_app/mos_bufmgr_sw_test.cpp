@@ -0,0 +1,183 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_bufmgr_api.h"
+#include "mos_bufmgr_priv.h"
+#include "mos_bufmgr_sw.h"
+#include "mos_defs.h"
+#include "mos_resource_defs.h"
+
+using namespace std;
+
+#define SW_TEST_MI_CMD(opcode, len)     (((opcode) << 23) | ((len) > 1 ? (len) - 2 : 0))
+#define SW_TEST_MI_BATCH_BUFFER_END     SW_TEST_MI_CMD(0x0a, 1)
+#define SW_TEST_MI_STORE_DATA_IMM       SW_TEST_MI_CMD(0x20, 4)
+#define SW_TEST_MI_FLUSH_DW_WRITE_IMM   (SW_TEST_MI_CMD(0x26, 4) | (1 << 14))
+#define SW_TEST_MI_COPY_MEM_MEM         SW_TEST_MI_CMD(0x2e, 5)
+
+class MosBufmgrSwTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        int deviceType = -1;
+        m_bufmgr       = mos_bufmgr_sw_init(-1, 0, &deviceType);
+        ASSERT_NE(nullptr, m_bufmgr);
+        EXPECT_EQ(DEVICE_TYPE_I915, deviceType);
+        EXPECT_TRUE(mos_bufmgr_is_sw(m_bufmgr));
+
+        m_batch  = Alloc("batch");
+        m_target = Alloc("target");
+        ASSERT_NE(nullptr, m_batch);
+        ASSERT_NE(nullptr, m_target);
+    }
+
+    void TearDown() override
+    {
+        mos_bo_unreference(m_batch);
+        mos_bo_unreference(m_target);
+        mos_bufmgr_destroy(m_bufmgr);
+    }
+
+    mos_linux_bo *Alloc(const char *name)
+    {
+        struct mos_drm_bo_alloc alloc;
+        alloc.name         = name;
+        alloc.size         = 4096;
+        alloc.alignment    = 4096;
+        alloc.ext.mem_type = MOS_MEMPOOL_VIDEOMEMORY;
+        return mos_bo_alloc(m_bufmgr, &alloc);
+    }
+
+    void EmitAddr(uint64_t addr)
+    {
+        m_cmds.push_back((uint32_t)addr);
+        m_cmds.push_back((uint32_t)(addr >> 32));
+    }
+
+    int Exec()
+    {
+        m_cmds.push_back(SW_TEST_MI_BATCH_BUFFER_END);
+        EXPECT_EQ(0, mos_bo_map(m_batch, 1));
+        memcpy(m_batch->virt, m_cmds.data(), m_cmds.size() * sizeof(uint32_t));
+        mos_bo_unmap(m_batch);
+
+        int fence = 0;
+        int ret   = mos_bo_context_exec2(m_batch, m_cmds.size() * sizeof(uint32_t), nullptr, nullptr, 0, 0, 0, &fence);
+        EXPECT_EQ(-1, fence);
+        return ret;
+    }
+
+    mos_bufmgr_sw_stats Stats()
+    {
+        mos_bufmgr_sw_stats stats = {};
+        EXPECT_EQ(0, mos_bufmgr_sw_get_stats(m_bufmgr, &stats));
+        return stats;
+    }
+
+    mos_bufmgr      *m_bufmgr = nullptr;
+    mos_linux_bo    *m_batch  = nullptr;
+    mos_linux_bo    *m_target = nullptr;
+    vector<uint32_t> m_cmds;
+};
+
+TEST_F(MosBufmgrSwTest, ExecPerformsStatusWrites)
+{
+    uint64_t target = m_target->offset64;
+
+    m_cmds.push_back(SW_TEST_MI_STORE_DATA_IMM);
+    EmitAddr(target);
+    m_cmds.push_back(0x12345678);
+
+    m_cmds.push_back(SW_TEST_MI_FLUSH_DW_WRITE_IMM);
+    EmitAddr(target + 8);
+    m_cmds.push_back(0xabcd);
+
+    m_cmds.push_back(SW_TEST_MI_COPY_MEM_MEM);
+    EmitAddr(target + 16);
+    EmitAddr(target);
+
+    ASSERT_EQ(0, Exec());
+
+    // Execution is synchronous, the results are visible as soon as exec returns
+    EXPECT_EQ(0, mos_bo_busy(m_target));
+    ASSERT_EQ(0, mos_bo_map(m_target, 0));
+    const uint32_t *data = (const uint32_t *)m_target->virt;
+    EXPECT_EQ(0x12345678u, data[0]);
+    EXPECT_EQ(0xabcdu, data[2]);
+    EXPECT_EQ(0x12345678u, data[4]);
+    mos_bo_unmap(m_target);
+
+    auto stats = Stats();
+    EXPECT_EQ(1u, stats.exec_count);
+    EXPECT_EQ(3u, stats.mem_writes);
+    EXPECT_EQ(0u, stats.unresolved_addrs);
+    EXPECT_EQ(m_cmds.size(), stats.dwords_parsed);
+}
+
+TEST_F(MosBufmgrSwTest, WriteOutsideAnyBufferIsDropped)
+{
+    // One page past the target is inside its 64K VA reservation, but not inside the bo
+    m_cmds.push_back(SW_TEST_MI_STORE_DATA_IMM);
+    EmitAddr(m_target->offset64 + m_target->size);
+    m_cmds.push_back(0x12345678);
+
+    ASSERT_EQ(0, Exec());
+
+    auto stats = Stats();
+    EXPECT_EQ(0u, stats.mem_writes);
+    EXPECT_EQ(1u, stats.unresolved_addrs);
+}
+
+TEST_F(MosBufmgrSwTest, StatsTrackBufferLifetime)
+{
+    auto stats = Stats();
+    EXPECT_EQ(2u, stats.bo_alloc_count);
+    EXPECT_EQ(2u * 4096, stats.bo_alloc_bytes);
+    EXPECT_EQ(2u, stats.bo_live_count);
+
+    mos_linux_bo *bo = Alloc("temp");
+    ASSERT_NE(nullptr, bo);
+    EXPECT_NE(m_target->offset64, bo->offset64);
+    EXPECT_EQ(3u, Stats().bo_live_count);
+
+    mos_bo_reference(bo);
+    mos_bo_unreference(bo);
+    EXPECT_EQ(3u, Stats().bo_live_count);
+
+    mos_bo_unreference(bo);
+    stats = Stats();
+    EXPECT_EQ(3u, stats.bo_alloc_count);
+    EXPECT_EQ(2u, stats.bo_live_count);
+}
+
+TEST(MosBufmgrSwApiTest, RejectsOtherBufmgrs)
+{
+    mos_bufmgr_sw_stats stats = {};
+    EXPECT_FALSE(mos_bufmgr_is_sw(nullptr));
+    EXPECT_EQ(-EINVAL, mos_bufmgr_sw_get_stats(nullptr, &stats));
+
+    mos_bufmgr other = {};
+    EXPECT_FALSE(mos_bufmgr_is_sw(&other));
+    EXPECT_EQ(-EINVAL, mos_bufmgr_sw_get_stats(&other, &stats));
+}
@@ -0,0 +1,308 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_defs.h"
+#include "mos_bufmgr_xe.h"
+#include "mos_synchronization_xe.h"
+
+using namespace std;
+
+// Replays bo dependency tracking of Xe execs without a device: no syncobj is
+// created, every exec queue gets a fake timeline dep.
+class MosSyncXeDepsTest : public testing::Test
+{
+protected:
+    // Map based tracking the inline slots replaced: latest read dep per exec
+    // queue and the dep of the last write.
+    struct RefBoDeps
+    {
+        map<uint32_t, mos_xe_bo_dep> reads;
+        uint32_t                     writeQueue = 0;
+        mos_xe_bo_dep                write      = {};
+    };
+
+    void SetUp() override
+    {
+        m_deps.resize(m_maxQueueNum);
+        for (uint32_t q = 0; q < m_maxQueueNum; q++)
+        {
+            m_deps[q].syncobj_handle = q + 1;
+            m_deps[q].timeline_index = 1;
+        }
+    }
+
+    void CreateQueues(uint32_t queueNum)
+    {
+        for (uint32_t q = 0; q < queueNum; q++)
+        {
+            mos_sync_add_exec_queue_id(m_ids, q);
+        }
+    }
+
+    // Waits of one exec as syncobj handle -> timeline point
+    static map<uint32_t, uint64_t> ToWaits(const vector<drm_xe_sync> &syncs)
+    {
+        map<uint32_t, uint64_t> waits;
+        for (auto &sync : syncs)
+        {
+            EXPECT_EQ(0u, waits.count(sync.handle));
+            waits[sync.handle] = sync.timeline_value;
+        }
+        return waits;
+    }
+
+    static void RefAddWait(map<uint32_t, uint64_t> &waits, const mos_xe_bo_dep &dep)
+    {
+        uint64_t &point = waits[dep.dep->syncobj_handle];
+        point           = max(point, dep.exec_timeline_index);
+    }
+
+    void RefExecWaits(uint32_t queue, uint32_t flags, RefBoDeps &deps, map<uint32_t, uint64_t> &waits)
+    {
+        if (deps.write.dep && deps.writeQueue != queue && mos_sync_is_exec_queue_valid(m_ids, deps.writeQueue))
+        {
+            RefAddWait(waits, deps.write);
+        }
+        if (flags & EXEC_OBJECT_WRITE_XE)
+        {
+            for (auto &read : deps.reads)
+            {
+                if (read.first != queue && mos_sync_is_exec_queue_valid(m_ids, read.first))
+                {
+                    RefAddWait(waits, read.second);
+                }
+            }
+        }
+    }
+
+    void RefUpdate(uint32_t queue, uint32_t flags, RefBoDeps &deps)
+    {
+        mos_xe_bo_dep dep = {&m_deps[queue], m_deps[queue].timeline_index};
+        if (flags & EXEC_OBJECT_READ_XE)
+        {
+            deps.reads[queue] = dep;
+        }
+        if (flags & EXEC_OBJECT_WRITE_XE)
+        {
+            deps.writeQueue = queue;
+            deps.write      = dep;
+        }
+    }
+
+    static const uint32_t m_maxQueueNum = 32;
+
+    vector<mos_xe_dep>     m_deps;
+    mos_xe_exec_queue_ids  m_ids;
+};
+
+TEST_F(MosSyncXeDepsTest, ReadSlotsSpillPastInlineNum)
+{
+    const uint32_t queueNum = MOS_XE_BO_DEP_INLINE_NUM + 3;
+    CreateQueues(queueNum);
+
+    mos_xe_bo_deps deps;
+    for (uint32_t round = 0; round < 2; round++)
+    {
+        for (uint32_t q = 0; q < queueNum; q++)
+        {
+            m_deps[q].timeline_index++;
+            EXPECT_EQ(MOS_XE_SUCCESS, mos_sync_update_bo_deps(q, EXEC_OBJECT_READ_XE, &m_deps[q], deps));
+        }
+    }
+
+    // A queue reading again updates its slot instead of adding one
+    EXPECT_EQ(queueNum, deps.read_num);
+    EXPECT_EQ(queueNum - MOS_XE_BO_DEP_INLINE_NUM, deps.read_overflow.size());
+
+    map<uint32_t, uint64_t> waits;
+    mos_sync_get_bo_wait_timeline_deps(m_ids, deps, waits, EXEC_OBJECT_WRITE_XE);
+    EXPECT_EQ(queueNum, waits.size());
+    for (uint32_t q = 0; q < queueNum; q++)
+    {
+        EXPECT_EQ(m_deps[q].timeline_index, waits[m_deps[q].syncobj_handle]);
+    }
+}
+
+TEST_F(MosSyncXeDepsTest, OneWaitPerQueueAcrossBos)
+{
+    CreateQueues(3);
+
+    // Queue 1 writes two bos at different points, queue 2 reads the second one
+    mos_xe_bo_deps deps[2];
+    m_deps[1].timeline_index = 5;
+    mos_sync_update_bo_deps(1, EXEC_OBJECT_WRITE_XE, &m_deps[1], deps[0]);
+    m_deps[1].timeline_index = 7;
+    mos_sync_update_bo_deps(1, EXEC_OBJECT_WRITE_XE, &m_deps[1], deps[1]);
+    m_deps[2].timeline_index = 3;
+    mos_sync_update_bo_deps(2, EXEC_OBJECT_READ_XE, &m_deps[2], deps[1]);
+
+    vector<drm_xe_sync> syncs;
+    mos_sync_begin_exec_syncs(m_ids);
+    for (auto &bo : deps)
+    {
+        mos_sync_update_exec_syncs_from_timeline_deps(0, EXEC_OBJECT_WRITE_XE, m_ids, bo, syncs);
+    }
+
+    map<uint32_t, uint64_t> waits = ToWaits(syncs);
+    EXPECT_EQ(2u, waits.size());
+    EXPECT_EQ(7u, waits[m_deps[1].syncobj_handle]);
+    EXPECT_EQ(3u, waits[m_deps[2].syncobj_handle]);
+
+    // The next exec starts with no wait
+    syncs.clear();
+    mos_sync_begin_exec_syncs(m_ids);
+    mos_sync_update_exec_syncs_from_timeline_deps(1, EXEC_OBJECT_READ_XE, m_ids, deps[0], syncs);
+    EXPECT_TRUE(syncs.empty());
+}
+
+TEST_F(MosSyncXeDepsTest, DestroyedQueueIsNotWaited)
+{
+    CreateQueues(MOS_XE_BO_DEP_INLINE_NUM + 2);
+
+    mos_xe_bo_deps deps;
+    for (uint32_t q = 1; q < MOS_XE_BO_DEP_INLINE_NUM + 2; q++)
+    {
+        mos_sync_update_bo_deps(q, EXEC_OBJECT_READ_XE, &m_deps[q], deps);
+    }
+    mos_sync_update_bo_deps(1, EXEC_OBJECT_WRITE_XE, &m_deps[1], deps);
+    mos_sync_remove_exec_queue_id(m_ids, 1);
+    mos_sync_remove_exec_queue_id(m_ids, 2);
+
+    map<uint32_t, uint64_t> waits;
+    mos_sync_get_bo_wait_timeline_deps(m_ids, deps, waits, EXEC_OBJECT_WRITE_XE);
+    EXPECT_EQ(0u, waits.count(m_deps[1].syncobj_handle));
+    EXPECT_EQ(0u, waits.count(m_deps[2].syncobj_handle));
+
+    vector<drm_xe_sync> syncs;
+    mos_sync_begin_exec_syncs(m_ids);
+    mos_sync_update_exec_syncs_from_timeline_deps(0, EXEC_OBJECT_WRITE_XE, m_ids, deps, syncs);
+    EXPECT_EQ(MOS_XE_BO_DEP_INLINE_NUM - 1, syncs.size());
+
+    // Read slots of destroyed queues are dropped by the exec
+    EXPECT_EQ(MOS_XE_BO_DEP_INLINE_NUM - 1, deps.read_num);
+    EXPECT_TRUE(deps.read_overflow.empty());
+}
+
+// Null submission replay: random execs over a set of bos give the same waits as
+// the map based tracking, and the CPU cost per exec of both is printed.
+TEST_F(MosSyncXeDepsTest, NullSubmissionReplay)
+{
+    const uint32_t boNum       = 256;
+    const uint32_t bosPerExec  = 48;
+    const uint32_t execNum     = 20000;
+    const uint32_t queueNums[] = {4, 8, 16};
+
+    printf("%8s %14s %14s %12s %12s\n", "queues", "map us/exec", "slot us/exec", "map syncs", "slot syncs");
+    for (uint32_t queueNum : queueNums)
+    {
+        CreateQueues(queueNum);
+
+        // Both trackings see the same exec sequence
+        vector<uint32_t> execQueues(execNum);
+        vector<uint32_t> execBos(execNum * bosPerExec);
+        vector<uint32_t> execFlags(execNum * bosPerExec);
+        mt19937          rng(queueNum);
+        for (uint32_t e = 0; e < execNum; e++)
+        {
+            execQueues[e] = rng() % queueNum;
+            for (uint32_t b = 0; b < bosPerExec; b++)
+            {
+                execBos[e * bosPerExec + b]   = rng() % boNum;
+                execFlags[e * bosPerExec + b] = rng() % 4 ? EXEC_OBJECT_READ_XE : EXEC_OBJECT_READ_XE | EXEC_OBJECT_WRITE_XE;
+            }
+        }
+
+        vector<RefBoDeps>        refDeps(boNum);
+        vector<mos_xe_bo_deps>   slotDeps(boNum);
+        vector<drm_xe_sync>      syncs;
+        map<uint32_t, uint64_t>  refWaits;
+        uint64_t                 refSyncNum  = 0;
+        uint64_t                 slotSyncNum = 0;
+        double                   refUs       = 0;
+        double                   slotUs      = 0;
+
+        for (uint32_t e = 0; e < execNum; e++)
+        {
+            uint32_t queue = execQueues[e];
+            uint32_t *bos   = &execBos[e * bosPerExec];
+            uint32_t *flags = &execFlags[e * bosPerExec];
+
+            // The map based tracking pushed one sync per bo dep
+            auto start = chrono::steady_clock::now();
+            refWaits.clear();
+            for (uint32_t b = 0; b < bosPerExec; b++)
+            {
+                map<uint32_t, uint64_t> boWaits;
+                RefExecWaits(queue, flags[b], refDeps[bos[b]], boWaits);
+                refSyncNum += boWaits.size();
+                for (auto &wait : boWaits)
+                {
+                    refWaits[wait.first] = max(refWaits[wait.first], wait.second);
+                }
+            }
+            auto mid = chrono::steady_clock::now();
+
+            syncs.clear();
+            mos_sync_begin_exec_syncs(m_ids);
+            for (uint32_t b = 0; b < bosPerExec; b++)
+            {
+                mos_sync_update_exec_syncs_from_timeline_deps(queue, flags[b], m_ids, slotDeps[bos[b]], syncs);
+            }
+            auto end = chrono::steady_clock::now();
+
+            refUs  += chrono::duration<double, micro>(mid - start).count();
+            slotUs += chrono::duration<double, micro>(end - mid).count();
+            slotSyncNum += syncs.size();
+            ASSERT_EQ(refWaits, ToWaits(syncs)) << "exec " << e;
+
+            // Fence out of the exec
+            m_deps[queue].timeline_index++;
+            for (uint32_t b = 0; b < bosPerExec; b++)
+            {
+                RefUpdate(queue, flags[b], refDeps[bos[b]]);
+                mos_sync_update_bo_deps(queue, flags[b], &m_deps[queue], slotDeps[bos[b]]);
+            }
+        }
+
+        // bo wait sees the same deps too
+        for (uint32_t bo = 0; bo < boNum; bo++)
+        {
+            map<uint32_t, uint64_t> waits;
+            map<uint32_t, uint64_t> expected;
+            mos_sync_get_bo_wait_timeline_deps(m_ids, slotDeps[bo], waits, EXEC_OBJECT_WRITE_XE);
+            RefExecWaits(m_maxQueueNum, EXEC_OBJECT_WRITE_XE, refDeps[bo], expected);
+            EXPECT_EQ(expected, waits);
+        }
+
+        printf("%8u %14.2f %14.2f %12.1f %12.1f\n",
+            queueNum,
+            refUs / execNum,
+            slotUs / execNum,
+            (double)refSyncNum / execNum,
+            (double)slotSyncNum / execNum);
+    }
+}
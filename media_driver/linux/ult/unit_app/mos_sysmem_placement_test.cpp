@@ -0,0 +1,196 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "mos_bufmgr_api.h"
+#include "mos_bufmgr_sw.h"
+#include "mos_sysmem_placement.h"
+
+// The placement mode is process wide and only set by Init from the user setting,
+// so the tests switch it directly and restore it.
+class MosSysMemPlacementTest : public testing::Test, protected MosSysMemPlacement
+{
+protected:
+    void SetUp() override
+    {
+        m_savedMode = m_mode;
+    }
+
+    void TearDown() override
+    {
+        m_mode = m_savedMode;
+    }
+
+    static Stats Diff(const Stats &before)
+    {
+        Stats after = {};
+        GetStats(after);
+        after.hugetlbAllocs   -= before.hugetlbAllocs;
+        after.thpAllocs       -= before.thpAllocs;
+        after.localNodeAllocs -= before.localNodeAllocs;
+        after.fallbackAllocs  -= before.fallbackAllocs;
+        after.smallAllocs     -= before.smallAllocs;
+        return after;
+    }
+
+    Mode m_savedMode = modeOff;
+};
+
+TEST_F(MosSysMemPlacementTest, OffKeepsTheRegularAllocator)
+{
+    m_mode = modeOff;
+    Stats before = {};
+    GetStats(before);
+
+    void *ptr = Alloc(4 * m_hugePageSize, -1);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_FALSE(IsPlaced(ptr));
+    Free(ptr);
+
+    Stats diff = Diff(before);
+    EXPECT_EQ(0u, diff.thpAllocs + diff.hugetlbAllocs + diff.smallAllocs + diff.fallbackAllocs);
+}
+
+TEST_F(MosSysMemPlacementTest, LargeBuffersAreMappedAligned)
+{
+    m_mode = modeThp;
+    Stats before = {};
+    GetStats(before);
+
+    // Not a multiple of the huge page size, the mapping is rounded up
+    size_t size = 3 * m_hugePageSize + 4096;
+    uint8_t *ptr = (uint8_t *)Alloc(size, -1);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_TRUE(IsPlaced(ptr));
+    EXPECT_EQ(0u, (uintptr_t)ptr % m_hugePageSize);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ASSERT_EQ(1u, m_mappings.count(ptr));
+        EXPECT_EQ(4 * m_hugePageSize, m_mappings[ptr]);
+    }
+    ptr[0]        = 1;
+    ptr[size - 1] = 2;
+
+    Free(ptr);
+    EXPECT_FALSE(IsPlaced(ptr));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        EXPECT_EQ(0u, m_mappings.count(ptr));
+    }
+
+    Stats diff = Diff(before);
+    EXPECT_EQ(1u, diff.thpAllocs);
+    EXPECT_EQ(0u, diff.hugetlbAllocs);
+    EXPECT_EQ(0u, diff.fallbackAllocs);
+    // Without a device there is no node to prefer
+    EXPECT_EQ(0u, diff.localNodeAllocs);
+}
+
+TEST_F(MosSysMemPlacementTest, SmallBuffersAreNotPlaced)
+{
+    m_mode = modeThp;
+    Stats before = {};
+    GetStats(before);
+
+    void *ptr = Alloc(m_hugePageSize - 1, -1);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_FALSE(IsPlaced(ptr));
+    Free(ptr);
+
+    Stats diff = Diff(before);
+    EXPECT_EQ(1u, diff.smallAllocs);
+    EXPECT_EQ(0u, diff.thpAllocs);
+}
+
+TEST_F(MosSysMemPlacementTest, HugetlbFallsBackToThp)
+{
+    m_mode = modeHugetlb;
+    Stats before = {};
+    GetStats(before);
+
+    // Succeeds whether or not the hugetlbfs pool has free pages
+    void *ptr = Alloc(m_hugePageSize, -1);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_TRUE(IsPlaced(ptr));
+    Free(ptr);
+
+    Stats diff = Diff(before);
+    EXPECT_EQ(1u, diff.hugetlbAllocs + diff.thpAllocs);
+    EXPECT_EQ(0u, diff.fallbackAllocs);
+}
+
+TEST_F(MosSysMemPlacementTest, FailedMappingFallsBack)
+{
+    m_mode = modeThp;
+    Stats before = {};
+    GetStats(before);
+
+    // No address space for it, the regular allocator fails as well
+    void *ptr = Alloc((size_t)1 << 62, -1);
+    EXPECT_EQ(nullptr, ptr);
+    EXPECT_FALSE(IsPlaced(ptr));
+
+    Stats diff = Diff(before);
+    EXPECT_EQ(1u, diff.fallbackAllocs);
+    EXPECT_EQ(0u, diff.thpAllocs);
+}
+
+TEST_F(MosSysMemPlacementTest, NumaNodeOfNonDevices)
+{
+    EXPECT_EQ(-1, GetNumaNode(-1));
+
+    // A regular file is not a character device
+    FILE *file = tmpfile();
+    ASSERT_NE(nullptr, file);
+    EXPECT_EQ(-1, GetNumaNode(fileno(file)));
+    fclose(file);
+
+    // A character device without a PCI parent has no node, and the answer is cached
+    int32_t fd = open("/dev/null", O_RDONLY);
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(-1, GetNumaNode(fd));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        EXPECT_FALSE(m_nodes.empty());
+    }
+    EXPECT_EQ(-1, GetNumaNode(fd));
+    close(fd);
+}
+
+TEST_F(MosSysMemPlacementTest, ReadbackBenchmarkReadsABufferObject)
+{
+    m_mode = modeThp;
+    int        deviceType = -1;
+    MOS_BUFMGR *bufmgr    = mos_bufmgr_sw_init(-1, 0, &deviceType);
+    ASSERT_NE(nullptr, bufmgr);
+
+    BenchResult result = {};
+    EXPECT_EQ(MOS_STATUS_SUCCESS, RunReadbackBenchmark(bufmgr, -1, result));
+    EXPECT_GT(result.defaultRate, 0u);
+    EXPECT_GT(result.placedRate, 0u);
+    EXPECT_FALSE(result.bound);
+
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, RunReadbackBenchmark(nullptr, -1, result));
+    mos_bufmgr_destroy(bufmgr);
+}
@@ -0,0 +1,177 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_vdbox_balancer.h"
+
+using namespace std;
+
+// Opens the selection helpers and gives each test its own balancer
+class TestVdboxBalancer : public MosVdboxBalancer
+{
+public:
+    using MosVdboxBalancer::Device;
+    using MosVdboxBalancer::Stream;
+    using MosVdboxBalancer::GetLeastLoadedEngine;
+    using MosVdboxBalancer::GetTargetEngine;
+};
+
+static TestVdboxBalancer::Device MakeDevice(const vector<double> &loads, const vector<uint32_t> &streamNums)
+{
+    TestVdboxBalancer::Device device;
+    device.engines.resize(loads.size());
+    for (uint32_t i = 0; i < loads.size(); i++)
+    {
+        device.engines[i].load            = loads[i];
+        device.engines[i].stats.streamNum = streamNums[i];
+    }
+    return device;
+}
+
+static TestVdboxBalancer::Stream MakeStream(uint32_t engine, double load, uint32_t frameNum)
+{
+    TestVdboxBalancer::Stream stream;
+    stream.engine   = engine;
+    stream.load     = load;
+    stream.frameNum = frameNum;
+    return stream;
+}
+
+TEST(MosVdboxBalancerTest, LeastLoadedEngineBreaksTiesByStreams)
+{
+    EXPECT_EQ(1u, TestVdboxBalancer::GetLeastLoadedEngine(MakeDevice({300, 100, 200}, {1, 1, 1})));
+
+    // Streams registered together have no load yet
+    EXPECT_EQ(2u, TestVdboxBalancer::GetLeastLoadedEngine(MakeDevice({0, 0, 0}, {2, 1, 0})));
+    EXPECT_EQ(0u, TestVdboxBalancer::GetLeastLoadedEngine(MakeDevice({0, 0}, {1, 1})));
+}
+
+TEST(MosVdboxBalancerTest, StreamWaitsMinFramesBeforeMoving)
+{
+    auto device = MakeDevice({3000, 0}, {3, 0});
+    auto stream = MakeStream(0, 1000, MosVdboxBalancer::m_minFramesToMove - 1);
+
+    EXPECT_EQ(0u, TestVdboxBalancer::GetTargetEngine(device, stream));
+
+    stream.frameNum = MosVdboxBalancer::m_minFramesToMove;
+    EXPECT_EQ(1u, TestVdboxBalancer::GetTargetEngine(device, stream));
+}
+
+TEST(MosVdboxBalancerTest, StreamMovesOnlyIfLoadsClearlyEvenOut)
+{
+    uint32_t frames = MosVdboxBalancer::m_minFramesToMove;
+
+    // 1000 + 1000 < 3000 * 0.75, the move evens out the loads
+    EXPECT_EQ(1u, TestVdboxBalancer::GetTargetEngine(MakeDevice({3000, 1000}, {3, 1}), MakeStream(0, 1000, frames)));
+
+    // 1000 + 1000 >= 2400 * 0.75, the engines would only trade the stream back and forth
+    EXPECT_EQ(0u, TestVdboxBalancer::GetTargetEngine(MakeDevice({2400, 1000}, {2, 1}), MakeStream(0, 1000, frames)));
+
+    // Already on the least loaded engine
+    EXPECT_EQ(1u, TestVdboxBalancer::GetTargetEngine(MakeDevice({3000, 1000}, {3, 1}), MakeStream(1, 1000, frames)));
+}
+
+TEST(MosVdboxBalancerTest, StreamAloneOnItsEngineNeverMoves)
+{
+    // The stream is the whole load of its engine, moving only carries it along
+    auto device = MakeDevice({5000, 0}, {1, 0});
+    EXPECT_EQ(0u, TestVdboxBalancer::GetTargetEngine(device, MakeStream(0, 5000, 10 * MosVdboxBalancer::m_minFramesToMove)));
+}
+
+TEST(MosVdboxBalancerTest, RegisterSpreadsStreamsAcrossEngines)
+{
+    TestVdboxBalancer balancer;
+    int               device = 0;
+
+    EXPECT_EQ(-1, balancer.RegisterStream(&device, 1));
+    EXPECT_EQ(-1, balancer.RegisterStream(nullptr, 2));
+
+    vector<int32_t> streams;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        streams.push_back(balancer.RegisterStream(&device, 2));
+        ASSERT_GE(streams.back(), 0);
+    }
+
+    // A different engine count on the same device is refused while streams run
+    EXPECT_EQ(-1, balancer.RegisterStream(&device, 3));
+
+    vector<MosVdboxBalancer::EngineStats> stats;
+    balancer.GetEngineStats(&device, stats);
+    ASSERT_EQ(2u, stats.size());
+    EXPECT_EQ(2u, stats[0].streamNum);
+    EXPECT_EQ(2u, stats[1].streamNum);
+
+    for (auto stream : streams)
+    {
+        balancer.UnregisterStream(stream);
+    }
+    balancer.GetEngineStats(&device, stats);
+    EXPECT_TRUE(stats.empty());
+}
+
+TEST(MosVdboxBalancerTest, SelectEngineMovesLightStreamOffBusyEngine)
+{
+    TestVdboxBalancer balancer;
+    int               device = 0;
+
+    // heavy and light share engine 0, idle holds engine 1 without submitting
+    int32_t heavy = balancer.RegisterStream(&device, 2);
+    int32_t idle  = balancer.RegisterStream(&device, 2);
+    int32_t light = balancer.RegisterStream(&device, 2);
+    ASSERT_GE(heavy, 0);
+    ASSERT_GE(idle, 0);
+    ASSERT_GE(light, 0);
+
+    uint32_t busyEngine = balancer.SelectEngine(heavy, 4 * MosVdboxBalancer::m_defaultWorkload, true);
+    ASSERT_EQ(busyEngine, balancer.SelectEngine(light, MosVdboxBalancer::m_defaultWorkload, true));
+
+    // Submissions inside a frame follow the first one and are not accounted
+    EXPECT_EQ(busyEngine, balancer.SelectEngine(heavy, 0, false));
+
+    uint32_t heavyEngine = busyEngine;
+    uint32_t lightEngine = busyEngine;
+    for (uint32_t i = 1; i < 2 * MosVdboxBalancer::m_minFramesToMove; i++)
+    {
+        heavyEngine = balancer.SelectEngine(heavy, 4 * MosVdboxBalancer::m_defaultWorkload, true);
+        lightEngine = balancer.SelectEngine(light, MosVdboxBalancer::m_defaultWorkload, true);
+    }
+
+    // Moving the heavy stream would leave the loads as uneven as before
+    EXPECT_EQ(busyEngine, heavyEngine);
+    EXPECT_NE(busyEngine, lightEngine);
+
+    vector<MosVdboxBalancer::EngineStats> stats;
+    balancer.GetEngineStats(&device, stats);
+    ASSERT_EQ(2u, stats.size());
+    EXPECT_EQ(1u, stats[busyEngine].streamNum);
+    EXPECT_EQ(2u, stats[lightEngine].streamNum);
+    EXPECT_EQ(2 * 2 * MosVdboxBalancer::m_minFramesToMove, stats[0].frameNum + stats[1].frameNum);
+    EXPECT_GT(stats[busyEngine].loadPercent, stats[lightEngine].loadPercent);
+    EXPECT_NEAR(100, stats[0].loadPercent + stats[1].loadPercent, 1);
+
+    EXPECT_EQ(0u, balancer.SelectEngine(-1, 0, true));
+
+    balancer.UnregisterStream(heavy);
+    balancer.UnregisterStream(idle);
+    balancer.UnregisterStream(light);
+}
@@ -0,0 +1,114 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_worker_pool.h"
+
+using namespace std;
+
+TEST(MosWorkerPoolTest, RangesCoverItemsInOrder)
+{
+    const uint32_t itemNum = 1001;
+    vector<uint32_t> owner(itemNum, 0xffffffff);
+
+    MOS_STATUS status = MosWorkerPool::GetInstance().Run(itemNum, 7, [&](uint32_t rangeIdx, uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            owner[i] = rangeIdx;
+        }
+        return MOS_STATUS_SUCCESS;
+    });
+    EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+
+    // Every item is done once, ranges are contiguous and ordered by index
+    for (uint32_t i = 1; i < itemNum; i++)
+    {
+        ASSERT_NE(0xffffffffu, owner[i]);
+        EXPECT_TRUE(owner[i] == owner[i - 1] || owner[i] == owner[i - 1] + 1);
+    }
+    EXPECT_EQ(0u, owner[0]);
+}
+
+TEST(MosWorkerPoolTest, SmallJobRunsOnCaller)
+{
+    thread::id caller = this_thread::get_id();
+    thread::id runner;
+    uint32_t   calls  = 0;
+
+    MOS_STATUS status = MosWorkerPool::GetInstance().Run(5, 1, [&](uint32_t rangeIdx, uint32_t begin, uint32_t end) {
+        runner = this_thread::get_id();
+        calls++;
+        EXPECT_EQ(0u, rangeIdx);
+        EXPECT_EQ(0u, begin);
+        EXPECT_EQ(5u, end);
+        return MOS_STATUS_SUCCESS;
+    });
+    EXPECT_EQ(MOS_STATUS_SUCCESS, status);
+    EXPECT_EQ(1u, calls);
+    EXPECT_EQ(caller, runner);
+}
+
+TEST(MosWorkerPoolTest, FirstFailingRangeWins)
+{
+    MOS_STATUS status = MosWorkerPool::GetInstance().Run(8, 8, [&](uint32_t rangeIdx, uint32_t begin, uint32_t end) {
+        if (rangeIdx == 5)
+        {
+            return MOS_STATUS_NO_SPACE;
+        }
+        if (rangeIdx == 3)
+        {
+            return MOS_STATUS_NULL_POINTER;
+        }
+        return MOS_STATUS_SUCCESS;
+    });
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, status);
+}
+
+TEST(MosWorkerPoolTest, ConcurrentAndNestedJobs)
+{
+    const uint32_t  callerNum = 4;
+    atomic<uint32_t> items(0);
+    vector<thread>  callers;
+
+    for (uint32_t c = 0; c < callerNum; c++)
+    {
+        callers.emplace_back([&]() {
+            for (uint32_t loop = 0; loop < 50; loop++)
+            {
+                MosWorkerPool::GetInstance().Run(16, 4, [&](uint32_t, uint32_t begin, uint32_t end) {
+                    // Nested jobs are finished by their caller if the pool is busy
+                    return MosWorkerPool::GetInstance().Run(end - begin, 2, [&](uint32_t, uint32_t b, uint32_t e) {
+                        items += e - b;
+                        return MOS_STATUS_SUCCESS;
+                    });
+                });
+            }
+        });
+    }
+    for (auto &caller : callers)
+    {
+        caller.join();
+    }
+    EXPECT_EQ(callerNum * 50 * 16, items.load());
+}
@@ -0,0 +1,180 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "oca_rtlog_section_mgr.h"
+
+using namespace std;
+
+// A section manager set up the way InitSectionMgrAndGetAddress sets up the decode,
+// VP and encode sections, on a section of its own. Every value of an entry is the
+// id of its writer, an entry mixing two ids was written by two writers at once.
+class OcaRtLogSectionMgrTest : public testing::Test, protected OcaRtLogSectionMgr
+{
+protected:
+#pragma pack(push, 1)
+    struct Entry
+    {
+        MOS_OCA_RTLOG_HEADER header;
+        int32_t              paramId;
+        int64_t              paramValue;
+    };
+#pragma pack(pop)
+
+    void SetUp() override
+    {
+        static_assert(sizeof(Entry) == MOS_OCA_RTLOG_ENTRY_SIZE, "entry layout");
+        m_section.assign(MAX_OCA_RT_SUB_SIZE, 0);
+        Init(m_section.data(), MAX_OCA_RT_SIZE, MAX_OCA_RT_SUB_SIZE, 0);
+
+        MOS_OCA_RTLOG_SECTION_HEADER sectionHeader = {};
+        sectionHeader.magicNum      = MOS_OCA_RTLOG_MAGIC_NUM;
+        sectionHeader.componentType = MOS_OCA_RTLOG_COMPONENT_DECODE;
+        ASSERT_EQ(MOS_STATUS_SUCCESS, InsertUid(sectionHeader));
+        ASSERT_GT(m_EntryCount, 1u);
+    }
+
+    MOS_STATUS Insert(uint32_t id)
+    {
+        MOS_OCA_RTLOG_HEADER header = {};
+        header.globalId             = id;
+        header.id                   = id;
+        header.paramCount           = MOS_OCA_RTLOG_MAX_PARAM_COUNT;
+
+        uint8_t param[sizeof(int32_t) + sizeof(int64_t)];
+        int32_t paramId    = (int32_t)id;
+        int64_t paramValue = id;
+        memcpy(param, &paramId, sizeof(paramId));
+        memcpy(param + sizeof(paramId), &paramValue, sizeof(paramValue));
+        return InsertData(header, param);
+    }
+
+    Entry Read(uint32_t slot)
+    {
+        Entry entry;
+        memcpy(&entry, m_section.data() + sizeof(MOS_OCA_RTLOG_SECTION_HEADER) + slot * MOS_OCA_RTLOG_ENTRY_SIZE, sizeof(entry));
+        return entry;
+    }
+
+    static bool IsWhole(const Entry &entry)
+    {
+        return entry.header.globalId == entry.header.id &&
+               entry.header.paramCount == MOS_OCA_RTLOG_MAX_PARAM_COUNT &&
+               entry.paramId == (int32_t)entry.header.id &&
+               entry.paramValue == entry.header.id;
+    }
+
+    vector<uint8_t> m_section;
+};
+
+TEST_F(OcaRtLogSectionMgrTest, EntriesWrapInRingOrder)
+{
+    for (uint32_t i = 1; i <= 2 * m_EntryCount; i++)
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, Insert(i));
+        Entry entry = Read((i - 1) % m_EntryCount);
+        EXPECT_EQ(i, entry.header.id);
+        EXPECT_TRUE(IsWhole(entry));
+    }
+
+    // The section header stays in front of the entries
+    MOS_OCA_RTLOG_SECTION_HEADER sectionHeader;
+    memcpy(&sectionHeader, m_section.data(), sizeof(sectionHeader));
+    EXPECT_EQ((uint32_t)MOS_OCA_RTLOG_MAGIC_NUM, sectionHeader.magicNum);
+}
+
+TEST_F(OcaRtLogSectionMgrTest, WriterSkipsSlotBeingWritten)
+{
+    // Another writer is in the middle of filling this slot
+    uint32_t held = 0;
+    ASSERT_TRUE(AcquireSlot(held));
+
+    // Later writers lap the ring but never write to it
+    for (uint32_t i = 1; i <= 3 * m_EntryCount; i++)
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, Insert(i));
+    }
+    EXPECT_EQ(0u, Read(held).header.id);
+    for (uint32_t slot = 0; slot < m_EntryCount; slot++)
+    {
+        EXPECT_TRUE(slot == held || Read(slot).header.id != 0);
+    }
+
+    // With every slot being written the entry is dropped
+    vector<uint32_t> slots;
+    uint32_t         slot = 0;
+    while (slots.size() < m_EntryCount && AcquireSlot(slot))
+    {
+        slots.push_back(slot);
+    }
+    EXPECT_EQ(m_EntryCount - 1, slots.size());
+    vector<uint8_t> before = m_section;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Insert(1000));
+    EXPECT_EQ(before, m_section);
+
+    ReleaseSlot(held);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, Insert(1001));
+    EXPECT_EQ(1001u, Read(held).header.id);
+}
+
+TEST_F(OcaRtLogSectionMgrTest, EveryEntryOfTheCommonSectionHasASlot)
+{
+    vector<uint8_t> common(MAX_OCA_RT_COMMON_SUB_SIZE, 0);
+    Init(common.data(), MAX_OCA_RT_SIZE, MAX_OCA_RT_COMMON_SUB_SIZE, 0);
+    EXPECT_EQ((MAX_OCA_RT_COMMON_SUB_SIZE - sizeof(MOS_OCA_RTLOG_SECTION_HEADER)) / MOS_OCA_RTLOG_ENTRY_SIZE, m_EntryCount);
+    EXPECT_LE(m_EntryCount, m_MaxEntryCount);
+}
+
+TEST_F(OcaRtLogSectionMgrTest, ContendedWritersLeaveWholeEntries)
+{
+    const uint32_t loops = 200000;
+
+    for (uint32_t threadNum : {1u, 4u, 8u})
+    {
+        vector<thread> threads;
+        auto           start = chrono::steady_clock::now();
+        for (uint32_t t = 0; t < threadNum; t++)
+        {
+            threads.emplace_back([this, t, loops]() {
+                for (uint32_t i = 0; i < loops; i++)
+                {
+                    EXPECT_EQ(MOS_STATUS_SUCCESS, Insert(t + 1));
+                }
+            });
+        }
+        for (auto &th : threads)
+        {
+            th.join();
+        }
+        auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+        for (uint32_t slot = 0; slot < m_EntryCount; slot++)
+        {
+            EXPECT_TRUE(IsWhole(Read(slot))) << "slot " << slot;
+        }
+        long long nsPerEntry = ns / ((long long)threadNum * loops);
+        RecordProperty("NsPerEntry" + to_string(threadNum), (int)nsPerEntry);
+        printf("%u writers on %u slots: %lld ns per entry\n", threadNum, m_EntryCount, nsPerEntry);
+    }
+}
@@ -0,0 +1,165 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <memory>
+#include <vector>
+#include "gtest/gtest.h"
+#include "vp_hdrlite_render_filter.h"
+
+using namespace std;
+using namespace vp;
+
+// LUTs are fetched the way InitLayerCri3DLut does. The cache is process wide, so
+// every test uses white points of its own to start from LUTs no other test cached.
+class VpHdrLite3DLutCacheTest : public testing::Test, protected VpHdrLiteRenderFilter
+{
+protected:
+    using Lut = VpHdrLite3DLutCache::Lut;
+
+    VpHdrLite3DLutCacheTest() : VpHdrLiteRenderFilter(nullptr)
+    {
+    }
+
+    // HDR10 to SDR on a DCI-P3 monitor, the target gamut is part of the LUT
+    void SetUp() override
+    {
+        m_param.PriorCSC  = VPHAL_HDR_CSC_YUV_TO_RGB_BT2020;
+        m_param.EOTFGamma = VPHAL_GAMMA_SMPTE_ST2084;
+        m_param.CCM       = VPHAL_HDR_CCM_BT2020_TO_BT601_BT709_MATRIX;
+        m_param.CCMExt1   = VPHAL_HDR_CCM_BT2020_TO_MONITOR_MATRIX;
+        m_param.CCMExt2   = VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX;
+        m_param.HdrMode   = VPHAL_HDR_MODE_TONE_MAPPING;
+        m_param.OETFGamma = VPHAL_GAMMA_SRGB;
+        m_param.PostCSC   = VPHAL_HDR_CSC_RGB_TO_YUV_BT709;
+
+        m_param.stageEnable.PriorCSCEnable = 1;
+        m_param.stageEnable.EOTFEnable     = 1;
+        m_param.stageEnable.CCMEnable      = 1;
+        m_param.stageEnable.PWLFEnable     = 1;
+        m_param.stageEnable.CCMExt1Enable  = 1;
+        m_param.stageEnable.CCMExt2Enable  = 1;
+        m_param.stageEnable.OETFEnable     = 1;
+        m_param.stageEnable.PostCSCEnable  = 1;
+
+        m_target.display_primaries_x[0] = 13250;
+        m_target.display_primaries_y[0] = 34500;
+        m_target.display_primaries_x[1] = 7500;
+        m_target.display_primaries_y[1] = 3000;
+        m_target.display_primaries_x[2] = 34000;
+        m_target.display_primaries_y[2] = 16000;
+        m_target.white_point_y          = 16450;
+    }
+
+    shared_ptr<const Lut> Get(MOS_FORMAT inputFormat = Format_P010)
+    {
+        shared_ptr<const Lut> lut;
+        EXPECT_EQ(MOS_STATUS_SUCCESS, GetCri3DLut(m_param, m_target, inputFormat, lut));
+        EXPECT_NE(nullptr, lut);
+        return lut;
+    }
+
+    Lut Generate(MOS_FORMAT inputFormat = Format_P010)
+    {
+        Lut lut(VPHAL_HDR_CRI_3DLUT_SIZE * VPHAL_HDR_CRI_3DLUT_SIZE * VPHAL_HDR_CRI_3DLUT_SIZE * 3);
+        EXPECT_EQ(MOS_STATUS_SUCCESS, GenerateColorTransfer3dLut(m_param, m_target, inputFormat, lut.data()));
+        return lut;
+    }
+
+    HDRLITE_LAYER_PARAM m_param  = {};
+    HDR_PARAMS          m_target = {};
+};
+
+TEST_F(VpHdrLite3DLutCacheTest, SameParamsReuseTheLut)
+{
+    m_target.white_point_x = 15635;
+
+    shared_ptr<const Lut> lut = Get();
+    EXPECT_EQ(Generate(), *lut);
+    EXPECT_EQ(lut, Get());
+
+    // Only packed input changes the prior CSC
+    EXPECT_EQ(lut, Get(Format_P016));
+    shared_ptr<const Lut> packed = Get(Format_AYUV);
+    EXPECT_NE(lut, packed);
+    EXPECT_EQ(Generate(Format_AYUV), *packed);
+}
+
+TEST_F(VpHdrLite3DLutCacheTest, ChangedParamsGenerateAnotherLut)
+{
+    m_target.white_point_x    = 15636;
+    shared_ptr<const Lut> lut = Get();
+
+    m_param.HdrMode = VPHAL_HDR_MODE_TONE_MAPPING_AUTO_MODE;
+    shared_ptr<const Lut> autoMode = Get();
+    EXPECT_NE(lut, autoMode);
+    EXPECT_EQ(Generate(), *autoMode);
+    m_param.HdrMode = VPHAL_HDR_MODE_TONE_MAPPING;
+
+    // Another monitor gamut needs another LUT
+    m_target.display_primaries_x[1] = 7501;
+    shared_ptr<const Lut> gamut     = Get();
+    EXPECT_NE(lut, gamut);
+    EXPECT_EQ(Generate(), *gamut);
+}
+
+TEST_F(VpHdrLite3DLutCacheTest, GamutWithoutMonitorCcmKeepsTheLut)
+{
+    m_param.CCMExt1                   = VPHAL_HDR_CCM_NONE;
+    m_param.CCMExt2                   = VPHAL_HDR_CCM_NONE;
+    m_param.stageEnable.CCMExt1Enable = 0;
+    m_param.stageEnable.CCMExt2Enable = 0;
+
+    // A new mastering display does not change the LUT
+    m_target.white_point_x    = 15637;
+    shared_ptr<const Lut> lut = Get();
+    m_target.white_point_x    = 15638;
+    EXPECT_EQ(lut, Get());
+}
+
+TEST_F(VpHdrLite3DLutCacheTest, EvictsLeastRecentlyUsed)
+{
+    const uint32_t                entryNum = VpHdrLite3DLutCache::m_maxEntryNum;
+    vector<shared_ptr<const Lut>> luts;
+
+    // Fill the cache with LUTs of this test only
+    for (uint32_t i = 0; i <= entryNum; i++)
+    {
+        m_target.white_point_x = 20000 + i;
+        luts.push_back(Get());
+        if (i == 0)
+        {
+            continue;
+        }
+        // The first one becomes the most recent, the second one the oldest
+        m_target.white_point_x = 20000;
+        EXPECT_EQ(luts[0], Get());
+    }
+
+    m_target.white_point_x = 20001;
+    shared_ptr<const Lut> evicted = Get();
+    EXPECT_NE(luts[1], evicted);
+    EXPECT_EQ(*luts[1], *evicted);
+
+    m_target.white_point_x = 20000;
+    EXPECT_EQ(luts[0], Get());
+    m_target.white_point_x = 20000 + entryNum;
+    EXPECT_EQ(luts[entryNum], Get());
+}
@@ -0,0 +1,371 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <math.h>
+#include <array>
+#include <vector>
+#include "gtest/gtest.h"
+#include "vp_hdrlite_render_filter.h"
+
+using namespace std;
+using namespace vp;
+
+// The whole LUT generator is checked bit for bit against the per entry generator
+// it replaced. The reference below is that generator, called once per entry with
+// the grid coordinates the render filter used to pass in.
+class VpHdrLite3DLutGenerateTest : public testing::Test, protected VpHdrLiteRenderFilter
+{
+protected:
+    static const uint32_t m_lutSize  = VPHAL_HDR_CRI_3DLUT_SIZE;
+    static const uint32_t m_entryNum = m_lutSize * m_lutSize * m_lutSize;
+
+    VpHdrLite3DLutGenerateTest() : VpHdrLiteRenderFilter(nullptr)
+    {
+    }
+
+    // HDR10 to SDR the way InitLayerParam sets it up for a P010 layer
+    void SetUp() override
+    {
+        m_param.PriorCSC  = VPHAL_HDR_CSC_YUV_TO_RGB_BT2020;
+        m_param.EOTFGamma = VPHAL_GAMMA_SMPTE_ST2084;
+        m_param.CCM       = VPHAL_HDR_CCM_BT2020_TO_BT601_BT709_MATRIX;
+        m_param.HdrMode   = VPHAL_HDR_MODE_TONE_MAPPING;
+        m_param.OETFGamma = VPHAL_GAMMA_SRGB;
+        m_param.PostCSC   = VPHAL_HDR_CSC_RGB_TO_YUV_BT709;
+
+        m_param.stageEnable.PriorCSCEnable = 1;
+        m_param.stageEnable.EOTFEnable     = 1;
+        m_param.stageEnable.CCMEnable      = 1;
+        m_param.stageEnable.PWLFEnable     = 1;
+        m_param.stageEnable.OETFEnable     = 1;
+        m_param.stageEnable.PostCSCEnable  = 1;
+
+        // DCI-P3 D65 display, in units of 0.00002 as the SEI carries them
+        m_target.display_primaries_x[0] = 13250;
+        m_target.display_primaries_y[0] = 34500;
+        m_target.display_primaries_x[1] = 7500;
+        m_target.display_primaries_y[1] = 3000;
+        m_target.display_primaries_x[2] = 34000;
+        m_target.display_primaries_y[2] = 16000;
+        m_target.white_point_x          = 15635;
+        m_target.white_point_y          = 16450;
+    }
+
+    static double Eotf(VPHAL_GAMMA_TYPE gamma, double result)
+    {
+        double m1 = 0.1593017578125;  // SMPTE ST2084 EOTF parameters
+        double m2 = 78.84375;         // SMPTE ST2084 EOTF parameters
+        double c2 = 18.8515625;       // SMPTE ST2084 EOTF parameters
+        double c3 = 18.6875;          // SMPTE ST2084 EOTF parameters
+        double c1 = c3 - c2 + 1;      // SMPTE ST2084 EOTF parameters
+
+        if (gamma == VPHAL_GAMMA_TRADITIONAL_GAMMA)
+        {
+            if (result < 0.081)
+            {
+                result = result / 4.5;
+            }
+            else
+            {
+                result = (result + 0.099) / 1.099;
+                result = pow(result, 1.0 / 0.45);
+            }
+        }
+        else if (gamma == VPHAL_GAMMA_SMPTE_ST2084)
+        {
+            double temp = 0;
+
+            result = pow(result, 1.0f / m2);
+            temp   = c2 - c3 * result;
+            result = result > c1 ? result - c1 : 0;
+            result = result / temp;
+            result = pow(result, 1.0f / m1);
+        }
+        else if (gamma == VPHAL_GAMMA_BT1886)
+        {
+            result = (result < -0.0f) ? 0 : pow(result, 2.4);
+        }
+        return result;
+    }
+
+    static double Oetf(VPHAL_GAMMA_TYPE gamma, double result)
+    {
+        double m1 = 0.1593017578125;  // SMPTE ST2084 EOTF parameters
+        double m2 = 78.84375;         // SMPTE ST2084 EOTF parameters
+        double c2 = 18.8515625;       // SMPTE ST2084 EOTF parameters
+        double c3 = 18.6875;          // SMPTE ST2084 EOTF parameters
+        double c1 = c3 - c2 + 1;      // SMPTE ST2084 EOTF parameters
+
+        if (gamma == VPHAL_GAMMA_TRADITIONAL_GAMMA)
+        {
+            if (result < 0.018)
+            {
+                result = 4.5 * result;
+            }
+            else
+            {
+                result = pow(result, 0.45);
+                result = 1.099 * result - 0.099;
+            }
+        }
+        else if (gamma == VPHAL_GAMMA_SMPTE_ST2084)
+        {
+            result = pow(result, m1);
+            result = (c1 + c2 * result) / (1 + c3 * result);
+            result = pow(result, m2);
+        }
+        else if (gamma == VPHAL_GAMMA_SRGB)
+        {
+            if (result < 0.0031308f)
+            {
+                result = 12.92 * result;
+            }
+            else
+            {
+                result = pow(result, (double)(1.0f / 2.4f));
+                result = 1.055 * result - 0.055;
+            }
+        }
+        return result;
+    }
+
+    static void CcmMatrix(VPHAL_HDR_CCM_TYPE ccmType, bool monitorGamut, HDR_PARAMS &target, array<float, 12> &matrix)
+    {
+        matrix = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+        if (ccmType == VPHAL_HDR_CCM_BT601_BT709_TO_BT2020_MATRIX)
+        {
+            matrix = {0.627404078626f, 0.329282097415f, 0.043313797587f, 0.000000f, 0.069097233123f, 0.919541035593f, 0.011361189924f, 0.000000f, 0.016391587664f, 0.088013255546f, 0.895595009604f, 0.000000f};
+        }
+        else if (ccmType == VPHAL_HDR_CCM_BT2020_TO_BT601_BT709_MATRIX)
+        {
+            matrix = {1.660490254890140f, -0.587638564717282f, -0.072851975229213f, 0.000000f, -0.124550248621850f, 1.132898753013895f, -0.008347895599309f, 0.000000f, -0.018151059958635f, -0.100578696221493f, 1.118729865913540f, 0.000000f};
+        }
+        else if (monitorGamut &&
+                 (ccmType == VPHAL_HDR_CCM_BT2020_TO_MONITOR_MATRIX ||
+                  ccmType == VPHAL_HDR_CCM_MONITOR_TO_BT2020_MATRIX ||
+                  ccmType == VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX))
+        {
+            EXPECT_EQ(MOS_STATUS_SUCCESS, CalculateCCMWithMonitorGamut(ccmType, target, matrix));
+        }
+    }
+
+    // One entry of the per entry generator, the stage clamps it had discarded
+    // their result and are left out.
+    void ReferenceEntry(MOS_FORMAT inputFormat, float inputX, float inputY, float inputZ, uint16_t *output)
+    {
+        HDRStageEnables &stageEnable = m_param.stageEnable;
+
+        double resultX = (double)inputX;
+        double resultY = (double)inputY;
+        double resultZ = (double)inputZ;
+
+        if (stageEnable.PriorCSCEnable)
+        {
+            float priorCscMatrix[12] = {};
+            EXPECT_EQ(MOS_STATUS_SUCCESS, CalculateCscMatrix(m_param.PriorCSC, true, priorCscMatrix));
+
+            double tempX = resultX;
+            if (inputFormat == Format_AYUV)
+            {
+                resultX = priorCscMatrix[0] * resultY + priorCscMatrix[1] * resultZ + priorCscMatrix[2] * tempX + priorCscMatrix[3];
+                resultY = priorCscMatrix[4] * resultY + priorCscMatrix[5] * resultZ + priorCscMatrix[6] * tempX + priorCscMatrix[7];
+                resultZ = priorCscMatrix[8] * resultY + priorCscMatrix[9] * resultZ + priorCscMatrix[10] * tempX + priorCscMatrix[11];
+            }
+            else
+            {
+                resultX = priorCscMatrix[0] * resultZ + priorCscMatrix[1] * resultY + priorCscMatrix[2] * tempX + priorCscMatrix[3];
+                resultY = priorCscMatrix[4] * resultZ + priorCscMatrix[5] * resultY + priorCscMatrix[6] * tempX + priorCscMatrix[7];
+                resultZ = priorCscMatrix[8] * resultZ + priorCscMatrix[9] * resultY + priorCscMatrix[10] * tempX + priorCscMatrix[11];
+            }
+        }
+
+        if (stageEnable.EOTFEnable)
+        {
+            resultX = Eotf(m_param.EOTFGamma, resultX);
+            resultY = Eotf(m_param.EOTFGamma, resultY);
+            resultZ = Eotf(m_param.EOTFGamma, resultZ);
+        }
+
+        if (stageEnable.CCMEnable)
+        {
+            array<float, 12> matrix = {};
+            CcmMatrix(m_param.CCM, false, m_target, matrix);
+
+            double tempX = resultX;
+            double tempY = resultY;
+            double tempZ = resultZ;
+
+            resultX = matrix[0] * tempX + matrix[1] * tempY + matrix[2] * tempZ + matrix[3];
+            resultY = matrix[4] * tempX + matrix[5] * tempY + matrix[6] * tempZ + matrix[7];
+            resultZ = matrix[8] * tempX + matrix[9] * tempY + matrix[10] * tempZ + matrix[11];
+        }
+
+        if (stageEnable.PWLFEnable)
+        {
+            EXPECT_EQ(MOS_STATUS_SUCCESS, CaluclateToneMapping3DLut(m_param.HdrMode, resultX, resultY, resultZ, resultX, resultY, resultZ));
+        }
+
+        if (stageEnable.CCMExt1Enable)
+        {
+            array<float, 12> matrix = {};
+            CcmMatrix(m_param.CCMExt1, true, m_target, matrix);
+
+            resultX = matrix[0] * resultX + matrix[1] * resultY + matrix[2] * resultZ + matrix[3];
+            resultY = matrix[4] * resultX + matrix[5] * resultY + matrix[6] * resultZ + matrix[7];
+            resultZ = matrix[8] * resultX + matrix[9] * resultY + matrix[10] * resultZ + matrix[11];
+        }
+
+        if (stageEnable.CCMExt2Enable)
+        {
+            array<float, 12> matrix = {};
+            CcmMatrix(m_param.CCMExt2, true, m_target, matrix);
+
+            double tempX = resultX;
+            double tempY = resultY;
+            double tempZ = resultZ;
+
+            resultX = matrix[0] * tempX + matrix[1] * tempY + matrix[2] * tempZ + matrix[3];
+            resultY = matrix[4] * tempX + matrix[5] * tempY + matrix[6] * tempZ + matrix[7];
+            resultZ = matrix[8] * tempX + matrix[9] * tempY + matrix[10] * tempZ + matrix[11];
+        }
+
+        if (m_param.OETFGamma != VPHAL_GAMMA_NONE)
+        {
+            resultX = Oetf(m_param.OETFGamma, resultX);
+            resultY = Oetf(m_param.OETFGamma, resultY);
+            resultZ = Oetf(m_param.OETFGamma, resultZ);
+        }
+
+        if (m_param.PostCSC != VPHAL_HDR_CSC_NONE)
+        {
+            float postCscMatrix[12] = {};
+            EXPECT_EQ(MOS_STATUS_SUCCESS, CalculateCscMatrix(m_param.PostCSC, true, postCscMatrix));
+
+            double tempX = resultX;
+            double tempY = resultY;
+            double tempZ = resultZ;
+
+            resultX = postCscMatrix[0] * tempX + postCscMatrix[1] * tempY + postCscMatrix[2] * tempZ + postCscMatrix[3];
+            resultY = postCscMatrix[4] * tempX + postCscMatrix[5] * tempY + postCscMatrix[6] * tempZ + postCscMatrix[7];
+            resultZ = postCscMatrix[8] * tempX + postCscMatrix[9] * tempY + postCscMatrix[10] * tempZ + postCscMatrix[11];
+        }
+
+        output[0] = (uint16_t)(resultX * 65535.0f + 0.5f);
+        output[1] = (uint16_t)(resultY * 65535.0f + 0.5f);
+        output[2] = (uint16_t)(resultZ * 65535.0f + 0.5f);
+    }
+
+    // Fills the LUT in the order InitLayerCri3DLut used to
+    vector<uint16_t> ReferenceLut(MOS_FORMAT inputFormat)
+    {
+        vector<uint16_t> lut(m_entryNum * 3);
+        uint16_t        *dst = lut.data();
+        for (uint32_t i = 0; i < m_lutSize; i++)
+        {
+            for (uint32_t j = 0; j < m_lutSize; j++)
+            {
+                for (uint32_t k = 0; k < m_lutSize; k++)
+                {
+                    ReferenceEntry(inputFormat,
+                        (float)k / (float)(m_lutSize - 1),
+                        (float)j / (float)(m_lutSize - 1),
+                        (float)i / (float)(m_lutSize - 1),
+                        dst);
+                    dst += 3;
+                }
+            }
+        }
+        return lut;
+    }
+
+    void ExpectSameLut(MOS_FORMAT inputFormat)
+    {
+        vector<uint16_t> lut(m_entryNum * 3, 0xdead);
+        ASSERT_EQ(MOS_STATUS_SUCCESS, GenerateColorTransfer3dLut(m_param, m_target, inputFormat, lut.data()));
+
+        vector<uint16_t> reference = ReferenceLut(inputFormat);
+        uint32_t         mismatch  = 0;
+        for (uint32_t n = 0; n < reference.size(); n++)
+        {
+            if (lut[n] != reference[n] && mismatch++ < 8)
+            {
+                ADD_FAILURE() << "entry " << n / 3 << " channel " << n % 3 << ": " << lut[n] << " != " << reference[n];
+            }
+        }
+        EXPECT_EQ(0u, mismatch);
+    }
+
+    HDRLITE_LAYER_PARAM m_param  = {};
+    HDR_PARAMS          m_target = {};
+};
+
+TEST_F(VpHdrLite3DLutGenerateTest, Hdr10ToSdr)
+{
+    ExpectSameLut(Format_P010);
+}
+
+TEST_F(VpHdrLite3DLutGenerateTest, Hdr10ToSdrPackedInput)
+{
+    // AYUV swaps the prior CSC input channels
+    ExpectSameLut(Format_AYUV);
+}
+
+TEST_F(VpHdrLite3DLutGenerateTest, AutoModeToneMapping)
+{
+    m_param.HdrMode   = VPHAL_HDR_MODE_TONE_MAPPING_AUTO_MODE;
+    m_param.OETFGamma = VPHAL_GAMMA_TRADITIONAL_GAMMA;
+    ExpectSameLut(Format_P010);
+}
+
+TEST_F(VpHdrLite3DLutGenerateTest, RgbOutput)
+{
+    m_param.PostCSC                   = VPHAL_HDR_CSC_NONE;
+    m_param.stageEnable.PostCSCEnable = 0;
+    ExpectSameLut(Format_P010);
+}
+
+TEST_F(VpHdrLite3DLutGenerateTest, MonitorGamut)
+{
+    m_param.CCMExt1                   = VPHAL_HDR_CCM_BT2020_TO_MONITOR_MATRIX;
+    m_param.CCMExt2                   = VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX;
+    m_param.stageEnable.CCMExt1Enable = 1;
+    m_param.stageEnable.CCMExt2Enable = 1;
+    ExpectSameLut(Format_P010);
+}
+
+TEST_F(VpHdrLite3DLutGenerateTest, RgbInput)
+{
+    // Without prior CSC the EOTF is taken per axis value
+    m_param.PriorCSC                   = VPHAL_HDR_CSC_NONE;
+    m_param.stageEnable.PriorCSCEnable = 0;
+    ExpectSameLut(Format_R10G10B10A2);
+}
+
+TEST_F(VpHdrLite3DLutGenerateTest, InvalidGamma)
+{
+    vector<uint16_t> lut(m_entryNum * 3);
+    m_param.EOTFGamma = VPHAL_GAMMA_SRGB;
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, GenerateColorTransfer3dLut(m_param, m_target, Format_P010, lut.data()));
+
+    m_param.EOTFGamma = VPHAL_GAMMA_SMPTE_ST2084;
+    m_param.OETFGamma = VPHAL_GAMMA_BT1886;
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, GenerateColorTransfer3dLut(m_param, m_target, Format_P010, lut.data()));
+}
@@ -70,20 +70,18 @@ MOS_STATUS HevcPipelineM12::Init(void *settings)
     DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, hevcLongPacketId), m_hevcDecodePktLong));
     DECODE_CHK_STATUS(m_hevcDecodePktLong->Init());
 
-    auto hevcDecodePktFrontEnd = MOS_New(HevcDecodeFrontEndPktM12, this, m_task, m_hwInterface);
-    DECODE_CHK_NULL(hevcDecodePktFrontEnd);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, hevcFrontEndPacketId), hevcDecodePktFrontEnd));
-    DECODE_CHK_STATUS(hevcDecodePktFrontEnd->Init());
-
-    auto hevcDecodePktBackEnd = MOS_New(HevcDecodeBackEndPktM12, this, m_task, m_hwInterface);
-    DECODE_CHK_NULL(hevcDecodePktBackEnd);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, hevcBackEndPacketId), hevcDecodePktBackEnd));
-    DECODE_CHK_STATUS(hevcDecodePktBackEnd->Init());
-
-    auto hevcDecodePktRealTile = MOS_New(HevcDecodeRealTilePktM12, this, m_task, m_hwInterface);
-    DECODE_CHK_NULL(hevcDecodePktRealTile);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, hevcRealTilePacketId), hevcDecodePktRealTile));
-    DECODE_CHK_STATUS(hevcDecodePktRealTile->Init());
+    // Scalable decode packets are only used by multi-pipe streams, create them on first use
+    RegisterPacket(DecodePacketId(this, hevcFrontEndPacketId), [this]() -> MediaPacket * {
+        return MOS_New(HevcDecodeFrontEndPktM12, this, m_task, m_hwInterface);
+    });
+
+    RegisterPacket(DecodePacketId(this, hevcBackEndPacketId), [this]() -> MediaPacket * {
+        return MOS_New(HevcDecodeBackEndPktM12, this, m_task, m_hwInterface);
+    });
+
+    RegisterPacket(DecodePacketId(this, hevcRealTilePacketId), [this]() -> MediaPacket * {
+        return MOS_New(HevcDecodeRealTilePktM12, this, m_task, m_hwInterface);
+    });
 
     if (m_numVdbox == 2)
     {
@@ -49,6 +49,11 @@ protected:
 
 public:
     Impl(PMOS_INTERFACE osItf) : base_t(osItf){};
+
+    std::shared_ptr<mhw::vdbox::hcp::Itf> CreateInstance() override
+    {
+        return std::make_shared<Impl>(this->m_osItf);
+    }
 MEDIA_CLASS_DEFINE_END(mhw__vdbox__hcp__xe2_lpm_base__xe2_lpm__Impl)
 };
 }  // namespace xe2_lpm
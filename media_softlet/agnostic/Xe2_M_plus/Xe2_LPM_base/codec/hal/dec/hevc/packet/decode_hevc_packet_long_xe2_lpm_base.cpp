@@ -34,12 +34,25 @@
 #include "hal_oca_interface_next.h"
 #include "mhw_vdbox_xe2_lpm_base.h"
 #include "mhw_mi_hwcmd_xe2_lpm_base_next.h"
+#include "mos_worker_pool.h"
 
 using namespace mhw::vdbox::xe2_lpm_base;
 
 namespace decode
 {
 
+HevcDecodeLongPktXe2_Lpm_Base::~HevcDecodeLongPktXe2_Lpm_Base()
+{
+    MOS_Delete(m_sliceCmdBuilder);
+
+    for (auto &worker : m_sliceBuildWorkers)
+    {
+        MOS_Delete(worker.slicePkt);
+        MOS_Delete(worker.tilePkt);
+    }
+    m_sliceBuildWorkers.clear();
+}
+
 MOS_STATUS HevcDecodeLongPktXe2_Lpm_Base::Init()
 {
     DECODE_FUNC_CALL();
@@ -52,9 +65,104 @@ MOS_STATUS HevcDecodeLongPktXe2_Lpm_Base::Init()
     m_tilePkt = dynamic_cast<HevcDecodeTilePktXe2_Lpm_Base*>(subPacket);
     DECODE_CHK_NULL(m_tilePkt);
 
+    DECODE_CHK_STATUS(InitParallelSliceBuild());
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcDecodeLongPktXe2_Lpm_Base::InitParallelSliceBuild()
+{
+    DECODE_FUNC_CALL();
+
+    if (m_hevcPipeline->IsShortFormat())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // 1 (default) keeps slice commands on the submit thread, 0 picks the range number
+    // from the threads of the shared MOS worker pool.
+    uint32_t rangeNum = ReadUserFeature(m_hevcPipeline->GetUserSetting(), "HEVC Decode Slice Build Threads", MediaUserSetting::Group::Sequence).Get<uint32_t>();
+    if (rangeNum == 0)
+    {
+        rangeNum = MOS_MIN(MosWorkerPool::GetMaxThreadNum() / 2, 4u);
+    }
+    rangeNum = rangeNum > m_maxSliceBuildRanges ? (uint32_t)m_maxSliceBuildRanges : rangeNum;
+    if (rangeNum <= 1)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Every range needs its own HCP interface since command parameters
+    // live in the interface. Platforms which cannot provide one stay serial.
+    auto hcpItf = std::static_pointer_cast<mhw::vdbox::hcp::Itf>(m_hwInterface->GetHcpInterfaceNext());
+    DECODE_CHK_NULL(hcpItf);
+
+    for (uint32_t i = 1; i < rangeNum; i++)
+    {
+        std::shared_ptr<mhw::vdbox::hcp::Itf> workerHcpItf = hcpItf->CreateInstance();
+        if (workerHcpItf == nullptr)
+        {
+            break;
+        }
+
+        SliceBuildWorker worker;
+        worker.slicePkt = MOS_New(HevcDecodeSlcPktXe2_Lpm_Base, m_hevcPipeline, m_hwInterface);
+        worker.tilePkt  = MOS_New(HevcDecodeTilePktXe2_Lpm_Base, m_hevcPipeline, m_hwInterface);
+        m_sliceBuildWorkers.push_back(worker);
+        DECODE_CHK_NULL(worker.slicePkt);
+        DECODE_CHK_NULL(worker.tilePkt);
+
+        worker.slicePkt->SetHcpInterface(workerHcpItf);
+        worker.tilePkt->SetHcpInterface(workerHcpItf);
+        DECODE_CHK_STATUS(worker.slicePkt->Init());
+        DECODE_CHK_STATUS(worker.tilePkt->Init());
+    }
+
+    if (m_sliceBuildWorkers.empty())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    m_sliceCmdBuilder = MOS_New(DecodeParallelCmdBuilder, (uint32_t)m_sliceBuildWorkers.size() + 1, (uint32_t)m_minSlicesPerBuildRange);
+    DECODE_CHK_NULL(m_sliceCmdBuilder);
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    bool verify = ReadUserFeature(m_hevcPipeline->GetUserSetting(), "HEVC Decode Slice Build Verify", MediaUserSetting::Group::Sequence).Get<bool>();
+    m_sliceCmdBuilder->SetVerifyMode(verify);
+#endif
+
     return MOS_STATUS_SUCCESS;
 }
 
+bool HevcDecodeLongPktXe2_Lpm_Base::IsParallelSliceBuildAllowed()
+{
+    if (m_sliceCmdBuilder == nullptr)
+    {
+        return false;
+    }
+
+    if (m_hevcBasicFeature->m_numSlices < 2 * m_minSlicesPerBuildRange)
+    {
+        return false;
+    }
+
+    // Decode CP programs slice state through its own interface, which is shared.
+    if (m_hevcPipeline->GetDecodeCp() != nullptr)
+    {
+        return false;
+    }
+
+#if MHW_HWCMDPARSER_ENABLED
+    // The command parser records commands in a global instance.
+    if (mhw::HwcmdParser::GetInstance() != nullptr)
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
 MOS_STATUS HevcDecodeLongPktXe2_Lpm_Base::Submit(
     MOS_COMMAND_BUFFER* cmdBuffer,
     uint8_t packetPhase)
@@ -184,7 +292,71 @@ MOS_STATUS HevcDecodeLongPktXe2_Lpm_Base::PackSliceLevelCmds(MOS_COMMAND_BUFFER
     sliceLevelCmdBuffer.pCmdPtr    = sliceLevelCmdBuffer.pCmdBase;
     sliceLevelCmdBuffer.iRemaining = batchBuffer->iSize;
 
+    uint32_t numSlices = m_hevcBasicFeature->m_numSlices;
+
+    if (IsParallelSliceBuildAllowed())
+    {
+        // Worker packets are not registered to the sub packet manager, refresh them here.
+        for (auto &worker : m_sliceBuildWorkers)
+        {
+            DECODE_CHK_STATUS(worker.slicePkt->Prepare());
+            DECODE_CHK_STATUS(worker.tilePkt->Prepare());
+        }
+
+        auto buildSlices = [this](uint32_t rangeIdx, MOS_COMMAND_BUFFER &buffer, uint32_t begin, uint32_t end) -> MOS_STATUS {
+            if (rangeIdx == 0)
+            {
+                return PackSliceRange(buffer, *m_slicePkt, *m_tilePkt, begin, end);
+            }
+            SliceBuildWorker &worker = m_sliceBuildWorkers[rangeIdx - 1];
+            return PackSliceRange(buffer, *worker.slicePkt, *worker.tilePkt, begin, end);
+        };
+        DECODE_CHK_STATUS(m_sliceCmdBuilder->Build(sliceLevelCmdBuffer, numSlices, GetMaxSliceCmdSize(), buildSlices));
+    }
+    else
+    {
+        DECODE_CHK_STATUS(PackSliceRange(sliceLevelCmdBuffer, *m_slicePkt, *m_tilePkt, 0, numSlices));
+    }
+
+    DECODE_CHK_STATUS(m_miItf->AddMiBatchBufferEnd(&sliceLevelCmdBuffer, nullptr));
+    return MOS_STATUS_SUCCESS;
+}
+
+uint32_t HevcDecodeLongPktXe2_Lpm_Base::GetMaxSliceCmdSize()
+{
+    uint32_t sliceStatesSize    = 0;
+    uint32_t slicePatchListSize = 0;
+    if (m_slicePkt->CalculateCommandSize(sliceStatesSize, slicePatchListSize) != MOS_STATUS_SUCCESS)
+    {
+        return 0;
+    }
+    if (m_hevcPipeline->GetDecodeMode() != HevcPipeline::separateTileDecodeMode)
+    {
+        return sliceStatesSize;
+    }
+
+    // A slice is programmed once per tile it covers, each time possibly after the
+    // tile commands, which are budgeted as one more slice state.
+    uint32_t maxSubStreams = 1;
     for (uint32_t i = 0; i < m_hevcBasicFeature->m_numSlices; i++)
+    {
+        const HevcTileCoding::SliceTileInfo *sliceTileInfo = m_hevcBasicFeature->m_tileCoding.GetSliceTileInfo(i);
+        if (sliceTileInfo != nullptr)
+        {
+            maxSubStreams = MOS_MAX(maxSubStreams, (uint32_t)sliceTileInfo->numTiles);
+        }
+    }
+    return 2 * maxSubStreams * sliceStatesSize;
+}
+
+MOS_STATUS HevcDecodeLongPktXe2_Lpm_Base::PackSliceRange(
+    MOS_COMMAND_BUFFER            &cmdBuffer,
+    HevcDecodeSlcPkt              &slicePkt,
+    HevcDecodeTilePktXe2_Lpm_Base &tilePkt,
+    uint32_t                       sliceBegin,
+    uint32_t                       sliceEnd)
+{
+    for (uint32_t i = sliceBegin; i < sliceEnd; i++)
     {
         if (m_hevcPipeline->GetDecodeMode() == HevcPipeline::separateTileDecodeMode)
         {
@@ -210,20 +382,18 @@ MOS_STATUS HevcDecodeLongPktXe2_Lpm_Base::PackSliceLevelCmds(MOS_COMMAND_BUFFER
 
                 if (sliceTileInfo->firstSliceOfTile)
                 {
-                    DECODE_CHK_STATUS(m_tilePkt->Execute(sliceLevelCmdBuffer, tileX, tileY));
+                    DECODE_CHK_STATUS(tilePkt.Execute(cmdBuffer, tileX, tileY));
                 }
-                DECODE_CHK_STATUS(m_slicePkt->Execute(sliceLevelCmdBuffer, i, j));
+                DECODE_CHK_STATUS(slicePkt.Execute(cmdBuffer, i, j));
             }
         }
         else
         {
-            DECODE_CHK_STATUS(m_slicePkt->Execute(sliceLevelCmdBuffer, i, 0));
+            DECODE_CHK_STATUS(slicePkt.Execute(cmdBuffer, i, 0));
         }
     }
 
-    DECODE_CHK_STATUS(m_miItf->AddMiBatchBufferEnd(&sliceLevelCmdBuffer, nullptr));
     return MOS_STATUS_SUCCESS;
 }
 
 }
-
@@ -29,6 +29,8 @@
 
 #include "decode_hevc_packet_long.h"
 #include "decode_hevc_tile_packet_xe2_lpm_base.h"
+#include "decode_hevc_slice_packet_xe2_lpm_base.h"
+#include "decode_parallel_cmd_builder.h"
 #include "codec_hw_xe2_lpm_base.h"
 
 namespace decode
@@ -45,7 +47,7 @@ public:
         m_vdencItf    = std::static_pointer_cast<mhw::vdbox::vdenc::Itf>(m_hwInterface->GetVdencInterfaceNext());
     }
 
-    virtual ~HevcDecodeLongPktXe2_Lpm_Base() {}
+    virtual ~HevcDecodeLongPktXe2_Lpm_Base();
 
     //!
     //! \brief  Initialize the media packet, allocate required resources
@@ -67,12 +69,51 @@ public:
 protected:
     MOS_STATUS PackPictureLevelCmds(MOS_COMMAND_BUFFER &cmdBuffer);
     MOS_STATUS PackSliceLevelCmds(MOS_COMMAND_BUFFER &cmdBuffer);
+    MOS_STATUS PackSliceRange(
+        MOS_COMMAND_BUFFER            &cmdBuffer,
+        HevcDecodeSlcPkt              &slicePkt,
+        HevcDecodeTilePktXe2_Lpm_Base &tilePkt,
+        uint32_t                       sliceBegin,
+        uint32_t                       sliceEnd);
     MOS_STATUS VdMemoryFlush(MOS_COMMAND_BUFFER &cmdBuffer);
     MOS_STATUS VdPipelineFlush(MOS_COMMAND_BUFFER &cmdBuffer);
 
+    //!
+    //! \brief  Create the slice packets and HCP interfaces used by slice build ranges
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS InitParallelSliceBuild();
+
+    //!
+    //! \brief  Largest command size of one slice of the current frame
+    //! \return uint32_t
+    //!         Size in bytes, 0 if unknown
+    //!
+    uint32_t GetMaxSliceCmdSize();
+
+    //!
+    //! \brief  Check if slice level commands of current frame can be built in parallel
+    //! \return bool
+    //!         True if the slices are built on the worker pool
+    //!
+    bool IsParallelSliceBuildAllowed();
+
+    struct SliceBuildWorker
+    {
+        HevcDecodeSlcPktXe2_Lpm_Base  *slicePkt = nullptr;
+        HevcDecodeTilePktXe2_Lpm_Base *tilePkt  = nullptr;
+    };
+
+    static const uint32_t m_maxSliceBuildRanges     = 8;
+    static const uint32_t m_minSlicesPerBuildRange  = 16;  //!< Below this the hand-off costs more than it saves
+
     CodechalHwInterfaceXe2_Lpm_Base *m_hwInterface = nullptr;
     HevcDecodeTilePktXe2_Lpm_Base   *m_tilePkt     = nullptr;
 
+    DecodeParallelCmdBuilder     *m_sliceCmdBuilder = nullptr;  //!< Null if slices are always built serially
+    std::vector<SliceBuildWorker> m_sliceBuildWorkers;          //!< Packets of build ranges 1..N-1
+
 MEDIA_CLASS_DEFINE_END(decode__HevcDecodeLongPktXe2_Lpm_Base)
 };
 
@@ -102,6 +102,16 @@ public:
         uint32_t &commandBufferSize,
         uint32_t &requestedPatchListSize) override;
 
+    //!
+    //! \brief  Set the HCP interface which tile commands are added through
+    //! \param  [in] hcpItf
+    //!         HCP interface
+    //!
+    void SetHcpInterface(std::shared_ptr<mhw::vdbox::hcp::Itf> hcpItf)
+    {
+        m_hcpItf = hcpItf;
+    }
+
 protected:
     virtual MOS_STATUS SET_HCP_TILE_CODING(uint16_t tileX, uint16_t tileY);
     virtual MOS_STATUS AddCmd_HCP_Tile_Coding(MOS_COMMAND_BUFFER &cmdBuffer, uint16_t tileX, uint16_t tileY);
@@ -115,8 +115,6 @@ namespace decode
 
         CodechalHwInterfaceXe2_Lpm_Base *m_hwInterface = nullptr;
 
-        BufferArray *m_s2lDmemBufferArray = nullptr; //!< S2L DMEM buffer array
-
     MEDIA_CLASS_DEFINE_END(decode__HucS2lPktXe2_Lpm_Base)
     };
 
@@ -50,12 +50,16 @@ MOS_STATUS MediaCopyStateXe2_Lpm::Initialize(PMOS_INTERFACE  osInterface, MhwInt
 
     MCPY_CHK_STATUS_RETURN(MediaCopyBaseState::Initialize(osInterface));
 
+    PMOS_INTERFACE     engineOsInterface   = nullptr;
+    MhwInterfacesNext *engineMhwInterfaces = nullptr;
+
     if (MEDIA_IS_SKU(pSkuTable, FtrCCSNode))
     {
         // render copy init
         if (nullptr == m_renderCopy)
         {
-            m_renderCopy = MOS_New(RenderCopyxe2_Lpm, m_osInterface, m_mhwInterfaces);
+            MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_RENDER, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+            m_renderCopy = MOS_New(RenderCopyxe2_Lpm, engineOsInterface, engineMhwInterfaces);
             MCPY_CHK_NULL_RETURN(m_renderCopy);
             MCPY_CHK_STATUS_RETURN(m_renderCopy->Initialize());
         }
@@ -68,7 +72,8 @@ MOS_STATUS MediaCopyStateXe2_Lpm::Initialize(PMOS_INTERFACE  osInterface, MhwInt
     // vebox init
     if ( nullptr == m_veboxCopyState)
     {
-        m_veboxCopyState = MOS_New(VeboxCopyStateXe2_Lpm, m_osInterface, m_mhwInterfaces);
+        MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_VEBOX, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+        m_veboxCopyState = MOS_New(VeboxCopyStateXe2_Lpm, engineOsInterface, engineMhwInterfaces);
         MCPY_CHK_NULL_RETURN(m_veboxCopyState);
         MCPY_CHK_STATUS_RETURN(m_veboxCopyState->Initialize());
     }
@@ -76,7 +81,8 @@ MOS_STATUS MediaCopyStateXe2_Lpm::Initialize(PMOS_INTERFACE  osInterface, MhwInt
     // blt copy init
     if (nullptr == m_bltCopy)
     {
-        m_bltCopy = MOS_New(BltStateXe2_Lpm, m_osInterface, m_mhwInterfaces);
+        MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_BLT, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+        m_bltCopy = MOS_New(BltStateXe2_Lpm, engineOsInterface, engineMhwInterfaces);
         MCPY_CHK_NULL_RETURN(m_bltCopy);
         MCPY_CHK_STATUS_RETURN(m_bltCopy->Initialize());
     }
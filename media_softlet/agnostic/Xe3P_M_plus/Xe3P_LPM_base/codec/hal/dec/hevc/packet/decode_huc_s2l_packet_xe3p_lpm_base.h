@@ -125,8 +125,6 @@ namespace decode
 
         HucKernelSource *m_hucKernelSource = nullptr;
 
-        BufferArray *m_s2lDmemBufferArray = nullptr; //!< S2L DMEM buffer array
-
         MOS_BUFFER *m_kernelBinBuffer = nullptr;
 
         bool m_isPpgttMode = false;
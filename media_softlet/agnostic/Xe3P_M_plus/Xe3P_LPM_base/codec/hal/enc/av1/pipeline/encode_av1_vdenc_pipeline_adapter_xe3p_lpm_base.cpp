@@ -58,6 +58,15 @@ MOS_STATUS EncodeAv1VdencPipelineAdapterXe3P_Lpm_Base::GetStatusReport(
     return m_encoder->GetStatusReport(status, numStatus);
 }
 
+MOS_STATUS EncodeAv1VdencPipelineAdapterXe3P_Lpm_Base::GetSubregionStatus(
+    uint32_t            pendingIndex,
+    void                *report)
+{
+    ENCODE_FUNC_CALL();
+
+    return m_encoder->GetSubregionStatus(pendingIndex, report);
+}
+
 MOS_STATUS EncodeAv1VdencPipelineAdapterXe3P_Lpm_Base::ResolveMetaData(PMOS_RESOURCE pInput, PMOS_RESOURCE pOutput)
 {
     ENCODE_FUNC_CALL();
@@ -41,6 +41,8 @@ public:
 
     virtual MOS_STATUS GetStatusReport(void *status, uint16_t numStatus);
 
+    virtual MOS_STATUS GetSubregionStatus(uint32_t pendingIndex, void *report);
+
     //!
     //! \brief    Resolves metadata from input to output resource
     //! \details  Resolves metadata from input resource to output resource
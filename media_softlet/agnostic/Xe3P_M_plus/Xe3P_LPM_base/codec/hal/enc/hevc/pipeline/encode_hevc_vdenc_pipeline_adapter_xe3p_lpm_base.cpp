@@ -72,6 +72,15 @@ MOS_STATUS EncodeHevcVdencPipelineAdapterXe3P_Lpm_Base::GetStatusReport(
     return m_encoder->GetStatusReport(status, numStatus);
 }
 
+MOS_STATUS EncodeHevcVdencPipelineAdapterXe3P_Lpm_Base::GetSubregionStatus(
+    uint32_t            pendingIndex,
+    void                *report)
+{
+    ENCODE_FUNC_CALL();
+
+    return m_encoder->GetSubregionStatus(pendingIndex, report);
+}
+
 void EncodeHevcVdencPipelineAdapterXe3P_Lpm_Base::Destroy()
 {
     ENCODE_FUNC_CALL();
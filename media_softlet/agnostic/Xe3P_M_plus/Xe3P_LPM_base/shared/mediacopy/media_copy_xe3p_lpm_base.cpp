@@ -49,12 +49,16 @@ MOS_STATUS MediaCopyStateXe3P_Lpm_Base::Initialize(PMOS_INTERFACE  osInterface,
 
     MCPY_CHK_STATUS_RETURN(MediaCopyBaseState::Initialize(osInterface));
 
+    PMOS_INTERFACE     engineOsInterface   = nullptr;
+    MhwInterfacesNext *engineMhwInterfaces = nullptr;
+
     if (!MEDIA_IS_SKU(pSkuTable, FtrMainCopyRemoved))
     {
         // blt copy init
         if (nullptr == m_bltCopy)
         {
-            m_bltCopy = MOS_New(BltStateXe3P_Lpm_Base, m_osInterface, m_mhwInterfaces);
+            MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_BLT, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+            m_bltCopy = MOS_New(BltStateXe3P_Lpm_Base, engineOsInterface, engineMhwInterfaces);
             MCPY_CHK_NULL_RETURN(m_bltCopy);
             MCPY_CHK_STATUS_RETURN(m_bltCopy->Initialize());
         }
@@ -67,7 +71,8 @@ MOS_STATUS MediaCopyStateXe3P_Lpm_Base::Initialize(PMOS_INTERFACE  osInterface,
     // vebox init
     if (nullptr == m_veboxCopyState)
     {
-        m_veboxCopyState = MOS_New(VeboxCopyStateXe3P_Lpm_Base, m_osInterface, m_mhwInterfaces);
+        MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_VEBOX, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+        m_veboxCopyState = MOS_New(VeboxCopyStateXe3P_Lpm_Base, engineOsInterface, engineMhwInterfaces);
         MCPY_CHK_NULL_RETURN(m_veboxCopyState);
         MCPY_CHK_STATUS_RETURN(m_veboxCopyState->Initialize());
     }
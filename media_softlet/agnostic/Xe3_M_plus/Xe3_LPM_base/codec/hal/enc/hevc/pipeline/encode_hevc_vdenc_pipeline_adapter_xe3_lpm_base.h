@@ -45,6 +45,8 @@ public:
 
     virtual MOS_STATUS GetStatusReport(void *status, uint16_t numStatus);
 
+    virtual MOS_STATUS GetSubregionStatus(uint32_t pendingIndex, void *report);
+
     virtual MOS_STATUS ResolveMetaData(PMOS_RESOURCE pInput, PMOS_RESOURCE pOutput);
 
     virtual void Destroy();
@@ -50,11 +50,15 @@ MOS_STATUS MediaCopyStateXe2_Hpm_Base::Initialize(PMOS_INTERFACE  osInterface, M
 
     MCPY_CHK_STATUS_RETURN(MediaCopyBaseState::Initialize(osInterface));
 
+    PMOS_INTERFACE     engineOsInterface   = nullptr;
+    MhwInterfacesNext *engineMhwInterfaces = nullptr;
+
     // blt copy init
     if (nullptr == m_bltState)
     {
         MOS_FUNCTION_ENTER(MOS_COMPONENT_MCPY, MOS_MCPY_SUBCOMP_SELF);
-        m_bltState = MOS_New(BltStateXe2_Hpm_Base, m_osInterface, m_mhwInterfaces);
+        MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_BLT, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+        m_bltState = MOS_New(BltStateXe2_Hpm_Base, engineOsInterface, engineMhwInterfaces);
         MCPY_CHK_NULL_RETURN(m_bltState);
         MCPY_CHK_STATUS_RETURN(m_bltState->Initialize());
     }
@@ -62,14 +66,16 @@ MOS_STATUS MediaCopyStateXe2_Hpm_Base::Initialize(PMOS_INTERFACE  osInterface, M
     // vebox init
     if ( nullptr == m_veboxCopyState)
     {
-        m_veboxCopyState = MOS_New(VeboxCopyStateXe2_Hpm_Base, m_osInterface, m_mhwInterfaces);
+        MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_VEBOX, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+        m_veboxCopyState = MOS_New(VeboxCopyStateXe2_Hpm_Base, engineOsInterface, engineMhwInterfaces);
         MCPY_CHK_NULL_RETURN(m_veboxCopyState);
         MCPY_CHK_STATUS_RETURN(m_veboxCopyState->Initialize());
     }
 
     if (nullptr == m_renderCopyState)
     {
-        m_renderCopyState = MOS_New(RenderCopyxe2_hpm_Base, m_osInterface, m_mhwInterfaces);
+        MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_RENDER, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+        m_renderCopyState = MOS_New(RenderCopyxe2_hpm_Base, engineOsInterface, engineMhwInterfaces);
         MCPY_CHK_NULL_RETURN(m_renderCopyState);
         MCPY_CHK_STATUS_RETURN(m_renderCopyState->Initialize());
     }
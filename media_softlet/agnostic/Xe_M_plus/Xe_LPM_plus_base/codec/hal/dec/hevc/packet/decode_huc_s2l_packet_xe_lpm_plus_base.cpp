@@ -38,12 +38,12 @@ namespace decode
         DECODE_CHK_STATUS(HucS2lPkt::AllocateResources());
 
         m_dmemBufferSize = MOS_ALIGN_CEIL(sizeof(HucHevcS2lBssXe_Lpm_Plus_Base), CODECHAL_CACHELINE_SIZE);
-        if (m_s2lDmemBufferArray == nullptr)
+        if (m_s2lDmemBuffer == nullptr)
         {
-            m_s2lDmemBufferArray = m_allocator->AllocateBufferArray(
+            m_s2lDmemBuffer = m_allocator->AllocateOrphanableBuffer(
                 m_dmemBufferSize, "DmemBuffer", CODECHAL_HEVC_NUM_DMEM_BUFFERS,
                 resourceInternalReadWriteCache, lockableVideoMem);
-            DECODE_CHK_NULL(m_s2lDmemBufferArray);
+            DECODE_CHK_NULL(m_s2lDmemBuffer);
         }
 
         return MOS_STATUS_SUCCESS;
@@ -53,7 +53,7 @@ namespace decode
     {
         if (m_allocator != nullptr)
         {
-            DECODE_CHK_STATUS(m_allocator->Destroy(m_s2lDmemBufferArray));
+            DECODE_CHK_STATUS(m_allocator->Destroy(m_s2lDmemBuffer));
         }
 
         DECODE_CHK_STATUS(HucS2lPkt::Destroy());
@@ -264,7 +264,6 @@ namespace decode
     {
         DECODE_FUNC_CALL();
 
-        m_s2lDmemBuffer = m_s2lDmemBufferArray->Fetch();
         DECODE_CHK_NULL(m_s2lDmemBuffer);
 
         ResourceAutoLock resLock(m_allocator, &m_s2lDmemBuffer->OsResource);
@@ -117,8 +117,6 @@ namespace decode
         MOS_STATUS VdPipelineFlush(MOS_COMMAND_BUFFER &cmdBuffer);
 
         CodechalHwInterfaceXe_Lpm_Plus_Base *m_hwInterface = nullptr;
-       
-        BufferArray *m_s2lDmemBufferArray = nullptr; //!< S2L DMEM buffer array
 
     MEDIA_CLASS_DEFINE_END(decode__HucS2lPktXe_Lpm_Plus_Base)
     };
@@ -61,20 +61,18 @@ MOS_STATUS HevcPipelineXe_Lpm_Plus_Base::Init(void *settings)
     DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, hevcLongPacketId), m_hevcDecodePktLong));
     DECODE_CHK_STATUS(m_hevcDecodePktLong->Init());
 
-    auto hevcDecodePktFrontEnd = MOS_New(HevcDecodeFrontEndPktXe_Lpm_Plus_Base, this, m_task, m_hwInterface);
-    DECODE_CHK_NULL(hevcDecodePktFrontEnd);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, hevcFrontEndPacketId), hevcDecodePktFrontEnd));
-    DECODE_CHK_STATUS(hevcDecodePktFrontEnd->Init());
-
-    auto hevcDecodePktBackEnd = MOS_New(HevcDecodeBackEndPktXe_Lpm_Plus_Base, this, m_task, m_hwInterface);
-    DECODE_CHK_NULL(hevcDecodePktBackEnd);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, hevcBackEndPacketId), hevcDecodePktBackEnd));
-    DECODE_CHK_STATUS(hevcDecodePktBackEnd->Init());
-
-    auto hevcDecodePktRealTile = MOS_New(HevcDecodeRealTilePktXe_Lpm_Plus_Base, this, m_task, m_hwInterface);
-    DECODE_CHK_NULL(hevcDecodePktRealTile);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, hevcRealTilePacketId), hevcDecodePktRealTile));
-    DECODE_CHK_STATUS(hevcDecodePktRealTile->Init());
+    // Scalable decode packets are only used by multi-pipe streams, create them on first use
+    RegisterPacket(DecodePacketId(this, hevcFrontEndPacketId), [this]() -> MediaPacket * {
+        return MOS_New(HevcDecodeFrontEndPktXe_Lpm_Plus_Base, this, m_task, m_hwInterface);
+    });
+
+    RegisterPacket(DecodePacketId(this, hevcBackEndPacketId), [this]() -> MediaPacket * {
+        return MOS_New(HevcDecodeBackEndPktXe_Lpm_Plus_Base, this, m_task, m_hwInterface);
+    });
+
+    RegisterPacket(DecodePacketId(this, hevcRealTilePacketId), [this]() -> MediaPacket * {
+        return MOS_New(HevcDecodeRealTilePktXe_Lpm_Plus_Base, this, m_task, m_hwInterface);
+    });
 
     if (m_numVdbox == 2)
     {
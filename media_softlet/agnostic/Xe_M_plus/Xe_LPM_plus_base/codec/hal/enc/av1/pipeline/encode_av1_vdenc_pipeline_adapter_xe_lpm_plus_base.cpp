@@ -66,6 +66,15 @@ MOS_STATUS EncodeAv1VdencPipelineAdapterXe_Lpm_Plus_Base::GetStatusReport(
     return m_encoder->GetStatusReport(status, numStatus);
 }
 
+MOS_STATUS EncodeAv1VdencPipelineAdapterXe_Lpm_Plus_Base::GetSubregionStatus(
+    uint32_t            pendingIndex,
+    void                *report)
+{
+    ENCODE_FUNC_CALL();
+
+    return m_encoder->GetSubregionStatus(pendingIndex, report);
+}
+
 void EncodeAv1VdencPipelineAdapterXe_Lpm_Plus_Base::Destroy()
 {
     ENCODE_FUNC_CALL();
@@ -72,6 +72,15 @@ MOS_STATUS EncodeHevcVdencPipelineAdapterXe_Lpm_Plus_Base::GetStatusReport(
     return m_encoder->GetStatusReport(status, numStatus);
 }
 
+MOS_STATUS EncodeHevcVdencPipelineAdapterXe_Lpm_Plus_Base::GetSubregionStatus(
+    uint32_t            pendingIndex,
+    void                *report)
+{
+    ENCODE_FUNC_CALL();
+
+    return m_encoder->GetSubregionStatus(pendingIndex, report);
+}
+
 void EncodeHevcVdencPipelineAdapterXe_Lpm_Plus_Base::Destroy()
 {
     ENCODE_FUNC_CALL();
@@ -47,6 +47,8 @@ public:
 
     virtual MOS_STATUS GetStatusReport(void *status, uint16_t numStatus) override;
 
+    virtual MOS_STATUS GetSubregionStatus(uint32_t pendingIndex, void *report) override;
+
     virtual void Destroy() override;
 
 protected:
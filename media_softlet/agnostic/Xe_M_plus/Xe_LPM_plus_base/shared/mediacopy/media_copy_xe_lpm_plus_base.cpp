@@ -48,12 +48,16 @@ MOS_STATUS MediaCopyStateXe_Lpm_Plus_Base::Initialize(PMOS_INTERFACE  osInterfac
 
     MCPY_CHK_STATUS_RETURN(MediaCopyBaseState::Initialize(osInterface));
 
+    PMOS_INTERFACE     engineOsInterface   = nullptr;
+    MhwInterfacesNext *engineMhwInterfaces = nullptr;
+
     if (MEDIA_IS_SKU(pSkuTable, FtrCCSNode))
     {
         // render copy init
         if (nullptr == m_renderCopy)
         {
-            m_renderCopy = MOS_New(RenderCopyXe_LPM_Plus_Base, m_osInterface, m_mhwInterfaces);
+            MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_RENDER, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+            m_renderCopy = MOS_New(RenderCopyXe_LPM_Plus_Base, engineOsInterface, engineMhwInterfaces);
             MCPY_CHK_NULL_RETURN(m_renderCopy);
             MCPY_CHK_STATUS_RETURN(m_renderCopy->Initialize());
         }
@@ -65,7 +69,8 @@ MOS_STATUS MediaCopyStateXe_Lpm_Plus_Base::Initialize(PMOS_INTERFACE  osInterfac
     // blt copy init
     if (nullptr == m_bltState)
     {
-        m_bltState = MOS_New(BltStateXe_Lpm_Plus_Base, m_osInterface, m_mhwInterfaces);
+        MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_BLT, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+        m_bltState = MOS_New(BltStateXe_Lpm_Plus_Base, engineOsInterface, engineMhwInterfaces);
         MCPY_CHK_NULL_RETURN(m_bltState);
         MCPY_CHK_STATUS_RETURN(m_bltState->Initialize());
     }
@@ -73,7 +78,8 @@ MOS_STATUS MediaCopyStateXe_Lpm_Plus_Base::Initialize(PMOS_INTERFACE  osInterfac
     // vebox init
     if ( nullptr == m_veboxCopyState)
     {
-        m_veboxCopyState = MOS_New(VeboxCopyStateXe_Lpm_Plus_Base, m_osInterface, m_mhwInterfaces);
+        MCPY_CHK_STATUS_RETURN(CreateEngineInterfaces(MCPY_ENGINE_VEBOX, m_mhwInterfaces, engineOsInterface, engineMhwInterfaces));
+        m_veboxCopyState = MOS_New(VeboxCopyStateXe_Lpm_Plus_Base, engineOsInterface, engineMhwInterfaces);
         MCPY_CHK_NULL_RETURN(m_veboxCopyState);
         MCPY_CHK_STATUS_RETURN(m_veboxCopyState->Initialize());
     }
@@ -203,6 +203,16 @@ MOS_STATUS Codechal::GetStatusReport(
     return MOS_STATUS_UNKNOWN;
 }
 
+MOS_STATUS Codechal::GetSubregionStatus(
+    uint32_t            pendingIndex,
+    void                *report)
+{
+    CODECHAL_PUBLIC_FUNCTION_ENTER;
+    MOS_UNUSED(pendingIndex);
+    MOS_UNUSED(report);
+    return MOS_STATUS_UNIMPLEMENTED;
+}
+
 void Codechal::Destroy()
 {
     CODECHAL_PUBLIC_FUNCTION_ENTER;
@@ -305,6 +305,22 @@ public:
         void                *status,
         uint16_t            numStatus);
 
+    //!
+    //! \brief    Gets the slices or tiles already encoded of a picture not reported yet
+    //! \details  Lets the application send the start of a bitstream before the whole
+    //!           picture is encoded. Only encoders with subregion report enabled support it.
+    //! \param    [in] pendingIndex
+    //!           Position of the picture among the pictures GetStatusReport did not report
+    //!           yet, 0 for the oldest one
+    //! \param    [out] report
+    //!           Pointer to encode::EncodeSubregionReport
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success else fail reason
+    //!
+    virtual MOS_STATUS GetSubregionStatus(
+        uint32_t            pendingIndex,
+        void                *report);
+
     //!
     //! \brief    Get Encode Status for Vulkan Query Pool
     //! \details  Retrieve the necessary status and results for the Vulkan query pool
@@ -67,6 +67,51 @@ namespace decode
         m_hevcRextSliceParams = m_hevcBasicFeature->m_hevcRextSliceParams;
         m_hevcSccPicParams    = m_hevcBasicFeature->m_hevcSccPicParams;
 
+        DECODE_CHK_STATUS(SetFirstInterSliceInfo());
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS HevcDecodeSlcPkt::SetFirstInterSliceInfo()
+    {
+        DECODE_FUNC_CALL();
+
+        m_firstInterSlice = {};
+
+        const int8_t *refIdxMapping = m_hevcBasicFeature->m_refFrames.m_refIdxMapping;
+
+        for (uint32_t i = 0; i < m_hevcBasicFeature->m_numSlices; i++)
+        {
+            const CODEC_HEVC_SLICE_PARAMS *sliceParams = m_hevcSliceParams + i;
+            if ((sliceParams->LongSliceFlags.fields.slice_type == SLICE_TYPE_I_SLICE) ||
+                (sliceParams->LongSliceFlags.fields.slice_temporal_mvp_enabled_flag == 0))
+            {
+                continue;
+            }
+
+            uint8_t collocatedRefIndex   = sliceParams->collocated_ref_idx;
+            uint8_t collocatedFromL0Flag = sliceParams->LongSliceFlags.fields.collocated_from_l0_flag;
+            uint8_t collocatedFrameIdx   = 0;
+            if (sliceParams->LongSliceFlags.fields.slice_type == SLICE_TYPE_P_SLICE)
+            {
+                collocatedFrameIdx = sliceParams->RefPicList[0][collocatedRefIndex].FrameIdx;
+            }
+            else if (sliceParams->LongSliceFlags.fields.slice_type == SLICE_TYPE_B_SLICE)
+            {
+                collocatedFrameIdx = sliceParams->RefPicList[!collocatedFromL0Flag][collocatedRefIndex].FrameIdx;
+            }
+
+            // An invalid mapping is reported when this slice itself is programmed.
+            if (collocatedFrameIdx < CODEC_MAX_NUM_REF_FRAME_HEVC && refIdxMapping[collocatedFrameIdx] >= 0)
+            {
+                m_firstInterSlice.collocatedRefIdx = refIdxMapping[collocatedFrameIdx];
+            }
+            m_firstInterSlice.collocatedFromL0Flag = collocatedFromL0Flag;
+            m_firstInterSlice.sliceIdx             = i;
+            m_firstInterSlice.valid                = true;
+            break;
+        }
+
         return MOS_STATUS_SUCCESS;
     }
 
@@ -274,34 +319,14 @@ namespace decode
             params.collocatedrefidx = 0;
         }
 
-        static uint8_t ucFirstInterSliceCollocatedFrameIdx   = 0;
-        static uint8_t ucFirstInterSliceCollocatedFromL0Flag = 0;
-        static bool    bFinishFirstInterSlice                = false;
-
-        // Need to save the first interSlice collocatedRefIdx value to use on subsequent intra slices
+        // Need to use the first interSlice collocatedRefIdx value on subsequent intra slices
         // this is a HW requrement as collcoated ref fetching from memory may not be complete yet
-        if (dwSliceIndex == 0)
-        {
-            ucFirstInterSliceCollocatedFrameIdx   = 0;
-            ucFirstInterSliceCollocatedFromL0Flag = 0;
-            bFinishFirstInterSlice                = false;
-        }
-
-        if ((!bFinishFirstInterSlice) &&
-            (sliceParams->LongSliceFlags.fields.slice_type != SLICE_TYPE_I_SLICE) &&
-            (sliceParams->LongSliceFlags.fields.slice_temporal_mvp_enabled_flag == 1))
-        {
-            ucFirstInterSliceCollocatedFrameIdx   = params.collocatedrefidx;
-            ucFirstInterSliceCollocatedFromL0Flag = params.collocatedFromL0Flag;
-            bFinishFirstInterSlice                = true;
-        }
-
-        if (bFinishFirstInterSlice &&
+        if (m_firstInterSlice.valid && (dwSliceIndex > m_firstInterSlice.sliceIdx) &&
             ((sliceParams->LongSliceFlags.fields.slice_type == SLICE_TYPE_I_SLICE) ||
                 (sliceParams->LongSliceFlags.fields.slice_temporal_mvp_enabled_flag == 0)))
         {
-            params.collocatedrefidx     = ucFirstInterSliceCollocatedFrameIdx;
-            params.collocatedFromL0Flag = ucFirstInterSliceCollocatedFromL0Flag;
+            params.collocatedrefidx     = m_firstInterSlice.collocatedRefIdx;
+            params.collocatedFromL0Flag = m_firstInterSlice.collocatedFromL0Flag;
         }
 
         params.sliceheaderlength = sliceParams->ByteOffsetToSliceData;
@@ -85,7 +85,28 @@ public:
         uint32_t &commandBufferSize,
         uint32_t &requestedPatchListSize) override;
 
+    //!
+    //! \brief  Set the HCP interface which slice commands are added through
+    //! \details A packet owning its own HCP interface instance can build slices
+    //!          on another thread than the packet using the shared one.
+    //! \param  [in] hcpItf
+    //!         HCP interface
+    //!
+    void SetHcpInterface(std::shared_ptr<mhw::vdbox::hcp::Itf> hcpItf)
+    {
+        m_hcpItf = hcpItf;
+    }
+
 protected:
+    //!
+    //! \brief  Find the first inter slice with temporal MVP of the frame
+    //! \details Its collocated reference is reused by the following intra slices,
+    //!          working it out up front lets slices be programmed in any order.
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS SetFirstInterSliceInfo();
+
     virtual MOS_STATUS ValidateSubTileIdx(const HevcTileCoding::SliceTileInfo &sliceTileInfo, uint32_t subTileIdx);
     MOS_STATUS AddHcpCpState(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t sliceIdx, uint32_t subTileIdx);
 
@@ -117,6 +138,15 @@ protected:
     PCODEC_HEVC_EXT_SLICE_PARAMS m_hevcRextSliceParams = nullptr;  //!< Extended slice params for Rext
     PCODEC_HEVC_SCC_PIC_PARAMS   m_hevcSccPicParams    = nullptr;  //!< Pic params for SCC
 
+    struct FirstInterSliceInfo
+    {
+        bool     valid                = false;
+        uint32_t sliceIdx             = 0;
+        uint8_t  collocatedRefIdx     = 0;
+        uint8_t  collocatedFromL0Flag = 0;
+    };
+    FirstInterSliceInfo m_firstInterSlice = {};  //!< First inter slice with temporal MVP of current frame
+
     uint32_t              m_sliceStatesSize    = 0;  //!< Slice state command size
     uint32_t              m_slicePatchListSize = 0;  //!< Slice patch list size
     static const uint32_t m_HevcSccPaletteSize = 96; //!< For HEVC SCC palette size on Gen12+
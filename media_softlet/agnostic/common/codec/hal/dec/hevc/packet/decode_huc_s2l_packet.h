@@ -226,7 +226,7 @@ namespace decode
         PCODEC_HEVC_SLICE_PARAMS   m_hevcSliceParams   = nullptr; //!< Pointer to slice parameter
         PCODEC_HEVC_SCC_PIC_PARAMS m_hevcSccPicParams  = nullptr; //!< Pic params for SCC
 
-        MOS_BUFFER*                m_s2lDmemBuffer     = nullptr; //!< Resource of current DMEM buffer
+        MOS_BUFFER*                m_s2lDmemBuffer     = nullptr; //!< S2L DMEM buffer, orphaned when busy
         MOS_BUFFER*                m_s2lControlTempMVRegionBuffer = nullptr;  //!< Point to RegionBuffer which controls temporal MV Buffer
         uint32_t                   m_dmemBufferSize    = 0;       //!< Size of DMEM buffer
         uint32_t                   m_dmemTransferSize  = 0;       //!< Transfer size of current DMEM buffer
@@ -67,7 +67,19 @@ MOS_STATUS HevcPipeline::InitUserSetting(MediaUserSettingSharedPtr userSettingPt
         MediaUserSetting::Group::Sequence,
         int32_t(0),
         true);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "HEVC Decode Slice Build Threads",
+        MediaUserSetting::Group::Sequence,
+        uint32_t(1),
+        false);
 #if (_DEBUG || _RELEASE_INTERNAL)
+    DeclareUserSettingKeyForDebug(
+        userSettingPtr,
+        "HEVC Decode Slice Build Verify",
+        MediaUserSetting::Group::Sequence,
+        int32_t(0),
+        false);
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
         "Disable HEVC Real Tile Decode",
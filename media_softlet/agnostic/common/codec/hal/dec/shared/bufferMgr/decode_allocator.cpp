@@ -62,15 +62,7 @@ MOS_BUFFER* DecodeAllocator::AllocateBuffer(
         return nullptr;
 
     MOS_ALLOC_GFXRES_PARAMS allocParams;
-    MOS_ZeroMemory(&allocParams, sizeof(MOS_ALLOC_GFXRES_PARAMS));
-    allocParams.Type            = MOS_GFXRES_BUFFER;
-    allocParams.TileType        = MOS_TILE_LINEAR;
-    allocParams.Format          = Format_Buffer;
-    allocParams.dwBytes         = sizeOfBuffer;
-    allocParams.pBufName        = nameOfBuffer;
-    allocParams.bIsPersistent   = bPersistent;
-    allocParams.ResUsageType    = static_cast<MOS_HW_RESOURCE_DEF>(resUsageType);
-    SetAccessRequirement(accessReq, allocParams);
+    SetBufferAllocParams(sizeOfBuffer, nameOfBuffer, resUsageType, accessReq, bPersistent, allocParams);
 
     MOS_BUFFER* buffer = m_allocator->AllocateBuffer(allocParams, false, COMPONENT_Decode);
     if (buffer == nullptr)
@@ -97,6 +89,28 @@ MOS_BUFFER* DecodeAllocator::AllocateBuffer(
     return buffer;
 }
 
+MOS_BUFFER* DecodeAllocator::AllocateOrphanableBuffer(
+    const uint32_t sizeOfBuffer, const char* nameOfBuffer, const uint32_t maxBackingNum,
+    ResourceUsage resUsageType, ResourceAccessReq accessReq)
+{
+    DECODE_ASSERT(accessReq != notLockableVideoMem);
+
+    MOS_BUFFER* buffer = AllocateBuffer(sizeOfBuffer, nameOfBuffer, resUsageType, accessReq);
+    if (buffer == nullptr)
+    {
+        return nullptr;
+    }
+
+    MOS_ALLOC_GFXRES_PARAMS allocParams;
+    SetBufferAllocParams(sizeOfBuffer, nameOfBuffer, resUsageType, accessReq, false, allocParams);
+    if (m_allocator->EnableOrphaning(&buffer->OsResource, allocParams, maxBackingNum) != MOS_STATUS_SUCCESS)
+    {
+        DECODE_ASSERTMESSAGE("Failed to enable orphaning of buffer %s", nameOfBuffer);
+    }
+
+    return buffer;
+}
+
 BufferArray * DecodeAllocator::AllocateBufferArray(
     const uint32_t sizeOfBuffer, const char* nameOfBuffer, const uint32_t numberOfBuffer,
     ResourceUsage resUsageType, ResourceAccessReq accessReq,
@@ -659,6 +673,20 @@ ResourceUsage DecodeAllocator::ConvertGmmResourceUsage(const GMM_RESOURCE_USAGE_
     return (ResourceUsage)gmmUsage;
 }
 
+void DecodeAllocator::SetBufferAllocParams(const uint32_t sizeOfBuffer, const char *nameOfBuffer,
+    ResourceUsage resUsageType, ResourceAccessReq accessReq, bool bPersistent, MOS_ALLOC_GFXRES_PARAMS &allocParams)
+{
+    MOS_ZeroMemory(&allocParams, sizeof(MOS_ALLOC_GFXRES_PARAMS));
+    allocParams.Type            = MOS_GFXRES_BUFFER;
+    allocParams.TileType        = MOS_TILE_LINEAR;
+    allocParams.Format          = Format_Buffer;
+    allocParams.dwBytes         = sizeOfBuffer;
+    allocParams.pBufName        = nameOfBuffer;
+    allocParams.bIsPersistent   = bPersistent;
+    allocParams.ResUsageType    = static_cast<MOS_HW_RESOURCE_DEF>(resUsageType);
+    SetAccessRequirement(accessReq, allocParams);
+}
+
 void DecodeAllocator::SetAccessRequirement(
     ResourceAccessReq accessReq, MOS_ALLOC_GFXRES_PARAMS &allocParams)
 {
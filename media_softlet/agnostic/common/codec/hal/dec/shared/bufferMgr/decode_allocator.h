@@ -111,6 +111,29 @@ public:
         ResourceUsage resUsageType = resourceDefault, ResourceAccessReq accessReq = lockableVideoMem,
         bool initOnAllocate = false, uint8_t initValue = 0, bool bPersistent = false);
 
+    //!
+    //! \brief  Allocate buffer fully rewritten by CPU for each frame
+    //! \details Write-only locks of the buffer switch to an idle allocation while the GPU
+    //!          still uses the current one, see Allocator::EnableOrphaning. It replaces a
+    //!          buffer array fetched once per frame, the buffer must only be referenced
+    //!          through its OsResource address.
+    //! \param  [in] sizeOfBuffer
+    //!         Buffer size
+    //! \param  [in] nameOfBuffer
+    //!         Buffer name
+    //! \param  [in] maxBackingNum
+    //!         Maximum number of allocations backing the buffer
+    //! \param  [in] resUsageType
+    //!         ResourceUsage to be set
+    //! \param  [in] accessReq
+    //!         Resource access requirement, must be lockable
+    //! \return MOS_BUFFER*
+    //!         return the pointer to MOS_BUFFER
+    //!
+    MOS_BUFFER* AllocateOrphanableBuffer(const uint32_t sizeOfBuffer, const char* nameOfBuffer,
+        const uint32_t maxBackingNum, ResourceUsage resUsageType = resourceDefault,
+        ResourceAccessReq accessReq = lockableVideoMem);
+
     //!
     //! \brief  Allocate buffer array
     //! \param  [in] sizeOfBuffer
@@ -548,6 +571,12 @@ protected:
     //!
     void SetAccessRequirement(ResourceAccessReq accessReq, MOS_ALLOC_GFXRES_PARAMS &allocParams);
 
+    //!
+    //! \brief   Fill the allocation parameters of a linear buffer
+    //!
+    void SetBufferAllocParams(const uint32_t sizeOfBuffer, const char *nameOfBuffer, ResourceUsage resUsageType,
+        ResourceAccessReq accessReq, bool bPersistent, MOS_ALLOC_GFXRES_PARAMS &allocParams);
+
     PMOS_INTERFACE m_osInterface = nullptr;  //!< PMOS_INTERFACE
     Allocator *m_allocator = nullptr;
     bool m_limitedLMemBar = false; //!< Indicate if running with limited LMem bar config
@@ -65,12 +65,11 @@ MOS_STATUS DecodeInputBitstream::Init(CodechalSetting& settings)
 
     HucPacketCreatorBase *hucPktCreator = dynamic_cast<HucPacketCreatorBase *>(m_pipeline);
     DECODE_CHK_NULL(hucPktCreator);
-    m_concatPkt = hucPktCreator->CreateHucCopyPkt(m_pipeline, m_task, hwInterface);  
-    DECODE_CHK_NULL(m_concatPkt);
-    MediaPacket *packet = dynamic_cast<MediaPacket *>(m_concatPkt);
-    DECODE_CHK_NULL(packet);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(m_pipeline, hucCopyPacketId), *packet));
-    DECODE_CHK_STATUS(packet->Init());
+    // Only incomplete bitstreams need the concat packet, create it on first use
+    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(m_pipeline, hucCopyPacketId), [this, hucPktCreator, hwInterface]() -> MediaPacket * {
+        m_concatPkt = hucPktCreator->CreateHucCopyPkt(m_pipeline, m_task, hwInterface);
+        return dynamic_cast<MediaPacket *>(m_concatPkt);
+    }));
 
     return MOS_STATUS_SUCCESS;
 }
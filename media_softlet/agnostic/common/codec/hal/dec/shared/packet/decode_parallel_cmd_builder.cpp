@@ -0,0 +1,163 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     decode_parallel_cmd_builder.cpp
+//! \brief    Implements the helper which builds slice/tile level commands on the MOS worker pool
+//!
+
+#include <string.h>
+#include "decode_parallel_cmd_builder.h"
+#include "decode_utils.h"
+#include "mos_worker_pool.h"
+
+namespace decode
+{
+
+DecodeParallelCmdBuilder::DecodeParallelCmdBuilder(uint32_t rangeNum, uint32_t minUnitsPerRange)
+    : m_rangeNum(MOS_MAX(rangeNum, 1)), m_minUnitsPerRange(MOS_MAX(minUnitsPerRange, 1))
+{
+    m_rangeNum = MOS_MIN(m_rangeNum, MosWorkerPool::m_maxRanges);
+    m_rangeBuffers.resize(m_rangeNum);
+    m_scratch.resize(m_rangeNum);
+}
+
+MOS_STATUS DecodeParallelCmdBuilder::BuildSerial(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t unitNum, const BuildFunc &func)
+{
+    m_serialCount++;
+    return func(0, cmdBuffer, 0, unitNum);
+}
+
+MOS_STATUS DecodeParallelCmdBuilder::Build(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t unitNum, uint32_t unitCmdSize, const BuildFunc &func)
+{
+    DECODE_FUNC_CALL();
+
+    DECODE_CHK_NULL(cmdBuffer.pCmdPtr);
+
+    uint32_t rangeNum = MOS_MIN(m_rangeNum, unitNum / m_minUnitsPerRange);
+    if (rangeNum <= 1 || cmdBuffer.iRemaining <= 0 || unitCmdSize == 0)
+    {
+        return BuildSerial(cmdBuffer, unitNum, func);
+    }
+
+    // Kept so that the destination can be rewound for the serial fallback.
+    const MOS_COMMAND_BUFFER start = cmdBuffer;
+
+    // The pool builds range 0 in place, the others write scratch buffers sized for
+    // their own units. A range outgrowing its buffer fails with NO_SPACE and the
+    // frame is rebuilt serially.
+    auto buildRange = [&](uint32_t rangeIdx, uint32_t begin, uint32_t end) -> MOS_STATUS {
+        if (rangeIdx == 0)
+        {
+            return func(0, cmdBuffer, begin, end);
+        }
+
+        uint64_t               rangeSize = MOS_MIN((uint64_t)(end - begin) * unitCmdSize, (uint64_t)start.iRemaining);
+        std::vector<uint32_t> &scratch   = m_scratch[rangeIdx];
+        if (scratch.size() < rangeSize / sizeof(uint32_t))
+        {
+            scratch.resize(rangeSize / sizeof(uint32_t));
+        }
+
+        MOS_COMMAND_BUFFER &buffer = m_rangeBuffers[rangeIdx];
+        MOS_ZeroMemory(&buffer, sizeof(buffer));
+        buffer.pCmdBase   = scratch.data();
+        buffer.pCmdPtr    = scratch.data();
+        buffer.iRemaining = (int32_t)(scratch.size() * sizeof(uint32_t));
+        return func(rangeIdx, buffer, begin, end);
+    };
+    MOS_STATUS status = MosWorkerPool::GetInstance().Run(unitNum, rangeNum, buildRange);
+
+    for (uint32_t i = 1; i < rangeNum && status == MOS_STATUS_SUCCESS; i++)
+    {
+        int32_t size = m_rangeBuffers[i].iOffset;
+        if (size > cmdBuffer.iRemaining)
+        {
+            status = MOS_STATUS_NO_SPACE;
+            break;
+        }
+        MOS_SecureMemcpy(cmdBuffer.pCmdPtr, cmdBuffer.iRemaining, m_scratch[i].data(), size);
+        cmdBuffer.pCmdPtr += size / sizeof(uint32_t);
+        cmdBuffer.iOffset += size;
+        cmdBuffer.iRemaining -= size;
+    }
+
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        DECODE_NORMALMESSAGE("Parallel command build failed (%d), rebuild serially", status);
+        cmdBuffer = start;
+        m_fallbackCount++;
+        return BuildSerial(cmdBuffer, unitNum, func);
+    }
+
+    m_parallelCount++;
+
+    if (m_verify)
+    {
+        DECODE_CHK_STATUS(Verify(cmdBuffer, start, unitNum, func));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS DecodeParallelCmdBuilder::Verify(
+    MOS_COMMAND_BUFFER       &cmdBuffer,
+    const MOS_COMMAND_BUFFER &start,
+    uint32_t                  unitNum,
+    const BuildFunc          &func)
+{
+    DECODE_FUNC_CALL();
+
+    size_t shadowSize = (size_t)start.iRemaining / sizeof(uint32_t);
+    if (m_shadow.size() < shadowSize)
+    {
+        m_shadow.resize(shadowSize);
+    }
+
+    MOS_COMMAND_BUFFER shadow;
+    MOS_ZeroMemory(&shadow, sizeof(shadow));
+    shadow.pCmdBase   = m_shadow.data();
+    shadow.pCmdPtr    = m_shadow.data();
+    shadow.iRemaining = start.iRemaining;
+    DECODE_CHK_STATUS(func(0, shadow, 0, unitNum));
+
+    int32_t parallelSize = cmdBuffer.iOffset - start.iOffset;
+    if (shadow.iOffset == parallelSize &&
+        memcmp(m_shadow.data(), start.pCmdPtr, parallelSize) == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    DECODE_ASSERTMESSAGE("Parallel command stream (%d bytes) differs from serial stream (%d bytes)",
+        parallelSize, shadow.iOffset);
+    m_mismatchCount++;
+
+    cmdBuffer = start;
+    MOS_SecureMemcpy(cmdBuffer.pCmdPtr, cmdBuffer.iRemaining, m_shadow.data(), shadow.iOffset);
+    cmdBuffer.pCmdPtr += shadow.iOffset / sizeof(uint32_t);
+    cmdBuffer.iOffset += shadow.iOffset;
+    cmdBuffer.iRemaining -= shadow.iOffset;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+}  // namespace decode
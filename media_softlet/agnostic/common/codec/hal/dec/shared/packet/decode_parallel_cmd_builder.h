@@ -0,0 +1,116 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     decode_parallel_cmd_builder.h
+//! \brief    Defines the helper which builds slice/tile level commands on the MOS worker pool
+//! \details  Units (slices, tiles) are split into contiguous ranges. The first range is
+//!           built straight into the destination buffer, the others into private scratch
+//!           buffers which are then appended in order, so the result is the same command
+//!           stream a serial build would produce. Ranges run on the process wide
+//!           MosWorkerPool, which every decoder of the process shares.
+//!
+
+#ifndef __DECODE_PARALLEL_CMD_BUILDER_H__
+#define __DECODE_PARALLEL_CMD_BUILDER_H__
+
+#include <functional>
+#include <vector>
+#include "mos_defs.h"
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+namespace decode
+{
+
+class DecodeParallelCmdBuilder
+{
+public:
+    //!
+    //! \brief  Build commands for units [begin, end) into cmdBuffer
+    //! \details rangeIdx is 0..rangeNum-1 and no two ranges of a build share an index,
+    //!          callers use it to select objects which are private to one range.
+    //!
+    using BuildFunc = std::function<MOS_STATUS(uint32_t rangeIdx, MOS_COMMAND_BUFFER &cmdBuffer, uint32_t begin, uint32_t end)>;
+
+    //!
+    //! \brief  Decode parallel command builder constructor
+    //! \param  [in] rangeNum
+    //!         Maximum number of ranges a build is split into
+    //! \param  [in] minUnitsPerRange
+    //!         Minimum units in one range, smaller jobs are built serially
+    //!
+    DecodeParallelCmdBuilder(uint32_t rangeNum, uint32_t minUnitsPerRange);
+
+    //!
+    //! \brief  Decode parallel command builder destructor
+    //!
+    virtual ~DecodeParallelCmdBuilder() {}
+
+    //!
+    //! \brief  Build commands for unitNum units into cmdBuffer
+    //! \details Falls back to a serial build on the calling thread if the job is too small,
+    //!          if any range fails or overflows its scratch buffer, or if the stitched
+    //!          stream does not fit into cmdBuffer.
+    //! \param  [in, out] cmdBuffer
+    //!         Destination command buffer
+    //! \param  [in] unitNum
+    //!         Number of units to build
+    //! \param  [in] unitCmdSize
+    //!         Largest command size of one unit in bytes, sizes the scratch buffers
+    //! \param  [in] func
+    //!         Builds a range of units, must only touch state owned by its rangeIdx
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Build(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t unitNum, uint32_t unitCmdSize, const BuildFunc &func);
+
+    //!
+    //! \brief  Rebuild every parallel result serially and compare the command streams
+    //! \details On mismatch the serial stream replaces the parallel one. Debug only, it
+    //!          doubles the CPU cost of the build.
+    //!
+    void SetVerifyMode(bool enable) { m_verify = enable; }
+
+protected:
+    MOS_STATUS BuildSerial(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t unitNum, const BuildFunc &func);
+    MOS_STATUS Verify(MOS_COMMAND_BUFFER &cmdBuffer, const MOS_COMMAND_BUFFER &start, uint32_t unitNum, const BuildFunc &func);
+
+    uint32_t m_rangeNum         = 1;
+    uint32_t m_minUnitsPerRange = 1;
+    bool     m_verify           = false;
+
+    std::vector<MOS_COMMAND_BUFFER>    m_rangeBuffers;     //!< Command buffers of ranges 1..N-1
+    std::vector<std::vector<uint32_t>> m_scratch;          //!< Per range command storage, grows on demand
+    std::vector<uint32_t>              m_shadow;           //!< Serial rebuild used by verify mode
+
+    uint32_t m_parallelCount = 0;
+    uint32_t m_serialCount   = 0;
+    uint32_t m_fallbackCount = 0;
+    uint32_t m_mismatchCount = 0;
+
+MEDIA_CLASS_DEFINE_END(decode__DecodeParallelCmdBuilder)
+};
+
+}  // namespace decode
+
+#endif  // !__DECODE_PARALLEL_CMD_BUILDER_H__
@@ -29,6 +29,7 @@ set(SOFTLET_DECODE_COMMON_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/decode_av1_aqm_packet.cpp
     ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_aqm_packet.cpp
     ${CMAKE_CURRENT_LIST_DIR}/decode_avc_aqm_packet.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/decode_parallel_cmd_builder.cpp
 )
 
 set(SOFTLET_DECODE_COMMON_HEADERS_
@@ -44,6 +45,7 @@ set(SOFTLET_DECODE_COMMON_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/decode_av1_aqm_packet.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_aqm_packet.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_avc_aqm_packet.h
+    ${CMAKE_CURRENT_LIST_DIR}/decode_parallel_cmd_builder.h
 )
 
 
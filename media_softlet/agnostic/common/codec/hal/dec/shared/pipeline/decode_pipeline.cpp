@@ -204,6 +204,7 @@ MOS_STATUS DecodePipeline::Initialize(void *settings)
     }
     DECODE_CHK_STATUS(CreateFeatureManager());
     DECODE_CHK_STATUS(m_featureManager->Init(codecSettings));
+    m_decodeBasicFeature = dynamic_cast<DecodeBasicFeature *>(m_featureManager->GetFeature(FeatureIDs::basicFeature));
 
     DECODE_CHK_STATUS(CreateSubPipeLineManager(codecSettings));
     DECODE_CHK_STATUS(CreateSubPacketManager(codecSettings));
@@ -414,6 +415,15 @@ MOS_STATUS DecodePipeline::Prepare(void *params)
     }
     DECODE_CHK_STATUS(m_subPacketManager->Prepare());
 
+    // Size of the frame in MBs plus bitstream, lets the OS spread streams across VDBoxes
+    if (m_decodeBasicFeature && m_osInterface->pfnSetVdboxWorkload)
+    {
+        uint32_t workload = MOS_ROUNDUP_DIVIDE(m_decodeBasicFeature->m_width, 16) *
+                            MOS_ROUNDUP_DIVIDE(m_decodeBasicFeature->m_height, 16) +
+                            (m_decodeBasicFeature->m_dataSize >> 8);
+        m_osInterface->pfnSetVdboxWorkload(m_osInterface, workload);
+    }
+
     // trace decode frame info after all update done
     if (MOS_TraceEnabled())
     {
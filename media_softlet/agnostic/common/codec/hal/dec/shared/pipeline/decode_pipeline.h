@@ -61,6 +61,7 @@ struct DecodePipelineParams
 
 class DecodeSubPacket;
 class DecodeSubPacketManager;
+class DecodeBasicFeature;
 
 class DecodePipeline : public MediaPipeline
 {
@@ -572,6 +573,7 @@ protected:
     DecodeMemComp*          m_mmcState  = nullptr;      //!< Decode mmc state
     DecodeCpInterface*      m_decodecp = nullptr;       //!< DecodeCp interface
     DecodeStreamOut*        m_streamout = nullptr;      //!< Decode input bitstream
+    DecodeBasicFeature*     m_decodeBasicFeature = nullptr; //!< Basic feature, looked up once at init
 
     uint8_t                 m_numVdbox  = 0;            //!< Number of Vdbox
     VdboxTypePref           m_pipelineVdboxTypePref = MOS_VDBOX_PREFER_NONE;
@@ -66,12 +66,11 @@ MOS_STATUS DecodeSfcHistogramSubPipeline::Init(CodechalSetting &settings)
     //Create Packets
     HucPacketCreatorBase *hucPktCreator = dynamic_cast<HucPacketCreatorBase *>(m_pipeline);
     DECODE_CHK_NULL(hucPktCreator);
-    m_copyPkt = hucPktCreator->CreateHucCopyPkt(m_pipeline, m_task, hwInterface);
-    DECODE_CHK_NULL(m_copyPkt);
-    MediaPacket *packet = dynamic_cast<MediaPacket *>(m_copyPkt);
-    DECODE_CHK_NULL(packet);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(m_pipeline, hucCopyPacketId), *packet));
-    DECODE_CHK_STATUS(packet->Init());
+    // Only streams reporting SFC histograms need the copy packet, create it on first use
+    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(m_pipeline, hucCopyPacketId), [this, hucPktCreator, hwInterface]() -> MediaPacket * {
+        m_copyPkt = hucPktCreator->CreateHucCopyPkt(m_pipeline, m_task, hwInterface);
+        return dynamic_cast<MediaPacket *>(m_copyPkt);
+    }));
 
     return MOS_STATUS_SUCCESS;
 }
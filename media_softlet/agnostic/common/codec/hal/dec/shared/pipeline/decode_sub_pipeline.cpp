@@ -78,18 +78,60 @@ MOS_STATUS DecodeSubPipeline::RegisterPacket(uint32_t packetId, MediaPacket& pac
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS DecodeSubPipeline::RegisterPacket(uint32_t packetId, PacketCreator &&creator)
+{
+    if (m_packetList.find(packetId) == m_packetList.end())
+    {
+        m_packetCreators[packetId] = std::move(creator);
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MediaPacket *DecodeSubPipeline::GetOrCreatePacket(uint32_t packetId)
+{
+    auto iter = m_packetList.find(packetId);
+    if (iter != m_packetList.end())
+    {
+        return iter->second;
+    }
+
+    auto iterCreator = m_packetCreators.find(packetId);
+    if (iterCreator == m_packetCreators.end())
+    {
+        return nullptr;
+    }
+
+    MediaPacket *packet = iterCreator->second();
+    if (packet == nullptr)
+    {
+        DECODE_ASSERTMESSAGE("Failed to create packet %d", packetId);
+        return nullptr;
+    }
+    if (MOS_FAILED(packet->Init()))
+    {
+        DECODE_ASSERTMESSAGE("Failed to initialize packet %d", packetId);
+        MOS_Delete(packet);
+        return nullptr;
+    }
+
+    m_packetList.emplace(packetId, packet);
+    m_packetCreators.erase(iterCreator);
+    return packet;
+}
+
 MOS_STATUS DecodeSubPipeline::ActivatePacket(uint32_t packetId, bool immediateSubmit,
                                              uint8_t pass, uint8_t pipe, uint8_t pipeNum)
 {
-    auto iter = m_packetList.find(packetId);
-    if (iter == m_packetList.end())
+    MediaPacket *packet = GetOrCreatePacket(packetId);
+    if (packet == nullptr)
     {
         return MOS_STATUS_INVALID_PARAMETER;
     }
 
     PacketProperty prop;
-    prop.packetId                         = iter->first;
-    prop.packet                           = iter->second;
+    prop.packetId                         = packetId;
+    prop.packet                           = packet;
     prop.immediateSubmit                  = immediateSubmit;
     prop.frameTrackingRequested           = false;
 
@@ -28,6 +28,7 @@
 #ifndef __DECODE_SUB_PIPELINE_H__
 #define __DECODE_SUB_PIPELINE_H__
 
+#include <functional>
 #include "decode_scalability_defs.h"
 #include "media_packet.h"
 #include "media_task.h"
@@ -44,6 +45,7 @@ class DecodeSubPipeline
 public:
     using PacketListType       = std::map<uint32_t, MediaPacket *>;
     using ActivePacketListType = std::vector<PacketProperty>;
+    using PacketCreator        = std::function<MediaPacket *()>;
 
     //!
     //! \brief  Decode sub pipeline constructor
@@ -113,6 +115,19 @@ protected:
     //!
     MOS_STATUS RegisterPacket(uint32_t packetId, MediaPacket& packet);
 
+    //!
+    //! \brief  Register the creator of one packet
+    //! \details The packet is created and initialized by the first ActivatePacket with
+    //!          packetId, streams never activating it do not pay for it.
+    //! \param  [in] packetId
+    //!         Packet Id
+    //! \param  [in] creator
+    //!         Creates the packet corresponding to packetId
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS RegisterPacket(uint32_t packetId, PacketCreator &&creator);
+
     //!
     //! \brief  Activate one packet and add it to active packet list
     //! \param  [in] packetId
@@ -131,6 +146,13 @@ protected:
     MOS_STATUS ActivatePacket(uint32_t packetId, bool immediateSubmit,
                               uint8_t pass, uint8_t pipe, uint8_t pipeNum = 1);
 
+    //!
+    //! \brief  Get the packet of packetId, create it from its creator if needed
+    //! \return MediaPacket *
+    //!         The packet, nullptr if it is not registered or fails to initialize
+    //!
+    MediaPacket *GetOrCreatePacket(uint32_t packetId);
+
     //!
     //! \brief  Reset sub pipeline
     //! \return MOS_STATUS
@@ -149,6 +171,7 @@ protected:
     uint8_t                 m_numVdbox = 1;          //!< Number of Vdbox
 
     PacketListType          m_packetList;            //!< Packets list
+    std::map<uint32_t, PacketCreator> m_packetCreators;  //!< Creators of packets not created yet
     ActivePacketListType    m_activePacketList;      //!< Active packets property list
 
     DecodeScalabilityPars   m_decodeScalabilityPars; //!< Decode scalability parameters
@@ -199,6 +199,7 @@ namespace decode {
         }
 
         UpdateCodecStatus(statusReportData, decodeStatusMfx, mfxCompleted && rcsCompleted);
+        DECODE_CHK_STATUS(ReportGpuTiming(COMPONENT_Decode, statusReportData->gpuEngineTimeNs));
 
         // The frame is completed, notify the observers
         if (statusReportData->codecStatus == CODECHAL_STATUS_SUCCESSFUL)
@@ -63,6 +63,8 @@ namespace decode {
         uint16_t                numMbsAffected = 0;
         //! \brief Crc of frame from MMIO
         uint32_t                frameCrc = 0;
+        //! \brief GPU busy time of the frame in ns per MediaGpuTiming::Engine, 0 if GPU frame timing is disabled
+        uint64_t                gpuEngineTimeNs[MediaGpuTiming::engineNum] = {};
 
 #if (_DEBUG || _RELEASE_INTERNAL)
         //! \brief Applies when debug dumps are enabled, pointer to SFC output resource for the picture associated with this status report
@@ -32,11 +32,11 @@ namespace decode
 MOS_STATUS HucVp9ProbUpdatePkt::AllocateResources()
 {
     m_dmemBufferSize = MOS_ALIGN_CEIL(sizeof(HucVp9ProbBss), CODECHAL_CACHELINE_SIZE);
-    if (m_probUpdateDmemBufferArray == nullptr)
+    if (m_probUpdateDmemBuffer == nullptr)
     {
-        m_probUpdateDmemBufferArray = m_allocator->AllocateBufferArray(
+        m_probUpdateDmemBuffer = m_allocator->AllocateOrphanableBuffer(
             m_dmemBufferSize, "DmemBuffer", m_numVp9ProbUpdateDmem, resourceInternalReadWriteCache, lockableVideoMem);
-        DECODE_CHK_NULL(m_probUpdateDmemBufferArray);
+        DECODE_CHK_NULL(m_probUpdateDmemBuffer);
     }
 
     if (m_interProbSaveBuffer == nullptr)
@@ -54,9 +54,9 @@ HucVp9ProbUpdatePkt::~HucVp9ProbUpdatePkt()
 {
     if (m_allocator != nullptr)
     {
-        if (m_probUpdateDmemBufferArray)
+        if (m_probUpdateDmemBuffer)
         {
-            m_allocator->Destroy(m_probUpdateDmemBufferArray);
+            m_allocator->Destroy(m_probUpdateDmemBuffer);
         }
 
         if (m_interProbSaveBuffer)
@@ -183,7 +183,6 @@ MOS_STATUS HucVp9ProbUpdatePkt::SetDmemBuffer()
 {
     DECODE_FUNC_CALL();
 
-    m_probUpdateDmemBuffer = m_probUpdateDmemBufferArray->Fetch();
     DECODE_CHK_NULL(m_probUpdateDmemBuffer);
 
     ResourceAutoLock resLock(m_allocator, &m_probUpdateDmemBuffer->OsResource);
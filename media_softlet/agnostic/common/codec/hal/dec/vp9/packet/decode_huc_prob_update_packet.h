@@ -134,13 +134,12 @@ protected:
     virtual MHW_SETPAR_DECL_HDR(HUC_START);
 
     static constexpr uint32_t m_vdboxHucVp9ProbUpdateKernelDescriptor = 6;     //!< Huc Vp9 prob update kernel descriptor
-    static constexpr uint32_t m_numVp9ProbUpdateDmem                  = 8;     //!< Huc Vp9 prob update Dmem number
+    static constexpr uint32_t m_numVp9ProbUpdateDmem                  = 8;     //!< Max allocations backing the Huc Vp9 prob update Dmem
     static constexpr uint32_t m_mediaResetCounter                     = 2400;  //!< Media reset counter for Huc Vp9 prob update
 
     Vp9BasicFeature *m_vp9BasicFeature = nullptr;  //!< Pointer to vp9 basic feature
 
-    BufferArray *m_probUpdateDmemBufferArray = nullptr;  //!< Vp9 prob update DMEM buffer array
-    MOS_BUFFER * m_probUpdateDmemBuffer      = nullptr;  //!< Resource of current DMEM buffer
+    MOS_BUFFER * m_probUpdateDmemBuffer      = nullptr;  //!< Vp9 prob update DMEM buffer, orphaned when busy
     uint32_t     m_dmemBufferSize            = 0;        //!< Size of DMEM buffer
 
     MOS_BUFFER *m_interProbSaveBuffer = nullptr;  //!< Vp9 inter prob save buffer
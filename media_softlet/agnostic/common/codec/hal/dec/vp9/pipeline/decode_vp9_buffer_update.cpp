@@ -54,6 +54,14 @@ DecodeVp9BufferUpdate::~DecodeVp9BufferUpdate()
         {
             m_allocator->Destroy(m_tempVp9ResetFullNonKeyDefaultProbBuffer);
         }
+        if (m_segProbBufferArray)
+        {
+            m_allocator->Destroy(m_segProbBufferArray);
+        }
+        if (m_interProbSaveBuffer)
+        {
+            m_allocator->Destroy(m_interProbSaveBuffer);
+        }
     }
 }
 
@@ -86,16 +94,22 @@ MOS_STATUS DecodeVp9BufferUpdate::Init(CodechalSetting &settings)
 
     HucPacketCreatorBase *probUpdateCreator = dynamic_cast<HucPacketCreatorBase *>(m_pipeline);
     DECODE_CHK_NULL(probUpdateCreator);
-    auto probUpdatePkt = probUpdateCreator->CreateProbUpdatePkt(m_pipeline, m_task, hwInterface);
-    DECODE_CHK_NULL(probUpdatePkt);
-    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, HucVp9ProbUpdatePktId), *probUpdatePkt));
-    DECODE_CHK_STATUS(probUpdatePkt->Init());
+    // Only heavy mode CP updates the probabilities with HuC, create the packet on first use
+    DECODE_CHK_STATUS(RegisterPacket(DecodePacketId(this, HucVp9ProbUpdatePktId), [this, probUpdateCreator, hwInterface]() -> MediaPacket * {
+        return probUpdateCreator->CreateProbUpdatePkt(m_pipeline, m_task, hwInterface);
+    }));
 
-    if (m_basicFeature->m_osInterface->pfnIsMismatchOrderProgrammingSupported())
+    if (m_basicFeature->m_osInterface->pfnIsMismatchOrderProgrammingSupported() ||
+        !m_basicFeature->m_osInterface->osCpInterface->IsHMEnabled())
     {
         DECODE_CHK_STATUS(AllocateProbDefaultBuffer());
     }
 
+    if (!m_basicFeature->m_osInterface->osCpInterface->IsHMEnabled())
+    {
+        DECODE_CHK_STATUS(AllocateProbUpdateBuffer());
+    }
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -104,6 +118,7 @@ MOS_STATUS DecodeVp9BufferUpdate::Prepare(DecodePipelineParams &params)
     if (m_pipeline->IsFirstProcessPipe(params))
     {
         DECODE_CHK_STATUS(Begin());
+        m_copyPending = false;
 
         if ((m_basicFeature->m_resetSegIdBuffer && !m_basicFeature->m_osInterface->pfnIsMismatchOrderProgrammingSupported()) ||
             ((!m_basicFeature->m_vp9PicParams->PicFlags.fields.frame_type || m_basicFeature->m_vp9PicParams->PicFlags.fields.intra_only) &&
@@ -113,22 +128,13 @@ MOS_STATUS DecodeVp9BufferUpdate::Prepare(DecodePipelineParams &params)
             uint32_t allocSize = m_basicFeature->m_resVp9SegmentIdBuffer->size;
             DECODE_CHK_STATUS(AllocateSegmentInitBuffer(allocSize));
 
-            HucCopyPktItf::HucCopyParams copyParams;
-            copyParams.srcBuffer  = &m_segmentInitBuffer->OsResource;
-            copyParams.srcOffset  = 0;
-            copyParams.destBuffer = &(m_basicFeature->m_resVp9SegmentIdBuffer->OsResource);
-            copyParams.destOffset = 0;
-            copyParams.copyLength = allocSize;
-            m_sgementbufferResetPkt->PushCopyParams(copyParams);
-
-            DECODE_CHK_STATUS(ActivatePacket(DecodePacketId(m_pipeline, hucCopyPacketId), true, 0, 0));
+            DECODE_CHK_STATUS(PushCopy(
+                &m_segmentInitBuffer->OsResource, 0,
+                &(m_basicFeature->m_resVp9SegmentIdBuffer->OsResource), 0,
+                allocSize));
         }
 
-        if (m_basicFeature->m_osInterface->osCpInterface->IsHMEnabled())
-        {
-            DECODE_CHK_STATUS(ActivatePacket(DecodePacketId(this, HucVp9ProbUpdatePktId), true, 0, 0));
-        }
-        else
+        if (!m_basicFeature->m_osInterface->osCpInterface->IsHMEnabled())
         {
             if (m_basicFeature->m_fullProbBufferUpdate)
             {
@@ -139,120 +145,199 @@ MOS_STATUS DecodeVp9BufferUpdate::Prepare(DecodePipelineParams &params)
                 DECODE_CHK_STATUS(ProbBufferPartialUpdatewithDrv());
             }
         }
+
+        // All copies of this frame go in one activation, they run in the order they were pushed.
+        if (m_copyPending)
+        {
+            DECODE_CHK_STATUS(ActivatePacket(DecodePacketId(m_pipeline, hucCopyPacketId), true, 0, 0));
+        }
+
+        if (m_basicFeature->m_osInterface->osCpInterface->IsHMEnabled())
+        {
+            DECODE_CHK_STATUS(ActivatePacket(DecodePacketId(this, HucVp9ProbUpdatePktId), true, 0, 0));
+        }
     }
     return MOS_STATUS_SUCCESS;
 }
 
-MOS_STATUS DecodeVp9BufferUpdate ::ProbBufFullUpdatewithDrv()
+MOS_STATUS DecodeVp9BufferUpdate::PushCopy(
+    PMOS_RESOURCE srcBuffer, uint32_t srcOffset, PMOS_RESOURCE destBuffer, uint32_t destOffset, uint32_t copyLength)
 {
-    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+    DECODE_CHK_NULL(m_sgementbufferResetPkt);
+    DECODE_CHK_NULL(srcBuffer);
+    DECODE_CHK_NULL(destBuffer);
+
+    HucCopyPktItf::HucCopyParams copyParams;
+    copyParams.srcBuffer  = srcBuffer;
+    copyParams.srcOffset  = srcOffset;
+    copyParams.destBuffer = destBuffer;
+    copyParams.destOffset = destOffset;
+    copyParams.copyLength = copyLength;
+    DECODE_CHK_STATUS(m_sgementbufferResetPkt->PushCopyParams(copyParams));
+    m_copyPending = true;
 
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS DecodeVp9BufferUpdate::ProbBufSegProbCopy()
+{
     DECODE_FUNC_CALL();
 
-    ResourceAutoLock resLock(m_allocator, &(m_basicFeature->m_resVp9ProbBuffer[m_basicFeature->m_frameCtxIdx]->OsResource));
-    auto             data = (uint8_t *)resLock.LockResourceForWrite();
-    DECODE_CHK_NULL(data);
-
-    DECODE_CHK_STATUS(ContextBufferInit(
-        data, (m_basicFeature->m_probUpdateFlags.bResetKeyDefault ? true : false)));
-    DECODE_CHK_STATUS(MOS_SecureMemcpy(
-        (data + CODEC_VP9_SEG_PROB_OFFSET),
-        7,
-        m_basicFeature->m_probUpdateFlags.SegTreeProbs,
-        7));
-    DECODE_CHK_STATUS(MOS_SecureMemcpy(
-        (data + CODEC_VP9_SEG_PROB_OFFSET + 7),
-        3,
-        m_basicFeature->m_probUpdateFlags.SegPredProbs,
-        3));
-
-    return eStatus;
+    DECODE_CHK_NULL(m_segProbBufferArray);
+
+    // Only the seg probs come from the CPU. They go to a buffer of the ring which the GPU
+    // retired several frames ago, so the lock below does not wait on the previous frame.
+    PMOS_BUFFER segProbBuffer = m_segProbBufferArray->Fetch();
+    DECODE_CHK_NULL(segProbBuffer);
+
+    {
+        ResourceAutoLock resLock(m_allocator, &segProbBuffer->OsResource);
+        auto             data = (uint8_t *)resLock.LockResourceForWrite();
+        DECODE_CHK_NULL(data);
+
+        DECODE_CHK_STATUS(MOS_SecureMemcpy(data, 7, m_basicFeature->m_probUpdateFlags.SegTreeProbs, 7));
+        DECODE_CHK_STATUS(MOS_SecureMemcpy(data + 7, 3, m_basicFeature->m_probUpdateFlags.SegPredProbs, 3));
+    }
+
+    DECODE_CHK_STATUS(PushCopy(
+        &segProbBuffer->OsResource, 0,
+        &(m_basicFeature->m_resVp9ProbBuffer[m_basicFeature->m_frameCtxIdx]->OsResource), CODEC_VP9_SEG_PROB_OFFSET,
+        m_segProbSize));
+
+    return MOS_STATUS_SUCCESS;
 }
 
-MOS_STATUS DecodeVp9BufferUpdate ::ProbBufferPartialUpdatewithDrv()
+MOS_STATUS DecodeVp9BufferUpdate::ProbBufResetFull(bool resetTail)
 {
-    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+    DECODE_FUNC_CALL();
+
+    PMOS_BUFFER defaultBuffer = m_basicFeature->m_probUpdateFlags.bResetKeyDefault ?
+        m_tempVp9ResetFullKeyDefaultProbBuffer : m_tempVp9ResetFullNonKeyDefaultProbBuffer;
+    DECODE_CHK_NULL(defaultBuffer);
+    PMOS_RESOURCE probBuffer = &(m_basicFeature->m_resVp9ProbBuffer[m_basicFeature->m_frameCtxIdx]->OsResource);
+
+    DECODE_CHK_STATUS(PushCopy(&defaultBuffer->OsResource, 0, probBuffer, 0, CODEC_VP9_SEG_PROB_OFFSET));
+
+    // Zeros which ContextBufferInit writes behind the seg probs
+    if (resetTail)
+    {
+        uint32_t tailOffset = CODEC_VP9_SEG_PROB_OFFSET + m_segProbSize;
+        DECODE_CHK_STATUS(PushCopy(&defaultBuffer->OsResource, tailOffset, probBuffer, tailOffset, m_probTailSize));
+    }
 
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS DecodeVp9BufferUpdate::ProbBufResetPartial()
+{
     DECODE_FUNC_CALL();
 
-    if (m_basicFeature->m_probUpdateFlags.bSegProbCopy ||
-        m_basicFeature->m_probUpdateFlags.bProbSave ||
-        m_basicFeature->m_probUpdateFlags.bProbReset ||
-        m_basicFeature->m_probUpdateFlags.bProbRestore)
+    bool        setToKey      = m_basicFeature->m_probUpdateFlags.bResetKeyDefault ? true : false;
+    PMOS_BUFFER defaultBuffer = setToKey ?
+        m_tempVp9ResetFullKeyDefaultProbBuffer : m_tempVp9ResetFullNonKeyDefaultProbBuffer;
+    DECODE_CHK_NULL(defaultBuffer);
+    PMOS_RESOURCE probBuffer = &(m_basicFeature->m_resVp9ProbBuffer[m_basicFeature->m_frameCtxIdx]->OsResource);
+
+    // Copy the ranges CtxBufDiffInit writes, the bytes it skips keep their current value.
+    uint32_t partitionOffset = CODEC_VP9_INTER_PROB_OFFSET +
+                               CODEC_VP9_INTER_MODE_CONTEXTS * (CODEC_VP9_INTER_MODES - 1) +
+                               (CODEC_VP9_SWITCHABLE_FILTERS + 1) * (CODEC_VP9_SWITCHABLE_FILTERS - 1) +
+                               CODEC_VP9_INTRA_INTER_CONTEXTS +
+                               CODEC_VP9_COMP_INTER_CONTEXTS +
+                               CODEC_VP9_REF_CONTEXTS * 2 +
+                               CODEC_VP9_REF_CONTEXTS +
+                               CODEC_VP9_BLOCK_SIZE_GROUPS * (CODEC_VP9_INTRA_MODES - 1);
+    uint32_t partitionSize   = CODECHAL_VP9_PARTITION_CONTEXTS * (CODEC_VP9_PARTITION_TYPES - 1);
+    uint32_t nmvEnd          = partitionOffset + partitionSize +
+                               (CODEC_VP9_MV_JOINTS - 1) +
+                               2 * (1 + (CODEC_VP9_MV_CLASSES - 1) + (CODECHAL_VP9_CLASS0_SIZE - 1) + CODECHAL_VP9_MV_OFFSET_BITS) +
+                               2 * (CODECHAL_VP9_CLASS0_SIZE * (CODEC_VP9_MV_FP_SIZE - 1) + (CODEC_VP9_MV_FP_SIZE - 1)) +
+                               2 * 2;
+    uint32_t uvModeOffset    = nmvEnd + 47;
+    uint32_t uvModeSize      = CODEC_VP9_INTRA_MODES * (CODEC_VP9_INTRA_MODES - 1);
+    DECODE_ASSERT(uvModeOffset + uvModeSize == CODEC_VP9_SEG_PROB_OFFSET);
+
+    if (setToKey)
+    {
+        DECODE_CHK_STATUS(PushCopy(&defaultBuffer->OsResource, partitionOffset, probBuffer, partitionOffset, partitionSize));
+    }
+    else
     {
-        ResourceAutoLock resLock(m_allocator, &(m_basicFeature->m_resVp9ProbBuffer[m_basicFeature->m_frameCtxIdx]->OsResource));
-        auto             data = (uint8_t *)resLock.LockResourceForWrite();
+        DECODE_CHK_STATUS(PushCopy(
+            &defaultBuffer->OsResource, CODEC_VP9_INTER_PROB_OFFSET,
+            probBuffer, CODEC_VP9_INTER_PROB_OFFSET,
+            nmvEnd - CODEC_VP9_INTER_PROB_OFFSET));
+    }
+    DECODE_CHK_STATUS(PushCopy(&defaultBuffer->OsResource, uvModeOffset, probBuffer, uvModeOffset, uvModeSize));
 
-        DECODE_CHK_NULL(data);
+    return MOS_STATUS_SUCCESS;
+}
 
-        if (m_basicFeature->m_probUpdateFlags.bSegProbCopy)
-        {
-            DECODE_CHK_STATUS(MOS_SecureMemcpy(
-                (data + CODEC_VP9_SEG_PROB_OFFSET),
-                7,
-                m_basicFeature->m_probUpdateFlags.SegTreeProbs,
-                7));
-            DECODE_CHK_STATUS(MOS_SecureMemcpy(
-                (data + CODEC_VP9_SEG_PROB_OFFSET + 7),
-                3,
-                m_basicFeature->m_probUpdateFlags.SegPredProbs,
-                3));
-        }
+MOS_STATUS DecodeVp9BufferUpdate ::ProbBufFullUpdatewithDrv()
+{
+    DECODE_FUNC_CALL();
 
-        if (m_basicFeature->m_probUpdateFlags.bProbSave)
-        {
-            DECODE_CHK_STATUS(MOS_SecureMemcpy(
-                m_basicFeature->m_interProbSaved,
-                CODECHAL_VP9_INTER_PROB_SIZE,
-                data + CODEC_VP9_INTER_PROB_OFFSET,
-                CODECHAL_VP9_INTER_PROB_SIZE));
-        }
+    DECODE_CHK_STATUS(ProbBufResetFull(true));
+    DECODE_CHK_STATUS(ProbBufSegProbCopy());
 
-        if (m_basicFeature->m_probUpdateFlags.bProbReset)
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS DecodeVp9BufferUpdate ::ProbBufferPartialUpdatewithDrv()
+{
+    DECODE_FUNC_CALL();
+
+    // The probability buffer may still be read or adapted by the previous frame, so it is
+    // only updated by copies queued behind that frame on the GPU, never locked here.
+    if (m_basicFeature->m_probUpdateFlags.bSegProbCopy)
+    {
+        DECODE_CHK_STATUS(ProbBufSegProbCopy());
+    }
+
+    PMOS_RESOURCE probBuffer = &(m_basicFeature->m_resVp9ProbBuffer[m_basicFeature->m_frameCtxIdx]->OsResource);
+
+    if (m_basicFeature->m_probUpdateFlags.bProbSave)
+    {
+        DECODE_CHK_NULL(m_interProbSaveBuffer);
+        DECODE_CHK_STATUS(PushCopy(
+            probBuffer, CODEC_VP9_INTER_PROB_OFFSET,
+            &m_interProbSaveBuffer->OsResource, 0,
+            CODECHAL_VP9_INTER_PROB_SIZE));
+    }
+
+    if (m_basicFeature->m_probUpdateFlags.bProbReset)
+    {
+        if (m_basicFeature->m_probUpdateFlags.bResetFull)
         {
-            if (m_basicFeature->m_probUpdateFlags.bResetFull)
+            if (m_basicFeature->m_osInterface->pfnIsMismatchOrderProgrammingSupported() &&
+               (!m_basicFeature->m_vp9PicParams->PicFlags.fields.frame_type || m_basicFeature->m_vp9PicParams->PicFlags.fields.intra_only))
             {
-                if (m_basicFeature->m_osInterface->pfnIsMismatchOrderProgrammingSupported() &&
-                   (!m_basicFeature->m_vp9PicParams->PicFlags.fields.frame_type || m_basicFeature->m_vp9PicParams->PicFlags.fields.intra_only))
-                {
-                    HucCopyPktItf::HucCopyParams copyParams;
-                    copyParams.srcBuffer = m_basicFeature->m_probUpdateFlags.bResetKeyDefault ?
-                        (&m_tempVp9ResetFullKeyDefaultProbBuffer->OsResource) : (&m_tempVp9ResetFullNonKeyDefaultProbBuffer->OsResource);
-                    copyParams.srcOffset  = 0;
-                    copyParams.destBuffer = &(m_basicFeature->m_resVp9ProbBuffer[m_basicFeature->m_frameCtxIdx]->OsResource);
-                    copyParams.destOffset = 0;
-                    copyParams.copyLength = CODEC_VP9_SEG_PROB_OFFSET;
-                    m_sgementbufferResetPkt->PushCopyParams(copyParams);
-
-                    DECODE_CHK_STATUS(ActivatePacket(DecodePacketId(m_pipeline, hucCopyPacketId), true, 0, 0));
-                }
-                else
-                {
-                    DECODE_CHK_STATUS(ContextBufferInit(
-                        data, (m_basicFeature->m_probUpdateFlags.bResetKeyDefault ? true : false)));
-                }
+                DECODE_CHK_STATUS(ProbBufResetFull(false));
             }
             else
             {
-                 if (!m_basicFeature->m_osInterface->pfnIsMismatchOrderProgrammingSupported())
-                {
-                    DECODE_CHK_STATUS(CtxBufDiffInit(
-                      data, (m_basicFeature->m_probUpdateFlags.bResetKeyDefault ? true : false)));
-                }
+                DECODE_CHK_STATUS(ProbBufResetFull(true));
             }
         }
-
-        if (m_basicFeature->m_probUpdateFlags.bProbRestore)
+        else
         {
-            DECODE_CHK_STATUS(MOS_SecureMemcpy(
-                data + CODEC_VP9_INTER_PROB_OFFSET,
-                CODECHAL_VP9_INTER_PROB_SIZE,
-                m_basicFeature->m_interProbSaved,
-                CODECHAL_VP9_INTER_PROB_SIZE));
+            if (!m_basicFeature->m_osInterface->pfnIsMismatchOrderProgrammingSupported())
+            {
+                DECODE_CHK_STATUS(ProbBufResetPartial());
+            }
         }
     }
 
-    return eStatus;
+    if (m_basicFeature->m_probUpdateFlags.bProbRestore)
+    {
+        DECODE_CHK_NULL(m_interProbSaveBuffer);
+        DECODE_CHK_STATUS(PushCopy(
+            &m_interProbSaveBuffer->OsResource, 0,
+            probBuffer, CODEC_VP9_INTER_PROB_OFFSET,
+            CODECHAL_VP9_INTER_PROB_SIZE));
+    }
+
+    return MOS_STATUS_SUCCESS;
 }
 
 MOS_STATUS DecodeVp9BufferUpdate::ContextBufferInit(
@@ -683,6 +768,29 @@ MOS_STATUS DecodeVp9BufferUpdate::AllocateProbDefaultBuffer()
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS DecodeVp9BufferUpdate::AllocateProbUpdateBuffer()
+{
+    DECODE_CHK_NULL(m_allocator);
+
+    if (m_segProbBufferArray == nullptr)
+    {
+        m_segProbBufferArray = m_allocator->AllocateBufferArray(
+            MOS_ALIGN_CEIL(m_segProbSize, CODECHAL_CACHELINE_SIZE), "Vp9SegProbBuffer", m_numSegProbBuffer,
+            resourceInternalRead, lockableVideoMem);
+        DECODE_CHK_NULL(m_segProbBufferArray);
+    }
+
+    if (m_interProbSaveBuffer == nullptr)
+    {
+        m_interProbSaveBuffer = m_allocator->AllocateBuffer(
+            MOS_ALIGN_CEIL(CODECHAL_VP9_INTER_PROB_SIZE, CODECHAL_PAGE_SIZE), "Vp9InterProbsSaveBuffer",
+            resourceInternalReadWriteCache, notLockableVideoMem);
+        DECODE_CHK_NULL(m_interProbSaveBuffer);
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MediaFunction DecodeVp9BufferUpdate::GetMediaFunction()
 {
     // WA for Vulkan, currently only support one MOS_GPU_CONTEXT_VIDEO.
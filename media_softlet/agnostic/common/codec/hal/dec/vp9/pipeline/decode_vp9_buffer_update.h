@@ -109,6 +109,43 @@ protected:
     //!
     MOS_STATUS AllocateProbDefaultBuffer();
 
+    //!
+    //! \brief  Allocate seg probs staging buffers and inter probs save buffer
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AllocateProbUpdateBuffer();
+
+    //!
+    //! \brief  Queue one HuC copy, all copies of a frame are submitted by one packet activation
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS PushCopy(PMOS_RESOURCE srcBuffer, uint32_t srcOffset, PMOS_RESOURCE destBuffer, uint32_t destOffset, uint32_t copyLength);
+
+    //!
+    //! \brief  Queue copies resetting the probability buffer to the default tables
+    //! \param  [in] resetTail
+    //!         Also reset the zero bytes behind the seg probs
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ProbBufResetFull(bool resetTail);
+
+    //!
+    //! \brief  Queue copies of the default probs which differ between key and non-key frames
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ProbBufResetPartial();
+
+    //!
+    //! \brief  Stage seg tree/pred probs in the next ring buffer and queue their copy
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ProbBufSegProbCopy();
+
     MOS_STATUS ProbBufFullUpdatewithDrv();
     MOS_STATUS ProbBufferPartialUpdatewithDrv();
     MOS_STATUS ContextBufferInit(uint8_t *ctxBuffer, bool setToKey);
@@ -123,6 +160,13 @@ protected:
     PMOS_BUFFER        m_tempVp9ResetFullKeyDefaultProbBuffer = nullptr; //!< Temporary buffer for key frame default probability values
     PMOS_BUFFER        m_tempVp9ResetFullNonKeyDefaultProbBuffer = nullptr; //!< Temporary buffer for non-key frame default probability values
 
+    static constexpr uint32_t m_numSegProbBuffer = 8;   //!< Seg probs staging buffer number
+    static constexpr uint32_t m_segProbSize      = 10;  //!< Seg tree probs and seg pred probs
+    static constexpr uint32_t m_probTailSize     = 28;  //!< Zero bytes behind the seg probs
+    BufferArray       *m_segProbBufferArray  = nullptr;  //!< Ring of seg probs staging buffers
+    PMOS_BUFFER        m_interProbSaveBuffer = nullptr;  //!< Inter probs saved from probability buffer 0
+    bool               m_copyPending         = false;    //!< HuC copies are queued for current frame
+
 MEDIA_CLASS_DEFINE_END(decode__DecodeVp9BufferUpdate)
 };
 
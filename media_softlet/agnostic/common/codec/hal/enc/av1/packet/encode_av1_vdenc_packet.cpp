@@ -1095,6 +1095,20 @@ namespace encode{
         flushDwParams                    = {};
         ENCODE_CHK_STATUS_RETURN(m_miItf->MHW_ADDCMD_F(MI_FLUSH_DW)(cmdBuf));
 
+        // VCS_GPR0_Lo still holds the size of the tiles so far, report the tile completion with it
+        m_tileStatusIdx = firstTile ? 0 : m_tileStatusIdx;
+        if (m_pipeline->IsLastPass())
+        {
+            auto packetUtilities = m_pipeline->GetPacketUtilities();
+            ENCODE_CHK_NULL_RETURN(packetUtilities);
+            ENCODE_CHK_STATUS_RETURN(packetUtilities->AddSubregionStatusCmd(
+                cmdBuf,
+                m_statusReport,
+                m_tileStatusIdx,
+                mmioRegs->generalPurposeRegister0LoOffset));
+        }
+        m_tileStatusIdx++;
+
         return MOS_STATUS_SUCCESS;
     }
 
@@ -1151,10 +1165,17 @@ namespace encode{
         uint32_t tileNum = 1;
         RUN_FEATURE_INTERFACE_RETURN(Av1EncodeTile, Av1FeatureIDs::encodeTile, GetTileNum, tileNum);
 
+        uint32_t tileStatusSize = 0;
+        auto     packetUtilities = m_pipeline->GetPacketUtilities();
+        if (packetUtilities != nullptr)
+        {
+            tileStatusSize = packetUtilities->GetSubregionStatusCmdSize(m_statusReport);
+        }
+
         // To be refined later, differentiate BRC and CQP
         commandBufferSize =
             m_pictureStatesSize +
-            (m_tileStatesSize * tileNum);
+            ((m_tileStatesSize + tileStatusSize) * tileNum);
 
         // 4K align since allocation is in chunks of 4K bytes.
         commandBufferSize = MOS_ALIGN_CEIL(commandBufferSize, CODECHAL_PAGE_SIZE);
@@ -305,6 +305,7 @@ protected:
     uint32_t m_picturePatchListSize        = 0;  //!< Picture patch list size
     uint32_t m_tileStatesSize              = 0;  //!< Slice states size
     uint32_t m_tilePatchListSize           = 0;  //!< Slice patch list size
+    uint32_t m_tileStatusIdx               = 0;  //!< Index of the next tile to report completion of
 
     MOS_STATUS SetPipeBufAddr(
         PMHW_VDBOX_PIPE_BUF_ADDR_PARAMS pipeBufAddrParams,
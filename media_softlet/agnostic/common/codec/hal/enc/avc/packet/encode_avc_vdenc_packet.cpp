@@ -552,6 +552,7 @@ namespace encode {
             if (!m_lastSlice)
             {
                 SETPAR_AND_ADDCMD(MI_FLUSH_DW, m_miItf, &cmdBuffer);
+                ENCODE_CHK_STATUS_RETURN(AddSliceStatus(&cmdBuffer, slcCount));
             }
         }
 
@@ -567,6 +568,9 @@ namespace encode {
 
         ENCODE_CHK_STATUS_RETURN(EnsureAllCommandsExecuted(cmdBuffer));
 
+        // The last slice ends with the tail inserted after it
+        ENCODE_CHK_STATUS_RETURN(AddSliceStatus(&cmdBuffer, m_basicFeature->m_numSlices - 1));
+
 #if (_DEBUG || _RELEASE_INTERNAL)
         if (m_bypassHwLegacyEnabled)
         {
@@ -1050,6 +1054,31 @@ namespace encode {
         return MOS_STATUS_SUCCESS;
     }
 
+    MOS_STATUS AvcVdencPkt::AddSliceStatus(
+        PMOS_COMMAND_BUFFER cmdBuffer,
+        uint32_t            slcCount)
+    {
+        ENCODE_FUNC_CALL();
+
+        auto packetUtilities = m_pipeline->GetPacketUtilities();
+        ENCODE_CHK_NULL_RETURN(packetUtilities);
+        // Earlier passes are redone, only the last one reports
+        if (!m_pipeline->IsLastPass() || !packetUtilities->IsSubregionReportEnabled(m_statusReport))
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+
+        ENCODE_CHK_COND_RETURN((m_vdboxIndex > m_mfxItf->GetMaxVdboxIndex()), "ERROR - vdbox index exceed the maximum");
+        MmioRegistersMfx *mmioRegisters = SelectVdboxAndGetMmioRegister(m_vdboxIndex, cmdBuffer);
+        CODEC_HW_CHK_NULL_RETURN(mmioRegisters);
+
+        return packetUtilities->AddSubregionStatusCmd(
+            cmdBuffer,
+            m_statusReport,
+            slcCount,
+            mmioRegisters->mfcBitstreamBytecountFrameRegOffset);
+    }
+
     MOS_STATUS AvcVdencPkt::SetSliceStateCommonParams(MHW_VDBOX_AVC_SLICE_STATE &sliceState)
     {
         ENCODE_FUNC_CALL();
@@ -1281,11 +1310,13 @@ namespace encode {
         m_sliceStatesSize += vdencSliceStatesSize;
         m_slicePatchListSize += vdencSlicePatchListSize;
 
+        auto packetUtilities = m_pipeline->GetPacketUtilities();
+        ENCODE_CHK_NULL_RETURN(packetUtilities);
+        m_sliceStatesSize += packetUtilities->GetSubregionStatusCmdSize(m_statusReport);
+
 #if USE_CODECHAL_DEBUG_TOOL
         // for ModifyEncodedFrameSizeWithFakeHeaderSize
         // total sum is 368 (108*2 + 152)
-        auto packetUtilities = m_pipeline->GetPacketUtilities();
-        ENCODE_CHK_NULL_RETURN(packetUtilities);
         uint32_t sizeInByte = 0;
         bool     isIframe   = m_basicFeature->m_pictureCodingType == I_TYPE;
         if (packetUtilities->GetFakeHeaderSettings(sizeInByte, isIframe))
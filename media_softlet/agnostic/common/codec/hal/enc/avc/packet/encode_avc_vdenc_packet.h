@@ -365,6 +365,20 @@ protected:
         PMOS_COMMAND_BUFFER cmdBuffer,
         uint32_t            slcCount);
 
+    //!
+    //! \brief    Report the completion of a slice
+    //! \details  Must follow the MI_FLUSH_DW of the slice.
+    //! \param    [in] cmdBuffer
+    //!               Pointer to primary cmd buffer
+    //!           [in] slcCount
+    //!               Current slice count
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AddSliceStatus(
+        PMOS_COMMAND_BUFFER cmdBuffer,
+        uint32_t            slcCount);
+
     //! \brief    Get AVC VDenc frame level status extention
     //!
     //! \param    [in] cmdBuffer
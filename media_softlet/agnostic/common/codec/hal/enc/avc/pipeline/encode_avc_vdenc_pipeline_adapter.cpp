@@ -60,6 +60,15 @@ MOS_STATUS EncodeAvcVdencPipelineAdapter::GetStatusReport(
     return m_encoder->GetStatusReport(status, numStatus);
 }
 
+MOS_STATUS EncodeAvcVdencPipelineAdapter::GetSubregionStatus(
+    uint32_t            pendingIndex,
+    void                *report)
+{
+    ENCODE_FUNC_CALL();
+
+    return m_encoder->GetSubregionStatus(pendingIndex, report);
+}
+
 void EncodeAvcVdencPipelineAdapter::Destroy()
 {
     ENCODE_FUNC_CALL();
@@ -475,6 +475,8 @@ namespace encode
         // starting location for executing slice level cmds
         vdenc2ndLevelBatchBuffer->dwOffset = m_hwInterface->m_vdencBatchBuffer1stGroupSize + m_hwInterface->m_vdencBatchBuffer2ndGroupSize;
 
+        bool sliceStatusReported = IsSliceStatusReported();
+
         PCODEC_ENCODER_SLCDATA slcData = m_basicFeature->m_slcData;
         for (uint32_t startLcu = 0, slcCount = 0; slcCount < m_basicFeature->m_numSlices; slcCount++)
         {
@@ -498,8 +500,14 @@ namespace encode
                 vdenc2ndLevelBatchBuffer->dwOffset += m_hwInterface->m_vdencBatchBufferPerSliceConstSize + m_basicFeature->m_vdencBatchBufferPerSliceVarSize[slcCount];
             }
 
-            m_flushCmd = waitVdenc;
+            // The slice must leave HCP too before its size is reported
+            m_flushCmd = sliceStatusReported ? waitHevcVdenc : waitVdenc;
             SETPAR_AND_ADDCMD(VD_PIPELINE_FLUSH, m_vdencItf, &cmdBuffer);
+
+            if (sliceStatusReported)
+            {
+                ENCODE_CHK_STATUS_RETURN(AddSliceStatus(cmdBuffer, slcCount));
+            }
         }
 
         if (m_useBatchBufferForPakSlices)
@@ -624,6 +632,7 @@ namespace encode
         ENCODE_FUNC_CALL();
 
         PCODEC_ENCODER_SLCDATA         slcData = m_basicFeature->m_slcData;
+        bool                           sliceStatusReported = IsSliceStatusReported();
 
         uint32_t slcCount, sliceNumInTile = 0;
         for (slcCount = 0; slcCount < m_basicFeature->m_numSlices; slcCount++)
@@ -647,6 +656,11 @@ namespace encode
             m_flushCmd = waitHevcVdenc;
             SETPAR_AND_ADDCMD(VD_PIPELINE_FLUSH, m_vdencItf, &cmdBuffer);
 
+            if (sliceStatusReported)
+            {
+                ENCODE_CHK_STATUS_RETURN(AddSliceStatus(cmdBuffer, slcCount));
+            }
+
             sliceNumInTile++;
         }  // end of slice
 
@@ -669,6 +683,34 @@ namespace encode
         return MOS_STATUS_SUCCESS;
     }
 
+    bool HevcVdencPkt::IsSliceStatusReported()
+    {
+        // Slices of multiple pipes do not complete in bitstream order, earlier passes are redone
+        return m_packetUtilities != nullptr &&
+               m_packetUtilities->IsSubregionReportEnabled(m_statusReport) &&
+               m_pipeline->IsLastPass() &&
+               m_pipeline->GetPipeNum() <= 1;
+    }
+
+    MOS_STATUS HevcVdencPkt::AddSliceStatus(
+        MOS_COMMAND_BUFFER &cmdBuffer,
+        uint32_t            slcCount)
+    {
+        ENCODE_FUNC_CALL();
+
+        ENCODE_CHK_NULL_RETURN(m_packetUtilities);
+
+        // The VD_PIPELINE_FLUSH before waits for HCP, no MI_FLUSH_DW is needed to read the byte count
+        auto mmioRegisters = m_hcpItf->GetMmioRegisters(m_vdboxIndex);
+        ENCODE_CHK_NULL_RETURN(mmioRegisters);
+
+        return m_packetUtilities->AddSubregionStatusCmd(
+            &cmdBuffer,
+            m_statusReport,
+            slcCount,
+            mmioRegisters->hcpEncBitstreamBytecountFrameRegOffset);
+    }
+
     MOS_STATUS HevcVdencPkt::AddOneTileCommands(
         MOS_COMMAND_BUFFER &cmdBuffer,
         uint32_t            tileRow,
@@ -2359,6 +2401,11 @@ MOS_STATUS HevcVdencPkt::AddAllCmds_HCP_PAK_INSERT_OBJECT_BRC(PMOS_COMMAND_BUFFE
         m_sliceStatesSize      = m_defaultSliceStatesSize;
         m_slicePatchListSize   = m_defaultSlicePatchListSize;
 
+        if (m_packetUtilities != nullptr)
+        {
+            m_sliceStatesSize += m_packetUtilities->GetSubregionStatusCmdSize(m_statusReport);
+        }
+
         commandBufferSize      = CalculateCommandBufferSize();
         requestedPatchListSize = CalculatePatchListSize();
         return MOS_STATUS_SUCCESS;
@@ -332,6 +332,26 @@ namespace encode
         MOS_STATUS AddSlicesCommandsInTile(
             MOS_COMMAND_BUFFER &cmdBuffer);
 
+        //!
+        //! \brief  Check whether the slices of the current pass report their completion
+        //! \return bool
+        //!         true for the last pass of single pipe encoding with subregion report enabled
+        //!
+        bool IsSliceStatusReported();
+
+        //!
+        //! \brief  Report the completion of a slice once its VD_PIPELINE_FLUSH is added
+        //! \param  [in] cmdBuffer
+        //!         Command buffer
+        //! \param  [in] slcCount
+        //!         Slice index
+        //! \return MOS_STATUS
+        //!         MOS_STATUS_SUCCESS if success, else fail reason
+        //!
+        MOS_STATUS AddSliceStatus(
+            MOS_COMMAND_BUFFER &cmdBuffer,
+            uint32_t            slcCount);
+
         //!
         //! \brief  Update params
         //! \return void
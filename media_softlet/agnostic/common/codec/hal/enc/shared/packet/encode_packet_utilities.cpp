@@ -121,6 +121,63 @@ namespace encode {
         return MOS_STATUS_SUCCESS;
     }
 
+    bool PacketUtilities::IsSubregionReportEnabled(MediaStatusReport *statusReport)
+    {
+        auto encodeStatusReport = dynamic_cast<EncoderStatusReport *>(statusReport);
+        return encodeStatusReport != nullptr && encodeStatusReport->IsSubregionReportEnabled();
+    }
+
+    MOS_STATUS PacketUtilities::AddSubregionStatusCmd(
+        PMOS_COMMAND_BUFFER cmdBuf,
+        MediaStatusReport  *statusReport,
+        uint32_t            subregionIdx,
+        uint32_t            byteCountReg)
+    {
+        ENCODE_FUNC_CALL();
+
+        ENCODE_CHK_NULL_RETURN(cmdBuf);
+        ENCODE_CHK_NULL_RETURN(m_miItf);
+
+        auto encodeStatusReport = dynamic_cast<EncoderStatusReport *>(statusReport);
+        if (encodeStatusReport == nullptr || !encodeStatusReport->IsSubregionReportEnabled())
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+
+        PMOS_RESOURCE osResource = nullptr;
+        uint32_t      offset     = 0;
+        uint32_t      tag        = 0;
+        ENCODE_CHK_STATUS_RETURN(encodeStatusReport->GetSubregionAddress(subregionIdx, osResource, offset, tag));
+
+        auto &miStoreRegMemParams           = m_miItf->MHW_GETPAR_F(MI_STORE_REGISTER_MEM)();
+        miStoreRegMemParams                 = {};
+        miStoreRegMemParams.presStoreBuffer = osResource;
+        miStoreRegMemParams.dwOffset        = offset + CODECHAL_OFFSETOF(EncodeSubregionStatus, bitstreamEnd);
+        miStoreRegMemParams.dwRegister      = byteCountReg;
+        ENCODE_CHK_STATUS_RETURN(m_miItf->MHW_ADDCMD_F(MI_STORE_REGISTER_MEM)(cmdBuf));
+
+        // The post sync write of the flush lands after the offset above
+        auto &flushDwParams            = m_miItf->MHW_GETPAR_F(MI_FLUSH_DW)();
+        flushDwParams                  = {};
+        flushDwParams.pOsResource      = osResource;
+        flushDwParams.dwResourceOffset = offset + CODECHAL_OFFSETOF(EncodeSubregionStatus, tag);
+        flushDwParams.dwDataDW1        = tag;
+        ENCODE_CHK_STATUS_RETURN(m_miItf->MHW_ADDCMD_F(MI_FLUSH_DW)(cmdBuf));
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    uint32_t PacketUtilities::GetSubregionStatusCmdSize(MediaStatusReport *statusReport)
+    {
+        if (m_miItf == nullptr || !IsSubregionReportEnabled(statusReport))
+        {
+            return 0;
+        }
+
+        return m_miItf->MHW_GETSIZE_F(MI_STORE_REGISTER_MEM)() +
+               m_miItf->MHW_GETSIZE_F(MI_FLUSH_DW)();
+    }
+
     MOS_STATUS PacketUtilities::SendMarkerCommand(PMOS_COMMAND_BUFFER cmdBuffer, PMOS_RESOURCE presSetMarker)
     {
         ENCODE_FUNC_CALL();
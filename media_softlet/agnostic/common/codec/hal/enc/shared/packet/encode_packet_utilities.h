@@ -34,6 +34,7 @@
 #include "codechal_debug.h"
 #include "encode_basic_feature.h"
 #include "mhw_vdbox.h"
+#include "encode_status_report.h"
 
 namespace encode
 {
@@ -53,6 +54,43 @@ public:
 
     MOS_STATUS SendPredicationCommand(PMOS_COMMAND_BUFFER cmdBuffer);
 
+    //!
+    //! \brief  Check whether the slices or tiles of the frames report their completion
+    //! \param  [in] statusReport
+    //!         Status report of the pipeline
+    //! \return bool
+    //!         true if EncoderStatusReport::EnableSubregionReport was called
+    //!
+    bool IsSubregionReportEnabled(MediaStatusReport *statusReport);
+
+    //!
+    //! \brief  Report the completion of a slice or tile
+    //! \details Must follow a flush waiting for the subregion to leave the codec pipe,
+    //!          the byte count register then holds the bitstream size up to its end.
+    //! \param  [in] cmdBuf
+    //!         Command buffer
+    //! \param  [in] statusReport
+    //!         Status report of the pipeline
+    //! \param  [in] subregionIdx
+    //!         Slice or tile index in bitstream order
+    //! \param  [in] byteCountReg
+    //!         Register holding the bitstream size of the frame so far
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AddSubregionStatusCmd(
+        PMOS_COMMAND_BUFFER cmdBuf,
+        MediaStatusReport  *statusReport,
+        uint32_t            subregionIdx,
+        uint32_t            byteCountReg);
+
+    //!
+    //! \brief  Get the size of the commands added by AddSubregionStatusCmd
+    //! \return uint32_t
+    //!         Command size in bytes, 0 if subregion report is disabled
+    //!
+    uint32_t GetSubregionStatusCmdSize(MediaStatusReport *statusReport);
+
 #if USE_CODECHAL_DEBUG_TOOL
     //!
     //! \brief  Modify the frame size with fake header size
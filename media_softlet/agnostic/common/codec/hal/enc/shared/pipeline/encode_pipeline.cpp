@@ -122,10 +122,21 @@ MOS_STATUS EncodePipeline::Initialize(void *settings)
     ENCODE_CHK_NULL_RETURN(m_packetUtilities);
     ENCODE_CHK_STATUS_RETURN(m_packetUtilities->Init());
 
-    m_statusReport = MOS_New(EncoderStatusReport, m_allocator, m_osInterface, true, true, cpenable);
-    ENCODE_CHK_NULL_RETURN(m_statusReport);
+    EncoderStatusReport *statusReport = MOS_New(EncoderStatusReport, m_allocator, m_osInterface, true, true, cpenable);
+    ENCODE_CHK_NULL_RETURN(statusReport);
+    m_statusReport = statusReport;
     ENCODE_CHK_STATUS_RETURN(m_statusReport->Create());
 
+    ReadUserSetting(
+        m_userSettingPtr,
+        outValue,
+        __MEDIA_USER_FEATURE_VALUE_ENCODE_SUBREGION_REPORT_ENABLE,
+        MediaUserSetting::Group::Sequence);
+    if (outValue.Get<bool>())
+    {
+        ENCODE_CHK_STATUS_RETURN(statusReport->EnableSubregionReport());
+    }
+
     m_encodecp->setStatusReport(m_statusReport);
 
     ENCODE_CHK_COND_RETURN(
@@ -363,6 +374,22 @@ MOS_STATUS EncodePipeline::ExecuteActivePackets()
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS EncodePipeline::GetSubregionStatus(uint32_t pendingIndex, void *report)
+{
+    ENCODE_FUNC_CALL();
+
+    ENCODE_CHK_NULL_RETURN(report);
+
+    auto statusReport = dynamic_cast<EncoderStatusReport *>(m_statusReport);
+    ENCODE_CHK_NULL_RETURN(statusReport);
+    if (!statusReport->IsSubregionReportEnabled())
+    {
+        return MOS_STATUS_UNIMPLEMENTED;
+    }
+
+    return statusReport->GetSubregionReport(pendingIndex, *(EncodeSubregionReport *)report);
+}
+
 MOS_STATUS EncodePipeline::ExecuteResolveMetaData(PMOS_RESOURCE pInput, PMOS_RESOURCE pOutput)
 {
     ENCODE_FUNC_CALL();
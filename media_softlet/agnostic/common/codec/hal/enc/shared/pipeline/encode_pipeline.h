@@ -46,6 +46,8 @@
 #define CONSTRUCTPACKETID(_componentId, _subComponentId, _packetId) \
     (_componentId << 24 | _subComponentId << 16 | _packetId)
 
+#define __MEDIA_USER_FEATURE_VALUE_ENCODE_SUBREGION_REPORT_ENABLE "Encode Subregion Report Enable"
+
 namespace encode
 {
 class EncodePipeline : public MediaPipeline
@@ -323,6 +325,17 @@ public:
 
     MOS_STATUS ExecuteResolveMetaData(PMOS_RESOURCE pInput, PMOS_RESOURCE pOutput);
 
+    //!
+    //! \brief  Get the completed slices or tiles of a frame not reported yet
+    //! \param  [in] pendingIndex
+    //!         Position of the frame among the frames not reported by GetStatusReport, 0 for the oldest
+    //! \param  [out] report
+    //!         Pointer to EncodeSubregionReport
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, MOS_STATUS_UNIMPLEMENTED if subregion report is disabled
+    //!
+    MOS_STATUS GetSubregionStatus(uint32_t pendingIndex, void *report);
+
     MOS_STATUS ReportErrorFlag(PMOS_RESOURCE pMetadataBuffer,
         uint32_t size, uint32_t offset, uint32_t flag);
 
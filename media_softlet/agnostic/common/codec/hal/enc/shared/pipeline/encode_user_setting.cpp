@@ -100,6 +100,13 @@ MOS_STATUS EncodePipeline::InitUserSetting(MediaUserSettingSharedPtr userSetting
         int32_t(1),
         false);
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_ENCODE_SUBREGION_REPORT_ENABLE,
+        MediaUserSetting::Group::Sequence,
+        int32_t(0),
+        false);
+
     DeclareUserSettingKey(
         userSettingPtr,
         "TF Downscale Method",
@@ -259,6 +259,9 @@ namespace encode {
             MOS_ZeroMemory((uint8_t*)encodeStatusRcs, m_statusBufSizeRcs);
         }
 
+        // Subregion reports of the previous use of the slot are told apart by their tag
+        m_subregionNum[submitIndex] = 0;
+
         return eStatus;
     }
 
@@ -267,6 +270,96 @@ namespace encode {
         return m_hwcounterBuf;
     }
 
+    MOS_STATUS EncoderStatusReport::EnableSubregionReport()
+    {
+        ENCODE_FUNC_CALL();
+
+        if (m_subregionBuf != nullptr)
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+
+        MOS_ALLOC_GFXRES_PARAMS param;
+        MOS_ZeroMemory(&param, sizeof(MOS_ALLOC_GFXRES_PARAMS));
+        param.Type          = MOS_GFXRES_BUFFER;
+        param.TileType      = MOS_TILE_LINEAR;
+        param.Format        = Format_Buffer;
+        param.dwBytes       = sizeof(EncodeSubregionStatus) * ENCODE_SUBREGION_REPORT_MAX_NUM * m_statusNum;
+        param.ResUsageType  = MOS_HW_RESOURCE_USAGE_ENCODE_INTERNAL_READ_WRITE_NOCACHE;
+        param.pBufName      = "StatusQueryBufferSubregion";
+        // keeping status buffer persistent since its used in all command buffers
+        param.bIsPersistent = true;
+
+        m_subregionBuf = m_allocator->AllocateResource(param, true);
+        ENCODE_CHK_NULL_RETURN(m_subregionBuf);
+        ENCODE_CHK_STATUS_RETURN(m_allocator->SkipResourceSync(m_subregionBuf));
+
+        m_dataSubregion = (EncodeSubregionStatus *)m_allocator->LockResourceForRead(m_subregionBuf);
+        ENCODE_CHK_NULL_RETURN(m_dataSubregion);
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS EncoderStatusReport::GetSubregionAddress(
+        uint32_t      subregionIdx,
+        PMOS_RESOURCE &osResource,
+        uint32_t      &offset,
+        uint32_t      &tag)
+    {
+        ENCODE_CHK_NULL_RETURN(m_subregionBuf);
+
+        uint32_t submitIndex = CounterToIndex(m_submittedCount);
+
+        // Subregions beyond the last entry overwrite it, it then ends with the last one
+        subregionIdx                = MOS_MIN(subregionIdx, ENCODE_SUBREGION_REPORT_MAX_NUM - 1);
+        m_subregionNum[submitIndex] = MOS_MAX(m_subregionNum[submitIndex], subregionIdx + 1);
+
+        osResource = m_subregionBuf;
+        offset     = (submitIndex * ENCODE_SUBREGION_REPORT_MAX_NUM + subregionIdx) * sizeof(EncodeSubregionStatus);
+        // Never 0, so a cleared entry does not look written
+        tag        = m_submittedCount + 1;
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS EncoderStatusReport::GetSubregionReport(uint32_t pendingIndex, EncodeSubregionReport &report)
+    {
+        ENCODE_CHK_NULL_RETURN(m_completedCount);
+        ENCODE_CHK_NULL_RETURN(m_dataSubregion);
+
+        MOS_ZeroMemory(&report, sizeof(report));
+
+        Lock();
+
+        if (pendingIndex >= m_submittedCount - m_reportedCount)
+        {
+            UnLock();
+            return MOS_STATUS_INVALID_PARAMETER;
+        }
+
+        uint32_t counter = m_reportedCount + pendingIndex;
+        uint32_t index   = CounterToIndex(counter);
+
+        report.frameCompleted = (int32_t)(*m_completedCount - counter) > 0;
+        report.subregionNum   = m_subregionNum[index];
+
+        volatile EncodeSubregionStatus *status = m_dataSubregion + index * ENCODE_SUBREGION_REPORT_MAX_NUM;
+        for (uint32_t i = 0; i < report.subregionNum; i++)
+        {
+            // The GPU writes the tag after the offset, check it first
+            if (status[i].tag != counter + 1)
+            {
+                break;
+            }
+            report.bitstreamEnd[i] = status[i].bitstreamEnd;
+            report.completedNum++;
+        }
+
+        UnLock();
+
+        return MOS_STATUS_SUCCESS;
+    }
+
     MOS_STATUS EncoderStatusReport::GetCommonMfxReportData(EncodeStatusReportData *statusReportData, uint32_t index)
     {
         EncodeStatusMfx *encodeStatusMfx = nullptr;
@@ -391,6 +484,8 @@ namespace encode {
             statusReportData->codecStatus = CODECHAL_STATUS_SUCCESSFUL;
         }
 
+        ENCODE_CHK_STATUS_RETURN(ReportGpuTiming(COMPONENT_Encode, statusReportData->gpuEngineTimeNs));
+
         // The frame is completed, notify the observers
         if (statusReportData->codecStatus == CODECHAL_STATUS_SUCCESSFUL)
         {
@@ -478,6 +573,14 @@ namespace encode {
             m_statusBufRcs = nullptr;
         }
 
+        if (m_subregionBuf != nullptr)
+        {
+            m_allocator->UnLock(m_subregionBuf);
+            m_allocator->DestroyResource(m_subregionBuf);
+            m_subregionBuf  = nullptr;
+            m_dataSubregion = nullptr;
+        }
+
         if (m_statusBufAddr != nullptr)
         {
             MOS_DeleteArray(m_statusBufAddr);
@@ -298,6 +298,8 @@ namespace encode {
         uint32_t                        frameHeight;
 
         uint32_t                        targetFrameSize;
+
+        uint64_t                        gpuEngineTimeNs[MediaGpuTiming::engineNum];  //!< GPU busy time of the frame in ns per MediaGpuTiming::Engine, 0 if GPU frame timing is disabled
         uint32_t                        brcMode;
 
         uint32_t                        MSE[3];
@@ -359,6 +361,43 @@ namespace encode {
 
         virtual PMOS_RESOURCE GetHwCtrBuf();
 
+        //!
+        //! \brief  Let the slices or tiles of every frame report their completion
+        //! \details The GPU writes each report as soon as the subregion is in the bitstream
+        //!          buffer, so an application can send it before the frame is done.
+        //! \return MOS_STATUS
+        //!         MOS_STATUS_SUCCESS if success, else fail reason
+        //!
+        MOS_STATUS EnableSubregionReport();
+
+        bool IsSubregionReportEnabled() const { return m_dataSubregion != nullptr; }
+
+        //!
+        //! \brief  Get where the GPU reports the completion of a subregion of the frame being submitted
+        //! \param  [in] subregionIdx
+        //!         Slice or tile index in bitstream order
+        //! \param  [out] osResource
+        //!         Resource to write the EncodeSubregionStatus to
+        //! \param  [out] offset
+        //!         Offset of the EncodeSubregionStatus in osResource
+        //! \param  [out] tag
+        //!         Value to write to EncodeSubregionStatus::tag once bitstreamEnd is written
+        //! \return MOS_STATUS
+        //!         MOS_STATUS_SUCCESS if success, else fail reason
+        //!
+        MOS_STATUS GetSubregionAddress(uint32_t subregionIdx, PMOS_RESOURCE &osResource, uint32_t &offset, uint32_t &tag);
+
+        //!
+        //! \brief  Get the completed subregions of a frame not reported yet
+        //! \param  [in] pendingIndex
+        //!         Position of the frame among the frames not reported by GetReport, 0 for the oldest
+        //! \param  [out] report
+        //!         Subregions completed so far
+        //! \return MOS_STATUS
+        //!         MOS_STATUS_SUCCESS if success, MOS_STATUS_INVALID_PARAMETER if no such frame was submitted
+        //!
+        MOS_STATUS GetSubregionReport(uint32_t pendingIndex, EncodeSubregionReport &report);
+
 #if (_DEBUG || _RELEASE_INTERNAL)
         //!
         //! \brief  Report Used Vdbox Ids
@@ -452,6 +491,9 @@ namespace encode {
         PMOS_RESOURCE           m_hwcounterBuf  = nullptr;
         uint64_t *              m_hwcounter     = nullptr;
         uint32_t *              m_hwcounterBase = nullptr;
+        PMOS_RESOURCE           m_subregionBuf  = nullptr;
+        EncodeSubregionStatus  *m_dataSubregion = nullptr;
+        uint32_t                m_subregionNum[m_statusNum] = {};
 
         EncodeAllocator        *m_allocator = nullptr;  //!< encoder allocator
 
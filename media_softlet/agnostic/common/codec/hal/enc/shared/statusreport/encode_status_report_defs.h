@@ -31,6 +31,11 @@
 #include "codec_def_common.h"
 #include "media_status_report.h"
 
+//!
+//! \brief  Slices or tiles reported per frame, the ones beyond it are merged into the last report
+//!
+#define ENCODE_SUBREGION_REPORT_MAX_NUM     64
+
 namespace encode
 {
 enum EncodeStatusReportType
@@ -416,6 +421,26 @@ struct EncodeStatusRcs
     } executingStatus[statusReportRcsMaxNum];   //!< Media states of stored encode data
 };
 
+//!
+//! \brief  Completion of one slice or tile, written by the GPU once the subregion is in the bitstream buffer
+//!
+struct EncodeSubregionStatus
+{
+    uint32_t                        bitstreamEnd;   //!< Bitstream bytes of the frame up to the end of the subregion
+    uint32_t                        tag;            //!< Counter of the frame plus one, written after bitstreamEnd
+};
+
+//!
+//! \brief  Completion of the slices or tiles of one frame
+//!
+struct EncodeSubregionReport
+{
+    uint32_t                        subregionNum;   //!< Subregions reported by the frame
+    uint32_t                        completedNum;   //!< Leading subregions already in the bitstream buffer
+    bool                            frameCompleted; //!< Whole frame done, its frame status report is available
+    uint32_t                        bitstreamEnd[ENCODE_SUBREGION_REPORT_MAX_NUM];  //!< End offset of each completed subregion
+};
+
 struct VDEncStatusReportParam
 {
     bool          vdEncBRCEnabled;
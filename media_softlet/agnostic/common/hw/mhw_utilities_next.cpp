@@ -25,6 +25,9 @@
 //!
 
 #include <math.h>
+#include <string.h>
+#include <atomic>
+#include <new>
 #include <set>
 #include "mhw_utilities_next.h"
 #include "mhw_state_heap.h"
@@ -676,6 +679,193 @@ MOS_STATUS Mhw_SetNearestModeTable(
     return eStatus;
 }
 
+//!
+//! \brief    Everything a polyphase table depends on
+//! \details  Scale factor, HP strength and Lanczos factor are kept as raw float bits,
+//!           so a hit returns exactly the table the calculation would produce.
+//!
+enum MHW_POLYPHASE_TABLE_TYPE
+{
+    MHW_POLYPHASE_TABLE_Y = 0,
+    MHW_POLYPHASE_TABLE_UV,
+    MHW_POLYPHASE_TABLE_UV_OFFSET
+};
+
+struct MHW_POLYPHASE_KEY
+{
+    uint32_t type;              //!< MHW_POLYPHASE_TABLE_TYPE
+    uint32_t numEntries;
+    uint32_t hwPhase;
+    uint32_t use8x8Filter;
+    uint32_t hpFilter;          //!< HP convolution, Y and generic planes only
+    uint32_t scaleFactor;
+    uint32_t hpStrength;
+    uint32_t lanczosT;
+    int32_t  uvPhaseOffset;     //!< Chroma siting
+};
+
+#define MHW_POLYPHASE_CACHE_MAX_COEFS   (NUM_HW_POLYPHASE_TABLES * NUM_POLYPHASE_Y_ENTRIES)
+
+struct MHW_POLYPHASE_ENTRY
+{
+    MHW_POLYPHASE_KEY key;
+    uint32_t          coefNum;
+    int32_t           coefs[MHW_POLYPHASE_CACHE_MAX_COEFS];
+};
+
+//!
+//! \brief    Process wide cache of polyphase tables
+//! \details  Scaling ladders and multi-layer composition ask for the same few tables
+//!           every frame. Entries are immutable once published and never evicted, so
+//!           readers only need an acquire load per probe. A table which finds no free
+//!           slot is simply not cached. Entries are plain heap allocations because they
+//!           outlive every MOS instance and must not show up in its leak counters.
+//!
+class MhwPolyphaseCache
+{
+public:
+    MhwPolyphaseCache()
+    {
+        for (auto &slot : m_slots)
+        {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~MhwPolyphaseCache()
+    {
+        for (auto &slot : m_slots)
+        {
+            delete slot.exchange(nullptr);
+        }
+    }
+
+    template <typename Generate>
+    MOS_STATUS GetTables(const MHW_POLYPHASE_KEY &key, int32_t *coefs, uint32_t coefNum, Generate generate)
+    {
+        if (coefNum > MHW_POLYPHASE_CACHE_MAX_COEFS)
+        {
+            return generate(coefs);
+        }
+
+        uint32_t hash = Hash(key);
+        for (uint32_t i = 0; i < m_maxProbeNum; i++)
+        {
+            MHW_POLYPHASE_ENTRY *entry = m_slots[(hash + i) % m_slotNum].load(std::memory_order_acquire);
+            if (entry == nullptr)
+            {
+                break;
+            }
+            if (entry->coefNum == coefNum && memcmp(&entry->key, &key, sizeof(key)) == 0)
+            {
+                MOS_SecureMemcpy(coefs, coefNum * sizeof(int32_t), entry->coefs, coefNum * sizeof(int32_t));
+                return MOS_STATUS_SUCCESS;
+            }
+        }
+
+        MOS_STATUS eStatus = generate(coefs);
+        if (eStatus != MOS_STATUS_SUCCESS)
+        {
+            return eStatus;
+        }
+
+        MHW_POLYPHASE_ENTRY *newEntry = new (std::nothrow) MHW_POLYPHASE_ENTRY;
+        if (newEntry == nullptr)
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+        newEntry->key     = key;
+        newEntry->coefNum = coefNum;
+        MOS_SecureMemcpy(newEntry->coefs, sizeof(newEntry->coefs), coefs, coefNum * sizeof(int32_t));
+
+        for (uint32_t i = 0; i < m_maxProbeNum; i++)
+        {
+            std::atomic<MHW_POLYPHASE_ENTRY *> &slot     = m_slots[(hash + i) % m_slotNum];
+            MHW_POLYPHASE_ENTRY                *expected = nullptr;
+            if (slot.compare_exchange_strong(expected, newEntry, std::memory_order_acq_rel))
+            {
+                return MOS_STATUS_SUCCESS;
+            }
+            if (expected->coefNum == coefNum && memcmp(&expected->key, &key, sizeof(key)) == 0)
+            {
+                // Published by another thread meanwhile
+                break;
+            }
+        }
+
+        delete newEntry;
+        return MOS_STATUS_SUCCESS;
+    }
+
+private:
+    static uint32_t Hash(const MHW_POLYPHASE_KEY &key)
+    {
+        // FNV-1a
+        const uint8_t *data = (const uint8_t *)&key;
+        uint32_t       hash = 2166136261u;
+        for (uint32_t i = 0; i < sizeof(key); i++)
+        {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    static constexpr uint32_t m_slotNum     = 256;
+    static constexpr uint32_t m_maxProbeNum = 8;
+
+    std::atomic<MHW_POLYPHASE_ENTRY *> m_slots[m_slotNum];
+};
+
+static MhwPolyphaseCache s_polyphaseCache;
+
+static uint32_t Mhw_FloatBits(float value)
+{
+    uint32_t bits = 0;
+    MOS_SecureMemcpy(&bits, sizeof(bits), &value, sizeof(value));
+    return bits;
+}
+
+//!
+//! \brief      Get the Lanczos factor used for the Y polyphase tables
+//! \details    The Lanczos factor only depends on the format class, the plane and
+//!             whether the plane is downscaled.
+//! \param      float   fScaleFactor
+//!             [in]    Scaling factor
+//! \param      uint32_t   dwPlane
+//!             [in]    Plane Info
+//! \param      MOS_FORMAT srcFmt
+//!             [in]    Source Format
+//! \return     float
+//!             Lanczos factor
+//!
+static float Mhw_GetPolyphaseLanczosTY(
+    float           fScaleFactor,
+    uint32_t        dwPlane,
+    MOS_FORMAT      srcFmt)
+{
+    if ((IS_YUV_FORMAT(srcFmt)    &&
+        dwPlane != MHW_U_PLANE    &&
+        dwPlane != MHW_V_PLANE)   ||
+        ((IS_RGB32_FORMAT(srcFmt) ||
+        srcFmt == Format_Y410     ||
+        srcFmt == Format_AYUV)    &&
+        dwPlane == MHW_Y_PLANE))
+    {
+        if (fScaleFactor < 1.0F)
+        {
+            return 4.0F;
+        }
+        else
+        {
+            return 8.0F;
+        }
+    }
+    else // if (dwPlane == MHW_U_PLANE || dwPlane == MHW_V_PLANE || (IS_RGB_FORMAT(srcFmt) && dwPlane != MHW_V_PLANE))
+    {
+        return 2.0F;
+    }
+}
+
 //!
 //! \brief      Calculate Polyphase tables for Y , across SFC and Render engine to set the sampler states
 //! \details    Calculate Polyphase tables for Y
@@ -701,7 +891,7 @@ MOS_STATUS Mhw_SetNearestModeTable(
 //! \return   MOS_STATUS
 //!           MOS_STATUS_SUCCESS if success, else fail reason
 //!
-MOS_STATUS Mhw_CalcPolyphaseTablesY(
+static MOS_STATUS Mhw_GeneratePolyphaseTablesY(
     int32_t         *iCoefs,
     float           fScaleFactor,
     uint32_t        dwPlane,
@@ -745,27 +935,7 @@ MOS_STATUS Mhw_CalcPolyphaseTablesY(
     iCenterPixel = dwNumEntries / 2 - 1;
     fStartOffset = (float)(-iCenterPixel);
 
-    if ((IS_YUV_FORMAT(srcFmt)    &&
-        dwPlane != MHW_U_PLANE    &&
-        dwPlane != MHW_V_PLANE)   ||
-        ((IS_RGB32_FORMAT(srcFmt) ||
-        srcFmt == Format_Y410     ||
-        srcFmt == Format_AYUV)    &&
-        dwPlane == MHW_Y_PLANE))
-    {
-        if (fScaleFactor < 1.0F)
-        {
-            fLanczosT = 4.0F;
-        }
-        else
-        {
-            fLanczosT = 8.0F;
-        }
-    }
-    else // if (dwPlane == MHW_U_PLANE || dwPlane == MHW_V_PLANE || (IS_RGB_FORMAT(srcFmt) && dwPlane != MHW_V_PLANE))
-    {
-        fLanczosT = 2.0F;
-    }
+    fLanczosT = Mhw_GetPolyphaseLanczosTY(fScaleFactor, dwPlane, srcFmt);
 
     for (i = 0; i < dwHwPhase; i++)
     {
@@ -850,7 +1020,7 @@ MOS_STATUS Mhw_CalcPolyphaseTablesY(
 //! \return   MOS_STATUS
 //!           MOS_STATUS_SUCCESS if success, else fail reason
 //!
-MOS_STATUS Mhw_CalcPolyphaseTablesUV(
+static MOS_STATUS Mhw_GeneratePolyphaseTablesUV(
     int32_t    *piCoefs,
     float      fLanczosT,
     float      fInverseScaleFactor)
@@ -941,7 +1111,7 @@ MOS_STATUS Mhw_CalcPolyphaseTablesUV(
 //! \return   MOS_STATUS
 //!           MOS_STATUS_SUCCESS if success, else fail reason
 //!
-MOS_STATUS Mhw_CalcPolyphaseTablesUVOffset(
+static MOS_STATUS Mhw_GeneratePolyphaseTablesUVOffset(
     int32_t     *piCoefs,
     float       fLanczosT,
     float       fInverseScaleFactor,
@@ -1021,6 +1191,88 @@ MOS_STATUS Mhw_CalcPolyphaseTablesUVOffset(
     return eStatus;
 }
 
+MOS_STATUS Mhw_CalcPolyphaseTablesY(
+    int32_t         *iCoefs,
+    float           fScaleFactor,
+    uint32_t        dwPlane,
+    MOS_FORMAT      srcFmt,
+    float           fHPStrength,
+    bool            bUse8x8Filter,
+    uint32_t        dwHwPhase,
+    float           fLanczosT)
+{
+    MHW_FUNCTION_ENTER;
+
+    MHW_CHK_NULL_RETURN(iCoefs);
+
+    bool hpFilter = (dwPlane == MHW_GENERIC_PLANE || dwPlane == MHW_Y_PLANE);
+
+    MHW_POLYPHASE_KEY key;
+    MOS_ZeroMemory(&key, sizeof(key));
+    key.type         = MHW_POLYPHASE_TABLE_Y;
+    key.numEntries   = hpFilter ? NUM_POLYPHASE_Y_ENTRIES : NUM_POLYPHASE_UV_ENTRIES;
+    key.hwPhase      = dwHwPhase;
+    key.use8x8Filter = bUse8x8Filter;
+    key.hpFilter     = hpFilter;
+    key.scaleFactor  = Mhw_FloatBits(fScaleFactor);
+    key.hpStrength   = hpFilter ? Mhw_FloatBits(fHPStrength) : 0;
+    key.lanczosT     = Mhw_FloatBits(Mhw_GetPolyphaseLanczosTY(fScaleFactor, dwPlane, srcFmt));
+
+    return s_polyphaseCache.GetTables(key, iCoefs, dwHwPhase * key.numEntries, [&](int32_t *coefs) {
+        return Mhw_GeneratePolyphaseTablesY(coefs, fScaleFactor, dwPlane, srcFmt, fHPStrength, bUse8x8Filter, dwHwPhase, fLanczosT);
+    });
+}
+
+MOS_STATUS Mhw_CalcPolyphaseTablesUV(
+    int32_t    *piCoefs,
+    float      fLanczosT,
+    float      fInverseScaleFactor)
+{
+    MHW_FUNCTION_ENTER;
+
+    MHW_CHK_NULL_RETURN(piCoefs);
+
+    double sf = MOS_MIN(1.0, fInverseScaleFactor);
+
+    MHW_POLYPHASE_KEY key;
+    MOS_ZeroMemory(&key, sizeof(key));
+    key.type        = MHW_POLYPHASE_TABLE_UV;
+    key.numEntries  = MHW_SCALER_UV_WIN_SIZE;
+    key.hwPhase     = MHW_TABLE_PHASE_COUNT;
+    key.scaleFactor = Mhw_FloatBits((float)sf);
+    key.lanczosT    = Mhw_FloatBits((sf < 1.0F) ? 2.0F : fLanczosT);
+
+    return s_polyphaseCache.GetTables(key, piCoefs, MHW_SCALER_UV_WIN_SIZE * MHW_TABLE_PHASE_COUNT, [&](int32_t *coefs) {
+        return Mhw_GeneratePolyphaseTablesUV(coefs, fLanczosT, fInverseScaleFactor);
+    });
+}
+
+MOS_STATUS Mhw_CalcPolyphaseTablesUVOffset(
+    int32_t     *piCoefs,
+    float       fLanczosT,
+    float       fInverseScaleFactor,
+    int32_t     iUvPhaseOffset)
+{
+    MHW_FUNCTION_ENTER;
+
+    MHW_CHK_NULL_RETURN(piCoefs);
+
+    double sf = MOS_MIN(1.0, fInverseScaleFactor);
+
+    MHW_POLYPHASE_KEY key;
+    MOS_ZeroMemory(&key, sizeof(key));
+    key.type          = MHW_POLYPHASE_TABLE_UV_OFFSET;
+    key.numEntries    = MHW_SCALER_UV_WIN_SIZE;
+    key.hwPhase       = MHW_TABLE_PHASE_COUNT;
+    key.scaleFactor   = Mhw_FloatBits((float)sf);
+    key.lanczosT      = Mhw_FloatBits((sf < 1.0) ? 3.0F : fLanczosT);
+    key.uvPhaseOffset = iUvPhaseOffset;
+
+    return s_polyphaseCache.GetTables(key, piCoefs, MHW_SCALER_UV_WIN_SIZE * MHW_TABLE_PHASE_COUNT, [&](int32_t *coefs) {
+        return Mhw_GeneratePolyphaseTablesUVOffset(coefs, fLanczosT, fInverseScaleFactor, iUvPhaseOffset);
+    });
+}
+
 //!
 //! \brief    Allocate BB
 //! \details  Allocated Batch Buffer
@@ -141,6 +141,20 @@ public:
         uint32_t *commandsSize,
         uint32_t *patchListSize,
         bool      modeSpecific) = 0;
+
+    //!
+    //! \brief    Create another instance of this interface on the same OS interface
+    //! \details  Command parameters are kept per instance, so separate instances can
+    //!           build slice and tile level commands on different threads.
+    //!
+    //! \return   std::shared_ptr<Itf>
+    //!           New instance, nullptr if the platform does not support it
+    //!
+    virtual std::shared_ptr<Itf> CreateInstance()
+    {
+        return nullptr;
+    }
+
     //!
     //! \brief    Get Hcp Cabac Error Flags Mask
     //!
@@ -40,6 +40,9 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_rtlog_mgr_base.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_cache_manager.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_hybrid_cmd_manager.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_async_lock.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_memory_usage.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_worker_pool.cpp
 )
 
 set(TMP_HEADERS_
@@ -63,6 +66,9 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_rtlog_mgr_base.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_cache_manager.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_hybrid_cmd_manager.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_async_lock.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_memory_usage.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_worker_pool.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_bypass_hw_defs.h
 )
 
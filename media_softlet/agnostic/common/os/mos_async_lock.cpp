@@ -0,0 +1,168 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_async_lock.cpp
+//! \brief    Queue of resource locks which are served once the GPU is done with the resource
+//!
+#include <algorithm>
+#include <vector>
+#include "mos_async_lock.h"
+#include "mos_interface.h"
+#include "mos_util_debug.h"
+
+MosAsyncLockQueue::MosAsyncLockQueue(MOS_STREAM_HANDLE streamState)
+    : m_streamState(streamState)
+{
+}
+
+MosAsyncLockQueue::~MosAsyncLockQueue()
+{
+    Process(nullptr, true);
+}
+
+uint64_t MosAsyncLockQueue::GetKey(MOS_RESOURCE_HANDLE resource)
+{
+    return MosInterface::GetResourceHandle(m_streamState, resource);
+}
+
+bool MosAsyncLockQueue::IsBusy(MOS_RESOURCE_HANDLE resource)
+{
+    return MosInterface::IsResourceBusy(m_streamState, resource);
+}
+
+void *MosAsyncLockQueue::Lock(MOS_RESOURCE_HANDLE resource, MOS_LOCK_PARAMS *flags)
+{
+    return MosInterface::LockMosResource(m_streamState, resource, flags);
+}
+
+MOS_STATUS MosAsyncLockQueue::Unlock(MOS_RESOURCE_HANDLE resource)
+{
+    return MosInterface::UnlockMosResource(m_streamState, resource);
+}
+
+uint32_t MosAsyncLockQueue::GetPendingNum()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (uint32_t)m_pendingLocks.size();
+}
+
+MOS_STATUS MosAsyncLockQueue::Add(MOS_RESOURCE_HANDLE resource, const MOS_LOCK_PARAMS &flags, MosAsyncLockCallback callback)
+{
+    MOS_OS_CHK_NULL_RETURN(resource);
+    MOS_OS_CHK_NULL_RETURN(callback);
+
+    PendingLock pendingLock;
+    pendingLock.key      = GetKey(resource);
+    pendingLock.resource = *resource;
+    pendingLock.flags    = flags;
+    pendingLock.callback = std::move(callback);
+
+    bool serveNow = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Locks of one resource are served in order, so a new lock can only bypass
+        // the queue if no earlier lock of the resource is waiting.
+        bool queued = std::any_of(m_pendingLocks.begin(), m_pendingLocks.end(),
+            [&](const PendingLock &pending) { return pending.key == pendingLock.key; });
+        serveNow = !queued && !IsBusy(resource);
+        if (!serveNow)
+        {
+            m_pendingLocks.push_back(std::move(pendingLock));
+        }
+    }
+
+    MOS_STATUS status = serveNow ? Serve(pendingLock) : MOS_STATUS_SUCCESS;
+
+    // Give locks queued earlier a chance as well
+    MOS_STATUS processStatus = Process(nullptr, false);
+    return (status != MOS_STATUS_SUCCESS) ? status : processStatus;
+}
+
+MOS_STATUS MosAsyncLockQueue::Process(MOS_RESOURCE_HANDLE resource, bool wait)
+{
+    std::vector<PendingLock> readyLocks;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pendingLocks.empty())
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+
+        uint64_t              key = resource ? GetKey(resource) : 0;
+        std::vector<uint64_t> busyKeys;
+        for (auto it = m_pendingLocks.begin(); it != m_pendingLocks.end();)
+        {
+            if (resource != nullptr && it->key != key)
+            {
+                ++it;
+                continue;
+            }
+
+            // Once a lock of a resource is left in the queue, later locks of the
+            // same resource stay behind it.
+            bool busy = std::find(busyKeys.begin(), busyKeys.end(), it->key) != busyKeys.end();
+            if (!busy && !wait && IsBusy(&it->resource))
+            {
+                busyKeys.push_back(it->key);
+                busy = true;
+            }
+
+            if (busy)
+            {
+                ++it;
+                continue;
+            }
+
+            readyLocks.push_back(std::move(*it));
+            it = m_pendingLocks.erase(it);
+        }
+    }
+
+    // Callbacks run without the queue mutex, they may queue new locks.
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+    for (auto &readyLock : readyLocks)
+    {
+        MOS_STATUS lockStatus = Serve(readyLock);
+        if (status == MOS_STATUS_SUCCESS)
+        {
+            status = lockStatus;
+        }
+    }
+
+    return status;
+}
+
+MOS_STATUS MosAsyncLockQueue::Serve(PendingLock &pendingLock)
+{
+    // The resource is idle unless the caller asked to wait, so this lock only
+    // blocks in the wait case.
+    void *data = Lock(&pendingLock.resource, &pendingLock.flags);
+    pendingLock.callback(data);
+
+    if (data == nullptr)
+    {
+        MOS_OS_ASSERTMESSAGE("Async lock of resource failed");
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    return Unlock(&pendingLock.resource);
+}
@@ -0,0 +1,132 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_async_lock.h
+//! \brief    Queue of resource locks which are served once the GPU is done with the resource
+//! \details  A plain lock of a resource still used by the GPU blocks the calling thread
+//!           until the GPU catches up. An async lock instead queues a callback which gets
+//!           the locked data once the last GPU use of the resource retired. Queued locks
+//!           are polled when new locks are queued. They are served, waiting if needed,
+//!           before the next command buffer submission of the stream, before a plain lock
+//!           or free of the same resource and when the stream is destroyed. Commands
+//!           submitted after an async lock therefore see what its callback wrote.
+//!
+#ifndef __MOS_ASYNC_LOCK_H__
+#define __MOS_ASYNC_LOCK_H__
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include "mos_defs.h"
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+//!
+//! \brief  Called with the locked data, or nullptr if the lock failed. The resource is
+//!         unlocked when the callback returns.
+//!
+using MosAsyncLockCallback = std::function<void(void *data)>;
+
+class MosAsyncLockQueue
+{
+public:
+    //!
+    //! \brief  Constructor
+    //! \param  [in] streamState
+    //!         Stream the queued locks are done on
+    //!
+    MosAsyncLockQueue(MOS_STREAM_HANDLE streamState);
+
+    //!
+    //! \brief  Destructor, waits for and serves every queued lock
+    //!
+    virtual ~MosAsyncLockQueue();
+
+    //!
+    //! \brief  Queue a lock of resource
+    //! \details Served right away if the resource is idle and has no earlier queued lock.
+    //! \param  [in] resource
+    //!         Resource to lock, copied. The allocation must stay until the callback ran.
+    //! \param  [in] flags
+    //!         Lock flags
+    //! \param  [in] callback
+    //!         Callback receiving the locked data
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason of a lock served by this call
+    //!
+    MOS_STATUS Add(MOS_RESOURCE_HANDLE resource, const MOS_LOCK_PARAMS &flags, MosAsyncLockCallback callback);
+
+    //!
+    //! \brief  Serve queued locks
+    //! \param  [in] resource
+    //!         Only serve locks of this resource, nullptr for all resources
+    //! \param  [in] wait
+    //!         Wait for the GPU instead of skipping busy resources
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else the first failure
+    //!
+    MOS_STATUS Process(MOS_RESOURCE_HANDLE resource, bool wait);
+
+    //!
+    //! \brief  Get number of queued locks
+    //!
+    uint32_t GetPendingNum();
+
+protected:
+    struct PendingLock
+    {
+        uint64_t             key      = 0;      //!< Allocation of the resource, same for all copies of it
+        MOS_RESOURCE         resource = {};
+        MOS_LOCK_PARAMS      flags    = {};
+        MosAsyncLockCallback callback = nullptr;
+    };
+
+    //!
+    //! \brief  Identify the allocation of a resource
+    //!
+    virtual uint64_t GetKey(MOS_RESOURCE_HANDLE resource);
+
+    //!
+    //! \brief  Check whether the GPU still uses a resource, does not block
+    //!
+    virtual bool IsBusy(MOS_RESOURCE_HANDLE resource);
+
+    //!
+    //! \brief  Lock a resource, waits for the GPU if it is busy
+    //!
+    virtual void *Lock(MOS_RESOURCE_HANDLE resource, MOS_LOCK_PARAMS *flags);
+
+    //!
+    //! \brief  Unlock a resource
+    //!
+    virtual MOS_STATUS Unlock(MOS_RESOURCE_HANDLE resource);
+
+    MOS_STATUS Serve(PendingLock &lock);
+
+    MOS_STREAM_HANDLE       m_streamState = nullptr;
+    std::deque<PendingLock> m_pendingLocks;
+    std::mutex              m_mutex;
+
+MEDIA_CLASS_DEFINE_END(MosAsyncLockQueue)
+};
+
+#endif  // __MOS_ASYNC_LOCK_H__
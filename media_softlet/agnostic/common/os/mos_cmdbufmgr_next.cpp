@@ -59,9 +59,11 @@ MOS_STATUS CmdBufMgrNext::Initialize(OsContextNext *osContext, uint32_t cmdBufSi
 
         m_inUsePoolMutex     = MosUtilities::MosCreateMutex();
         MOS_OS_CHK_NULL_RETURN(m_inUsePoolMutex);
+        MosUtilities::MosSetMutexName(m_inUsePoolMutex, "CmdBufMgr.InUsePool");
 
         m_availablePoolMutex = MosUtilities::MosCreateMutex();
         MOS_OS_CHK_NULL_RETURN(m_availablePoolMutex);
+        MosUtilities::MosSetMutexName(m_availablePoolMutex, "CmdBufMgr.AvailablePool");
 
         for (uint32_t i = 0; i < m_initBufNum; i++)
         {
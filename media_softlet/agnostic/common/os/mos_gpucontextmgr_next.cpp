@@ -68,9 +68,11 @@ MOS_STATUS GpuContextMgrNext::Initialize()
     MOS_STATUS status = MOS_STATUS_SUCCESS;
     m_gpuContextArrayMutex = MosUtilities::MosCreateMutex();
     MOS_OS_CHK_NULL_RETURN(m_gpuContextArrayMutex);
+    MosUtilities::MosSetMutexName(m_gpuContextArrayMutex, "GpuContextMgr.ContextArray");
 
     m_gpuContextDeleteArrayMutex = MosUtilities::MosCreateMutex();
     MOS_OS_CHK_NULL_RETURN(m_gpuContextDeleteArrayMutex);
+    MosUtilities::MosSetMutexName(m_gpuContextDeleteArrayMutex, "GpuContextMgr.DeleteArray");
 
     MosUtilities::MosLockMutex(m_gpuContextArrayMutex);
     m_gpuContextMap.clear();
@@ -49,7 +49,9 @@
 
 #include "mos_defs.h"
 #include "mos_oca_rtlog_mgr_defs.h"
+#include "mos_memory_usage.h"
 #include "mos_os.h"
+#include "mos_async_lock.h"
 #include "media_class_trace.h"
 
 class GpuContextSpecificNext;
@@ -645,6 +647,27 @@ public:
         COMMAND_BUFFER_HANDLE cmdBuffer,
         bool nullRendering = false);
 
+    //!
+    //! \brief    Set Vdbox Workload
+    //! \details  [Cmd Buffer Interface] Report the size of the frame the stream submits next.
+    //! \details  Caller: HAL only
+    //! \details  Used to place single pipe decode streams on the least loaded VDBox. Only
+    //!           the relative size of the streams matters, decode reports macroblocks.
+    //!           Each call starts a frame, all submissions up to the next call are
+    //!           accounted as that one frame.
+    //!
+    //! \param    [in] streamState
+    //!           Handle of Os Stream State
+    //! \param    [in] workload
+    //!           Size of the next submissions, 0 if unknown
+    //!
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    static MOS_STATUS SetVdboxWorkload(
+        MOS_STREAM_HANDLE streamState,
+        uint32_t          workload);
+
     //!
     //! \brief    Reset Command Buffer
     //! \details  [Cmd Buffer Interface] Reset cmd buffer to the initialized state.
@@ -1244,6 +1267,61 @@ public:
         PMOS_LOCK_PARAMS       flags,
         bool                   isDumpPacket=0);
 
+    //!
+    //! \brief    Check whether the GPU still uses a resource
+    //! \details  [Resource Interface] Non-blocking, a lock of a busy resource waits for the GPU.
+    //!
+    //! \param    [in] streamState
+    //!           Handle of Os Stream State
+    //! \param    [in] resource
+    //!           MOS Resource handle of the resource to check.
+    //!
+    //! \return   bool
+    //!           true if submitted GPU work still uses the resource
+    //!
+    static bool IsResourceBusy(
+        MOS_STREAM_HANDLE   streamState,
+        MOS_RESOURCE_HANDLE resource);
+
+    //!
+    //! \brief    Lock Resource when the GPU is done with it
+    //! \details  [Resource Interface] Non-blocking version of LockMosResource.
+    //! \details  Caller: HAL only
+    //! \details  callback gets the locked data once the last GPU use of the resource retired,
+    //!           then the resource is unlocked. It runs right away if the resource is idle.
+    //!           Else it runs from a later LockMosResourceAsync call, or waiting for the GPU
+    //!           before the next SubmitCommandBuffer of the stream, a LockMosResource or
+    //!           FreeResource of the resource, whichever comes first. Commands submitted
+    //!           after this call see the data the callback wrote. Locks of one resource are
+    //!           served in the order they were queued.
+    //!
+    //! \param    [in] streamState
+    //!           Handle of Os Stream State
+    //! \param    [in] resource
+    //!           MOS Resource handle of the resource to lock, copied.
+    //! \param    [in] flags
+    //!           Control flags of locking resource.
+    //! \param    [in] callback
+    //!           Callback receiving the locked data, nullptr data if the lock failed.
+    //!
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    static MOS_STATUS LockMosResourceAsync(
+        MOS_STREAM_HANDLE    streamState,
+        MOS_RESOURCE_HANDLE  resource,
+        PMOS_LOCK_PARAMS     flags,
+        MosAsyncLockCallback callback);
+
+    //!
+    //! \brief    Get the graphics memory allocated by the media allocators of the process
+    //! \details  [Resource Interface] The peak covers the whole process, not only the live contexts.
+    //!
+    //! \param    [out] usage
+    //!           Used, peak and spilled bytes
+    //!
+    static void GetMediaMemoryUsage(MosMemoryUsage::Usage &usage);
+
     //!
     //! \brief    Unlock Resource
     //! \details  [Resource Interface] Unlock the gfx resource which is locked out.
@@ -0,0 +1,66 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_memory_usage.cpp
+//! \brief    Process wide usage of the graphics memory allocated by media components
+//!
+
+#include "mos_memory_usage.h"
+
+std::atomic<uint64_t> MosMemoryUsage::m_usedBytes(0);
+std::atomic<uint64_t> MosMemoryUsage::m_peakBytes(0);
+std::atomic<uint64_t> MosMemoryUsage::m_spilledBytes(0);
+
+void MosMemoryUsage::Add(uint64_t bytes, bool spilled)
+{
+    uint64_t used = m_usedBytes.fetch_add(bytes) + bytes;
+    if (spilled)
+    {
+        m_spilledBytes.fetch_add(bytes);
+    }
+
+    uint64_t peak = m_peakBytes.load();
+    while (used > peak && !m_peakBytes.compare_exchange_weak(peak, used))
+    {
+    }
+}
+
+void MosMemoryUsage::Remove(uint64_t bytes, bool spilled)
+{
+    m_usedBytes.fetch_sub(bytes);
+    if (spilled)
+    {
+        m_spilledBytes.fetch_sub(bytes);
+    }
+}
+
+void MosMemoryUsage::Get(Usage &usage)
+{
+    usage.usedBytes    = m_usedBytes.load();
+    usage.peakBytes    = m_peakBytes.load();
+    usage.spilledBytes = m_spilledBytes.load();
+}
+
+bool MosMemoryUsage::IsOverLimit(uint64_t limitBytes)
+{
+    return limitBytes != 0 && m_usedBytes.load() >= limitBytes;
+}
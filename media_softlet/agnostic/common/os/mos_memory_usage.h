@@ -0,0 +1,83 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_memory_usage.h
+//! \brief    Process wide usage of the graphics memory allocated by media components
+//! \details  Media allocators add and remove what they allocate, the peak is kept for the
+//!           whole process so it does not depend on which allocator is destroyed last.
+//!           Read it through MosInterface::GetMediaMemoryUsage. The live usage also gates
+//!           the creation of new contexts, see IsOverLimit.
+//!
+#ifndef __MOS_MEMORY_USAGE_H__
+#define __MOS_MEMORY_USAGE_H__
+
+#include <atomic>
+#include "mos_defs.h"
+#include "media_class_trace.h"
+
+class MosMemoryUsage
+{
+public:
+    struct Usage
+    {
+        uint64_t usedBytes    = 0;  //!< Memory allocated now
+        uint64_t peakBytes    = 0;  //!< Highest usedBytes since the process started
+        uint64_t spilledBytes = 0;  //!< Part of usedBytes placed in system memory by a budget
+    };
+
+    //!
+    //! \brief  Account an allocation
+    //! \param  [in] bytes
+    //!         Size of the allocation
+    //! \param  [in] spilled
+    //!         Whether it was placed in system memory by a budget
+    //!
+    static void Add(uint64_t bytes, bool spilled);
+
+    //!
+    //! \brief  Drop the accounting of a freed allocation, same arguments as Add
+    //!
+    static void Remove(uint64_t bytes, bool spilled);
+
+    //!
+    //! \brief  Get the usage of the process
+    //!
+    static void Get(Usage &usage);
+
+    //!
+    //! \brief  Check the usage of the process against an admission limit
+    //! \param  [in] limitBytes
+    //!         Limit of the memory in use, 0 for no limit
+    //! \return bool
+    //!         true if the memory in use reached the limit, no new context should be admitted
+    //!
+    static bool IsOverLimit(uint64_t limitBytes);
+
+protected:
+    static std::atomic<uint64_t> m_usedBytes;
+    static std::atomic<uint64_t> m_peakBytes;
+    static std::atomic<uint64_t> m_spilledBytes;
+
+MEDIA_CLASS_DEFINE_END(MosMemoryUsage)
+};
+
+#endif  // __MOS_MEMORY_USAGE_H__
@@ -206,6 +206,48 @@ MOS_STATUS MosUserSetting::InitMosCommonUserSetting(MediaUserSettingSharedPtr us
         0,
         true); //"TRUE for Enabling Vebox Scalability. (Default FALSE: disabled)"
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_MCPY_CONCURRENT_ENGINES,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Give each media copy engine its own context so copies on different engines run in parallel. (Default 0: disabled)"
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_MCPY_CPU_COPY,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Let the CPU take media copies it is predicted to finish before a GPU copy would. (Default 0: CPU only copies what no GPU engine can)"
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CONTEXT_MEMORY_BUDGET,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Local memory budget in MB of each media allocator, buffers beyond it go to system memory. (Default 0: no budget)"
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_PROCESS_MEMORY_LIMIT,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Refuse new media contexts while the media allocators of the process hold this many MB. (Default 0: no limit)"
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_PROCESS_MEMORY_PEAK,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Report the peak memory in MB of all media allocators of the process, written when the driver terminates"
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_GPU_FRAME_TIMING,
+        MediaUserSetting::Group::Device,
+        false,
+        true); //"Store GPU timestamps around each frame and return its GPU time in the status report. (Default 0: disabled)"
+
     DeclareUserSettingKey(
         userSettingPtr,
         __MEDIA_USER_FEATURE_VALUE_ENABLE_HCP_SCALABILITY_DECODE,
@@ -1432,6 +1474,12 @@ MOS_STATUS MosUserSetting::InitUserSettingForDebug(MediaUserSettingSharedPtr use
         MediaUserSetting::Group::Device,
         "",
         true);  // "Path to per-pipeline repeat count config file"
+    DeclareUserSettingKeyForDebug(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_SW_BUFMGR_ENABLE,
+        MediaUserSetting::Group::Device,
+        0,
+        true);  // "Use the in-memory software bufmgr instead of the DRM one, requires NULL HW"
 #endif
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
@@ -1838,6 +1838,39 @@ public:
     //!
     static MOS_STATUS MosUnlockMutex(PMOS_MUTEX pMutex);
 
+    //!
+    //! \brief    Name a mutex for lock contention profiling
+    //! \details  When MEDIA_LOCK_PROFILER_LOG is set, MosLockMutex/MosUnlockMutex
+    //!           record acquire count, contention, wait time and hold time for
+    //!           named mutexes. Mutexes sharing a name are merged in the report.
+    //!           No-op when profiling is disabled.
+    //! \param    [in] pMutex
+    //!           Pointer of mutex
+    //! \param    [in] name
+    //!           Name of the lock
+    //! \return   void
+    //!
+    static void MosSetMutexName(PMOS_MUTEX pMutex, const char *name);
+
+    //!
+    //! \brief    Stop profiling a mutex
+    //! \details  Must be called for named mutexes that are destroyed without
+    //!           MosDestroyMutex, before the memory can be reused.
+    //! \param    [in] pMutex
+    //!           Pointer of mutex
+    //! \return   void
+    //!
+    static void MosRetireMutex(PMOS_MUTEX pMutex);
+
+    //!
+    //! \brief    Write the lock contention report
+    //! \param    [in] path
+    //!           Output file, nullptr to use MEDIA_LOCK_PROFILER_LOG
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_UNKNOWN if profiling is disabled or the file cannot be written
+    //!
+    static MOS_STATUS MosReportLockContention(const char *path);
+
     //!
     //! \brief    Creates or opens a semaphore object and returns a handle to the object
     //! \details  Creates or opens a semaphore object and returns a handle to the object
@@ -452,6 +452,11 @@ extern "C" {
         MosUtilities::MosSetUltFlag(ultFlag);
     }
 
+    MOS_FUNC_EXPORT int32_t MOS_ReportLockContention(const char *path)
+    {
+        return MosUtilities::MosReportLockContention(path) == MOS_STATUS_SUCCESS ? 0 : -1;
+    }
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
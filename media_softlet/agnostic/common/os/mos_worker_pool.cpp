@@ -0,0 +1,158 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_worker_pool.cpp
+//! \brief    Process wide pool of worker threads for CPU side data parallel jobs
+//!
+
+#include <algorithm>
+#include "mos_worker_pool.h"
+
+constexpr uint32_t MosWorkerPool::m_maxRanges;
+constexpr uint32_t MosWorkerPool::m_maxThreads;
+
+MosWorkerPool &MosWorkerPool::GetInstance()
+{
+    static MosWorkerPool pool;
+    return pool;
+}
+
+uint32_t MosWorkerPool::GetMaxThreadNum()
+{
+    uint32_t cores = std::thread::hardware_concurrency();
+    return cores > m_maxThreads ? m_maxThreads : MOS_MAX(cores, 1);
+}
+
+MosWorkerPool::~MosWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto &thread : m_threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+}
+
+void MosWorkerPool::StartThreads()
+{
+    if (!m_threads.empty())
+    {
+        return;
+    }
+
+    // The thread running a job is the last worker
+    uint32_t threadNum = GetMaxThreadNum() - 1;
+    for (uint32_t i = 0; i < threadNum; i++)
+    {
+        m_threads.emplace_back(&MosWorkerPool::WorkerThread, this);
+    }
+}
+
+bool MosWorkerPool::RunNextRange(Job &job, std::unique_lock<std::mutex> &lock)
+{
+    if (job.next >= job.rangeNum)
+    {
+        return false;
+    }
+
+    uint32_t idx = job.next++;
+    if (job.next == job.rangeNum)
+    {
+        // Nothing left to pick up, later ranges of other jobs come first
+        m_jobs.erase(std::find(m_jobs.begin(), m_jobs.end(), &job));
+    }
+
+    lock.unlock();
+    MOS_STATUS status = (*job.func)(idx, job.begin[idx], job.begin[idx + 1]);
+    lock.lock();
+
+    // The owner frees job once pending drops to 0, it cannot before this thread unlocks
+    job.status[idx] = status;
+    if (--job.pending == 0)
+    {
+        job.done.notify_all();
+    }
+    return true;
+}
+
+void MosWorkerPool::WorkerThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wakeCondition.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+        if (m_stop)
+        {
+            return;
+        }
+        RunNextRange(*m_jobs.front(), lock);
+    }
+}
+
+MOS_STATUS MosWorkerPool::Run(uint32_t itemNum, uint32_t rangeNum, const RangeFunc &func)
+{
+    rangeNum = MOS_MIN(rangeNum, itemNum);
+    rangeNum = rangeNum > m_maxRanges ? m_maxRanges : rangeNum;
+    if (rangeNum <= 1)
+    {
+        return func(0, 0, itemNum);
+    }
+
+    Job      job;
+    uint32_t itemsPerRange = itemNum / rangeNum;
+    uint32_t extraItems    = itemNum % rangeNum;
+    for (uint32_t i = 0; i < rangeNum; i++)
+    {
+        job.begin[i + 1] = job.begin[i] + itemsPerRange + (i < extraItems ? 1 : 0);
+        job.status[i]    = MOS_STATUS_SUCCESS;
+    }
+    job.func     = &func;
+    job.rangeNum = rangeNum;
+    job.pending  = rangeNum;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    StartThreads();
+    m_jobs.push_back(&job);
+    m_wakeCondition.notify_all();
+
+    while (RunNextRange(job, lock))
+    {
+    }
+    job.done.wait(lock, [&] { return job.pending == 0; });
+    lock.unlock();
+
+    for (uint32_t i = 0; i < rangeNum; i++)
+    {
+        if (job.status[i] != MOS_STATUS_SUCCESS)
+        {
+            return job.status[i];
+        }
+    }
+    return MOS_STATUS_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_worker_pool.h
+//! \brief    Process wide pool of worker threads for CPU side data parallel jobs
+//! \details  A job splits [0, itemNum) into contiguous ranges. The calling thread works on
+//!           the job like any pool thread and returns once every range is done, so the
+//!           caller consumes results in their original order. Every component running
+//!           CPU work in parallel shares this pool instead of owning threads. The threads
+//!           are started on the first parallel job and live until the process exits.
+//!           Jobs may be run from pool threads, the caller then does the ranges no
+//!           other thread picked up, so nested jobs cannot dead lock.
+//!
+#ifndef __MOS_WORKER_POOL_H__
+#define __MOS_WORKER_POOL_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mos_defs.h"
+#include "media_class_trace.h"
+
+class MosWorkerPool
+{
+public:
+    //!
+    //! \brief  Process items [begin, end) of range rangeIdx, range 0 starts at item 0
+    //!
+    using RangeFunc = std::function<MOS_STATUS(uint32_t rangeIdx, uint32_t begin, uint32_t end)>;
+
+    //!
+    //! \brief  Get the pool of the process
+    //!
+    static MosWorkerPool &GetInstance();
+
+    //!
+    //! \brief  Number of threads a job can use, including the calling thread
+    //!
+    static uint32_t GetMaxThreadNum();
+
+    //!
+    //! \brief  Process itemNum items split into at most rangeNum ranges
+    //! \details Ranges get itemNum / rangeNum items, the first ones one more for the
+    //!          remainder. With one range, or no item, func runs on the calling thread
+    //!          without touching the pool. The first failing range, in item order,
+    //!          decides the returned status.
+    //! \param  [in] itemNum
+    //!         Number of items
+    //! \param  [in] rangeNum
+    //!         Number of ranges, clamped to itemNum and m_maxRanges
+    //! \param  [in] func
+    //!         Processes a range, must only touch state owned by that range
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Run(uint32_t itemNum, uint32_t rangeNum, const RangeFunc &func);
+
+    virtual ~MosWorkerPool();
+
+    static constexpr uint32_t m_maxRanges  = 16;
+    static constexpr uint32_t m_maxThreads = 8;
+
+protected:
+    struct Job
+    {
+        const RangeFunc        *func     = nullptr;
+        uint32_t                rangeNum = 0;
+        uint32_t                begin[m_maxRanges + 1] = {};  // begin[i + 1] is the end of range i
+        MOS_STATUS              status[m_maxRanges]    = {};
+        uint32_t                next     = 0;                 // next range nobody picked up
+        uint32_t                pending  = 0;                 // ranges not done yet
+        std::condition_variable done;
+    };
+
+    MosWorkerPool() {}
+
+    void StartThreads();
+    void WorkerThread();
+
+    //!
+    //! \brief  Run the next range of job, the pool mutex is held by lock
+    //! \return bool
+    //!         false if every range of the job was already picked up
+    //!
+    bool RunNextRange(Job &job, std::unique_lock<std::mutex> &lock);
+
+    std::vector<std::thread> m_threads;
+    std::deque<Job *>        m_jobs;
+    std::mutex               m_mutex;
+    std::condition_variable  m_wakeCondition;
+    bool                     m_stop = false;
+
+MEDIA_CLASS_DEFINE_END(MosWorkerPool)
+};
+
+#endif  // __MOS_WORKER_POOL_H__
@@ -156,7 +156,22 @@ MOS_STATUS Configure::Read(Value &value,
         value = useCustomValue ? customValue : def->DefaultValue();
         return MOS_STATUS_SUCCESS;
     }
-    std::string path = GetReadPath(def, option);
+    // Release builds load the registry once when the configure is created, so the first
+    // resolved value of an internal item stays valid and later reads need no lock.
+    // Debug builds keep reading the registry to pick up changes made while running.
+    bool useCache = !m_isDebugMode && option == MEDIA_USER_SETTING_INTERNAL;
+    if (useCache && def->GetCachedValue(value, status))
+    {
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            value = useCustomValue ? customValue : def->DefaultValue();
+        }
+        return status;
+    }
+
+    // A Write while the value is resolved bumps the generation, the stale value is not kept
+    uint32_t    generation = def->CacheGeneration();
+    std::string path       = GetReadPath(def, option);
 #if (_DEBUG || _RELEASE_INTERNAL)
     //First, Read pid path user setting. If succeed, return;
     if (m_nonPidRegPaths.find(path) == m_nonPidRegPaths.end())
@@ -202,6 +217,11 @@ MOS_STATUS Configure::Read(Value &value,
         status = MosUtilities::MosReadEnvVariable(def->ItemEnvName(), defaultType, value);
     }
 
+    if (useCache)
+    {
+        def->SetCachedValue(value, status, generation);
+    }
+
     if (status != MOS_STATUS_SUCCESS)
     {
         // customValue is only for internal user setting Read
@@ -293,6 +313,9 @@ MOS_STATUS Configure::Write(
         m_mutexLock.Unlock();
     }
 
+    // Whatever path was written, the next read of the item resolves it again
+    def->ResetCachedValue();
+
     if (status != MOS_STATUS_SUCCESS)
     {
         // When any fail happen, just print out a critical message, but not return error to break normal call sequence.
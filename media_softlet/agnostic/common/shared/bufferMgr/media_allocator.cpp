@@ -27,23 +27,51 @@
 //!
 #include <algorithm>
 #include "media_allocator.h"
+#include "mos_interface.h"
+#include "mos_memory_usage.h"
+#include "media_user_setting.h"
 
-Allocator::Allocator(PMOS_INTERFACE osInterface) : m_osInterface(osInterface)
+static uint64_t ReadMemoryBudget(PMOS_INTERFACE osInterface)
+{
+    uint32_t budgetMB = 0;
+    if (osInterface && osInterface->pfnGetUserSettingInstance)
+    {
+        ReadUserSetting(
+            osInterface->pfnGetUserSettingInstance(osInterface),
+            budgetMB,
+            __MEDIA_USER_FEATURE_VALUE_CONTEXT_MEMORY_BUDGET,
+            MediaUserSetting::Group::Device);
+    }
+    return (uint64_t)budgetMB * 1024 * 1024;
+}
+
+Allocator::Allocator(PMOS_INTERFACE osInterface) : m_memoryBudget(ReadMemoryBudget(osInterface)), m_osInterface(osInterface)
 {
 
 }
 
 Allocator::~Allocator()
 {
+    if (m_peakBytes)
+    {
+        MOS_OS_NORMALMESSAGE("Allocator peak usage %llu bytes, %llu bytes spilled to system memory",
+            (unsigned long long)m_peakBytes, (unsigned long long)m_spilledBytes);
+    }
     DestroyAllResources();
 }
 
 MOS_STATUS Allocator::DestroyAllResources()
 {
+    while (!m_orphanPools.empty())
+    {
+        ReleaseOrphanPool(m_orphanPools.begin()->first);
+    }
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     for (auto it : m_resourcePool)
     {
         MOS_RESOURCE *resource = const_cast<MOS_RESOURCE *>(it.first);
+        UntrackMemory(resource);
         m_osInterface->pfnFreeResource(m_osInterface, resource);
         MOS_Delete(resource);
         MOS_Delete(it.second);
@@ -54,6 +82,7 @@ MOS_STATUS Allocator::DestroyAllResources()
     for (auto it : m_bufferPool)
     {
         MOS_BUFFER *buffer = const_cast<MOS_BUFFER *>(it.first);
+        UntrackMemory(&buffer->OsResource);
         m_osInterface->pfnFreeResource(m_osInterface, &buffer->OsResource);
         MOS_Delete(buffer);
         MOS_Delete(it.second);
@@ -66,6 +95,7 @@ MOS_STATUS Allocator::DestroyAllResources()
         MOS_SURFACE *surface = const_cast<MOS_SURFACE *>(it.first);
         if (surface)
         {
+            UntrackMemory(&surface->OsResource);
             m_osInterface->pfnFreeResource(m_osInterface, &(surface->OsResource));
         }
         MOS_Delete(surface);
@@ -77,6 +107,7 @@ MOS_STATUS Allocator::DestroyAllResources()
 
     for (auto it : m_resourcePool)
     {
+        UntrackMemory(it);
         m_osInterface->pfnFreeResource(m_osInterface, it);
         MOS_Delete(it);
     }
@@ -84,6 +115,7 @@ MOS_STATUS Allocator::DestroyAllResources()
 
     for (auto it : m_bufferPool)
     {
+        UntrackMemory(&it->OsResource);
         m_osInterface->pfnFreeResource(m_osInterface, &it->OsResource);
         MOS_Delete(it);
     }
@@ -91,6 +123,7 @@ MOS_STATUS Allocator::DestroyAllResources()
 
     for (auto it : m_surfacePool)
     {
+        UntrackMemory(&it->OsResource);
         m_osInterface->pfnFreeResource(m_osInterface, &it->OsResource);
         MOS_Delete(it);
     }
@@ -109,7 +142,10 @@ MOS_RESOURCE *Allocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool z
 
     MOS_RESOURCE *resource = MOS_New(MOS_RESOURCE);
     memset(resource, 0, sizeof(MOS_RESOURCE));
-    MOS_STATUS status = m_osInterface->pfnAllocateResource(m_osInterface, &param, resource);
+    int32_t    memType = param.dwMemType;
+    bool       spilled = SpillIfOverBudget(param);
+    MOS_STATUS status  = m_osInterface->pfnAllocateResource(m_osInterface, &param, resource);
+    param.dwMemType    = memType;
 
     if (status != MOS_STATUS_SUCCESS)
     {
@@ -136,6 +172,7 @@ MOS_RESOURCE *Allocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool z
 #else
     m_resourcePool.push_back(resource);
 #endif
+    TrackMemory(resource, component, param.pBufName, spilled);
 
     if (zeroOnAllocate)
     {
@@ -158,7 +195,10 @@ PMOS_BUFFER Allocator::AllocateBuffer(MOS_ALLOC_GFXRES_PARAMS &param, bool zeroO
     }
 
     memset(buffer, 0, sizeof(MOS_BUFFER));
-    MOS_STATUS status = m_osInterface->pfnAllocateResource(m_osInterface, &param, &buffer->OsResource);
+    int32_t    memType = param.dwMemType;
+    bool       spilled = SpillIfOverBudget(param);
+    MOS_STATUS status  = m_osInterface->pfnAllocateResource(m_osInterface, &param, &buffer->OsResource);
+    param.dwMemType    = memType;
 
     if (status != MOS_STATUS_SUCCESS)
     {
@@ -186,6 +226,7 @@ PMOS_BUFFER Allocator::AllocateBuffer(MOS_ALLOC_GFXRES_PARAMS &param, bool zeroO
 #else
     m_bufferPool.push_back(buffer);
 #endif
+    TrackMemory(&buffer->OsResource, component, param.pBufName, spilled);
 
     if (zeroOnAllocate)
     {
@@ -223,6 +264,7 @@ MOS_SURFACE *Allocator::AllocateSurface(MOS_ALLOC_GFXRES_PARAMS &param, bool zer
 #else
     m_surfacePool.push_back(surface);
 #endif
+    TrackMemory(&surface->OsResource, component, param.pBufName, false);
 
     if (zeroOnAllocate)
     {
@@ -254,6 +296,8 @@ MOS_STATUS Allocator::DestroyResource(MOS_RESOURCE *resource)
 #endif
 
     m_resourcePool.erase(it);
+    UntrackMemory(resource);
+    ReleaseOrphanPool(resource);
     m_osInterface->pfnFreeResource(m_osInterface, resource);
     MOS_Delete(resource);
 
@@ -283,6 +327,8 @@ MOS_STATUS Allocator::DestroyBuffer(MOS_BUFFER *buffer)
 #endif
 
     m_bufferPool.erase(it);
+    UntrackMemory(&buffer->OsResource);
+    ReleaseOrphanPool(&buffer->OsResource);
     m_osInterface->pfnFreeResource(m_osInterface, &buffer->OsResource);
     MOS_Delete(buffer);
 
@@ -312,6 +358,8 @@ MOS_STATUS Allocator::DestroySurface(MOS_SURFACE *surface, MOS_GFXRES_FREE_FLAGS
 #endif
 
     m_surfacePool.erase(it);
+    UntrackMemory(&surface->OsResource);
+    ReleaseOrphanPool(&surface->OsResource);
     m_osInterface->pfnFreeResourceWithFlag(m_osInterface, &surface->OsResource, flags.Value);
     MOS_Delete(surface);
 
@@ -385,6 +433,15 @@ void* Allocator::Lock(MOS_RESOURCE* resource, MOS_LOCK_PARAMS* lockFlag)
         return nullptr;
     }
 
+    if (lockFlag->WriteOnly && !lockFlag->ReadOnly && !m_orphanPools.empty())
+    {
+        auto it = m_orphanPools.find(resource);
+        if (it != m_orphanPools.end())
+        {
+            OrphanIfBusy(resource, *it->second);
+        }
+    }
+
     return (m_osInterface->pfnLockResource(m_osInterface, resource, lockFlag));
 }
 
@@ -398,6 +455,30 @@ MOS_STATUS Allocator::UnLock(MOS_RESOURCE* resource)
     return (m_osInterface->pfnUnlockResource(m_osInterface, resource));
 }
 
+MOS_STATUS Allocator::LockAsync(MOS_RESOURCE *resource, MOS_LOCK_PARAMS *lockFlag, MosAsyncLockCallback callback)
+{
+    if (nullptr == resource || nullptr == lockFlag || nullptr == callback)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    // An orphaned resource gets an idle allocation right away, the plain lock does not wait.
+    bool orphan = lockFlag->WriteOnly && !lockFlag->ReadOnly && m_orphanPools.find(resource) != m_orphanPools.end();
+    if (!orphan && m_osInterface->apoMosEnabled && m_osInterface->osStreamState)
+    {
+        return MosInterface::LockMosResourceAsync(m_osInterface->osStreamState, resource, lockFlag, std::move(callback));
+    }
+
+    void *data = Lock(resource, lockFlag);
+    callback(data);
+    if (nullptr == data)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    return UnLock(resource);
+}
+
 MOS_STATUS Allocator::SkipResourceSync(MOS_RESOURCE* resource)
 {
     if (nullptr == resource)
@@ -459,3 +540,174 @@ bool Allocator::isSyncFreeNeededForMMCSurface(PMOS_SURFACE pOsSurface)
 
     return false;
 }
+
+MOS_STATUS Allocator::EnableOrphaning(MOS_RESOURCE *resource, MOS_ALLOC_GFXRES_PARAMS &param, uint32_t maxBackingNum)
+{
+    if (nullptr == resource || nullptr == m_osInterface)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    // Busy state is only known through APO MOS, keep plain locks otherwise
+    if (!m_osInterface->apoMosEnabled || nullptr == m_osInterface->osStreamState || maxBackingNum <= 1)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    if (m_orphanPools.find(resource) != m_orphanPools.end())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    OrphanPool *pool = MOS_New(OrphanPool);
+    if (nullptr == pool)
+    {
+        return MOS_STATUS_NO_SPACE;
+    }
+
+    pool->param          = param;
+    pool->name           = param.pBufName ? param.pBufName : "OrphanBacking";
+    pool->param.pBufName = pool->name.c_str();
+    pool->maxBackingNum  = maxBackingNum;
+    pool->backingSize    = resource->pGmmResInfo ? resource->pGmmResInfo->GetSizeSurface() : 0;
+
+    m_orphanPools.insert(std::make_pair(resource, pool));
+    return MOS_STATUS_SUCCESS;
+}
+
+void Allocator::OrphanIfBusy(MOS_RESOURCE *resource, OrphanPool &pool)
+{
+    MOS_STREAM_HANDLE streamState = m_osInterface->osStreamState;
+    if (!MosInterface::IsResourceBusy(streamState, resource))
+    {
+        return;
+    }
+
+    // Spares keep their allocation order, so the oldest one is checked first
+    for (auto it = pool.spares.begin(); it != pool.spares.end(); it++)
+    {
+        if (!MosInterface::IsResourceBusy(streamState, &(*it)))
+        {
+            MOS_RESOURCE idle = *it;
+            pool.spares.erase(it);
+            pool.spares.push_back(*resource);
+            *resource = idle;
+            pool.orphanCount++;
+            return;
+        }
+    }
+
+    if (pool.spares.size() + 1 < pool.maxBackingNum &&
+        m_orphanBytes + pool.backingSize <= m_maxOrphanBytes)
+    {
+        MOS_RESOURCE backing;
+        MOS_ZeroMemory(&backing, sizeof(backing));
+        if (m_osInterface->pfnAllocateResource(m_osInterface, &pool.param, &backing) == MOS_STATUS_SUCCESS)
+        {
+            pool.spares.push_back(*resource);
+            *resource = backing;
+            m_orphanBytes += pool.backingSize;
+            m_peakBytes = MOS_MAX(m_peakBytes, m_usedBytes + m_orphanBytes);
+            MosMemoryUsage::Add(pool.backingSize, false);
+            pool.orphanCount++;
+            return;
+        }
+        MOS_OS_NORMALMESSAGE("Failed to allocate orphan backing for %s", pool.name.c_str());
+    }
+
+    pool.stallCount++;
+}
+
+void Allocator::ReleaseOrphanPool(MOS_RESOURCE *resource)
+{
+    auto it = m_orphanPools.find(resource);
+    if (it == m_orphanPools.end())
+    {
+        return;
+    }
+
+    OrphanPool *pool = it->second;
+    MOS_OS_NORMALMESSAGE("%s: %d backing allocations, %d orphaned locks, %d stalled locks",
+        pool->name.c_str(), (uint32_t)pool->spares.size() + 1, pool->orphanCount, pool->stallCount);
+
+    for (auto &spare : pool->spares)
+    {
+        m_osInterface->pfnFreeResource(m_osInterface, &spare);
+        m_orphanBytes -= MOS_MIN(m_orphanBytes, pool->backingSize);
+        MosMemoryUsage::Remove(pool->backingSize, false);
+    }
+
+    m_orphanPools.erase(it);
+    MOS_Delete(pool);
+}
+
+bool Allocator::SpillIfOverBudget(MOS_ALLOC_GFXRES_PARAMS &param)
+{
+    // Only linear buffers left to the default pool may move, surfaces and compressed
+    // or explicitly placed resources keep their placement
+    bool movable = param.Format == Format_Buffer &&
+                   !param.bIsCompressible &&
+                   param.dwMemType == MOS_MEMPOOL_VIDEOMEMORY;
+    // Spare backings of orphanable resources count against the budget too
+    if (!movable || m_memoryBudget == 0 || m_usedBytes + m_orphanBytes + param.dwBytes <= m_memoryBudget)
+    {
+        return false;
+    }
+
+    MOS_OS_NORMALMESSAGE("Memory budget used up, %s placed in system memory",
+        param.pBufName ? param.pBufName : "buffer");
+    param.dwMemType = MOS_MEMPOOL_SYSTEMMEMORY;
+    return true;
+}
+
+void Allocator::TrackMemory(MOS_RESOURCE *resource, MOS_COMPONENT component, const char *purpose, bool spilled)
+{
+    if (nullptr == resource || nullptr == resource->pGmmResInfo)
+    {
+        return;
+    }
+
+    // A resource tracked twice would leak its first size
+    UntrackMemory(resource);
+
+    MemoryRecord record;
+    record.component = component;
+    record.purpose   = purpose ? purpose : "";
+    record.bytes     = resource->pGmmResInfo->GetSizeSurface();
+    record.spilled   = spilled;
+
+    m_purposeBytes[MemoryPurpose(component, record.purpose)] += record.bytes;
+    m_usedBytes += record.bytes;
+    m_spilledBytes += spilled ? record.bytes : 0;
+    m_peakBytes = MOS_MAX(m_peakBytes, m_usedBytes + m_orphanBytes);
+    MosMemoryUsage::Add(record.bytes, spilled);
+
+    m_memoryRecords[resource] = std::move(record);
+}
+
+void Allocator::UntrackMemory(MOS_RESOURCE *resource)
+{
+    auto it = m_memoryRecords.find(resource);
+    if (it == m_memoryRecords.end())
+    {
+        return;
+    }
+
+    const MemoryRecord &record = it->second;
+
+    // Names of freed buffers do not pile up
+    auto purpose = m_purposeBytes.find(MemoryPurpose(record.component, record.purpose));
+    if (purpose != m_purposeBytes.end())
+    {
+        purpose->second -= MOS_MIN(purpose->second, record.bytes);
+        if (purpose->second == 0)
+        {
+            m_purposeBytes.erase(purpose);
+        }
+    }
+    m_usedBytes -= record.bytes;
+    m_spilledBytes -= record.spilled ? record.bytes : 0;
+    MosMemoryUsage::Remove(record.bytes, record.spilled);
+
+    m_memoryRecords.erase(it);
+}
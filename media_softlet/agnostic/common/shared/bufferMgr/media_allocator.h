@@ -23,18 +23,26 @@
 //! \file     media_allocator.h
 //! \brief    Defines the common interface for media resource manage
 //! \details  Media allocator will allocate and destory buffers, each component
-//!           is recommended to inherits and implement it's owner allocator
+//!           is recommended to inherits and implement it's owner allocator.
+//!           Each allocator accounts the memory it allocates per component and
+//!           buffer name, and adds it to the process usage of MosMemoryUsage. Once
+//!           the budget set by "Media Context Memory Budget" is used up, plain
+//!           buffers are placed in system memory instead of local memory.
 //!
 
 #ifndef __MEDIA_ALLOCATOR_H__
 #define __MEDIA_ALLOCATOR_H__
 
 #include <stdint.h>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 #include "mos_defs.h"
 #include "mos_os_hw.h"
 #include "mos_os_specific.h"
 #include "mos_os.h"
+#include "mos_async_lock.h"
 #include "media_class_trace.h"
 
 class Allocator
@@ -180,6 +188,22 @@ public:
     //!
     MOS_STATUS UnLock(MOS_RESOURCE *resource);
 
+    //!
+    //! \brief  Lock Surface without waiting for the GPU
+    //! \details The callback gets the locked data once the GPU is done with the resource,
+    //!           at the latest before the next submission, see MosAsyncLockQueue. The
+    //!           resource is unlocked when the callback returns.
+    //! \param  [in] resource
+    //!         Pointer to MOS_RESOURCE
+    //! \param  [in] lockFlag
+    //!         Pointer to MOS_LOCK_PARAMS
+    //! \param  [in] callback
+    //!         Callback receiving the locked data, nullptr if the lock failed
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS LockAsync(MOS_RESOURCE *resource, MOS_LOCK_PARAMS *lockFlag, MosAsyncLockCallback callback);
+
     //!
     //! \brief  Skip sync resource
     //! \param  [in] resource
@@ -250,7 +274,63 @@ public:
     //!
     bool isSyncFreeNeededForMMCSurface(PMOS_SURFACE pOsSurface);
 
+    //!
+    //! \brief    Let write-only locks of a busy resource switch to an idle allocation
+    //! \details  A write-only lock of the resource while the GPU still uses it retargets
+    //!           the MOS_RESOURCE to an idle allocation instead of waiting, the busy one
+    //!           is recycled once the GPU is done. The caller must rewrite the whole
+    //!           resource on each write-only lock and must only reference it through its
+    //!           MOS_RESOURCE pointer. Locks wait as before once maxBackingNum
+    //!           allocations are busy or the allocator orphan budget is used up.
+    //! \param    [in] resource
+    //!           Pointer to MOS_RESOURCE allocated by this allocator
+    //! \param    [in] param
+    //!           Allocation parameters of the resource, used for the extra allocations
+    //! \param    [in] maxBackingNum
+    //!           Maximum number of allocations backing the resource, including its own
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS EnableOrphaning(MOS_RESOURCE *resource, MOS_ALLOC_GFXRES_PARAMS &param, uint32_t maxBackingNum);
+
 protected:
+    //!
+    //! \brief  Prefer system memory for a plain buffer if it does not fit in the budget
+    //! \return bool
+    //!         true if param.dwMemType was changed and must be restored after allocation
+    //!
+    bool SpillIfOverBudget(MOS_ALLOC_GFXRES_PARAMS &param);
+
+    //!
+    //! \brief  Account an allocation of this allocator, tagged with its buffer name
+    //!
+    void TrackMemory(MOS_RESOURCE *resource, MOS_COMPONENT component, const char *purpose, bool spilled);
+
+    //!
+    //! \brief  Drop the accounting of an allocation about to be freed
+    //!
+    void UntrackMemory(MOS_RESOURCE *resource);
+
+    struct OrphanPool
+    {
+        MOS_ALLOC_GFXRES_PARAMS   param         = {};
+        std::string               name;                //!< Owns the name param.pBufName points to
+        uint32_t                  maxBackingNum = 0;
+        uint64_t                  backingSize   = 0;
+        std::vector<MOS_RESOURCE> spares;              //!< Allocations not backing the resource now
+        uint32_t                  orphanCount   = 0;   //!< Locks served by switching allocation
+        uint32_t                  stallCount    = 0;   //!< Locks which had to wait on the GPU
+    };
+
+    //!
+    //! \brief  Switch the resource to an idle allocation if the GPU still uses it
+    //!
+    void OrphanIfBusy(MOS_RESOURCE *resource, OrphanPool &pool);
+
+    //!
+    //! \brief  Free the extra allocations of an orphanable resource
+    //!
+    void ReleaseOrphanPool(MOS_RESOURCE *resource);
 
     //!
     //! \brief  Clear Resource
@@ -279,6 +359,28 @@ protected:
     std::vector<MOS_BUFFER *>   m_bufferPool;
 #endif
 
+    std::map<MOS_RESOURCE *, OrphanPool *> m_orphanPools;
+    uint64_t                               m_orphanBytes = 0;  //!< Size of all extra allocations
+
+    static constexpr uint64_t m_maxOrphanBytes = 64 * 1024 * 1024;  //!< Budget of the extra allocations
+
+    struct MemoryRecord
+    {
+        MOS_COMPONENT component = COMPONENT_UNKNOWN;
+        std::string   purpose;                      //!< Buffer name given at allocation
+        uint64_t      bytes     = 0;
+        bool          spilled   = false;            //!< Placed in system memory by the budget
+    };
+
+    using MemoryPurpose = std::pair<MOS_COMPONENT, std::string>;
+
+    std::map<const MOS_RESOURCE *, MemoryRecord> m_memoryRecords;
+    std::map<MemoryPurpose, uint64_t>            m_purposeBytes;      //!< Live bytes per component and buffer name
+    uint64_t                                     m_memoryBudget = 0;  //!< Local memory budget, 0 for no budget
+    uint64_t                                     m_usedBytes    = 0;  //!< Recorded allocations
+    uint64_t                                     m_peakBytes    = 0;  //!< Highest m_usedBytes plus m_orphanBytes
+    uint64_t                                     m_spilledBytes = 0;  //!< Part of m_usedBytes in system memory
+
     PMOS_INTERFACE m_osInterface = nullptr;  //!< PMOS_INTERFACE
 MEDIA_CLASS_DEFINE_END(Allocator)
 };
@@ -25,8 +25,12 @@
 //! \details  Common interface and structure used in media copy which are platform independent
 //!
 
+#include <chrono>
+#include <cmath>
 #include "media_copy.h"
 #include "media_copy_common.h"
+#include "media_copy_cpu.h"
+#include "media_interfaces_mhw_next.h"
 #include "media_debug_dumper.h"
 #include "mhw_cp_interface.h"
 #include "mos_utilities.h"
@@ -50,6 +54,8 @@ MediaCopyBaseState::MediaCopyBaseState():
 
 MediaCopyBaseState::~MediaCopyBaseState()
 {
+    MOS_Delete(m_cpuCopy);
+
     if (m_osInterface)
     {
         m_osInterface->pfnDestroy(m_osInterface, false);
@@ -63,6 +69,39 @@ MediaCopyBaseState::~MediaCopyBaseState()
         m_inUseGPUMutex = nullptr;
     }
 
+    if (m_cpuCopyMutex)
+    {
+        MosUtilities::MosDestroyMutex(m_cpuCopyMutex);
+        m_cpuCopyMutex = nullptr;
+    }
+
+    if (m_engineLoadMutex)
+    {
+        MosUtilities::MosDestroyMutex(m_engineLoadMutex);
+        m_engineLoadMutex = nullptr;
+    }
+
+    // engine copy states are deleted by the derived class already
+    for (auto &engine : m_engines)
+    {
+        if (engine.mhwInterfaces)
+        {
+            engine.mhwInterfaces->Destroy();
+            MOS_Delete(engine.mhwInterfaces);
+        }
+        if (engine.osInterface)
+        {
+            engine.osInterface->pfnDestroy(engine.osInterface, false);
+            MOS_FreeMemory(engine.osInterface);
+            engine.osInterface = nullptr;
+        }
+        if (engine.mutex)
+        {
+            MosUtilities::MosDestroyMutex(engine.mutex);
+            engine.mutex = nullptr;
+        }
+    }
+
    #if (_DEBUG || _RELEASE_INTERNAL)
     if (m_surfaceDumper != nullptr)
     {
@@ -86,10 +125,49 @@ MOS_STATUS MediaCopyBaseState::Initialize(PMOS_INTERFACE osInterface)
         m_inUseGPUMutex     = MosUtilities::MosCreateMutex();
         MCPY_CHK_NULL_RETURN(m_inUseGPUMutex);
     }
+    if (m_engineLoadMutex == nullptr)
+    {
+        m_engineLoadMutex   = MosUtilities::MosCreateMutex();
+        MCPY_CHK_NULL_RETURN(m_engineLoadMutex);
+    }
     MCPY_CHK_NULL_RETURN(m_osInterface);
     Mos_SetVirtualEngineSupported(m_osInterface, true);
     m_osInterface->pfnVirtualEngineSupported(m_osInterface, true, true);
 
+    MediaUserSettingSharedPtr userSetting = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
+    ReadUserSetting(
+        userSetting,
+        m_concurrentEngines,
+        __MEDIA_USER_FEATURE_MCPY_CONCURRENT_ENGINES,
+        MediaUserSetting::Group::Device);
+    // async devices record on the command list of the shared stream
+    if (m_osInterface->pfnIsAsyncDevice && m_osInterface->pfnIsAsyncDevice(m_osInterface->osStreamState))
+    {
+        m_concurrentEngines = false;
+    }
+
+    if (m_cpuCopy == nullptr)
+    {
+        m_cpuCopy = MOS_New(MediaCpuCopy, m_osInterface, m_inUseGPUMutex);
+        MCPY_CHK_NULL_RETURN(m_cpuCopy);
+    }
+    // CPU copies do not use the GPU context, they must not wait behind GPU copies
+    if (m_cpuCopyMutex == nullptr)
+    {
+        m_cpuCopyMutex = MosUtilities::MosCreateMutex();
+        MCPY_CHK_NULL_RETURN(m_cpuCopyMutex);
+    }
+    ReadUserSetting(
+        userSetting,
+        m_cpuCopyPredict,
+        __MEDIA_USER_FEATURE_MCPY_CPU_COPY,
+        MediaUserSetting::Group::Device);
+    // CPU access to local memory goes through the BAR, far slower than the prediction
+    if (MEDIA_IS_SKU(m_osInterface->pfnGetSkuTable(m_osInterface), FtrLocalMemory))
+    {
+        m_cpuCopyPredict = false;
+    }
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     if (m_surfaceDumper == nullptr)
     {
@@ -170,17 +248,17 @@ MOS_STATUS MediaCopyBaseState::CapabilityCheck(
         caps.engineRender = false;
     }
 
-    if (!caps.engineVebox && !caps.engineBlt && !caps.engineRender)
+    if (!caps.engineVebox && !caps.engineBlt && !caps.engineRender && !caps.engineCpu)
     {
-        return MOS_STATUS_INVALID_PARAMETER; // unsupport copy on each hw engine.
+        return MOS_STATUS_INVALID_PARAMETER; // unsupport copy on each hw engine and CPU.
     }
 
     MEDIA_WA_TABLE *pWaTable = m_osInterface->pfnGetWaTable(m_osInterface);
     if ((format == Format_Y210 || format == Format_Y216) &&
         MEDIA_IS_WA(pWaTable, Wa_16024792527_OptionB))
     {
-        caps.engineRender = false;
-        m_bRenderFallbackToBlt = true;
+        caps.engineRender        = false;
+        caps.renderFallbackToBlt = true;
     }
 
     return MOS_STATUS_SUCCESS;
@@ -255,6 +333,256 @@ MOS_STATUS MediaCopyBaseState::CopyEnigneSelect(MCPY_METHOD& preferMethod, MCPY_
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS MediaCopyBaseState::CreateEngineInterfaces(
+    MCPY_ENGINE         engine,
+    MhwInterfacesNext  *mhwInterfaces,
+    PMOS_INTERFACE     &engineOsInterface,
+    MhwInterfacesNext *&engineMhwInterfaces)
+{
+    MCPY_CHK_NULL_RETURN(m_osInterface);
+
+    engineOsInterface   = m_osInterface;
+    engineMhwInterfaces = mhwInterfaces;
+    if (!m_concurrentEngines || engine >= MCPY_ENGINE_MAX)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    EngineContext &context = m_engines[engine];
+    if (context.osInterface)
+    {
+        engineOsInterface   = context.osInterface;
+        engineMhwInterfaces = context.mhwInterfaces;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    PMOS_CONTEXT mosContext = nullptr;
+    MCPY_CHK_STATUS_RETURN(m_osInterface->pfnGetMosContext(m_osInterface, &mosContext));
+    MCPY_CHK_NULL_RETURN(mosContext);
+
+    PMOS_INTERFACE osInterface = (PMOS_INTERFACE)MOS_AllocAndZeroMemory(sizeof(MOS_INTERFACE));
+    MCPY_CHK_NULL_RETURN(osInterface);
+    if (Mos_InitInterface(osInterface, mosContext, COMPONENT_MCPY) != MOS_STATUS_SUCCESS)
+    {
+        MOS_FreeMemory(osInterface);
+        MCPY_NORMALMESSAGE("engine %d shares the os interface", engine);
+        return MOS_STATUS_SUCCESS;
+    }
+    Mos_SetVirtualEngineSupported(osInterface, true);
+    osInterface->pfnVirtualEngineSupported(osInterface, true, true);
+
+    MhwInterfacesNext::CreateParams params;
+    params.Flags.m_render = true;
+    params.Flags.m_vebox  = true;
+    params.Flags.m_blt    = true;
+    MhwInterfacesNext *mhw = MhwInterfacesNext::CreateFactory(params, osInterface);
+    if (mhw == nullptr || mhw->m_miItf == nullptr)
+    {
+        if (mhw)
+        {
+            mhw->Destroy();
+            MOS_Delete(mhw);
+        }
+        osInterface->pfnDestroy(osInterface, false);
+        MOS_FreeMemory(osInterface);
+        MCPY_NORMALMESSAGE("engine %d shares the mhw interfaces", engine);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    if (context.mutex == nullptr)
+    {
+        context.mutex = MosUtilities::MosCreateMutex();
+        if (context.mutex == nullptr)
+        {
+            mhw->Destroy();
+            MOS_Delete(mhw);
+            osInterface->pfnDestroy(osInterface, false);
+            MOS_FreeMemory(osInterface);
+            MCPY_CHK_NULL_RETURN(context.mutex);
+        }
+    }
+
+    context.osInterface   = osInterface;
+    context.mhwInterfaces = mhw;
+    engineOsInterface     = osInterface;
+    engineMhwInterfaces   = mhw;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+PMOS_MUTEX MediaCopyBaseState::GetEngineMutex(MCPY_ENGINE engine)
+{
+    if (engine == MCPY_ENGINE_CPU)
+    {
+        return m_cpuCopyMutex;
+    }
+    if (engine < MCPY_ENGINE_MAX && m_engines[engine].osInterface)
+    {
+        return m_engines[engine].mutex;
+    }
+    return m_inUseGPUMutex;
+}
+
+static uint64_t GetEngineLoadTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void MediaCopyBaseState::DecayEngineLoad(uint64_t now)
+{
+    for (auto &context : m_engines)
+    {
+        if (now > context.loadTime)
+        {
+            context.load    *= exp(-(double)(now - context.loadTime) / (m_engineLoadDecayMs * 1000));
+            context.loadTime = now;
+        }
+    }
+}
+
+void MediaCopyBaseState::AddEngineLoad(MCPY_ENGINE engine, uint32_t size)
+{
+    if (!m_concurrentEngines || engine >= MCPY_ENGINE_MAX || m_engineLoadMutex == nullptr)
+    {
+        return;
+    }
+
+    uint64_t now = GetEngineLoadTimeUs();
+
+    MosUtilities::MosLockMutex(m_engineLoadMutex);
+    DecayEngineLoad(now);
+    m_engines[engine].load += size;
+    m_engines[engine].copyNum++;
+    MosUtilities::MosUnlockMutex(m_engineLoadMutex);
+}
+
+bool MediaCopyBaseState::IsEngineSizeSupported(const MOS_SURFACE &res, MCPY_ENGINE engine)
+{
+    // quiet version of the limits in CheckResourceSizeValidForCopy
+    switch (engine)
+    {
+    case MCPY_ENGINE_BLT:
+        return res.dwPitch <= BLT_MAX_PITCH && res.dwHeight <= BLT_MAX_HEIGHT && res.dwWidth <= BLT_MAX_WIDTH;
+    case MCPY_ENGINE_RENDER:
+        return res.dwHeight >= RENDER_MIN_HEIGHT && res.dwWidth >= RENDER_MIN_WIDTH;
+    case MCPY_ENGINE_VEBOX:
+        return res.dwHeight >= VE_MIN_HEIGHT && res.dwWidth >= VE_MIN_WIDTH;
+    default:
+        return false;
+    }
+}
+
+void MediaCopyBaseState::SelectLeastLoadedEngine(
+    MCPY_ENGINE            &mcpyEngine,
+    const MCPY_ENGINE_CAPS &caps,
+    const MOS_SURFACE      &src,
+    const MOS_SURFACE      &dst)
+{
+    if (!m_concurrentEngines || mcpyEngine >= MCPY_ENGINE_MAX || m_engines[mcpyEngine].osInterface == nullptr ||
+        m_engineLoadMutex == nullptr ||
+        src.TileType == MOS_TILE_B || dst.TileType == MOS_TILE_B)
+    {
+        return;
+    }
+#if (_DEBUG || _RELEASE_INTERNAL)
+    if (MCPY_METHOD_DEFAULT != m_MCPYForceMode)
+    {
+        return;
+    }
+#endif
+
+    const bool capable[MCPY_ENGINE_MAX] = {caps.engineVebox != 0, caps.engineBlt != 0, caps.engineRender != 0};
+    uint32_t   candidateMask            = 0;
+    for (uint32_t i = 0; i < MCPY_ENGINE_MAX; i++)
+    {
+        MCPY_ENGINE engine = (MCPY_ENGINE)i;
+        if (capable[i] && m_engines[i].osInterface != nullptr &&
+            IsEngineSizeSupported(src, engine) && IsEngineSizeSupported(dst, engine))
+        {
+            candidateMask |= 1 << i;
+        }
+    }
+
+    uint64_t now = GetEngineLoadTimeUs();
+
+    MosUtilities::MosLockMutex(m_engineLoadMutex);
+    DecayEngineLoad(now);
+
+    // Keep the engine of the method unless it is busy and another one is clearly
+    // less busy, so engines with similar load do not trade copies.
+    MCPY_ENGINE best = mcpyEngine;
+    if (m_engines[mcpyEngine].load >= m_engineMinMoveLoad)
+    {
+        for (uint32_t i = 0; i < MCPY_ENGINE_MAX; i++)
+        {
+            if (i == mcpyEngine || !(candidateMask & (1 << i)) || m_engines[i].load * 2 >= m_engines[best].load)
+            {
+                continue;
+            }
+            best = (MCPY_ENGINE)i;
+        }
+    }
+
+    MosUtilities::MosUnlockMutex(m_engineLoadMutex);
+
+    if (best != mcpyEngine)
+    {
+        MCPY_NORMALMESSAGE("copy moved from engine %d to less loaded engine %d", mcpyEngine, best);
+        mcpyEngine = best;
+    }
+}
+
+void MediaCopyBaseState::SelectCpuEngine(
+    MCPY_METHOD              preferMethod,
+    MCPY_ENGINE             &mcpyEngine,
+    const MCPY_ENGINE_CAPS  &caps,
+    const MCPY_STATE_PARAMS &mcpySrc,
+    const MCPY_STATE_PARAMS &mcpyDst,
+    uint32_t                 size)
+{
+    if (!caps.engineCpu)
+    {
+        return;
+    }
+
+    if (!caps.engineVebox && !caps.engineBlt && !caps.engineRender)
+    {
+        MCPY_NORMALMESSAGE("no GPU engine can do the copy, copy on CPU");
+        mcpyEngine = MCPY_ENGINE_CPU;
+        return;
+    }
+
+    if (!m_cpuCopyPredict || MCPY_METHOD_DEFAULT != preferMethod)
+    {
+        return;
+    }
+#if (_DEBUG || _RELEASE_INTERNAL)
+    if (MCPY_METHOD_DEFAULT != m_MCPYForceMode)
+    {
+        return;
+    }
+#endif
+
+    // the CPU would wait for the GPU work on the surfaces, a GPU copy just queues behind it
+    MosUtilities::MosLockMutex(m_inUseGPUMutex);
+    bool busy = MosInterface::IsResourceBusy(m_osInterface->osStreamState, mcpySrc.OsRes) ||
+                MosInterface::IsResourceBusy(m_osInterface->osStreamState, mcpyDst.OsRes);
+    MosUtilities::MosUnlockMutex(m_inUseGPUMutex);
+    if (busy)
+    {
+        return;
+    }
+
+    uint32_t cpuUs = m_cpuCopy->EstimateCopyTimeUs(size);
+    uint32_t gpuUs = MediaCpuCopy::EstimateGpuCopyTimeUs(size);
+    if (cpuUs < gpuUs)
+    {
+        MCPY_NORMALMESSAGE("copy of %d bytes moved from engine %d to CPU, predicted %d us vs %d us", size, mcpyEngine, cpuUs, gpuUs);
+        mcpyEngine = MCPY_ENGINE_CPU;
+    }
+}
+
 uint32_t GetMinRequiredSurfaceSizeInBytes(uint32_t pitch, uint32_t height, MOS_FORMAT format)
 {
     uint32_t nBytes = 0;
@@ -398,6 +726,23 @@ MOS_STATUS MediaCopyBaseState::ValidateResource(const MOS_SURFACE &src, const MO
     return MOS_STATUS_SUCCESS;
 }
 
+static const char *GetEngineName(MCPY_ENGINE engine)
+{
+    switch (engine)
+    {
+    case MCPY_ENGINE_VEBOX:
+        return "VeBox";
+    case MCPY_ENGINE_BLT:
+        return "BLT";
+    case MCPY_ENGINE_RENDER:
+        return "Render";
+    case MCPY_ENGINE_CPU:
+        return "CPU";
+    default:
+        return "Unknown";
+    }
+}
+
 //!
 //! \brief    surface copy func.
 //! \details  copy surface.
@@ -424,7 +769,7 @@ MOS_STATUS MediaCopyBaseState::SurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst,
     MCPY_STATE_PARAMS     mcpySrc = {nullptr, MOS_MMC_DISABLED, MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false};
     MCPY_STATE_PARAMS     mcpyDst = {nullptr, MOS_MMC_DISABLED, MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false};
     MCPY_ENGINE           mcpyEngine = MCPY_ENGINE_BLT;
-    MCPY_ENGINE_CAPS      mcpyEngineCaps = {1, 1, 1, 1};
+    MCPY_ENGINE_CAPS      mcpyEngineCaps = {1, 1, 1, 0};
 
     MCPY_CHK_STATUS_RETURN(m_osInterface->pfnGetResourceInfo(m_osInterface, src, &SrcResDetails));
     MCPY_CHK_STATUS_RETURN(m_osInterface->pfnGetMemoryCompressionMode(m_osInterface, src, (PMOS_MEMCOMP_STATE)&(mcpySrc.CompressionMode)));
@@ -498,15 +843,43 @@ MOS_STATUS MediaCopyBaseState::SurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst,
 
     MCPY_CHK_STATUS_RETURN(PreCheckCpCopy(mcpySrc, mcpyDst, preferMethod));
 
+    mcpyEngineCaps.engineCpu = m_cpuCopy &&
+                               mcpySrc.CompressionMode == MOS_MMC_DISABLED &&
+                               mcpyDst.CompressionMode == MOS_MMC_DISABLED &&
+                               m_cpuCopy->IsCopySupported(SrcResDetails, DstResDetails);
+
     MCPY_CHK_STATUS_RETURN(CapabilityCheck(SrcResDetails.Format,
         mcpySrc, mcpyDst,
         mcpyEngineCaps, preferMethod));
 
     MCPY_CHK_STATUS_RETURN(CopyEnigneSelect(preferMethod, mcpyEngine, mcpyEngineCaps));
 
+    if (MCPY_METHOD_DEFAULT == preferMethod)
+    {
+        SelectLeastLoadedEngine(mcpyEngine, mcpyEngineCaps, SrcResDetails, DstResDetails);
+    }
+
+    SelectCpuEngine(preferMethod, mcpyEngine, mcpyEngineCaps, mcpySrc, mcpyDst, MOS_MAX(SrcResDetails.dwSize, DstResDetails.dwSize));
+
     MCPY_CHK_STATUS_RETURN(ValidateResource(SrcResDetails, DstResDetails, mcpyEngine));
 
-    MCPY_CHK_STATUS_RETURN(TaskDispatch(mcpySrc, mcpyDst, mcpyEngine));
+    AddEngineLoad(mcpyEngine, MOS_MAX(SrcResDetails.dwSize, DstResDetails.dwSize));
+
+    eStatus = TaskDispatch(mcpySrc, mcpyDst, mcpyEngine);
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    if (m_bRegReport)
+    {
+        std::string copyEngine = mcpyEngineCaps.renderFallbackToBlt ? "Render" : GetEngineName(mcpyEngine);
+        MediaUserSettingSharedPtr userSettingPtr = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
+        ReportUserSettingForDebug(
+            userSettingPtr,
+            __MEDIA_USER_FEATURE_MCPY_MODE,
+            copyEngine,
+            MediaUserSetting::Group::Device);
+    }
+#endif
+    MCPY_CHK_STATUS_RETURN(eStatus);
 
     MOS_TraceEventExt(EVENT_MEDIA_COPY, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return eStatus;
@@ -550,49 +923,39 @@ MOS_STATUS MediaCopyBaseState::TaskDispatch(MCPY_STATE_PARAMS mcpySrc, MCPY_STAT
     }
 #endif
 
-    MosUtilities::MosLockMutex(m_inUseGPUMutex);
+    if (mcpyEngine == MCPY_ENGINE_BLT &&
+        (mcpyDst.TileMode != MOS_TILE_LINEAR) && (mcpyDst.CompressionMode == MOS_MMC_RC))
+    {
+        MCPY_NORMALMESSAGE("mmc on, mcpyDst.TileMode= %d, mcpyDst.CompressionMode = %d", mcpyDst.TileMode, mcpyDst.CompressionMode);
+        // decompression submits through the shared os interface, also with a BLT engine of its own
+        MosUtilities::MosLockMutex(m_inUseGPUMutex);
+        eStatus = m_osInterface->pfnDecompResource(m_osInterface, mcpyDst.OsRes);
+        MosUtilities::MosUnlockMutex(m_inUseGPUMutex);
+        MCPY_CHK_STATUS_RETURN(eStatus);
+    }
+
+    PMOS_MUTEX engineMutex = GetEngineMutex(mcpyEngine);
+    MosUtilities::MosLockMutex(engineMutex);
     switch(mcpyEngine)
     {
         case MCPY_ENGINE_VEBOX:
             eStatus = MediaVeboxCopy(mcpySrc.OsRes, mcpyDst.OsRes);
             break;
         case MCPY_ENGINE_BLT:
-            if ((mcpyDst.TileMode != MOS_TILE_LINEAR) && (mcpyDst.CompressionMode == MOS_MMC_RC))
-            {
-                MCPY_NORMALMESSAGE("mmc on, mcpyDst.TileMode= %d, mcpyDst.CompressionMode = %d", mcpyDst.TileMode, mcpyDst.CompressionMode);
-                eStatus = m_osInterface->pfnDecompResource(m_osInterface, mcpyDst.OsRes);
-                if (MOS_STATUS_SUCCESS != eStatus)
-                {
-                    MosUtilities::MosUnlockMutex(m_inUseGPUMutex);
-                    MCPY_CHK_STATUS_RETURN(eStatus);
-                }
-            }
             eStatus = MediaBltCopy(mcpySrc.OsRes, mcpyDst.OsRes);
             break;
         case MCPY_ENGINE_RENDER:
             eStatus = MediaRenderCopy(mcpySrc.OsRes, mcpyDst.OsRes);
             break;
+        case MCPY_ENGINE_CPU:
+            eStatus = MediaCpuSurfaceCopy(mcpySrc.OsRes, mcpyDst.OsRes);
+            break;
         default:
             break;
     }
-    MosUtilities::MosUnlockMutex(m_inUseGPUMutex);
+    MosUtilities::MosUnlockMutex(engineMutex);
 
 #if (_DEBUG || _RELEASE_INTERNAL)
-    if (m_bRegReport)
-    {
-        std::string copyEngine = mcpyEngine ?(mcpyEngine == MCPY_ENGINE_BLT?"BLT":"Render"):"VeBox";
-        if (m_bRenderFallbackToBlt)
-        {
-            copyEngine = "Render";
-        }
-        MediaUserSettingSharedPtr userSettingPtr = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
-        ReportUserSettingForDebug(
-            userSettingPtr,
-            __MEDIA_USER_FEATURE_MCPY_MODE,
-            copyEngine,
-            MediaUserSetting::Group::Device);
-    }
-
     // Set the dump location like "dumpLocation after MCPY=path_to_dump_folder" in user feature configure file
     // Otherwise, the surface may not be dumped
     // Only dump linear surface
@@ -609,7 +972,7 @@ MOS_STATUS MediaCopyBaseState::TaskDispatch(MCPY_STATE_PARAMS mcpySrc, MCPY_STAT
         m_surfaceDumper->m_frameNum++;
     }
 #endif
-    MCPY_NORMALMESSAGE("Media Copy works on %s Engine", mcpyEngine ?(mcpyEngine == MCPY_ENGINE_BLT?"BLT":"Render"):"VeBox");
+    MCPY_NORMALMESSAGE("Media Copy works on %s Engine", GetEngineName(mcpyEngine));
 
     return eStatus;
 }
@@ -631,6 +994,33 @@ MOS_STATUS MediaCopyBaseState::AuxCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst)
     return MOS_STATUS_INVALID_HANDLE;
 }
 
+MOS_STATUS MediaCopyBaseState::MediaCpuSurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst)
+{
+    MCPY_CHK_NULL_RETURN(m_cpuCopy);
+    MCPY_CHK_NULL_RETURN(src);
+    MCPY_CHK_NULL_RETURN(dst);
+
+    MOS_SURFACE srcResDetails, dstResDetails;
+    MOS_ZeroMemory(&srcResDetails, sizeof(MOS_SURFACE));
+    MOS_ZeroMemory(&dstResDetails, sizeof(MOS_SURFACE));
+    srcResDetails.Format     = Format_Invalid;
+    srcResDetails.OsResource = *src;
+    dstResDetails.Format     = Format_Invalid;
+    dstResDetails.OsResource = *dst;
+
+    // runs under m_cpuCopyMutex, m_osInterface is shared with the GPU copies
+    MosUtilities::MosLockMutex(m_inUseGPUMutex);
+    MOS_STATUS eStatus = m_osInterface->pfnGetResourceInfo(m_osInterface, src, &srcResDetails);
+    if (MOS_STATUS_SUCCESS == eStatus)
+    {
+        eStatus = m_osInterface->pfnGetResourceInfo(m_osInterface, dst, &dstResDetails);
+    }
+    MosUtilities::MosUnlockMutex(m_inUseGPUMutex);
+    MCPY_CHK_STATUS_RETURN(eStatus);
+
+    return m_cpuCopy->SurfaceCopy(srcResDetails, dstResDetails);
+}
+
 PMOS_INTERFACE MediaCopyBaseState::GetMosInterface()
 {
     return m_osInterface;
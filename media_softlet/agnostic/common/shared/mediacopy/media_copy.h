@@ -38,13 +38,17 @@
 #include "mos_interface.h"
 
 class CommonSurfaceDumper;
+class MhwInterfacesNext;
+class MediaCpuCopy;
 
 typedef struct _MCPY_ENGINE_CAPS
 {
     uint32_t engineVebox   :1;
     uint32_t engineBlt     :1;
     uint32_t engineRender  :1;
-    uint32_t reversed      :29;
+    uint32_t engineCpu     :1;
+    uint32_t renderFallbackToBlt :1;  // render copy taken by BLT for a WA, reported as render
+    uint32_t reversed      :27;
 }MCPY_ENGINE_CAPS;
 
 enum MCPY_ENGINE
@@ -52,6 +56,8 @@ enum MCPY_ENGINE
     MCPY_ENGINE_VEBOX = 0,
     MCPY_ENGINE_BLT,
     MCPY_ENGINE_RENDER,
+    MCPY_ENGINE_CPU,
+    MCPY_ENGINE_MAX,
 };
 
 enum MCPY_CPMODE
@@ -290,14 +296,133 @@ protected:
     virtual MOS_STATUS MediaVeboxCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst)
     {return MOS_STATUS_SUCCESS;}
 
+    //!
+    //! \brief    use CPU to do surface copy.
+    //! \details  tiled surfaces are converted by the GMM CPU blit on worker threads.
+    //! \param    src
+    //!           [in] Pointer to source surface
+    //! \param    dst
+    //!           [in] Pointer to destination surface
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if support, otherwise return unspoort.
+    //!
+    virtual MOS_STATUS MediaCpuSurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst);
+
+    //!
+    //! \brief    move a copy to the CPU.
+    //! \details  the CPU takes the copies no GPU engine can do. With MCPY CPU Copy set,
+    //!           it also takes copies without engine preference when it is predicted
+    //!           to be done before a GPU submission would complete.
+    //! \param    preferMethod
+    //!           [in] copy method
+    //! \param    mcpyEngine
+    //!           [in/out] engine picked for the copy
+    //! \param    caps
+    //!           [in] reference of featue supported engine
+    //! \param    mcpySrc
+    //!           [in] source paramters
+    //! \param    mcpyDst
+    //!           [in] destination paramters
+    //! \param    size
+    //!           [in] bytes to copy
+    //!
+    void SelectCpuEngine(
+        MCPY_METHOD              preferMethod,
+        MCPY_ENGINE             &mcpyEngine,
+        const MCPY_ENGINE_CAPS  &caps,
+        const MCPY_STATE_PARAMS &mcpySrc,
+        const MCPY_STATE_PARAMS &mcpyDst,
+        uint32_t                 size);
+
     MOS_STATUS CheckResourceSizeValidForCopy(const MOS_SURFACE &res, const MCPY_ENGINE method);
     MOS_STATUS ValidateResource(const MOS_SURFACE &src, const MOS_SURFACE &dst, MCPY_ENGINE method);
 
+    //!
+    //! \brief    get the interfaces an engine copy state submits through.
+    //! \details  with concurrent engines enabled, each engine gets its own os and mhw
+    //!           interfaces, so copies on different engines do not wait for each other.
+    //!           Otherwise, or if they cannot be created, the shared ones are returned.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \param    mhwInterfaces
+    //!           [in] mhw interfaces shared by the engines
+    //! \param    engineOsInterface
+    //!           [out] os interface to create the engine copy state with
+    //! \param    engineMhwInterfaces
+    //!           [out] mhw interfaces to create the engine copy state with
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if success, otherwise return failed.
+    //!
+    MOS_STATUS CreateEngineInterfaces(
+        MCPY_ENGINE         engine,
+        MhwInterfacesNext  *mhwInterfaces,
+        PMOS_INTERFACE     &engineOsInterface,
+        MhwInterfacesNext *&engineMhwInterfaces);
+
+    //!
+    //! \brief    move a copy without engine preference to the least loaded engine.
+    //! \details  only engines with their own interfaces are considered, and only if
+    //!           the surfaces fit the engine limits.
+    //! \param    mcpyEngine
+    //!           [in/out] engine picked by the method preference order
+    //! \param    caps
+    //!           [in] reference of featue supported engine
+    //! \param    src
+    //!           [in] source surface details
+    //! \param    dst
+    //!           [in] destination surface details
+    //!
+    void SelectLeastLoadedEngine(
+        MCPY_ENGINE            &mcpyEngine,
+        const MCPY_ENGINE_CAPS &caps,
+        const MOS_SURFACE      &src,
+        const MOS_SURFACE      &dst);
+
+    bool IsEngineSizeSupported(const MOS_SURFACE &res, MCPY_ENGINE engine);
+
+    //!
+    //! \brief    account a copy on an engine, the load decays over m_engineLoadDecayMs.
+    //!
+    void AddEngineLoad(MCPY_ENGINE engine, uint32_t size);
+
+    //!
+    //! \brief    decay the engine loads up to now, m_engineLoadMutex is held by the caller.
+    //!
+    void DecayEngineLoad(uint64_t now);
+
+    //!
+    //! \brief    get the mutex serializing the copies of an engine.
+    //! \details  engines sharing the os interface share m_inUseGPUMutex, the CPU
+    //!           engine has m_cpuCopyMutex.
+    //!
+    PMOS_MUTEX GetEngineMutex(MCPY_ENGINE engine);
+
+    struct EngineContext
+    {
+        PMOS_INTERFACE     osInterface   = nullptr;  // private interfaces, nullptr if the shared ones are used
+        MhwInterfacesNext *mhwInterfaces = nullptr;
+        PMOS_MUTEX         mutex         = nullptr;
+        double             load          = 0;        // bytes copied, decayed over time
+        uint64_t           loadTime      = 0;        // time of load, in us
+        uint64_t           copyNum       = 0;
+    };
+
+    //! \brief  time constant of the engine load decay
+    static constexpr double m_engineLoadDecayMs  = 20.0;
+    //! \brief  load of the preferred engine below which copies never move, 1MB
+    static constexpr double m_engineMinMoveLoad  = 1048576.0;
+
 public:
     PMOS_INTERFACE       m_osInterface    = nullptr;
 
 protected:
     PMOS_MUTEX           m_inUseGPUMutex        = nullptr; // Mutex for in-use GPU context
+    PMOS_MUTEX           m_engineLoadMutex      = nullptr; // Mutex for m_engines load
+    EngineContext        m_engines[MCPY_ENGINE_MAX] = {};
+    bool                 m_concurrentEngines    = false;
+    MediaCpuCopy        *m_cpuCopy              = nullptr;
+    PMOS_MUTEX           m_cpuCopyMutex         = nullptr; // Mutex for CPU copies
+    bool                 m_cpuCopyPredict       = false;  // let the CPU take small copies
 #if (_DEBUG || _RELEASE_INTERNAL)
     CommonSurfaceDumper *m_surfaceDumper        = nullptr;
     int                  m_MCPYForceMode        = 0;
@@ -306,7 +431,6 @@ protected:
     char                 m_dumpLocation_in[MAX_PATH]  = {};
     char                 m_dumpLocation_out[MAX_PATH] = {};
 #endif
-    bool                 m_bRenderFallbackToBlt  = false;
 MEDIA_CLASS_DEFINE_END(MediaCopyBaseState)
 };
 #endif
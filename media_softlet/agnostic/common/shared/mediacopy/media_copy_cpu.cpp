@@ -0,0 +1,356 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_copy_cpu.cpp
+//! \brief    Surface copy and tile conversion on the CPU
+//!
+
+#include <vector>
+#include "media_copy_cpu.h"
+#include "media_copy_common.h"
+#include "mos_utilities.h"
+#include "mos_util_debug.h"
+#include "mos_worker_pool.h"
+
+constexpr uint32_t MediaCpuCopy::m_maxPlanes;
+constexpr uint32_t MediaCpuCopy::m_bandHeight;
+
+uint32_t MediaCpuCopy::GetBytesPerPixel(MOS_FORMAT format)
+{
+    switch (format)
+    {
+    case Format_NV12:
+        return 1;
+    case Format_P010:
+    case Format_P016:
+    case Format_YUY2:
+        return 2;
+    case Format_A8R8G8B8:
+    case Format_A8B8G8R8:
+    case Format_X8R8G8B8:
+    case Format_X8B8G8R8:
+    case Format_R10G10B10A2:
+    case Format_B10G10R10A2:
+    case Format_AYUV:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+uint32_t MediaCpuCopy::GetPlaneNum(MOS_FORMAT format)
+{
+    return (format == Format_NV12 || format == Format_P010 || format == Format_P016) ? 2 : 1;
+}
+
+bool MediaCpuCopy::IsFormatSupported(MOS_FORMAT format)
+{
+    return GetBytesPerPixel(format) != 0;
+}
+
+bool MediaCpuCopy::IsCopySupported(const MOS_SURFACE &src, const MOS_SURFACE &dst)
+{
+    const MOS_SURFACE *surfaces[] = {&src, &dst};
+
+    if (src.Format != dst.Format || !IsFormatSupported(src.Format))
+    {
+        return false;
+    }
+
+    for (auto surface : surfaces)
+    {
+        GMM_RESOURCE_INFO *gmmResInfo = surface->OsResource.pGmmResInfo;
+        Side               side;
+        // TileY covers Tile4 and TileYS covers Tile64, GMM knows the actual layout
+        if (gmmResInfo == nullptr ||
+            (surface->TileType != MOS_TILE_LINEAR && surface->TileType != MOS_TILE_Y && surface->TileType != MOS_TILE_YS) ||
+            surface->bIsCompressed ||
+            gmmResInfo->GetResFlags().Info.NotLockable ||
+            gmmResInfo->GetSetCpSurfTag(false, 0))
+        {
+            return false;
+        }
+        // the GMM CPU blit cannot start inside a tile, keep to the layout checks of the copy
+        if (InitSide(*surface, side) != MOS_STATUS_SUCCESS)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32_t MediaCpuCopy::EstimateCopyTimeUs(uint32_t size)
+{
+    uint32_t threadNum = size >= m_minThreadedSize ? MosWorkerPool::GetMaxThreadNum() : 1;
+    return size / (m_cpuBytesPerUs * threadNum);
+}
+
+uint32_t MediaCpuCopy::EstimateGpuCopyTimeUs(uint32_t size)
+{
+    return m_gpuSubmitUs + size / m_gpuBytesPerUs;
+}
+
+MOS_STATUS MediaCpuCopy::InitSide(const MOS_SURFACE &surface, Side &side)
+{
+    uint32_t pitch        = surface.dwPitch;
+    uint32_t bpp          = GetBytesPerPixel(surface.Format);
+    uint32_t yPlaneOffset = surface.YPlaneOffset.iSurfaceOffset;
+
+    if (pitch == 0 || bpp == 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    side       = {};
+    side.gmm   = surface.OsResource.pGmmResInfo;
+    side.pitch = pitch;
+    side.tiled = surface.TileType != MOS_TILE_LINEAR;
+
+    uint32_t regionStart = surface.dwOffset >= yPlaneOffset ? surface.dwOffset - yPlaneOffset : surface.dwOffset;
+    if (side.tiled && regionStart)
+    {
+        // an offset into a tiled plane is not a row and column of it
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    side.x = (regionStart % pitch) / bpp;
+    side.y = regionStart / pitch;
+
+    side.planeOffset[0] = yPlaneOffset;
+    if (GetPlaneNum(surface.Format) > 1)
+    {
+        side.planeOffset[1] = surface.UPlaneOffset.iSurfaceOffset;
+        if (side.planeOffset[1] <= yPlaneOffset)
+        {
+            // linear buffers carry no plane offsets
+            side.planeOffset[1] = yPlaneOffset + pitch * surface.dwHeight;
+        }
+    }
+
+    if (side.tiled && (side.planeOffset[0] % pitch || side.planeOffset[1] % pitch))
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void MediaCpuCopy::GetBands(uint32_t planeNum, uint32_t height, std::vector<Band> &bands)
+{
+    bands.clear();
+    for (uint32_t plane = 0; plane < planeNum; plane++)
+    {
+        uint32_t rows = plane ? (height + 1) / 2 : height;
+        for (uint32_t row = 0; row < rows; row += m_bandHeight)
+        {
+            bands.push_back({plane, row, MOS_MIN(m_bandHeight, rows - row)});
+        }
+    }
+}
+
+uint32_t MediaCpuCopy::GetRegionSize(uint32_t planeNum, uint32_t width, uint32_t height, uint32_t bpp)
+{
+    uint32_t rows = planeNum > 1 ? height + (height + 1) / 2 : height;
+    return width * bpp * rows;
+}
+
+bool MediaCpuCopy::IsRegionInPitch(const Side &side, uint32_t width, uint32_t bpp)
+{
+    return (side.x + width) * bpp <= side.pitch;
+}
+
+uint32_t MediaCpuCopy::GetPlaneRow(const Side &side, const Band &band)
+{
+    return (band.plane ? side.y / 2 : side.y) + band.row;
+}
+
+uint32_t MediaCpuCopy::GetSurfaceRow(const Side &side, const Band &band)
+{
+    return side.planeOffset[band.plane] / side.pitch + GetPlaneRow(side, band);
+}
+
+uint32_t MediaCpuCopy::GetLinearOffset(const Side &side, const Band &band, uint32_t bpp)
+{
+    return side.planeOffset[band.plane] + GetPlaneRow(side, band) * side.pitch + side.x * bpp;
+}
+
+MOS_STATUS MediaCpuCopy::CopyBand(
+    const Side &src,
+    const Side &dst,
+    const Band &band,
+    uint32_t    width,
+    uint32_t    bpp,
+    uint8_t    *temp,
+    uint32_t    tempPitch)
+{
+    auto getLinear = [&](const Side &side) {
+        return side.data + GetLinearOffset(side, band, bpp);
+    };
+    auto blt = [&](const Side &tiled, uint8_t *linear, uint32_t linearPitch, bool upload) {
+        GMM_RES_COPY_BLT gmmResCopyBlt = {};
+        gmmResCopyBlt.Gpu.pData        = tiled.data;
+        gmmResCopyBlt.Gpu.OffsetX      = tiled.x;
+        gmmResCopyBlt.Gpu.OffsetY      = GetSurfaceRow(tiled, band);
+        gmmResCopyBlt.Sys.pData        = linear;
+        gmmResCopyBlt.Sys.RowPitch     = linearPitch;
+        gmmResCopyBlt.Sys.BufferSize   = linearPitch * (band.rows - 1) + width * bpp;
+        gmmResCopyBlt.Sys.SlicePitch   = gmmResCopyBlt.Sys.BufferSize;
+        gmmResCopyBlt.Blt.Slices       = 1;
+        gmmResCopyBlt.Blt.Upload       = upload;
+        gmmResCopyBlt.Blt.Width        = width;
+        gmmResCopyBlt.Blt.Height       = band.rows;
+        return tiled.gmm->CpuBlt(&gmmResCopyBlt) ? MOS_STATUS_SUCCESS : MOS_STATUS_UNKNOWN;
+    };
+
+    if (src.tiled && dst.tiled)
+    {
+        MCPY_CHK_NULL_RETURN(temp);
+        MCPY_CHK_STATUS_RETURN(blt(src, temp, tempPitch, false));
+        MCPY_CHK_STATUS_RETURN(blt(dst, temp, tempPitch, true));
+    }
+    else if (src.tiled)
+    {
+        MCPY_CHK_STATUS_RETURN(blt(src, getLinear(dst), dst.pitch, false));
+    }
+    else if (dst.tiled)
+    {
+        MCPY_CHK_STATUS_RETURN(blt(dst, getLinear(src), src.pitch, true));
+    }
+    else
+    {
+        uint8_t *srcRow = getLinear(src);
+        uint8_t *dstRow = getLinear(dst);
+        for (uint32_t i = 0; i < band.rows; i++)
+        {
+            MOS_SecureMemcpy(dstRow, width * bpp, srcRow, width * bpp);
+            srcRow += src.pitch;
+            dstRow += dst.pitch;
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaCpuCopy::SurfaceCopy(MOS_SURFACE &src, MOS_SURFACE &dst, uint32_t width, uint32_t height)
+{
+    MCPY_CHK_NULL_RETURN(m_osInterface);
+
+    if (!IsCopySupported(src, dst))
+    {
+        MCPY_ASSERTMESSAGE("CPU copy not supported, format %d tile %d -> format %d tile %d",
+            src.Format, src.TileType, dst.Format, dst.TileType);
+        return MOS_STATUS_PLATFORM_NOT_SUPPORTED;
+    }
+
+    uint32_t bpp      = GetBytesPerPixel(src.Format);
+    uint32_t planeNum = GetPlaneNum(src.Format);
+    width             = width ? width : MOS_MIN(src.dwWidth, dst.dwWidth);
+    height            = height ? height : MOS_MIN(src.dwHeight, dst.dwHeight);
+
+    uint8_t *srcData = LockSurface(src, false);
+    MCPY_CHK_NULL_RETURN(srcData);
+
+    uint8_t *dstData = LockSurface(dst, true);
+    if (dstData == nullptr)
+    {
+        UnlockSurface(src);
+        MCPY_CHK_NULL_RETURN(dstData);
+    }
+
+    Side       srcSide, dstSide;
+    MOS_STATUS eStatus = InitSide(src, srcSide);
+    if (MOS_STATUS_SUCCESS == eStatus)
+    {
+        eStatus = InitSide(dst, dstSide);
+    }
+    srcSide.data = srcData;
+    dstSide.data = dstData;
+    if (MOS_STATUS_SUCCESS == eStatus &&
+        (!IsRegionInPitch(srcSide, width, bpp) ||
+         !IsRegionInPitch(dstSide, width, bpp)))
+    {
+        MCPY_ASSERTMESSAGE("copy region width %d out of pitch %d/%d", width, srcSide.pitch, dstSide.pitch);
+        eStatus = MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    std::vector<Band> bands;
+    GetBands(planeNum, height, bands);
+
+    if (MOS_STATUS_SUCCESS == eStatus && !bands.empty())
+    {
+        uint32_t size      = GetRegionSize(planeNum, width, height, bpp);
+        uint32_t rangeNum  = size >= m_minThreadedSize ? MosWorkerPool::GetMaxThreadNum() : 1;
+        uint32_t tempPitch = MOS_ALIGN_CEIL(width * bpp, 64);
+        bool     staging   = srcSide.tiled && dstSide.tiled;
+
+        eStatus = MosWorkerPool::GetInstance().Run((uint32_t)bands.size(), rangeNum, [&](uint32_t rangeIdx, uint32_t begin, uint32_t end) -> MOS_STATUS {
+            std::vector<uint8_t> temp(staging ? tempPitch * m_bandHeight : 0);
+            for (uint32_t i = begin; i < end; i++)
+            {
+                MCPY_CHK_STATUS_RETURN(CopyBand(srcSide, dstSide, bands[i], width, bpp, temp.data(), tempPitch));
+            }
+            return MOS_STATUS_SUCCESS;
+        });
+
+        MCPY_NORMALMESSAGE("CPU copy of %dx%d format %d, tile %d -> %d, %d bands in %d ranges",
+            width, height, src.Format, src.TileType, dst.TileType, (uint32_t)bands.size(), rangeNum);
+    }
+
+    UnlockSurface(dst);
+    UnlockSurface(src);
+
+    return eStatus;
+}
+
+uint8_t *MediaCpuCopy::LockSurface(MOS_SURFACE &surface, bool write)
+{
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
+    lockFlags.ReadOnly     = !write;
+    lockFlags.WriteOnly    = write;
+    lockFlags.TiledAsTiled = 1;
+
+    if (m_osInterfaceMutex)
+    {
+        MosUtilities::MosLockMutex(m_osInterfaceMutex);
+    }
+    uint8_t *data = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, &surface.OsResource, &lockFlags);
+    if (m_osInterfaceMutex)
+    {
+        MosUtilities::MosUnlockMutex(m_osInterfaceMutex);
+    }
+
+    return data;
+}
+
+void MediaCpuCopy::UnlockSurface(MOS_SURFACE &surface)
+{
+    if (m_osInterfaceMutex)
+    {
+        MosUtilities::MosLockMutex(m_osInterfaceMutex);
+    }
+    m_osInterface->pfnUnlockResource(m_osInterface, &surface.OsResource);
+    if (m_osInterfaceMutex)
+    {
+        MosUtilities::MosUnlockMutex(m_osInterfaceMutex);
+    }
+}
@@ -0,0 +1,216 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_copy_cpu.h
+//! \brief    Surface copy and tile conversion on the CPU
+//! \details  Both surfaces are locked tiled as tiled. Rows of a tiled surface are
+//!           converted by the GMM CPU blit, linear rows are copied as they are.
+//!           The planes are cut into bands of whole tile rows which are run on
+//!           MosWorkerPool. Meant for copies no GPU engine can do and for
+//!           small surfaces, where the copy is shorter than a GPU submission.
+//!
+
+#ifndef __MEDIA_COPY_CPU_H__
+#define __MEDIA_COPY_CPU_H__
+
+#include <stdint.h>
+#include <vector>
+#include "mos_defs.h"
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+class MediaCpuCopy
+{
+public:
+    //!
+    //! \brief    MediaCpuCopy constructor
+    //! \param    osInterface
+    //!           [in] Pointer to MOS_INTERFACE used to lock the surfaces.
+    //! \param    osInterfaceMutex
+    //!           [in] mutex held by the GPU copies using osInterface, taken around the
+    //!           surface locks. nullptr when the caller serializes every use of osInterface.
+    //!
+    MediaCpuCopy(PMOS_INTERFACE osInterface, PMOS_MUTEX osInterfaceMutex = nullptr) :
+        m_osInterface(osInterface), m_osInterfaceMutex(osInterfaceMutex) {}
+    virtual ~MediaCpuCopy() {}
+
+    //!
+    //! \brief    check whether the format of a surface can be copied.
+    //! \return   bool
+    //!           true for NV12, P010, P016, YUY2 and 32 bits RGB formats.
+    //!
+    static bool IsFormatSupported(MOS_FORMAT format);
+
+    //!
+    //! \brief    check whether a copy can be done on the CPU.
+    //! \details  both surfaces need the same supported format, linear, TileY, Tile4 or
+    //!           Tile64 layout, and must be lockable, uncompressed and clear. A tiled
+    //!           surface is only copied from the start of its first plane.
+    //! \param    src
+    //!           [in] source surface details
+    //! \param    dst
+    //!           [in] destination surface details
+    //! \return   bool
+    //!           Return true if support, otherwise return false.
+    //!
+    bool IsCopySupported(const MOS_SURFACE &src, const MOS_SURFACE &dst);
+
+    //!
+    //! \brief    predict the time of a CPU copy.
+    //! \param    size
+    //!           [in] bytes to copy
+    //! \return   uint32_t
+    //!           copy time in us
+    //!
+    uint32_t EstimateCopyTimeUs(uint32_t size);
+
+    //!
+    //! \brief    predict the time of a GPU copy, submission and completion included.
+    //! \param    size
+    //!           [in] bytes to copy
+    //! \return   uint32_t
+    //!           copy time in us
+    //!
+    static uint32_t EstimateGpuCopyTimeUs(uint32_t size);
+
+    //!
+    //! \brief    copy a region of a surface.
+    //! \details  the region starts at dwOffset of each surface and covers width x height
+    //!           pixels of the first plane, the chroma plane follows the subsampling.
+    //!           A linear surface without plane offsets has its chroma right below
+    //!           dwHeight rows of luma.
+    //! \param    src
+    //!           [in] source surface details
+    //! \param    dst
+    //!           [in] destination surface details
+    //! \param    width
+    //!           [in] region width in pixels, 0 for the surface width
+    //! \param    height
+    //!           [in] region height in rows, 0 for the surface height
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if success, otherwise return failed.
+    //!
+    MOS_STATUS SurfaceCopy(MOS_SURFACE &src, MOS_SURFACE &dst, uint32_t width = 0, uint32_t height = 0);
+
+    //! \brief  copies below this size are not worth waking worker threads
+    static constexpr uint32_t m_minThreadedSize  = 1024 * 1024;
+    //! \brief  conversion rate of one thread through write combined mappings
+    static constexpr uint32_t m_cpuBytesPerUs    = 2000;
+    //! \brief  submission, scheduling and completion wait of a GPU copy
+    static constexpr uint32_t m_gpuSubmitUs      = 150;
+    static constexpr uint32_t m_gpuBytesPerUs    = 20000;
+
+protected:
+    static constexpr uint32_t m_maxPlanes  = 2;
+    //! \brief  rows of a band, whole tile rows for TileY and Tile4
+    static constexpr uint32_t m_bandHeight = 64;
+
+    //!
+    //! \brief  Where the copy region lies in a surface
+    //!
+    struct Side
+    {
+        uint8_t           *data  = nullptr;
+        GMM_RESOURCE_INFO *gmm   = nullptr;
+        uint32_t           pitch = 0;
+        bool               tiled = false;
+        uint32_t           x     = 0;  // region origin in pixels
+        uint32_t           y     = 0;  // region origin in rows of the first plane
+        uint32_t           planeOffset[m_maxPlanes] = {};
+    };
+
+    struct Band
+    {
+        uint32_t plane;
+        uint32_t row;   // first row of the band in the region
+        uint32_t rows;
+    };
+
+    static uint32_t GetBytesPerPixel(MOS_FORMAT format);
+    static uint32_t GetPlaneNum(MOS_FORMAT format);
+
+    //!
+    //! \brief    get the layout of a surface for the copy.
+    //! \details  dwOffset is the base of the first plane as reported by GetResourceInfo,
+    //!           or the start of the region inside a linear one. A linear surface without
+    //!           plane offsets has its chroma right below dwHeight rows of luma.
+    //! \param    surface
+    //!           [in] surface details
+    //! \param    side
+    //!           [out] layout of the surface, data is left to the caller
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_INVALID_PARAMETER if a tiled plane does not start at a row or
+    //!           the region does not start at the first plane of a tiled surface
+    //!
+    static MOS_STATUS InitSide(const MOS_SURFACE &surface, Side &side);
+
+    //!
+    //! \brief    cut the region into bands, the chroma plane of planar formats is half height.
+    //!
+    static void GetBands(uint32_t planeNum, uint32_t height, std::vector<Band> &bands);
+
+    //!
+    //! \brief    bytes of the region in every plane.
+    //!
+    static uint32_t GetRegionSize(uint32_t planeNum, uint32_t width, uint32_t height, uint32_t bpp);
+
+    //!
+    //! \brief    whether width pixels from the region origin fit in the pitch.
+    //!
+    static bool IsRegionInPitch(const Side &side, uint32_t width, uint32_t bpp);
+
+    //!
+    //! \brief    first row of a band in its plane.
+    //!
+    static uint32_t GetPlaneRow(const Side &side, const Band &band);
+
+    //!
+    //! \brief    first row of a band counted from the surface start, used by the GMM CPU
+    //!           blit of a tiled surface.
+    //!
+    static uint32_t GetSurfaceRow(const Side &side, const Band &band);
+
+    //!
+    //! \brief    byte offset of the first pixel of a band in a linear surface.
+    //!
+    static uint32_t GetLinearOffset(const Side &side, const Band &band, uint32_t bpp);
+
+    //!
+    //! \brief    copy the rows of a band.
+    //! \param    temp
+    //!           [in] linear staging rows for tiled to tiled copies, nullptr otherwise
+    //!
+    MOS_STATUS CopyBand(const Side &src, const Side &dst, const Band &band, uint32_t width, uint32_t bpp, uint8_t *temp, uint32_t tempPitch);
+
+    //!
+    //! \brief    lock or unlock a surface through the shared osInterface.
+    //!
+    uint8_t *LockSurface(MOS_SURFACE &surface, bool write);
+    void     UnlockSurface(MOS_SURFACE &surface);
+
+    PMOS_INTERFACE m_osInterface      = nullptr;
+    PMOS_MUTEX     m_osInterfaceMutex = nullptr;
+
+MEDIA_CLASS_DEFINE_END(MediaCpuCopy)
+};
+
+#endif  // __MEDIA_COPY_CPU_H__
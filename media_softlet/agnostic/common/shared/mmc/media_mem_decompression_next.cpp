@@ -28,6 +28,8 @@
 #include "vp_utils.h"
 #include "renderhal.h"
 #include "mos_os_cp_interface_specific.h"
+#include "mos_interface.h"
+#include "media_copy_cpu.h"
 
 MediaMemDeCompNext::MediaMemDeCompNext():
     m_osInterface(nullptr),
@@ -64,6 +66,8 @@ MediaMemDeCompNext::~MediaMemDeCompNext()
         }
     }
 
+    MOS_Delete(m_cpuCopy);
+
     if (m_osInterface)
     {
         m_osInterface->pfnDestroy(m_osInterface, false);
@@ -451,6 +455,31 @@ MOS_STATUS MediaMemDeCompNext::MediaMemoryTileConvert(PMOS_RESOURCE inputResourc
     VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(GetResourceInfo(&targetSurface));
     VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(GetResourceInfo(&sourceSurface));
 
+    // The CPU converts the requested width and height at the requested offsets, in the
+    // format of the tiled surface. Vebox below converts its whole height.
+    MOS_SURFACE cpuSource   = sourceSurface;
+    MOS_SURFACE cpuTarget   = targetSurface;
+    MOS_SURFACE veboxFormat = isTileToLinear ? sourceSurface : targetSurface;
+    uint32_t    cpuHeight   = copyHeight ? MOS_MIN(copyHeight, veboxFormat.dwHeight) : veboxFormat.dwHeight;
+    cpuSource.Format        = veboxFormat.Format;
+    cpuTarget.Format        = veboxFormat.Format;
+    cpuSource.dwOffset      = copyInputOffset;
+    cpuTarget.dwOffset      = copyOutputOffset;
+    cpuSource.dwWidth       = copyWidth;
+    cpuTarget.dwWidth       = copyWidth;
+    cpuSource.dwHeight      = cpuHeight;
+    cpuTarget.dwHeight      = cpuHeight;
+
+    bool veboxSupported = (targetSurface.TileType != MOS_TILE_LINEAR || sourceSurface.TileType != MOS_TILE_LINEAR) &&
+                          IsFormatSupported(&veboxFormat);
+    bool cpuSupported   = !outputCompressed && m_cpuCopy && m_cpuCopy->IsCopySupported(cpuSource, cpuTarget);
+    if (cpuSupported && IsCpuTileConvertPreferred(cpuSource, cpuTarget, veboxSupported))
+    {
+        VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(m_cpuCopy->SurfaceCopy(cpuSource, cpuTarget, copyWidth, cpuHeight));
+        MOS_TraceEventExt(EVENT_MEDIA_COPY, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
+        return eStatus;
+    }
+
     if (targetSurface.TileType == MOS_TILE_LINEAR &&
         sourceSurface.TileType == MOS_TILE_LINEAR)
     {
@@ -511,12 +540,52 @@ MOS_STATUS MediaMemDeCompNext::MediaMemoryTileConvert(PMOS_RESOURCE inputResourc
         MOS_GPU_CONTEXT_VEBOX,
         false);
 
-    VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(RenderDoubleBufferDecompCMD(&sourceSurface, &targetSurface));
+    eStatus = RenderDoubleBufferDecompCMD(&sourceSurface, &targetSurface);
+    if (eStatus != MOS_STATUS_SUCCESS && cpuSupported)
+    {
+        VPHAL_MEMORY_DECOMP_NORMALMESSAGE("vebox tile convert failed with %d, convert on the CPU", eStatus);
+        eStatus = m_cpuCopy->SurfaceCopy(cpuSource, cpuTarget, copyWidth, cpuHeight);
+    }
+    VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(eStatus);
 
     MOS_TraceEventExt(EVENT_MEDIA_COPY, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return eStatus;
 }
 
+bool MediaMemDeCompNext::IsCpuTileConvertPreferred(MOS_SURFACE &source, MOS_SURFACE &target, bool veboxSupported)
+{
+    if (!veboxSupported)
+    {
+        VPHAL_MEMORY_DECOMP_NORMALMESSAGE("vebox cannot convert format %d, tile %d -> %d, convert on the CPU",
+            source.Format, source.TileType, target.TileType);
+        return true;
+    }
+
+    // CPU access to local memory goes through the BAR, far slower than the prediction
+    if (!m_cpuCopyPredict || MEDIA_IS_SKU(m_osInterface->pfnGetSkuTable(m_osInterface), FtrLocalMemory))
+    {
+        return false;
+    }
+
+    // The CPU would wait for the GPU work on the surfaces, Vebox just queues behind it
+    if (MosInterface::IsResourceBusy(m_osInterface->osStreamState, &source.OsResource) ||
+        MosInterface::IsResourceBusy(m_osInterface->osStreamState, &target.OsResource))
+    {
+        return false;
+    }
+
+    uint32_t size  = MOS_MAX(source.dwPitch, target.dwPitch) * source.dwHeight;
+    uint32_t cpuUs = m_cpuCopy->EstimateCopyTimeUs(size);
+    uint32_t gpuUs = MediaCpuCopy::EstimateGpuCopyTimeUs(size);
+    if (cpuUs >= gpuUs)
+    {
+        return false;
+    }
+
+    VPHAL_MEMORY_DECOMP_NORMALMESSAGE("tile convert of %d bytes on the CPU, predicted %d us vs %d us on vebox", size, cpuUs, gpuUs);
+    return true;
+}
+
 MOS_STATUS MediaMemDeCompNext::Initialize(PMOS_INTERFACE osInterface, MhwInterfacesNext* mhwInterfaces)
 {
     MOS_STATUS                  eStatus         = MOS_STATUS_SUCCESS;
@@ -537,6 +606,17 @@ MOS_STATUS MediaMemDeCompNext::Initialize(PMOS_INTERFACE osInterface, MhwInterfa
 
     m_userSettingPtr = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
 
+    if (m_cpuCopy == nullptr)
+    {
+        // callers serialize the decompression state under MemDecompMutex, m_osInterface is not shared
+        m_cpuCopy = MOS_New(MediaCpuCopy, m_osInterface);
+    }
+    ReadUserSetting(
+        m_userSettingPtr,
+        m_cpuCopyPredict,
+        __MEDIA_USER_FEATURE_MCPY_CPU_COPY,
+        MediaUserSetting::Group::Device);
+
     // Set-Up Vebox decompression enable or not
     IsVeboxDecompressionEnabled();
 
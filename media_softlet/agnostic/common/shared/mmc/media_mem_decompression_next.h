@@ -31,6 +31,8 @@
 #include "mediamemdecomp.h"
 #include "media_interfaces_mhw_next.h"
 
+class MediaCpuCopy;
+
 //------------------------------------------------------------------------------
 // Macros specific to MOS_VP_SUBCOMP_RENDER sub-comp
 //------------------------------------------------------------------------------
@@ -311,6 +313,21 @@ protected:
     //!
     bool IsFormatSupported(PMOS_SURFACE surface);
 
+    //!
+    //! Check whether a tile convert is better done on the CPU
+    //! \details  true if Vebox cannot do it, or with MCPY CPU Copy set, if the CPU is
+    //!           predicted to be done before a Vebox submission would complete and the
+    //!           surfaces are idle.
+    //! \param    [in] source
+    //!           Source surface, with the format, region and offset of the convert
+    //! \param    [in] target
+    //!           Target surface, with the format, region and offset of the convert
+    //! \param    [in] veboxSupported
+    //!           Whether Vebox can do the convert
+    //! \return   true to convert on the CPU, else false.
+    //!
+    bool IsCpuTileConvertPreferred(MOS_SURFACE &source, MOS_SURFACE &target, bool veboxSupported);
+
     enum MEDIA_TILE_TYPE
     {
         MEMORY_MEDIACOMPRESSION_ENABLE = 0,
@@ -338,6 +355,8 @@ protected:
     MhwCpInterface                        * m_cpInterface;
     bool                                    m_veboxMMCResolveEnabled;
     PMOS_MUTEX                              m_renderMutex = nullptr;
+    MediaCpuCopy                          * m_cpuCopy = nullptr;
+    bool                                    m_cpuCopyPredict = false;  //!< let the CPU take small converts
 
     MediaUserSettingSharedPtr m_userSettingPtr = nullptr;  //!< UserSettingInstance
 MEDIA_CLASS_DEFINE_END(MediaMemDeCompNext)
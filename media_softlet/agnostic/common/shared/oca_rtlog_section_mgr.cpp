@@ -26,9 +26,11 @@
 
 #include "oca_rtlog_section_mgr.h"
 #include "mos_utilities.h"
+#include "mos_oca_rtlog_mgr_base.h"
 
 #define ADDRESS_PAGE_ALIGNMENT_MASK 0xFFFFFFFFFFFFF000ULL
 
+constexpr uint32_t  OcaRtLogSectionMgr::m_MaxEntryCount;
 OcaRtLogSectionMgr  OcaRtLogSectionMgr::s_rtLogSectionMgr[MOS_OCA_RTLOG_COMPONENT_MAX] = {};
 uint8_t             OcaRtLogSectionMgr::s_localSysMem[MAX_OCA_RT_POOL_SIZE] = {};
 
@@ -54,6 +56,12 @@ MOS_STATUS OcaRtLogSectionMgr::InsertRTLog(
     uint32_t                     paramCount,
     const void                   *param)
 {
+    // Nothing reads the sections if no context attaches the log to its submissions
+    if (!MosOcaRTLogMgrBase::IsOcaRTLogEnabled())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
     //Try to init by calling GetMemAddress.
     GetMemAddress();
 
@@ -109,17 +117,12 @@ void OcaRtLogSectionMgr::Init(uint8_t* logSysMem, uint32_t size, uint32_t compon
         m_LockedHeap = logSysMem;
         m_HeapSize   = size;
         m_Offset     = offset;
-        m_HeapHandle = 0;
         m_EntryCount = (componentSize - sizeof(MOS_OCA_RTLOG_SECTION_HEADER))/ MOS_OCA_RTLOG_ENTRY_SIZE;
+        m_EntryCount = MOS_MIN(m_EntryCount, m_MaxEntryCount);
         m_IsInitialized = true;
     }
 }
 
-uint32_t OcaRtLogSectionMgr::AllocHeapHandle()
-{
-    return (uint32_t)MosUtilities::MosAtomicIncrement((int32_t *)&m_HeapHandle);
-}
-
 MOS_STATUS OcaRtLogSectionMgr::InsertUid(MOS_OCA_RTLOG_SECTION_HEADER sectionHeader)
 {
     if (0 == sectionHeader.magicNum)
@@ -143,15 +146,41 @@ MOS_STATUS OcaRtLogSectionMgr::InsertData(MOS_OCA_RTLOG_HEADER header, const voi
         {
             MOS_OS_CHK_STATUS_RETURN(MOS_STATUS_INVALID_PARAMETER);
         }
-        uint32_t heapHandle = AllocHeapHandle() % m_EntryCount;
-        if (heapHandle < m_EntryCount)
+        // The entry is dropped if every slot is still being written
+        uint32_t slot = 0;
+        if (!AcquireSlot(slot))
         {
-            uint8_t *copyAddr = (uint8_t *)m_LockedHeap + m_Offset + heapHandle * MOS_OCA_RTLOG_ENTRY_SIZE;
-            MOS_OS_CHK_NULL_RETURN(copyAddr);
-            MOS_OS_CHK_STATUS_RETURN(MOS_SecureMemcpy(copyAddr, sizeof(MOS_OCA_RTLOG_HEADER), &header, sizeof(MOS_OCA_RTLOG_HEADER)));
-            uint32_t copySize = header.paramCount * (sizeof(int32_t) + sizeof(int64_t));
-            MOS_OS_CHK_STATUS_RETURN(MOS_SecureMemcpy(copyAddr + sizeof(MOS_OCA_RTLOG_HEADER), copySize, param, copySize));
+            return MOS_STATUS_SUCCESS;
         }
+        uint8_t *copyAddr = (uint8_t *)m_LockedHeap + m_Offset + slot * MOS_OCA_RTLOG_ENTRY_SIZE;
+        uint32_t copySize = header.paramCount * (sizeof(int32_t) + sizeof(int64_t));
+        memcpy(copyAddr, &header, sizeof(MOS_OCA_RTLOG_HEADER));
+        memcpy(copyAddr + sizeof(MOS_OCA_RTLOG_HEADER), param, copySize);
+        ReleaseSlot(slot);
     }
     return MOS_STATUS_SUCCESS;
 }
+
+bool OcaRtLogSectionMgr::AcquireSlot(uint32_t &slot)
+{
+    // Trying each slot once bounds the time spent when writers pile up on a small section
+    for (uint32_t i = 0; i < m_EntryCount; ++i)
+    {
+        uint32_t index    = m_NextSlot.fetch_add(1, std::memory_order_relaxed) % m_EntryCount;
+        bool     expected = false;
+        if (m_SlotBusy[index].compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            slot = index;
+            return true;
+        }
+    }
+    return false;
+}
+
+void OcaRtLogSectionMgr::ReleaseSlot(uint32_t slot)
+{
+    if (slot < m_EntryCount)
+    {
+        m_SlotBusy[slot].store(false, std::memory_order_release);
+    }
+}
@@ -31,7 +31,18 @@
 #include "mos_defs.h"
 #include "mos_oca_rtlog_mgr_defs.h"
 
-class OcaRtLogSectionMgr
+#define MOS_OCA_RTLOG_CACHE_LINE_SIZE 64
+
+//!
+//! \brief  Writer of one component section of the OCA runtime log
+//! \details Writers take entry slots in ring order and fill them without locks. A
+//!          slot is owned by one writer until its entry is written, a writer that
+//!          laps the ring onto a slot still being written moves on to the next one,
+//!          so a slot is never filled by two writers at once. The sections live in the system memory backing the
+//!          OCA runtime log resource, so nothing is copied at submission. Each
+//!          manager sits on its own cache line so components do not contend.
+//!
+class alignas(MOS_OCA_RTLOG_CACHE_LINE_SIZE) OcaRtLogSectionMgr
 {
 public:
     OcaRtLogSectionMgr();
@@ -50,24 +61,35 @@ protected:
     void                        *m_LockedHeap    = nullptr;  //!< System (logical) address for state heap.
     std::atomic<bool>            m_IsInitialized {false};    //!< ture if current heap object has been initialized.
     uint32_t                     m_Offset        = 0;
-    uint32_t                     m_HeapHandle    = 0;
     uint32_t                     m_EntryCount    = 0;
 
+    static constexpr uint32_t    m_MaxEntryCount = MAX_OCA_RT_COMMON_SUB_SIZE / MOS_OCA_RTLOG_ENTRY_SIZE;
+    std::atomic<uint32_t>        m_NextSlot {0};                      //!< Slots handed out so far, wraps over m_EntryCount.
+    std::atomic<bool>            m_SlotBusy[m_MaxEntryCount] = {};    //!< Slot is owned by a writer.
+
     OcaRtLogSectionMgr &operator=(OcaRtLogSectionMgr &)
     {
         return *this;
     }
 
+    void       Init(uint8_t *logSysMem, uint32_t size, uint32_t componentSize, uint32_t offset);
+    MOS_STATUS InsertData(MOS_OCA_RTLOG_HEADER header, const void *param);
+    MOS_STATUS InsertUid(MOS_OCA_RTLOG_SECTION_HEADER sectionHeader);
+
+    //!
+    //! \brief  Take the next free entry slot
+    //! \return bool
+    //!         false if every slot tried is being written, the entry is then dropped
+    //!
+    bool       AcquireSlot(uint32_t &slot);
+    void       ReleaseSlot(uint32_t slot);
+
 private:
     static OcaRtLogSectionMgr  s_rtLogSectionMgr[MOS_OCA_RTLOG_COMPONENT_MAX];
     static uint8_t             s_localSysMem[MAX_OCA_RT_POOL_SIZE];
 
     static uint8_t *InitSectionMgrAndGetAddress();
 
-    void       Init(uint8_t *logSysMem, uint32_t size, uint32_t componentSize, uint32_t offset);
-    uint32_t   AllocHeapHandle();
-    MOS_STATUS InsertData(MOS_OCA_RTLOG_HEADER header, const void *param);
-    MOS_STATUS InsertUid(MOS_OCA_RTLOG_SECTION_HEADER sectionHeader);
     bool       IsInitialized() { return m_IsInitialized; }
     uint64_t   GetHeapSize() { return m_HeapSize; }
     void       *GetLockHeap() { return m_LockedHeap; }
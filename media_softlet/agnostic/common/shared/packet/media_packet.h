@@ -41,6 +41,7 @@
 #include "mhw_cmdpar.h"
 #include "mhw_mi_itf.h"
 class MediaStatusReport;
+class MediaGpuTiming;
 class MhwMiInterface;
 namespace mhw{namespace mi{class Itf;}}  // namespace mhw
 
@@ -163,6 +164,35 @@ public:
         return MOS_STATUS_SUCCESS;
     }
 
+    //!
+    //! \brief  Add the size of the GPU timestamps StoreGpuTimestamp may add
+    //! \details Nothing is added unless GPU frame timing is enabled.
+    //! \param  [in, out] commandBufferSize
+    //!         requested size
+    //! \param  [in, out] requestedPatchListSize
+    //!         requested size
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AddGpuTimestampCommandSize(
+        uint32_t &commandBufferSize,
+        uint32_t &requestedPatchListSize);
+
+    //!
+    //! \brief  Time the packet with a GPU timing which is not owned by the status report
+    //! \details Used by pipelines without a MediaStatusReport, the timing of the status
+    //!          report is used otherwise.
+    //! \param  [in] gpuTiming
+    //!         GPU timing of the pipeline, nullptr to use the status report
+    //! \param  [in] frame
+    //!         Frame counter of the pipeline
+    //!
+    void SetGpuTiming(MediaGpuTiming *gpuTiming, uint32_t frame)
+    {
+        m_gpuTiming      = gpuTiming;
+        m_gpuTimingFrame = frame;
+    }
+
     //!
     //! \brief  Get current associated media task
     //! \return MediaTask*
@@ -349,6 +379,27 @@ protected:
         uint32_t srType,
         MOS_COMMAND_BUFFER *cmdBuffer);
 
+    //!
+    //! \brief  Store a GPU timestamp of the current frame on the current engine
+    //! \details Nothing is added unless GPU frame timing is enabled.
+    //! \param  [in] start
+    //!         true at the start of the packet, false at its end
+    //! \param  [in, out] cmdBuffer
+    //!         cmdbuffer to send cmds
+    //! \param  [in] sfcUsed
+    //!         The packet drives SFC, which is timed with the same timestamps
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS StoreGpuTimestamp(bool start, MOS_COMMAND_BUFFER *cmdBuffer, bool sfcUsed = false);
+
+    //!
+    //! \brief  Get the GPU timing and frame counter the packet stores timestamps for
+    //! \return MediaGpuTiming*
+    //!         nullptr if GPU frame timing is disabled
+    //!
+    MediaGpuTiming *GetGpuTiming(uint32_t &frame);
+
 protected:
     MediaTask                     *m_task         = nullptr;        //!< MediaTask associated with current packet
     PMOS_INTERFACE                m_osInterface   = nullptr;
@@ -356,6 +407,8 @@ protected:
     MediaStatusReport             *m_statusReport = nullptr;
     std::shared_ptr<mhw::mi::Itf> m_miItf         = nullptr;
     MediaUserSettingSharedPtr     m_userSettingPtr = nullptr;  //!< usersettingInstance
+    MediaGpuTiming                *m_gpuTiming     = nullptr;  //!< GPU timing set by the pipeline, if any
+    uint32_t                      m_gpuTimingFrame = 0;
 #if (_DEBUG || _RELEASE_INTERNAL)
     //! Set to true when BypassHwLegacy is fully initialized and active. Controls two behaviors:
     //! (1) Disables NullHW::StartPredicateNext/StopPredicateNext so BypassHwLegacy is the
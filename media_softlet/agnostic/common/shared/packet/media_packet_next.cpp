@@ -53,6 +53,7 @@ MOS_STATUS MediaPacket::StartStatusReportNext(
     result = m_statusReport->GetAddress(srType, osResource, offset);
 
     result = SetStartTagNext(osResource, offset, srType, cmdBuffer);
+    MEDIA_CHK_STATUS_RETURN(StoreGpuTimestamp(true, cmdBuffer));
 
 #if (_DEBUG || _RELEASE_INTERNAL)
     if (!m_bypassHwLegacyEnabled)
@@ -114,6 +115,8 @@ MOS_STATUS MediaPacket::EndStatusReportNext(
         MEDIA_CHK_STATUS_RETURN(NullHW::StopPredicateNext(m_osInterface, m_miItf, cmdBuffer));
     }
 
+    MEDIA_CHK_STATUS_RETURN(StoreGpuTimestamp(false, cmdBuffer));
+
     result = m_statusReport->GetAddress(srType, osResource, offset);
 
     result = SetEndTagNext(osResource, offset, srType, cmdBuffer);
@@ -155,25 +158,83 @@ MOS_STATUS MediaPacket::SetEndTagNext(
     return MOS_STATUS_SUCCESS;
 }
 
-#if (_DEBUG || _RELEASE_INTERNAL)
-MOS_STATUS MediaPacket::StoreEngineId(MOS_COMMAND_BUFFER *cmdBuffer, uint32_t statusReportType, uint8_t curPipe, uint32_t csEngineIdReg)
+MediaGpuTiming *MediaPacket::GetGpuTiming(uint32_t &frame)
+{
+    MediaGpuTiming *gpuTiming = m_gpuTiming;
+    frame                     = m_gpuTimingFrame;
+    if (gpuTiming == nullptr && m_statusReport != nullptr)
+    {
+        gpuTiming = m_statusReport->GetGpuTiming();
+        frame     = m_statusReport->GetSubmittedCount();
+    }
+    return (gpuTiming && gpuTiming->IsEnabled()) ? gpuTiming : nullptr;
+}
+
+MOS_STATUS MediaPacket::AddGpuTimestampCommandSize(
+    uint32_t &commandBufferSize,
+    uint32_t &requestedPatchListSize)
 {
+    uint32_t frame = 0;
+    if (GetGpuTiming(frame) == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
     MEDIA_CHK_NULL_RETURN(m_miItf);
-    MEDIA_CHK_NULL_RETURN(m_statusReport);
 
-    MOS_RESOURCE* osResource = nullptr;
-    uint32_t      offset     = 0;
+    // Start and end, each once for the engine and once for SFC
+    const uint32_t timestampNum = 4;
+    uint32_t       cmdSize      = (uint32_t)MOS_MAX(m_miItf->MHW_GETSIZE_F(PIPE_CONTROL)(), m_miItf->MHW_GETSIZE_F(MI_FLUSH_DW)());
+    commandBufferSize += timestampNum * cmdSize;
+    requestedPatchListSize += timestampNum;
 
-    auto &par = m_miItf->MHW_GETPAR_F(MI_STORE_REGISTER_MEM)();
-    par       = {};
+    return MOS_STATUS_SUCCESS;
+}
 
-    MEDIA_CHK_STATUS_RETURN(m_statusReport->GetAddress(statusReportType, osResource, offset));
-    par.presStoreBuffer      = osResource;
-    par.dwOffset             = offset + curPipe * sizeof(uint32_t);
-    par.dwRegister           = csEngineIdReg;
+MOS_STATUS MediaPacket::StoreGpuTimestamp(bool start, MOS_COMMAND_BUFFER *cmdBuffer, bool sfcUsed)
+{
+    uint32_t        frame     = 0;
+    MediaGpuTiming *gpuTiming = GetGpuTiming(frame);
+    if (gpuTiming == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    MEDIA_CHK_NULL_RETURN(m_miItf);
+    MEDIA_CHK_NULL_RETURN(m_osInterface);
+
+    MOS_GPU_CONTEXT        gpuContext = m_osInterface->pfnGetGpuContext(m_osInterface);
+    MediaGpuTiming::Engine engines[]  = {MediaGpuTiming::GetEngine(gpuContext), MediaGpuTiming::engineSfc};
 
-    MEDIA_CHK_STATUS_RETURN(m_miItf->MHW_ADDCMD_F(MI_STORE_REGISTER_MEM)(cmdBuffer));
+    for (uint32_t i = 0; i < (sfcUsed ? 2u : 1u); i++)
+    {
+        PMOS_RESOURCE osResource = nullptr;
+        uint32_t      offset     = 0;
+        MEDIA_CHK_STATUS_RETURN(gpuTiming->GetAddress(frame, engines[i], gpuContext, start, osResource, offset));
+        if (osResource == nullptr)
+        {
+            continue;
+        }
+
+        // Same post sync writes as the perf profiler, PIPE_CONTROL on render and MI_FLUSH_DW elsewhere
+        if (MOS_RCS_ENGINE_USED(gpuContext))
+        {
+            auto &par            = m_miItf->MHW_GETPAR_F(PIPE_CONTROL)();
+            par                  = {};
+            par.presDest         = osResource;
+            par.dwResourceOffset = offset;
+            par.dwPostSyncOp     = MHW_FLUSH_WRITE_TIMESTAMP_REG;
+            par.dwFlushMode      = MHW_FLUSH_READ_CACHE;
+            MEDIA_CHK_STATUS_RETURN(m_miItf->MHW_ADDCMD_F(PIPE_CONTROL)(cmdBuffer));
+        }
+        else
+        {
+            auto &par             = m_miItf->MHW_GETPAR_F(MI_FLUSH_DW)();
+            par                   = {};
+            par.pOsResource       = osResource;
+            par.dwResourceOffset  = offset;
+            par.postSyncOperation = MHW_FLUSH_WRITE_TIMESTAMP_REG;
+            MEDIA_CHK_STATUS_RETURN(m_miItf->MHW_ADDCMD_F(MI_FLUSH_DW)(cmdBuffer));
+        }
+    }
 
     return MOS_STATUS_SUCCESS;
 }
-#endif
\ No newline at end of file
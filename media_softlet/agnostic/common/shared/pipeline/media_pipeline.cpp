@@ -173,7 +173,11 @@ MediaPacket *MediaPipeline::GetOrCreate(uint32_t packetId)
             MOS_STATUS status = iter->second->Init();
             if (MOS_FAILED(status))
             {
+                // Drop the packet so that the next activation does not use it half initialized
                 MOS_OS_ASSERTMESSAGE("Media packet init failed!");
+                MOS_Delete(iter->second);
+                m_packetList.erase(iter);
+                return nullptr;
             }
             return iter->second;
         }
@@ -208,15 +212,15 @@ MOS_STATUS MediaPipeline::ActivatePacket(uint32_t packetId, bool immediateSubmit
 
 MOS_STATUS MediaPipeline::ActivatePacket(uint32_t packetId, bool immediateSubmit, StateParams &stateProperty)
 {
-    auto iter = m_packetList.find(packetId);
-    if (iter == m_packetList.end())
+    auto packet = GetOrCreate(packetId);
+    if (packet == nullptr)
     {
         return MOS_STATUS_INVALID_PARAMETER;
     }
 
     PacketProperty prop;
-    prop.packetId        = iter->first;
-    prop.packet          = iter->second;
+    prop.packetId        = packetId;
+    prop.packet          = packet;
     prop.immediateSubmit = immediateSubmit;
     prop.stateProperty   = stateProperty;
     MOS_TraceEventExt(EVENT_PIPE_PACKET, EVENT_TYPE_INFO, &packetId, sizeof(packetId), &stateProperty, sizeof(StateParams));
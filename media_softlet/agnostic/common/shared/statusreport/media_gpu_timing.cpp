@@ -0,0 +1,299 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     media_gpu_timing.cpp
+//! \brief    Implements per engine GPU timing of media frames
+//!
+#include <cstddef>
+#include "media_gpu_timing.h"
+#include "mos_os.h"
+
+MediaGpuTiming::MediaGpuTiming(PMOS_INTERFACE osInterface, uint32_t frameNum) :
+    m_osInterface(osInterface),
+    m_frameNum(frameNum)
+{
+    MediaUserSettingSharedPtr userSettingPtr = nullptr;
+    if (osInterface && osInterface->pfnGetUserSettingInstance)
+    {
+        userSettingPtr = osInterface->pfnGetUserSettingInstance(osInterface);
+    }
+    ReadUserSetting(
+        userSettingPtr,
+        m_enabled,
+        __MEDIA_USER_FEATURE_VALUE_GPU_FRAME_TIMING,
+        MediaUserSetting::Group::Device);
+
+    if (m_osInterface == nullptr || m_frameNum == 0)
+    {
+        m_enabled = false;
+    }
+}
+
+MediaGpuTiming::~MediaGpuTiming()
+{
+    if (m_timing && m_osInterface)
+    {
+        m_osInterface->pfnUnlockResource(m_osInterface, &m_timingBuf);
+        m_osInterface->pfnFreeResource(m_osInterface, &m_timingBuf);
+        m_timing = nullptr;
+    }
+    MOS_DeleteArray(m_frameState);
+}
+
+MediaGpuTiming::Engine MediaGpuTiming::GetEngine(MOS_GPU_CONTEXT gpuContext)
+{
+    if (MOS_RCS_ENGINE_USED(gpuContext))
+    {
+        return engineRender;
+    }
+    if (MOS_VCS_ENGINE_USED(gpuContext))
+    {
+        return engineVdbox;
+    }
+    if (MOS_VECS_ENGINE_USED(gpuContext))
+    {
+        return engineVebox;
+    }
+    if (MOS_BCS_ENGINE_USED(gpuContext))
+    {
+        return engineBlt;
+    }
+    return engineNum;
+}
+
+MOS_STATUS MediaGpuTiming::Create()
+{
+    if (m_timing != nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_ALLOC_GFXRES_PARAMS allocParams;
+    MOS_ZeroMemory(&allocParams, sizeof(allocParams));
+    allocParams.Type         = MOS_GFXRES_BUFFER;
+    allocParams.TileType     = MOS_TILE_LINEAR;
+    allocParams.Format       = Format_Buffer;
+    allocParams.dwBytes      = sizeof(Timestamps) * engineNum * m_frameNum;
+    allocParams.pBufName     = "MediaGpuTiming";
+    allocParams.ResUsageType = MOS_HW_RESOURCE_USAGE_MEDIA_BATCH_BUFFERS;
+    allocParams.dwMemType    = MOS_MEMPOOL_SYSTEMMEMORY;
+
+    MOS_OS_CHK_STATUS_RETURN(m_osInterface->pfnAllocateResource(m_osInterface, &allocParams, &m_timingBuf));
+    m_osInterface->pfnSkipResourceSync(&m_timingBuf);
+
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(lockFlags));
+    // The CPU clears a slot each time it is reused, so map it for write
+    lockFlags.WriteOnly = 1;
+    m_timing = (Timestamps *)m_osInterface->pfnLockResource(m_osInterface, &m_timingBuf, &lockFlags);
+    if (m_timing == nullptr)
+    {
+        m_osInterface->pfnFreeResource(m_osInterface, &m_timingBuf);
+        m_enabled = false;
+        return MOS_STATUS_NULL_POINTER;
+    }
+    MOS_ZeroMemory(m_timing, sizeof(Timestamps) * engineNum * m_frameNum);
+
+    m_frameState = MOS_NewArray(FrameState, m_frameNum);
+    if (m_frameState == nullptr)
+    {
+        m_osInterface->pfnUnlockResource(m_osInterface, &m_timingBuf);
+        m_osInterface->pfnFreeResource(m_osInterface, &m_timingBuf);
+        m_timing  = nullptr;
+        m_enabled = false;
+        return MOS_STATUS_NO_SPACE;
+    }
+    MOS_ZeroMemory(m_frameState, sizeof(FrameState) * m_frameNum);
+
+    m_tsFrequency = m_osInterface->pfnGetTsFrequency ? m_osInterface->pfnGetTsFrequency(m_osInterface) : 0;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaGpuTiming::GetAddress(
+    uint32_t        frame,
+    Engine          engine,
+    MOS_GPU_CONTEXT gpuContext,
+    bool            start,
+    PMOS_RESOURCE   &osResource,
+    uint32_t        &offset)
+{
+    osResource = nullptr;
+    offset     = 0;
+
+    if (!m_enabled || engine >= engineNum)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    MOS_OS_CHK_STATUS_RETURN(Create());
+
+    uint32_t   index = FrameToIndex(frame);
+    FrameState &state = m_frameState[index];
+    if (!state.valid || state.frame != frame)
+    {
+        // The slot was last used m_frameNum frames ago
+        MOS_ZeroMemory(&m_timing[index * engineNum], sizeof(Timestamps) * engineNum);
+        MOS_ZeroMemory(&state, sizeof(state));
+        state.frame = frame;
+        state.valid = true;
+    }
+
+    if (start)
+    {
+        if (state.startedEngines & (1 << engine))
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+        state.startedEngines |= 1 << engine;
+    }
+    state.gpuContext[engine] = gpuContext;
+
+    osResource = &m_timingBuf;
+    offset     = (index * engineNum + engine) * sizeof(Timestamps) +
+             (start ? offsetof(Timestamps, startTs) : offsetof(Timestamps, endTs));
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaGpuTiming::GetEngineTimes(uint32_t frame, uint64_t timeNs[engineNum])
+{
+    MOS_OS_CHK_NULL_RETURN(timeNs);
+    MOS_ZeroMemory(timeNs, sizeof(uint64_t) * engineNum);
+
+    if (m_timing == nullptr || m_tsFrequency == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    uint32_t         index = FrameToIndex(frame);
+    const FrameState &state = m_frameState[index];
+    if (!state.valid || state.frame != frame)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    for (uint32_t engine = 0; engine < engineNum; engine++)
+    {
+        const Timestamps &ts = m_timing[index * engineNum + engine];
+        if (ts.startTs != 0 && ts.endTs > ts.startTs)
+        {
+            timeNs[engine] = (ts.endTs - ts.startTs) * 1000000000ull / m_tsFrequency;
+        }
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+void MediaGpuTiming::Report(uint32_t component, uint32_t frame, const uint64_t timeNs[engineNum])
+{
+    struct
+    {
+        uint32_t component;             // MOS_COMPONENT
+        uint32_t frame;                 // frame counter of the component
+        uint64_t timeNs[engineNum];     // render, vdbox, vebox, sfc, blt
+    } timing = {};
+
+    timing.component = component;
+    timing.frame     = frame;
+    MOS_SecureMemcpy(timing.timeNs, sizeof(timing.timeNs), timeNs, sizeof(uint64_t) * engineNum);
+    MOS_TraceEvent(EVENT_MEDIA_GPU_TIMING, EVENT_TYPE_INFO, &timing, sizeof(timing), nullptr, 0);
+
+    MOS_OS_VERBOSEMESSAGE("GPU timing of component %d frame %d: render %llu vdbox %llu vebox %llu sfc %llu blt %llu ns",
+        component,
+        frame,
+        (unsigned long long)timeNs[engineRender],
+        (unsigned long long)timeNs[engineVdbox],
+        (unsigned long long)timeNs[engineVebox],
+        (unsigned long long)timeNs[engineSfc],
+        (unsigned long long)timeNs[engineBlt]);
+}
+
+MOS_STATUS MediaGpuTiming::EndFrame(uint32_t frame)
+{
+    if (!m_enabled || m_frameState == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    MOS_OS_CHK_NULL_RETURN(m_osInterface->pfnGetGpuStatusTag);
+
+    FrameState &state = m_frameState[FrameToIndex(frame)];
+    if (!state.valid || state.frame != frame)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    for (uint32_t engine = 0; engine < engineNum; engine++)
+    {
+        if (state.startedEngines & (1 << engine))
+        {
+            // The tag was incremented by the last submission to the context
+            uint32_t tag      = m_osInterface->pfnGetGpuStatusTag(m_osInterface, state.gpuContext[engine]);
+            state.tag[engine] = tag > 1 ? tag - 1 : 0;
+        }
+    }
+
+    if (!m_framePending)
+    {
+        m_reportedFrame = frame;
+    }
+    m_framePending = true;
+    m_endedFrame   = frame;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaGpuTiming::ReportCompletedFrames(uint32_t component)
+{
+    if (!m_enabled || !m_framePending)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    MOS_OS_CHK_NULL_RETURN(m_osInterface->pfnGetGpuStatusSyncTag);
+
+    // Frames older than the slots are overwritten already
+    if (m_endedFrame - m_reportedFrame >= m_frameNum)
+    {
+        m_reportedFrame = m_endedFrame - m_frameNum + 1;
+    }
+
+    while (m_framePending)
+    {
+        uint32_t         frame = m_reportedFrame;
+        const FrameState &state = m_frameState[FrameToIndex(frame)];
+        if (state.valid && state.frame == frame)
+        {
+            for (uint32_t engine = 0; engine < engineNum; engine++)
+            {
+                if ((state.startedEngines & (1 << engine)) &&
+                    m_osInterface->pfnGetGpuStatusSyncTag(m_osInterface, state.gpuContext[engine]) < state.tag[engine])
+                {
+                    return MOS_STATUS_SUCCESS;
+                }
+            }
+
+            uint64_t timeNs[engineNum] = {};
+            MOS_OS_CHK_STATUS_RETURN(GetEngineTimes(frame, timeNs));
+            Report(component, frame, timeNs);
+        }
+
+        m_framePending  = (frame != m_endedFrame);
+        m_reportedFrame = frame + 1;
+    }
+    return MOS_STATUS_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_gpu_timing.h
+//! \brief    Defines the class for per engine GPU timing of media frames
+//! \details  Packets store GPU timestamps around the commands of a frame, one
+//!           pair per engine. The busy time of each engine is reported through
+//!           the status report and the EVENT_MEDIA_GPU_TIMING trace event.
+//!
+#ifndef __MEDIA_GPU_TIMING_H__
+#define __MEDIA_GPU_TIMING_H__
+
+#include "mos_os_specific.h"
+
+class MediaGpuTiming
+{
+public:
+    enum Engine
+    {
+        engineRender = 0,   //!< Render and compute command streamer
+        engineVdbox,        //!< VDBox command streamer
+        engineVebox,        //!< VEBOX command streamer
+        engineSfc,          //!< SFC, timed by the packets which drive it
+        engineBlt,          //!< Blitter command streamer
+        engineNum
+    };
+
+    //!
+    //! \brief  GPU timestamps of one engine for one frame
+    //!
+    struct Timestamps
+    {
+        uint64_t startTs;   //!< Timestamp when the first packet of the frame on the engine started
+        uint64_t endTs;     //!< Timestamp when the last packet of the frame on the engine ended
+    };
+
+    //!
+    //! \brief  Constructor
+    //! \param  [in] osInterface
+    //!         OS interface to allocate the timestamp buffer and read the setting
+    //! \param  [in] frameNum
+    //!         Number of frames in flight the timestamps are kept for
+    //!
+    MediaGpuTiming(PMOS_INTERFACE osInterface, uint32_t frameNum);
+    virtual ~MediaGpuTiming();
+
+    //!
+    //! \brief  Is GPU timing enabled by "Media GPU Frame Timing"
+    //! \return m_enabled
+    //!
+    bool IsEnabled() const { return m_enabled; }
+
+    //!
+    //! \brief  Get the engine which runs a GPU context
+    //! \param  [in] gpuContext
+    //!         GPU context
+    //! \return Engine
+    //!         engineNum if the context is not timed
+    //!
+    static Engine GetEngine(MOS_GPU_CONTEXT gpuContext);
+
+    //!
+    //! \brief  Get address to store a GPU timestamp of a frame
+    //! \details Only the first start of a frame on an engine is stored, so the time
+    //!          of a frame split in several packets spans all of them. Ends are
+    //!          always stored and the last one submitted wins.
+    //! \param  [in] frame
+    //!         Frame counter of the caller
+    //! \param  [in] engine
+    //!         Engine running the commands
+    //! \param  [in] gpuContext
+    //!         GPU context the commands are submitted to, for completion checks
+    //! \param  [in] start
+    //!         true for the start timestamp, false for the end timestamp
+    //! \param  [out] osResource
+    //!         Resource to store the timestamp in, nullptr if nothing is to be stored
+    //! \param  [out] offset
+    //!         Offset of the timestamp in the resource
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS GetAddress(
+        uint32_t        frame,
+        Engine          engine,
+        MOS_GPU_CONTEXT gpuContext,
+        bool            start,
+        PMOS_RESOURCE   &osResource,
+        uint32_t        &offset);
+
+    //!
+    //! \brief  Get the busy time of each engine for a completed frame
+    //! \param  [in] frame
+    //!         Frame counter of the caller
+    //! \param  [out] timeNs
+    //!         Time of each engine in ns, 0 for engines the frame did not use
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS GetEngineTimes(uint32_t frame, uint64_t timeNs[engineNum]);
+
+    //!
+    //! \brief  Report the engine times of a frame as EVENT_MEDIA_GPU_TIMING
+    //! \param  [in] component
+    //!         MOS_COMPONENT of the caller
+    //! \param  [in] frame
+    //!         Frame counter of the caller
+    //! \param  [in] timeNs
+    //!         Time of each engine in ns
+    //!
+    void Report(uint32_t component, uint32_t frame, const uint64_t timeNs[engineNum]);
+
+    //!
+    //! \brief  Mark all commands of a frame as submitted
+    //! \details For callers without a status report, which find completed frames
+    //!          through the GPU status tags in ReportCompletedFrames.
+    //! \param  [in] frame
+    //!         Frame counter of the caller, frames are ended in order
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS EndFrame(uint32_t frame);
+
+    //!
+    //! \brief  Report the ended frames the GPU completed, in order
+    //! \param  [in] component
+    //!         MOS_COMPONENT of the caller
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ReportCompletedFrames(uint32_t component);
+
+protected:
+    //!
+    //! \brief  CPU side state of one frame slot
+    //!
+    struct FrameState
+    {
+        uint32_t        frame;                          //!< Frame counter the slot holds
+        bool            valid;                          //!< Slot was written for frame
+        uint32_t        startedEngines;                 //!< Bit per engine whose start is stored
+        MOS_GPU_CONTEXT gpuContext[engineNum];          //!< Last GPU context per engine
+        uint32_t        tag[engineNum];                 //!< GPU status tag of the context at EndFrame
+    };
+
+    MOS_STATUS Create();
+
+    inline uint32_t FrameToIndex(uint32_t frame) const
+    {
+        return frame % m_frameNum;
+    }
+
+    PMOS_INTERFACE   m_osInterface      = nullptr;
+    bool             m_enabled          = false;    //!< Store GPU timestamps around each frame
+    uint32_t         m_frameNum         = 0;
+    MOS_RESOURCE     m_timingBuf        = {};       //!< m_frameNum slots of engineNum Timestamps
+    Timestamps       *m_timing          = nullptr;
+    FrameState       *m_frameState      = nullptr;
+    uint32_t         m_tsFrequency      = 0;        //!< GPU timestamp frequency in Hz
+    bool             m_framePending     = false;    //!< Some ended frame was not reported yet
+    uint32_t         m_reportedFrame    = 0;        //!< Next ended frame to report
+    uint32_t         m_endedFrame       = 0;        //!< Last ended frame
+
+MEDIA_CLASS_DEFINE_END(MediaGpuTiming)
+};
+
+#endif // !__MEDIA_GPU_TIMING_H__
@@ -21,11 +21,13 @@
 
 set(TMP_SOURCES_
     ${TMP_SOURCES_}
+    ${CMAKE_CURRENT_LIST_DIR}/media_gpu_timing.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_status_report.cpp
 )
 
 set(TMP_HEADERS_
     ${TMP_HEADERS_}
+    ${CMAKE_CURRENT_LIST_DIR}/media_gpu_timing.h
     ${CMAKE_CURRENT_LIST_DIR}/media_status_report.h
     ${CMAKE_CURRENT_LIST_DIR}/media_status_report_observer.h
 )
@@ -29,12 +29,15 @@
 #include "media_status_report.h"
 #include "mos_os.h"
 
+const uint32_t MediaStatusReport::m_statusNum;
+
 MediaStatusReport::MediaStatusReport(PMOS_INTERFACE osInterface)
 {
     if (osInterface && osInterface->pfnGetUserSettingInstance)
     {
         m_userSettingPtr = osInterface->pfnGetUserSettingInstance(osInterface);
     }
+    m_gpuTiming = MOS_New(MediaGpuTiming, osInterface, m_statusNum);
 #if (_DEBUG || _RELEASE_INTERNAL)
     ReadUserSettingForDebug(
         m_userSettingPtr,
@@ -44,6 +47,25 @@ MediaStatusReport::MediaStatusReport(PMOS_INTERFACE osInterface)
 #endif
 }
 
+MediaStatusReport::~MediaStatusReport()
+{
+    MOS_Delete(m_gpuTiming);
+}
+
+MOS_STATUS MediaStatusReport::ReportGpuTiming(uint32_t component, uint64_t timeNs[MediaGpuTiming::engineNum])
+{
+    MOS_OS_CHK_NULL_RETURN(timeNs);
+    MOS_ZeroMemory(timeNs, sizeof(uint64_t) * MediaGpuTiming::engineNum);
+
+    if (m_gpuTiming == nullptr || !m_gpuTiming->IsEnabled())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    MOS_OS_CHK_STATUS_RETURN(m_gpuTiming->GetEngineTimes(m_parsedCount, timeNs));
+    m_gpuTiming->Report(component, m_parsedCount, timeNs);
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS MediaStatusReport::GetAddress(uint32_t statusReportType, PMOS_RESOURCE &osResource, uint32_t &offset)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
@@ -82,8 +104,8 @@ MOS_STATUS MediaStatusReport::GetReport(uint16_t requireNum, void *status)
     while (reportedCount != completedCount && generatedReportCount < requireNum){
 
         // Get reverse order index to temporally fix application get status report size bigger than 2 case.
-        reportIndex = reverseOrder ? CounterToIndex(completedCount + reportedCountOrigin - reportedCount -1) :
-                                     CounterToIndex(reportedCount);
+        m_parsedCount = reverseOrder ? completedCount + reportedCountOrigin - reportedCount - 1 : reportedCount;
+        reportIndex   = CounterToIndex(m_parsedCount);
         // m_reportedCount is used by component. Need to assign actual index before call ParseStatus
         m_reportedCount = reportIndex;
         eStatus = ParseStatus(((uint8_t*)status + m_sizeOfReport * generatedReportCount), reportIndex);
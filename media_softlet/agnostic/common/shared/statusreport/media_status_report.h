@@ -29,6 +29,7 @@
 
 #include "mos_os_specific.h"
 #include "media_status_report_observer.h"
+#include "media_gpu_timing.h"
 
 #define STATUS_REPORT_GLOBAL_COUNT 0
 
@@ -82,7 +83,7 @@ public:
     //! \brief  Constructor
     //!
     MediaStatusReport(PMOS_INTERFACE osInterface);
-    virtual ~MediaStatusReport() {};
+    virtual ~MediaStatusReport();
 
     //!
     //! \brief  Create resources for status report and do initialization
@@ -142,6 +143,13 @@ public:
     //!
     uint32_t GetSubmittedCount() const { return m_submittedCount; }
 
+    //!
+    //! \brief  Get the per engine GPU timing of the frames, indexed by submitted count
+    //! \return MediaGpuTiming*
+    //!         nullptr if it could not be created
+    //!
+    MediaGpuTiming *GetGpuTiming() { return m_gpuTiming; }
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     //!
     //! \brief  Is Vdbox physical id reporting enabled
@@ -234,6 +242,18 @@ protected:
     //!
     MOS_STATUS NotifyObservers(void *mfxStatus, void *rcsStatus, void *statusReport);
 
+    //!
+    //! \brief  Get and report the engine times of the frame being parsed
+    //! \details Called from ParseStatus.
+    //! \param  [in] component
+    //!         MOS_COMPONENT of the status report
+    //! \param  [out] timeNs
+    //!         Time of each engine in ns, all 0 if timing is disabled
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ReportGpuTiming(uint32_t component, uint64_t timeNs[MediaGpuTiming::engineNum]);
+
     void Lock(){m_lock.lock();};
     void UnLock(){m_lock.unlock();};
 
@@ -257,6 +277,9 @@ protected:
     uint32_t         m_usedVdboxIds          = 0;      //!< Used Vdbox physical engine id. Default 0 is not used. Each Hex symbol represents one VDBOX, e.g. bits[3:0] means VD0, bits[7:4] means VD1.
 #endif
     MediaUserSettingSharedPtr                 m_userSettingPtr  = nullptr;  //!< user setting instance
+
+    MediaGpuTiming   *m_gpuTiming            = nullptr;
+    uint32_t         m_parsedCount           = 0;      //!< Submitted count of the frame in ParseStatus
     std::recursive_mutex                      m_lock;
     std::vector<MediaStatusReportObserver *>  m_completeObservers;
 MEDIA_CLASS_DEFINE_END(MediaStatusReport)
@@ -62,6 +62,7 @@ MOS_STATUS CmdTask::CalculateCmdBufferSizeFromActivePackets()
             curRequestedPatchListSize = 0;
 
             packet->CalculateCommandSize(curCommandBufferSize, curRequestedPatchListSize);
+            MEDIA_CHK_STATUS_RETURN(packet->AddGpuTimestampCommandSize(curCommandBufferSize, curRequestedPatchListSize));
             m_cmdBufSize += curCommandBufferSize;
             m_patchListSize += curRequestedPatchListSize;
         }
@@ -641,6 +641,18 @@ MOS_STATUS VpAllocator::UnLock(MOS_RESOURCE *resource)
     return m_allocator->UnLock(resource);
 }
 
+MOS_STATUS VpAllocator::LockResourceForWriteAsync(MOS_RESOURCE *resource, MosAsyncLockCallback callback)
+{
+    VP_FUNC_CALL();
+    VP_PUBLIC_CHK_NULL_RETURN(m_allocator);
+
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
+    lockFlags.WriteOnly = 1;
+
+    return m_allocator->LockAsync(resource, &lockFlags, std::move(callback));
+}
+
 MOS_STATUS VpAllocator::SkipResourceSync(MOS_RESOURCE *resource)
 {
     VP_FUNC_CALL();
@@ -271,6 +271,20 @@ public:
     //!
     MOS_STATUS UnLock(MOS_RESOURCE *resource);
 
+    //!
+    //! \brief  Lock resource for write without waiting for the GPU
+    //! \details The callback gets the locked data once the GPU is done with the resource,
+    //!           at the latest before the next submission. The resource is unlocked when
+    //!           the callback returns.
+    //! \param  [in] resource
+    //!         Pointer to MOS_RESOURCE
+    //! \param  [in] callback
+    //!         Callback receiving the locked data, nullptr if the lock failed
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS LockResourceForWriteAsync(MOS_RESOURCE *resource, MosAsyncLockCallback callback);
+
     //!
     //! \brief  Skip sync resource
     //! \param  [in] resource
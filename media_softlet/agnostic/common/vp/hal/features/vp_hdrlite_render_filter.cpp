@@ -51,6 +51,61 @@ void _RENDER_HDRLITE_PARAMS::Init()
     kernelParams.clear();
 }
 
+constexpr uint32_t VpHdrLite3DLutCache::m_maxEntryNum;
+
+VpHdrLite3DLutCache &VpHdrLite3DLutCache::GetInstance()
+{
+    static VpHdrLite3DLutCache instance;
+    return instance;
+}
+
+std::shared_ptr<const VpHdrLite3DLutCache::Lut> VpHdrLite3DLutCache::Find(const HDRLITE_3DLUT_KEY &key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto &entry : m_entries)
+    {
+        if (0 == memcmp(&entry.key, &key, sizeof(key)))
+        {
+            entry.lastUse = ++m_useCount;
+            return entry.lut;
+        }
+    }
+
+    return nullptr;
+}
+
+void VpHdrLite3DLutCache::Add(const HDRLITE_3DLUT_KEY &key, std::shared_ptr<const Lut> lut)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Another context may have generated the same LUT in the meantime
+    for (auto &entry : m_entries)
+    {
+        if (0 == memcmp(&entry.key, &key, sizeof(key)))
+        {
+            entry.lastUse = ++m_useCount;
+            return;
+        }
+    }
+
+    if (m_entries.size() < m_maxEntryNum)
+    {
+        m_entries.push_back({key, lut, ++m_useCount});
+        return;
+    }
+
+    auto oldest = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->lastUse < oldest->lastUse)
+        {
+            oldest = it;
+        }
+    }
+    *oldest = {key, lut, ++m_useCount};
+}
+
 VpHdrLiteRenderFilter::VpHdrLiteRenderFilter(PVP_MHWINTERFACE vpMhwInterface) : VpFilter(vpMhwInterface)
 {
 }
@@ -549,6 +604,15 @@ MOS_STATUS VpHdrLiteRenderFilter::InitLayerCri3DLut(VpAllocator &allocator, HDR_
     VP_PUBLIC_CHK_NULL_RETURN(inputSurface);
     VP_PUBLIC_CHK_NULL_RETURN(inputSurface->osSurface);
 
+    if (cri3DLutSurface->osSurface->Format != Format_A16B16G16R16 &&
+        cri3DLutSurface->osSurface->Format != Format_R10G10B10A2)
+    {
+        VP_PUBLIC_CHK_STATUS_RETURN(MOS_STATUS_INVALID_PARAMETER);
+    }
+
+    std::shared_ptr<const VpHdrLite3DLutCache::Lut> lut;
+    VP_PUBLIC_CHK_STATUS_RETURN(GetCri3DLut(layerParam, targetHdrParam, inputSurface->osSurface->Format, lut));
+
     MOS_LOCK_PARAMS lockFlags = {};
     MOS_ZeroMemory(&lockFlags, sizeof(lockFlags));
     lockFlags.WriteOnly = 1;
@@ -562,6 +626,8 @@ MOS_STATUS VpHdrLiteRenderFilter::InitLayerCri3DLut(VpAllocator &allocator, HDR_
     });
     VP_PUBLIC_CHK_NULL_RETURN(baseCri3DLut);
 
+    const uint16_t *src3DLut = lut->data();
+
     if (cri3DLutSurface->osSurface->Format == Format_A16B16G16R16)
     {
         uint8_t bytePerPixel = 8;
@@ -577,29 +643,14 @@ MOS_STATUS VpHdrLiteRenderFilter::InitLayerCri3DLut(VpAllocator &allocator, HDR_
                                                       j * cri3DLutSurface->osSurface->dwPitch +
                                                       k * bytePerPixel);
 
-                    uint16_t outputX = 0;
-                    uint16_t outputY = 0;
-                    uint16_t outputZ = 0;
-
-                    VP_PUBLIC_CHK_STATUS_RETURN(GenerateColorTransfer3dLut(
-                        layerParam,
-                        targetHdrParam,
-                        inputSurface->osSurface->Format,
-                        (float)k / (float)(VPHAL_HDR_CRI_3DLUT_SIZE - 1),
-                        (float)j / (float)(VPHAL_HDR_CRI_3DLUT_SIZE - 1),
-                        (float)i / (float)(VPHAL_HDR_CRI_3DLUT_SIZE - 1),
-                        outputX,
-                        outputY,
-                        outputZ));
-
-                    *dst3DLut++ = outputX;
-                    *dst3DLut++ = outputY;
-                    *dst3DLut++ = outputZ;
+                    *dst3DLut++ = *src3DLut++;
+                    *dst3DLut++ = *src3DLut++;
+                    *dst3DLut++ = *src3DLut++;
                 }
             }
         }
     }
-    else if (cri3DLutSurface->osSurface->Format == Format_R10G10B10A2)
+    else
     {
         uint8_t bytePerPixel = 4;
 
@@ -614,32 +665,14 @@ MOS_STATUS VpHdrLiteRenderFilter::InitLayerCri3DLut(VpAllocator &allocator, HDR_
                                                       j * cri3DLutSurface->osSurface->dwPitch +
                                                       k * bytePerPixel);
 
-                    uint16_t outputX = 0;
-                    uint16_t outputY = 0;
-                    uint16_t outputZ = 0;
-
-                    VP_PUBLIC_CHK_STATUS_RETURN(GenerateColorTransfer3dLut(
-                        layerParam,
-                        targetHdrParam,
-                        inputSurface->osSurface->Format,
-                        (float)k / (float)(VPHAL_HDR_CRI_3DLUT_SIZE - 1),
-                        (float)j / (float)(VPHAL_HDR_CRI_3DLUT_SIZE - 1),
-                        (float)i / (float)(VPHAL_HDR_CRI_3DLUT_SIZE - 1),
-                        outputX,
-                        outputY,
-                        outputZ));
-
-                    *dst3dLut = (uint32_t)outputX +
-                                ((uint32_t)outputY << 10) +
-                                ((uint32_t)outputZ << 20);
+                    *dst3dLut = (uint32_t)src3DLut[0] +
+                                ((uint32_t)src3DLut[1] << 10) +
+                                ((uint32_t)src3DLut[2] << 20);
+                    src3DLut += 3;
                 }
             }
         }
     }
-    else
-    {
-        VP_PUBLIC_CHK_STATUS_RETURN(MOS_STATUS_INVALID_PARAMETER);
-    }
 
     return MOS_STATUS_SUCCESS;
 }
@@ -1277,362 +1310,377 @@ MOS_STATUS VpHdrLiteRenderFilter::GenerateH2HPWLFCoeff(HDR_PARAMS &srcHdrParam,
     return MOS_STATUS_SUCCESS;
 }
 
-MOS_STATUS VpHdrLiteRenderFilter::GenerateColorTransfer3dLut(HDRLITE_LAYER_PARAM &param, HDR_PARAMS &targetHdrParam, MOS_FORMAT inputFormat, float fInputX, float fInputY, float fInputZ, uint16_t &outputX, uint16_t &outputY, uint16_t &outputZ)
+double VpHdrLiteRenderFilter::CalculateEotf3DLut(VPHAL_GAMMA_TYPE eotfGamma, double input)
 {
-    HDRStageEnables &stageEnable = param.stageEnable;
-    double           m1          = 0.1593017578125;  // SMPTE ST2084 EOTF parameters
-    double           m2          = 78.84375;         // SMPTE ST2084 EOTF parameters
-    double           c2          = 18.8515625;       // SMPTE ST2084 EOTF parameters
-    double           c3          = 18.6875;          // SMPTE ST2084 EOTF parameters
-    double           c1          = c3 - c2 + 1;      // SMPTE ST2084 EOTF parameters
+    double m1     = 0.1593017578125;  // SMPTE ST2084 EOTF parameters
+    double m2     = 78.84375;         // SMPTE ST2084 EOTF parameters
+    double c2     = 18.8515625;       // SMPTE ST2084 EOTF parameters
+    double c3     = 18.6875;          // SMPTE ST2084 EOTF parameters
+    double c1     = c3 - c2 + 1;      // SMPTE ST2084 EOTF parameters
+    double result = input;
 
-    double resultX = (double)fInputX;
-    double resultY = (double)fInputY;
-    double resultZ = (double)fInputZ;
-
-    // EOTF/CCM/Tone Mapping/OETF require RGB input
-    // So if prior CSC is needed, it will always be YUV to RGB conversion
-    if (stageEnable.PriorCSCEnable)
+    if (eotfGamma == VPHAL_GAMMA_TRADITIONAL_GAMMA)
     {
-        float priorCscMatrix[12] = {};
-        VP_PUBLIC_CHK_STATUS_RETURN(CalculateCscMatrix(param.PriorCSC, true, priorCscMatrix));
-
-        double tempX = resultX;
-        double tempY = resultY;
-        double tempZ = resultZ;
-
-        if (inputFormat == Format_AYUV)
+        if (result < 0.081)
         {
-            resultX = priorCscMatrix[0] * resultY + priorCscMatrix[1] * resultZ + priorCscMatrix[2] * tempX + priorCscMatrix[3];
-            resultY = priorCscMatrix[4] * resultY + priorCscMatrix[5] * resultZ + priorCscMatrix[6] * tempX + priorCscMatrix[7];
-            resultZ = priorCscMatrix[8] * resultY + priorCscMatrix[9] * resultZ + priorCscMatrix[10] * tempX + priorCscMatrix[11];
+            result = result / 4.5;
         }
         else
         {
-            resultX = priorCscMatrix[0] * resultZ + priorCscMatrix[1] * resultY + priorCscMatrix[2] * tempX + priorCscMatrix[3];
-            resultY = priorCscMatrix[4] * resultZ + priorCscMatrix[5] * resultY + priorCscMatrix[6] * tempX + priorCscMatrix[7];
-            resultZ = priorCscMatrix[8] * resultZ + priorCscMatrix[9] * resultY + priorCscMatrix[10] * tempX + priorCscMatrix[11];
+            result = (result + 0.099) / 1.099;
+            result = pow(result, 1.0 / 0.45);
         }
-
-        MOS_CLAMP_MIN_MAX(resultX, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultY, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultZ, 0.0f, 1.0f);
     }
+    else if (eotfGamma == VPHAL_GAMMA_SMPTE_ST2084)
+    {
+        double temp = 0;
 
-    if (stageEnable.EOTFEnable)
+        result = pow(result, 1.0f / m2);
+        temp   = c2 - c3 * result;
+        result = result > c1 ? result - c1 : 0;
+        result = result / temp;
+        result = pow(result, 1.0f / m1);
+    }
+    else if (eotfGamma == VPHAL_GAMMA_BT1886)
     {
-        if (param.EOTFGamma == VPHAL_GAMMA_TRADITIONAL_GAMMA)
+        if (result < -0.0f)
         {
-            if (resultX < 0.081)
-            {
-                resultX = resultX / 4.5;
-            }
-            else
-            {
-                resultX = (resultX + 0.099) / 1.099;
-                resultX = pow(resultX, 1.0 / 0.45);
-            }
-
-            if (resultY < 0.081)
-            {
-                resultY = resultY / 4.5;
-            }
-            else
-            {
-                resultY = (resultY + 0.099) / 1.099;
-                resultY = pow(resultY, 1.0 / 0.45);
-            }
-
-            if (resultZ < 0.081)
-            {
-                resultZ = resultZ / 4.5;
-            }
-            else
-            {
-                resultZ = (resultZ + 0.099) / 1.099;
-                resultZ = pow(resultZ, 1.0 / 0.45);
-            }
+            result = 0;
         }
-        else if (param.EOTFGamma == VPHAL_GAMMA_SMPTE_ST2084)
+        else
         {
-            double temp = 0;
+            result = pow(result, 2.4);
+        }
+    }
 
-            resultX = pow(resultX, 1.0f / m2);
-            temp    = c2 - c3 * resultX;
-            resultX = resultX > c1 ? resultX - c1 : 0;
-            resultX = resultX / temp;
-            resultX = pow(resultX, 1.0f / m1);
+    return result;
+}
 
-            resultY = pow(resultY, 1.0f / m2);
-            temp    = c2 - c3 * resultY;
-            resultY = resultY > c1 ? resultY - c1 : 0;
-            resultY = resultY / temp;
-            resultY = pow(resultY, 1.0f / m1);
+double VpHdrLiteRenderFilter::CalculateOetf3DLut(VPHAL_GAMMA_TYPE oetfGamma, double input)
+{
+    double m1     = 0.1593017578125;  // SMPTE ST2084 EOTF parameters
+    double m2     = 78.84375;         // SMPTE ST2084 EOTF parameters
+    double c2     = 18.8515625;       // SMPTE ST2084 EOTF parameters
+    double c3     = 18.6875;          // SMPTE ST2084 EOTF parameters
+    double c1     = c3 - c2 + 1;      // SMPTE ST2084 EOTF parameters
+    double result = input;
 
-            resultZ = pow(resultZ, 1.0f / m2);
-            temp    = c2 - c3 * resultZ;
-            resultZ = resultZ > c1 ? resultZ - c1 : 0;
-            resultZ = resultZ / temp;
-            resultZ = pow(resultZ, 1.0f / m1);
-        }
-        else if (param.EOTFGamma == VPHAL_GAMMA_BT1886)
+    if (oetfGamma == VPHAL_GAMMA_TRADITIONAL_GAMMA)
+    {
+        if (result < 0.018)
         {
-            if (resultX < -0.0f)
-            {
-                resultX = 0;
-            }
-            else
-            {
-                resultX = pow(resultX, 2.4);
-            }
-
-            if (resultY < -0.0f)
-            {
-                resultY = 0;
-            }
-            else
-            {
-                resultY = pow(resultY, 2.4);
-            }
-
-            if (resultZ < -0.0f)
-            {
-                resultZ = 0;
-            }
-            else
-            {
-                resultZ = pow(resultZ, 2.4);
-            }
+            result = 4.5 * result;
         }
         else
         {
-            VP_RENDER_ASSERTMESSAGE("Invalid EOTF setting for tone mapping");
-            VP_RENDER_CHK_STATUS_RETURN(MOS_STATUS_INVALID_PARAMETER);
+            result = pow(result, 0.45);
+            result = 1.099 * result - 0.099;
         }
-
-        MOS_CLAMP_MIN_MAX(resultX, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultY, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultZ, 0.0f, 1.0f);
     }
-
-    if (stageEnable.CCMEnable)
+    else if (oetfGamma == VPHAL_GAMMA_SMPTE_ST2084)
     {
-        std::array<float, 12> matrix = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
-        // BT709 to BT2020 CCM
-        if (param.CCM == VPHAL_HDR_CCM_BT601_BT709_TO_BT2020_MATRIX)
+        result = pow(result, m1);
+        result = (c1 + c2 * result) / (1 + c3 * result);
+        result = pow(result, m2);
+    }
+    else if (oetfGamma == VPHAL_GAMMA_SRGB)
+    {
+        if (result < 0.0031308f)
         {
-            matrix = {0.627404078626f, 0.329282097415f, 0.043313797587f, 0.000000f, 0.069097233123f, 0.919541035593f, 0.011361189924f, 0.000000f, 0.016391587664f, 0.088013255546f, 0.895595009604f, 0.000000f};
+            result = 12.92 * result;
         }
-        // BT2020 to BT709 CCM
-        else if (param.CCM == VPHAL_HDR_CCM_BT2020_TO_BT601_BT709_MATRIX)
+        else
         {
-            matrix = {1.660490254890140f, -0.587638564717282f, -0.072851975229213f, 0.000000f, -0.124550248621850f, 1.132898753013895f, -0.008347895599309f, 0.000000f, -0.018151059958635f, -0.100578696221493f, 1.118729865913540f, 0.000000f};
+            result = pow(result, (double)(1.0f / 2.4f));
+            result = 1.055 * result - 0.055;
         }
+    }
 
-        double tempX = resultX;
-        double tempY = resultY;
-        double tempZ = resultZ;
-
-        resultX = matrix[0] * tempX + matrix[1] * tempY + matrix[2] * tempZ + matrix[3];
-        resultY = matrix[4] * tempX + matrix[5] * tempY + matrix[6] * tempZ + matrix[7];
-        resultZ = matrix[8] * tempX + matrix[9] * tempY + matrix[10] * tempZ + matrix[11];
+    return result;
+}
 
-        MOS_CLAMP_MIN_MAX(resultX, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultY, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultZ, 0.0f, 1.0f);
+MOS_STATUS VpHdrLiteRenderFilter::CalculateCcmMatrix3DLut(VPHAL_HDR_CCM_TYPE ccmType, bool monitorGamut, HDR_PARAMS &targetHdrParam, std::array<float, 12> &outMatrix)
+{
+    outMatrix = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+    // BT709 to BT2020 CCM
+    if (ccmType == VPHAL_HDR_CCM_BT601_BT709_TO_BT2020_MATRIX)
+    {
+        outMatrix = {0.627404078626f, 0.329282097415f, 0.043313797587f, 0.000000f, 0.069097233123f, 0.919541035593f, 0.011361189924f, 0.000000f, 0.016391587664f, 0.088013255546f, 0.895595009604f, 0.000000f};
     }
-
-    if (stageEnable.PWLFEnable)
+    // BT2020 to BT709 CCM
+    else if (ccmType == VPHAL_HDR_CCM_BT2020_TO_BT601_BT709_MATRIX)
     {
-        VP_PUBLIC_CHK_STATUS_RETURN(CaluclateToneMapping3DLut(param.HdrMode, resultX, resultY, resultZ, resultX, resultY, resultZ));
-
-        MOS_CLAMP_MIN_MAX(resultX, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultY, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultZ, 0.0f, 1.0f);
+        outMatrix = {1.660490254890140f, -0.587638564717282f, -0.072851975229213f, 0.000000f, -0.124550248621850f, 1.132898753013895f, -0.008347895599309f, 0.000000f, -0.018151059958635f, -0.100578696221493f, 1.118729865913540f, 0.000000f};
+    }
+    else if (monitorGamut &&
+             (ccmType == VPHAL_HDR_CCM_BT2020_TO_MONITOR_MATRIX ||
+              ccmType == VPHAL_HDR_CCM_MONITOR_TO_BT2020_MATRIX ||
+              ccmType == VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX))
+    {
+        VP_PUBLIC_CHK_STATUS_RETURN(CalculateCCMWithMonitorGamut(ccmType, targetHdrParam, outMatrix));
     }
 
-    if (stageEnable.CCMExt1Enable)
+    return MOS_STATUS_SUCCESS;
+}
+
+void VpHdrLiteRenderFilter::Init3DLutKey(HDRLITE_LAYER_PARAM &param, HDR_PARAMS &targetHdrParam, MOS_FORMAT inputFormat, HDRLITE_3DLUT_KEY &key)
+{
+    MOS_ZeroMemory(&key, sizeof(key));
+
+    key.stageEnable = param.stageEnable.value;
+    key.EOTFGamma   = param.EOTFGamma;
+    key.OETFGamma   = param.OETFGamma;
+    key.HdrMode     = param.HdrMode;
+    key.CCM         = param.CCM;
+    key.CCMExt1     = param.CCMExt1;
+    key.CCMExt2     = param.CCMExt2;
+    key.PriorCSC    = param.PriorCSC;
+    key.PostCSC     = param.PostCSC;
+    // Prior CSC input channel order is the only thing the input format changes
+    key.inputFormat = (inputFormat == Format_AYUV) ? Format_AYUV : Format_Any;
+
+    // Target gamut only matters for the monitor CCMs, leave it out otherwise
+    // so that a new mastering display does not invalidate the LUT.
+    auto isMonitorCcm = [](VPHAL_HDR_CCM_TYPE ccmType) {
+        return ccmType == VPHAL_HDR_CCM_BT2020_TO_MONITOR_MATRIX ||
+               ccmType == VPHAL_HDR_CCM_MONITOR_TO_BT2020_MATRIX ||
+               ccmType == VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX;
+    };
+    if ((param.stageEnable.CCMExt1Enable && isMonitorCcm(param.CCMExt1)) ||
+        (param.stageEnable.CCMExt2Enable && isMonitorCcm(param.CCMExt2)))
     {
-        std::array<float, 12> matrix = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
-        // BT709 to BT2020 CCM
-        if (param.CCMExt1 == VPHAL_HDR_CCM_BT601_BT709_TO_BT2020_MATRIX)
+        for (uint32_t i = 0; i < 3; i++)
         {
-            matrix = {0.627404078626f, 0.329282097415f, 0.043313797587f, 0.000000f, 0.069097233123f, 0.919541035593f, 0.011361189924f, 0.000000f, 0.016391587664f, 0.088013255546f, 0.895595009604f, 0.000000f};
-        }
-        // BT2020 to BT709 CCM
-        else if (param.CCMExt1 == VPHAL_HDR_CCM_BT2020_TO_BT601_BT709_MATRIX)
-        {
-            matrix = {1.660490254890140f, -0.587638564717282f, -0.072851975229213f, 0.000000f, -0.124550248621850f, 1.132898753013895f, -0.008347895599309f, 0.000000f, -0.018151059958635f, -0.100578696221493f, 1.118729865913540f, 0.000000f};
-        }
-        else if (param.CCMExt1 == VPHAL_HDR_CCM_BT2020_TO_MONITOR_MATRIX ||
-                 param.CCMExt1 == VPHAL_HDR_CCM_MONITOR_TO_BT2020_MATRIX ||
-                 param.CCMExt1 == VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX)
-        {
-            VP_PUBLIC_CHK_STATUS_RETURN(CalculateCCMWithMonitorGamut(param.CCMExt1, targetHdrParam, matrix));
+            key.displayPrimariesX[i] = targetHdrParam.display_primaries_x[i];
+            key.displayPrimariesY[i] = targetHdrParam.display_primaries_y[i];
         }
+        key.whitePointX = targetHdrParam.white_point_x;
+        key.whitePointY = targetHdrParam.white_point_y;
+    }
+}
+
+MOS_STATUS VpHdrLiteRenderFilter::GetCri3DLut(HDRLITE_LAYER_PARAM &param, HDR_PARAMS &targetHdrParam, MOS_FORMAT inputFormat, std::shared_ptr<const VpHdrLite3DLutCache::Lut> &lut)
+{
+    HDRLITE_3DLUT_KEY key = {};
+    Init3DLutKey(param, targetHdrParam, inputFormat, key);
+
+    VpHdrLite3DLutCache &lutCache = VpHdrLite3DLutCache::GetInstance();
+    lut                           = lutCache.Find(key);
+    if (nullptr == lut)
+    {
+        auto newLut = std::make_shared<VpHdrLite3DLutCache::Lut>(VPHAL_HDR_CRI_3DLUT_SIZE * VPHAL_HDR_CRI_3DLUT_SIZE * VPHAL_HDR_CRI_3DLUT_SIZE * 3);
+        VP_PUBLIC_CHK_STATUS_RETURN(GenerateColorTransfer3dLut(param, targetHdrParam, inputFormat, newLut->data()));
+        lutCache.Add(key, newLut);
+        lut = newLut;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
 
-        double tempX = resultX;
-        double tempY = resultY;
-        double tempZ = resultZ;
+MOS_STATUS VpHdrLiteRenderFilter::GenerateColorTransfer3dLut(HDRLITE_LAYER_PARAM &param, HDR_PARAMS &targetHdrParam, MOS_FORMAT inputFormat, uint16_t *lut)
+{
+    VP_PUBLIC_CHK_NULL_RETURN(lut);
 
-        resultX = matrix[0] * resultX + matrix[1] * resultY + matrix[2] * resultZ + matrix[3];
-        resultY = matrix[4] * resultX + matrix[5] * resultY + matrix[6] * resultZ + matrix[7];
-        resultZ = matrix[8] * resultX + matrix[9] * resultY + matrix[10] * resultZ + matrix[11];
+    HDRStageEnables &stageEnable = param.stageEnable;
+    const uint32_t   lutSize     = VPHAL_HDR_CRI_3DLUT_SIZE;
 
-        MOS_CLAMP_MIN_MAX(resultX, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultY, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultZ, 0.0f, 1.0f);
+    if (stageEnable.EOTFEnable &&
+        param.EOTFGamma != VPHAL_GAMMA_TRADITIONAL_GAMMA &&
+        param.EOTFGamma != VPHAL_GAMMA_SMPTE_ST2084 &&
+        param.EOTFGamma != VPHAL_GAMMA_BT1886)
+    {
+        VP_RENDER_ASSERTMESSAGE("Invalid EOTF setting for tone mapping");
+        VP_RENDER_CHK_STATUS_RETURN(MOS_STATUS_INVALID_PARAMETER);
+    }
+    if (param.OETFGamma != VPHAL_GAMMA_NONE &&
+        param.OETFGamma != VPHAL_GAMMA_TRADITIONAL_GAMMA &&
+        param.OETFGamma != VPHAL_GAMMA_SMPTE_ST2084 &&
+        param.OETFGamma != VPHAL_GAMMA_SRGB)
+    {
+        VP_RENDER_ASSERTMESSAGE("Invalid OETF setting for tone mapping");
+        VP_RENDER_CHK_STATUS_RETURN(MOS_STATUS_INVALID_PARAMETER);
     }
 
+    // Everything which only depends on the layer parameters is worked out once
+    // instead of once per entry.
+    float                 priorCscMatrix[12] = {};
+    float                 postCscMatrix[12]  = {};
+    std::array<float, 12> ccmMatrix          = {};
+    std::array<float, 12> ccmExt1Matrix      = {};
+    std::array<float, 12> ccmExt2Matrix      = {};
+    if (stageEnable.PriorCSCEnable)
+    {
+        VP_PUBLIC_CHK_STATUS_RETURN(CalculateCscMatrix(param.PriorCSC, true, priorCscMatrix));
+    }
+    if (param.PostCSC != VPHAL_HDR_CSC_NONE)
+    {
+        VP_PUBLIC_CHK_STATUS_RETURN(CalculateCscMatrix(param.PostCSC, true, postCscMatrix));
+    }
+    VP_PUBLIC_CHK_STATUS_RETURN(CalculateCcmMatrix3DLut(param.CCM, false, targetHdrParam, ccmMatrix));
+    if (stageEnable.CCMExt1Enable)
+    {
+        VP_PUBLIC_CHK_STATUS_RETURN(CalculateCcmMatrix3DLut(param.CCMExt1, true, targetHdrParam, ccmExt1Matrix));
+    }
     if (stageEnable.CCMExt2Enable)
     {
-        std::array<float, 12> matrix = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
-        // BT709 to BT2020 CCM
-        if (param.CCMExt2 == VPHAL_HDR_CCM_BT601_BT709_TO_BT2020_MATRIX)
-        {
-            matrix = {0.627404078626f, 0.329282097415f, 0.043313797587f, 0.000000f, 0.069097233123f, 0.919541035593f, 0.011361189924f, 0.000000f, 0.016391587664f, 0.088013255546f, 0.895595009604f, 0.000000f};
-        }
-        // BT2020 to BT709 CCM
-        else if (param.CCMExt2 == VPHAL_HDR_CCM_BT2020_TO_BT601_BT709_MATRIX)
-        {
-            matrix = {1.660490254890140f, -0.587638564717282f, -0.072851975229213f, 0.000000f, -0.124550248621850f, 1.132898753013895f, -0.008347895599309f, 0.000000f, -0.018151059958635f, -0.100578696221493f, 1.118729865913540f, 0.000000f};
-        }
-        else if (param.CCMExt2 == VPHAL_HDR_CCM_BT2020_TO_MONITOR_MATRIX ||
-                 param.CCMExt2 == VPHAL_HDR_CCM_MONITOR_TO_BT2020_MATRIX ||
-                 param.CCMExt2 == VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX)
-        {
-            VP_PUBLIC_CHK_STATUS_RETURN(CalculateCCMWithMonitorGamut(param.CCMExt2, targetHdrParam, matrix));
-        }
-
-        double tempX = resultX;
-        double tempY = resultY;
-        double tempZ = resultZ;
-
-        resultX = matrix[0] * tempX + matrix[1] * tempY + matrix[2] * tempZ + matrix[3];
-        resultY = matrix[4] * tempX + matrix[5] * tempY + matrix[6] * tempZ + matrix[7];
-        resultZ = matrix[8] * tempX + matrix[9] * tempY + matrix[10] * tempZ + matrix[11];
+        VP_PUBLIC_CHK_STATUS_RETURN(CalculateCcmMatrix3DLut(param.CCMExt2, true, targetHdrParam, ccmExt2Matrix));
+    }
 
-        MOS_CLAMP_MIN_MAX(resultX, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultY, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultZ, 0.0f, 1.0f);
+    // Without prior CSC the EOTF sees the grid coordinates themselves, so it
+    // is evaluated once per axis value instead of once per entry.
+    double axis[lutSize]     = {};
+    double eotfAxis[lutSize] = {};
+    for (uint32_t n = 0; n < lutSize; n++)
+    {
+        axis[n]     = (double)((float)n / (float)(lutSize - 1));
+        eotfAxis[n] = stageEnable.EOTFEnable ? CalculateEotf3DLut(param.EOTFGamma, axis[n]) : axis[n];
     }
 
-    if (param.OETFGamma != VPHAL_GAMMA_NONE)
+    // One row of entries is carried through each stage at a time, keeping the
+    // loops free of stage selection.
+    double resultX[lutSize] = {};
+    double resultY[lutSize] = {};
+    double resultZ[lutSize] = {};
+
+    for (uint32_t i = 0; i < lutSize; i++)
     {
-        if (param.OETFGamma == VPHAL_GAMMA_TRADITIONAL_GAMMA)
+        for (uint32_t j = 0; j < lutSize; j++)
         {
-            if (resultX < 0.018)
-            {
-                resultX = 4.5 * resultX;
-            }
-            else
+            // EOTF/CCM/Tone Mapping/OETF require RGB input
+            // So if prior CSC is needed, it will always be YUV to RGB conversion
+            if (stageEnable.PriorCSCEnable)
             {
-                resultX = pow(resultX, 0.45);
-                resultX = 1.099 * resultX - 0.099;
-            }
+                const float *m = priorCscMatrix;
+                for (uint32_t k = 0; k < lutSize; k++)
+                {
+                    double inputX = axis[k];
+                    double inputY = axis[j];
+                    double inputZ = axis[i];
+
+                    // The third row reads the updated second channel, as the per entry
+                    // implementation this replaces did.
+                    if (inputFormat == Format_AYUV)
+                    {
+                        resultX[k] = m[0] * inputY + m[1] * inputZ + m[2] * inputX + m[3];
+                        resultY[k] = m[4] * inputY + m[5] * inputZ + m[6] * inputX + m[7];
+                        resultZ[k] = m[8] * resultY[k] + m[9] * inputZ + m[10] * inputX + m[11];
+                    }
+                    else
+                    {
+                        resultX[k] = m[0] * inputZ + m[1] * inputY + m[2] * inputX + m[3];
+                        resultY[k] = m[4] * inputZ + m[5] * inputY + m[6] * inputX + m[7];
+                        resultZ[k] = m[8] * inputZ + m[9] * resultY[k] + m[10] * inputX + m[11];
+                    }
+                }
 
-            if (resultY < 0.018)
-            {
-                resultY = 4.5 * resultY;
+                if (stageEnable.EOTFEnable)
+                {
+                    for (uint32_t k = 0; k < lutSize; k++)
+                    {
+                        resultX[k] = CalculateEotf3DLut(param.EOTFGamma, resultX[k]);
+                        resultY[k] = CalculateEotf3DLut(param.EOTFGamma, resultY[k]);
+                        resultZ[k] = CalculateEotf3DLut(param.EOTFGamma, resultZ[k]);
+                    }
+                }
             }
             else
             {
-                resultY = pow(resultY, 0.45);
-                resultY = 1.099 * resultY - 0.099;
+                for (uint32_t k = 0; k < lutSize; k++)
+                {
+                    resultX[k] = eotfAxis[k];
+                    resultY[k] = eotfAxis[j];
+                    resultZ[k] = eotfAxis[i];
+                }
             }
 
-            if (resultZ < 0.018)
-            {
-                resultZ = 4.5 * resultZ;
-            }
-            else
+            if (stageEnable.CCMEnable)
             {
-                resultZ = pow(resultZ, 0.45);
-                resultZ = 1.099 * resultZ - 0.099;
-            }
-        }
-        else if (param.OETFGamma == VPHAL_GAMMA_SMPTE_ST2084)
-        {
-            resultX = pow(resultX, m1);
-            resultX = (c1 + c2 * resultX) / (1 + c3 * resultX);
-            resultX = pow(resultX, m2);
+                const std::array<float, 12> &m = ccmMatrix;
+                for (uint32_t k = 0; k < lutSize; k++)
+                {
+                    double tempX = resultX[k];
+                    double tempY = resultY[k];
+                    double tempZ = resultZ[k];
 
-            resultY = pow(resultY, m1);
-            resultY = (c1 + c2 * resultY) / (1 + c3 * resultY);
-            resultY = pow(resultY, m2);
+                    resultX[k] = m[0] * tempX + m[1] * tempY + m[2] * tempZ + m[3];
+                    resultY[k] = m[4] * tempX + m[5] * tempY + m[6] * tempZ + m[7];
+                    resultZ[k] = m[8] * tempX + m[9] * tempY + m[10] * tempZ + m[11];
+                }
+            }
 
-            resultZ = pow(resultZ, m1);
-            resultZ = (c1 + c2 * resultZ) / (1 + c3 * resultZ);
-            resultZ = pow(resultZ, m2);
-        }
-        else if (param.OETFGamma == VPHAL_GAMMA_SRGB)
-        {
-            if (resultX < 0.0031308f)
+            if (stageEnable.PWLFEnable)
             {
-                resultX = 12.92 * resultX;
+                for (uint32_t k = 0; k < lutSize; k++)
+                {
+                    VP_PUBLIC_CHK_STATUS_RETURN(CaluclateToneMapping3DLut(param.HdrMode, resultX[k], resultY[k], resultZ[k], resultX[k], resultY[k], resultZ[k]));
+                }
             }
-            else
+
+            if (stageEnable.CCMExt1Enable)
             {
-                resultX = pow(resultX, (double)(1.0f / 2.4f));
-                resultX = 1.055 * resultX - 0.055;
+                // Rows read the channels already updated in this stage, as the per entry
+                // implementation this replaces did.
+                const std::array<float, 12> &m = ccmExt1Matrix;
+                for (uint32_t k = 0; k < lutSize; k++)
+                {
+                    resultX[k] = m[0] * resultX[k] + m[1] * resultY[k] + m[2] * resultZ[k] + m[3];
+                    resultY[k] = m[4] * resultX[k] + m[5] * resultY[k] + m[6] * resultZ[k] + m[7];
+                    resultZ[k] = m[8] * resultX[k] + m[9] * resultY[k] + m[10] * resultZ[k] + m[11];
+                }
             }
 
-            if (resultY < 0.0031308f)
+            if (stageEnable.CCMExt2Enable)
             {
-                resultY = 12.92 * resultY;
+                const std::array<float, 12> &m = ccmExt2Matrix;
+                for (uint32_t k = 0; k < lutSize; k++)
+                {
+                    double tempX = resultX[k];
+                    double tempY = resultY[k];
+                    double tempZ = resultZ[k];
+
+                    resultX[k] = m[0] * tempX + m[1] * tempY + m[2] * tempZ + m[3];
+                    resultY[k] = m[4] * tempX + m[5] * tempY + m[6] * tempZ + m[7];
+                    resultZ[k] = m[8] * tempX + m[9] * tempY + m[10] * tempZ + m[11];
+                }
             }
-            else
+
+            if (param.OETFGamma != VPHAL_GAMMA_NONE)
             {
-                resultY = pow(resultY, (double)(1.0f / 2.4f));
-                resultY = 1.055 * resultY - 0.055;
+                for (uint32_t k = 0; k < lutSize; k++)
+                {
+                    resultX[k] = CalculateOetf3DLut(param.OETFGamma, resultX[k]);
+                    resultY[k] = CalculateOetf3DLut(param.OETFGamma, resultY[k]);
+                    resultZ[k] = CalculateOetf3DLut(param.OETFGamma, resultZ[k]);
+                }
             }
 
-            if (resultZ < 0.0031308f)
+            // OETF will output RGB surface
+            // So if post CSC is needed, it will always be RGB to YUV conversion
+            if (param.PostCSC != VPHAL_HDR_CSC_NONE)
             {
-                resultZ = 12.92 * resultZ;
+                const float *m = postCscMatrix;
+                for (uint32_t k = 0; k < lutSize; k++)
+                {
+                    double tempX = resultX[k];
+                    double tempY = resultY[k];
+                    double tempZ = resultZ[k];
+
+                    resultX[k] = m[0] * tempX + m[1] * tempY + m[2] * tempZ + m[3];
+                    resultY[k] = m[4] * tempX + m[5] * tempY + m[6] * tempZ + m[7];
+                    resultZ[k] = m[8] * tempX + m[9] * tempY + m[10] * tempZ + m[11];
+                }
             }
-            else
+
+            // Convert and round up the [0, 1] float color value to 16 bit integer value
+            for (uint32_t k = 0; k < lutSize; k++)
             {
-                resultZ = pow(resultZ, (double)(1.0f / 2.4f));
-                resultZ = 1.055 * resultZ - 0.055;
+                *lut++ = (uint16_t)(resultX[k] * 65535.0f + 0.5f);
+                *lut++ = (uint16_t)(resultY[k] * 65535.0f + 0.5f);
+                *lut++ = (uint16_t)(resultZ[k] * 65535.0f + 0.5f);
             }
         }
-        else
-        {
-            VP_RENDER_ASSERTMESSAGE("Invalid EOTF setting for tone mapping");
-            VP_RENDER_CHK_STATUS_RETURN(MOS_STATUS_INVALID_PARAMETER);
-        }
-
-        MOS_CLAMP_MIN_MAX(resultX, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultY, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultZ, 0.0f, 1.0f);
-    }
-
-    // OETF will output RGB surface
-    // So if post CSC is needed, it will always be RGB to YUV conversion
-    if (param.PostCSC != VPHAL_HDR_CSC_NONE)
-    {
-        float postCscMatrix[12] = {};
-        VP_PUBLIC_CHK_STATUS_RETURN(CalculateCscMatrix(param.PostCSC, true, postCscMatrix));
-
-        double tempX = resultX;
-        double tempY = resultY;
-        double tempZ = resultZ;
-
-        resultX = postCscMatrix[0] * tempX + postCscMatrix[1] * tempY + postCscMatrix[2] * tempZ + postCscMatrix[3];
-        resultY = postCscMatrix[4] * tempX + postCscMatrix[5] * tempY + postCscMatrix[6] * tempZ + postCscMatrix[7];
-        resultZ = postCscMatrix[8] * tempX + postCscMatrix[9] * tempY + postCscMatrix[10] * tempZ + postCscMatrix[11];
-
-        MOS_CLAMP_MIN_MAX(resultX, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultY, 0.0f, 1.0f);
-        MOS_CLAMP_MIN_MAX(resultZ, 0.0f, 1.0f);
     }
 
-    // Convert and round up the [0, 1] float color value to 16 bit integer value
-    outputX = (uint16_t)(resultX * 65535.0f + 0.5f);
-    outputY = (uint16_t)(resultY * 65535.0f + 0.5f);
-    outputZ = (uint16_t)(resultZ * 65535.0f + 0.5f);
-
     return MOS_STATUS_SUCCESS;
 }
 
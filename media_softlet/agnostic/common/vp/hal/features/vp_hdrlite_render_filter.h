@@ -30,6 +30,9 @@
 #include "sw_filter.h"
 #include "kernel_args/igvpHdrRender_args.h"
 #include "vp_allocator.h"
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace vp
 {
@@ -122,6 +125,69 @@ struct HDRLITE_HAL_PARAM
 };
 
 
+//!
+//! \brief Everything the content of a CRI 3D LUT depends on
+//!
+struct HDRLITE_3DLUT_KEY
+{
+    uint32_t           stageEnable;
+    VPHAL_GAMMA_TYPE   EOTFGamma;
+    VPHAL_GAMMA_TYPE   OETFGamma;
+    VPHAL_HDR_MODE     HdrMode;
+    VPHAL_HDR_CCM_TYPE CCM;
+    VPHAL_HDR_CCM_TYPE CCMExt1;
+    VPHAL_HDR_CCM_TYPE CCMExt2;
+    VPHAL_HDR_CSC_TYPE PriorCSC;
+    VPHAL_HDR_CSC_TYPE PostCSC;
+    MOS_FORMAT         inputFormat;
+    uint32_t           displayPrimariesX[3];  //!< Target gamut, only set when a monitor CCM is used
+    uint32_t           displayPrimariesY[3];
+    uint32_t           whitePointX;
+    uint32_t           whitePointY;
+};
+
+//!
+//! \brief Process wide cache of generated CRI 3D LUTs
+//! \details LUT generation costs tens of milliseconds of CPU while the HDR metadata
+//!          it depends on rarely changes, so LUTs are kept across frames, layers
+//!          and contexts. Entries are packed RGB 16 bit triplets in [z][y][x] order.
+//!
+class VpHdrLite3DLutCache
+{
+public:
+    using Lut = std::vector<uint16_t>;
+
+    static constexpr uint32_t m_maxEntryNum = 8;  //!< 192KB per entry
+
+    static VpHdrLite3DLutCache &GetInstance();
+
+    //!
+    //! \brief  Find the LUT generated for key
+    //! \return std::shared_ptr<const Lut>
+    //!         nullptr if not cached
+    //!
+    std::shared_ptr<const Lut> Find(const HDRLITE_3DLUT_KEY &key);
+
+    //!
+    //! \brief  Add a LUT, evicting the least recently used one when full
+    //!
+    void Add(const HDRLITE_3DLUT_KEY &key, std::shared_ptr<const Lut> lut);
+
+protected:
+    struct Entry
+    {
+        HDRLITE_3DLUT_KEY          key;
+        std::shared_ptr<const Lut> lut;
+        uint64_t                   lastUse;
+    };
+
+    std::vector<Entry> m_entries;
+    std::mutex         m_mutex;
+    uint64_t           m_useCount = 0;
+
+    MEDIA_CLASS_DEFINE_END(vp__VpHdrLite3DLutCache)
+};
+
 // VpHdrLiteKrnStructedData structure
 struct VpHdrLiteKrnStructedData
 {
@@ -252,7 +318,12 @@ protected:
     static CSC_COEFF_FORMAT ConvertDouble2RegisterForamt(double input);
     static double           ConvertRegister2DoubleFormat(CSC_COEFF_FORMAT regVal);
     MOS_STATUS              Generate2SegmentsOETFLUT(float fStretchFactor, pfnOETFFunc oetfFunc, uint16_t *lut);
-    MOS_STATUS              GenerateColorTransfer3dLut(HDRLITE_LAYER_PARAM &param, HDR_PARAMS &targetHdrParam, MOS_FORMAT inputFormat, float fInputX, float fInputY, float fInputZ, uint16_t &outputX, uint16_t &outputY, uint16_t &outputZ);
+    static double           CalculateEotf3DLut(VPHAL_GAMMA_TYPE eotfGamma, double input);
+    static double           CalculateOetf3DLut(VPHAL_GAMMA_TYPE oetfGamma, double input);
+    static MOS_STATUS       CalculateCcmMatrix3DLut(VPHAL_HDR_CCM_TYPE ccmType, bool monitorGamut, HDR_PARAMS &targetHdrParam, std::array<float, 12> &outMatrix);
+    static void             Init3DLutKey(HDRLITE_LAYER_PARAM &param, HDR_PARAMS &targetHdrParam, MOS_FORMAT inputFormat, HDRLITE_3DLUT_KEY &key);
+    MOS_STATUS              GenerateColorTransfer3dLut(HDRLITE_LAYER_PARAM &param, HDR_PARAMS &targetHdrParam, MOS_FORMAT inputFormat, uint16_t *lut);
+    MOS_STATUS              GetCri3DLut(HDRLITE_LAYER_PARAM &param, HDR_PARAMS &targetHdrParam, MOS_FORMAT inputFormat, std::shared_ptr<const VpHdrLite3DLutCache::Lut> &lut);
     MOS_STATUS              GenerateH2HPWLFCoeff(HDR_PARAMS &srcHdrParam, HDR_PARAMS &targetHdrParam, float *pivotPoint, uint16_t *slopeIntercept);
 
 protected:
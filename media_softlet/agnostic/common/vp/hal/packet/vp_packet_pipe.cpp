@@ -209,6 +209,8 @@ MOS_STATUS PacketPipe::Clean()
 
     m_outputPipeMode = VPHAL_OUTPUT_PIPE_MODE_INVALID;
     m_veboxFeatureInuse = false;
+    m_gpuTiming = nullptr;
+    m_gpuTimingFrame = 0;
     for (std::vector<VpCmdPacket *>::iterator it = m_Pipe.begin(); it != m_Pipe.end(); ++it)
     {
         m_PacketFactory.ReturnPacket(*it);
@@ -348,6 +350,7 @@ MOS_STATUS PacketPipe::Execute(MediaStatusReport *statusReport, MediaScalability
         VP_PUBLIC_CHK_STATUS_RETURN(SwitchContext(pPacket->GetPacketId(), scalability, mediaContext, bEnableVirtualEngine, numVebox, gpuCtxOnHybridCmd));
         VP_PUBLIC_CHK_NULL_RETURN(scalability);
         pPacket->SetMediaScalability(scalability);
+        pPacket->SetGpuTiming(m_gpuTiming, m_gpuTimingFrame);
 
         VP_PUBLIC_CHK_STATUS_RETURN(pTask->AddPacket(&prop));
         if (prop.immediateSubmit)
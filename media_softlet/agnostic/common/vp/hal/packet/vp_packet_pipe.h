@@ -36,6 +36,7 @@
 
 class MediaScalability;
 class MediaContext;
+class MediaGpuTiming;
 class VpDebugInterface;
 
 namespace vp {
@@ -107,6 +108,15 @@ public:
 
     static MOS_STATUS SwitchContext(PacketType type, MediaScalability *&scalability, MediaContext *mediaContext, bool bEnableVirtualEngine, uint8_t numVebox, uint64_t gpuCtxOnHybridCmd = 0);
 
+    //!
+    //! \brief  Set the GPU timing the packets of the next Execute store timestamps for
+    //!
+    void SetGpuTiming(MediaGpuTiming *gpuTiming, uint32_t frame)
+    {
+        m_gpuTiming      = gpuTiming;
+        m_gpuTimingFrame = frame;
+    }
+
 private:
     VpCmdPacket *CreatePacket(EngineType type);
     MOS_STATUS SetOutputPipeMode(EngineType engineType);
@@ -115,6 +125,8 @@ private:
     std::vector<VpCmdPacket *> m_Pipe;
     VPHAL_OUTPUT_PIPE_MODE m_outputPipeMode = VPHAL_OUTPUT_PIPE_MODE_INVALID;
     bool m_veboxFeatureInuse = false;
+    MediaGpuTiming *m_gpuTiming = nullptr;
+    uint32_t m_gpuTimingFrame = 0;
 
 MEDIA_CLASS_DEFINE_END(vp__PacketPipe)
 };
@@ -477,7 +477,6 @@ MOS_STATUS VpRenderHdr3DLutOclKernel::SetWalkerSetting(KERNEL_THREAD_SPACE &thre
 MOS_STATUS VpRenderHdr3DLutOclKernel::InitCoefSurface(const uint32_t maxDLL, const uint32_t maxCLL, const VPHAL_HDR_MODE hdrMode)
 {
     VP_FUNC_CALL();
-    float  *hdrcoefBuffer = nullptr;
     int32_t oetfCurve = 0, tmMode = 0, tmSrcType = 0;
     float   *ccmMatrix = m_ccmMatrix;
     float   tmMaxCLL = 0.0f, tmMaxDLL = 0.0f;
@@ -488,17 +487,12 @@ MOS_STATUS VpRenderHdr3DLutOclKernel::InitCoefSurface(const uint32_t maxDLL, con
     auto        it   = m_surfaceGroup->find(SurfaceType3DLutCoef);
     VP_SURFACE *surf = (m_surfaceGroup->end() != it) ? it->second : nullptr;
     VP_RENDER_CHK_NULL_RETURN(surf);
+    VP_RENDER_CHK_NULL_RETURN(surf->osSurface);
+    VP_RENDER_CHK_NULL_RETURN(m_allocator);
 
     tmMaxCLL = (float)maxCLL;
     tmMaxDLL = (float)maxDLL;
 
-    // Lock surface
-    uint8_t *lockedAddr = (uint8_t *)m_allocator->LockResourceForWrite(&surf->osSurface->OsResource);
-
-    VP_RENDER_CHK_NULL_RETURN(lockedAddr);
-
-    hdrcoefBuffer = (float *)lockedAddr;
-
     if (hdrMode == VPHAL_HDR_MODE_TONE_MAPPING)  // H2S
     {
         CalcCCMMatrix();
@@ -525,26 +519,39 @@ MOS_STATUS VpRenderHdr3DLutOclKernel::InitCoefSurface(const uint32_t maxDLL, con
         tmSrcType = (TONE_MAPPING_SOURCE_TYPE)TONE_MAPPING_SOURCE_PSEUDO_Y_BT709;
     }
 
-    // Fill Coefficient Surface: Media kernel define the layout of coefficients. Please don't change it.
-    const uint32_t pos_coef[17] = {7, 16, 17, 18, 19, 20, 21, 24, 25, 26, 27, 28, 29, 54, 55, 62, 63};
+    float ccm[VP_CCM_MATRIX_SIZE] = {};
+    MOS_SecureMemcpy(ccm, sizeof(ccm), ccmMatrix, sizeof(ccm));
 
-    // OETF curve
-    ((int *)hdrcoefBuffer)[pos_coef[0]] = oetfCurve;
-    // CCM
-    for (uint32_t i = 0; i < VP_CCM_MATRIX_SIZE; ++i)
-    {
-        hdrcoefBuffer[pos_coef[i + 1]] = ccmMatrix[i];
-    }
-    // TM Source Type
-    ((int *)hdrcoefBuffer)[pos_coef[13]] = tmSrcType;
-    // TM Mode
-    ((int *)hdrcoefBuffer)[pos_coef[14]] = tmMode;
-    // Max CLL and DLL
-    hdrcoefBuffer[pos_coef[15]] = tmMaxCLL;
-    hdrcoefBuffer[pos_coef[16]] = tmMaxDLL;
-
-    //Unlock
-    VP_RENDER_CHK_STATUS_RETURN(m_allocator->UnLock(&surf->osSurface->OsResource));
+    // The kernel reading the coefficients is submitted after this call, so the write only has
+    // to land before the next submission. The previous frame may still read the surface, an
+    // async lock keeps the CPU from waiting on it.
+    VP_RENDER_CHK_STATUS_RETURN(m_allocator->LockResourceForWriteAsync(
+        &surf->osSurface->OsResource,
+        [=](void *lockedAddr) {
+            if (lockedAddr == nullptr)
+            {
+                return;
+            }
+            float *hdrcoefBuffer = (float *)lockedAddr;
+
+            // Fill Coefficient Surface: Media kernel define the layout of coefficients. Please don't change it.
+            const uint32_t pos_coef[17] = {7, 16, 17, 18, 19, 20, 21, 24, 25, 26, 27, 28, 29, 54, 55, 62, 63};
+
+            // OETF curve
+            ((int *)hdrcoefBuffer)[pos_coef[0]] = oetfCurve;
+            // CCM
+            for (uint32_t i = 0; i < VP_CCM_MATRIX_SIZE; ++i)
+            {
+                hdrcoefBuffer[pos_coef[i + 1]] = ccm[i];
+            }
+            // TM Source Type
+            ((int *)hdrcoefBuffer)[pos_coef[13]] = tmSrcType;
+            // TM Mode
+            ((int *)hdrcoefBuffer)[pos_coef[14]] = tmMode;
+            // Max CLL and DLL
+            hdrcoefBuffer[pos_coef[15]] = tmMaxCLL;
+            hdrcoefBuffer[pos_coef[16]] = tmMaxDLL;
+        }));
 
     return MOS_STATUS_SUCCESS;
 }
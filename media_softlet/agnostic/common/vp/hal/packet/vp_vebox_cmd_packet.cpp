@@ -444,6 +444,8 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
 
         VP_RENDER_CHK_STATUS_RETURN(pRenderHal->pRenderHalPltInterface->AddPerfCollectStartCmd(pRenderHal, pOsInterface, pCmdBufferInUse));
 
+        VP_RENDER_CHK_STATUS_RETURN(StoreGpuTimestamp(true, pCmdBufferInUse, m_IsSfcUsed));
+
         VP_RENDER_CHK_STATUS_RETURN(NullHW::StartPredicateNext(pOsInterface, m_miItf, pCmdBufferInUse));
 #if (_DEBUG || _RELEASE_INTERNAL)
         VP_RENDER_CHK_STATUS_RETURN(StoreCSEngineIdRegMem(pCmdBufferInUse, pVeboxHeap));
@@ -599,6 +601,8 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
 
         VP_RENDER_CHK_STATUS_RETURN(NullHW::StopPredicateNext(pOsInterface, m_miItf, pCmdBufferInUse));
 
+        VP_RENDER_CHK_STATUS_RETURN(StoreGpuTimestamp(false, pCmdBufferInUse, m_IsSfcUsed));
+
         VP_RENDER_CHK_STATUS_RETURN(pRenderHal->pRenderHalPltInterface->AddPerfCollectEndCmd(pRenderHal, pOsInterface, pCmdBufferInUse));
 
 #if (_DEBUG || _RELEASE_INTERNAL)
@@ -1160,6 +1164,8 @@ VpVeboxCmdPacket::VpVeboxCmdPacket(
     VP_PUBLIC_CHK_NULL_NO_STATUS_RETURN(hwInterface->m_vpPlatformInterface);
     m_veboxItf = hwInterface->m_vpPlatformInterface->GetMhwVeboxItf();
     m_miItf = hwInterface->m_vpPlatformInterface->GetMhwMiItf();
+    // MediaPacket::StoreGpuTimestamp adds its commands through the base interface
+    MediaPacket::m_miItf = m_miItf;
     m_vpUserFeatureControl = hwInterface->m_userFeatureControl;
 }
 
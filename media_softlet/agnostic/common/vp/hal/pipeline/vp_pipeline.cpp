@@ -84,6 +84,7 @@ VpPipeline::~VpPipeline()
 #endif
     MOS_Delete(m_allocator);
     MOS_Delete(m_statusReport);
+    MOS_Delete(m_gpuTiming);
     MOS_Delete(m_packetSharedContext);
     if (m_vpMhwInterface.m_reporting && this != m_vpMhwInterface.m_reporting->owner)
     {
@@ -385,6 +386,9 @@ MOS_STATUS VpPipeline::Init(void *mhwInterface)
     m_statusReport = MOS_New(VPStatusReport, m_osInterface);
     VP_PUBLIC_CHK_NULL_RETURN(m_statusReport);
 
+    m_gpuTiming = MOS_New(MediaGpuTiming, m_osInterface, VPHAL_STATUS_TABLE_MAX_SIZE);
+    VP_PUBLIC_CHK_NULL_RETURN(m_gpuTiming);
+
     VP_PUBLIC_CHK_STATUS_RETURN(CreateVPDebugInterface());
 
     m_vpMhwInterface.m_debugInterface = (void*)m_debugInterface;
@@ -598,6 +602,11 @@ MOS_STATUS VpPipeline::ExecuteVpPipeline()
     VP_PUBLIC_CHK_STATUS_RETURN(UpdateFrameTracker());
     VP_PUBLIC_CHK_STATUS_RETURN(CreateSwFilterPipe(m_pvpParams, swFilterPipes));
 
+    // Report the GPU time of the frames completed since the last call, all pipes of this call are one frame
+    VP_PUBLIC_CHK_NULL_RETURN(m_gpuTiming);
+    VP_PUBLIC_CHK_STATUS_RETURN(m_gpuTiming->ReportCompletedFrames(COMPONENT_VPCommon));
+    m_gpuTimingFrame++;
+
     // Increment frame ID for performance measurement
     m_osInterface->pfnIncPerfFrameID(m_osInterface);
 
@@ -636,6 +645,8 @@ MOS_STATUS VpPipeline::ExecuteVpPipeline()
                                  pipeIdx);
     }
 
+    VP_PUBLIC_CHK_STATUS_RETURN(m_gpuTiming->EndFrame(m_gpuTimingFrame));
+
     MT_LOG2(MT_VP_FEATURE_GRAPH_EXECUTE_VPPIPELINE_END, MT_NORMAL,
             MT_VP_FEATURE_GRAPH_FILTER_SWFILTERPIPE_COUNT, (int64_t)swFilterPipes.size(),
             MT_VP_FEATURE_GRAPH_FILTER_PIPELINEBYPASS, isBypassNeeded);
@@ -703,6 +714,7 @@ MOS_STATUS VpPipeline::ExecuteSingleswFilterPipe(VpSinglePipeContext *singlePipe
         singlePipeCtx->SetOutputPipeMode(pipeReused->GetOutputPipeMode());
         singlePipeCtx->SetIsVeboxFeatureInuse(pipeReused->IsVeboxFeatureInuse());
         // MediaPipeline::m_statusReport is always nullptr in VP APO path right now.
+        pipeReused->SetGpuTiming(m_gpuTiming, m_gpuTimingFrame);
         eStatus = pipeReused->Execute(MediaPipeline::m_statusReport, m_scalability, m_mediaContext, MOS_VE_SUPPORTED(m_osInterface), m_numVebox, gpuCtxOnHybridCmd, frameCounter);
         MT_LOG1(MT_VP_HAL_VEBOXNUM_CHECK, MT_NORMAL, MT_VP_HAL_VEBOX_NUMBER, m_numVebox)
         VP_PUBLIC_NORMALMESSAGE("Vebox Number for check %d", m_numVebox);
@@ -737,7 +749,7 @@ MOS_STATUS VpPipeline::ExecuteSingleswFilterPipe(VpSinglePipeContext *singlePipe
     singlePipeCtx->SetIsVeboxFeatureInuse(pPacketPipe->IsVeboxFeatureInuse());
 
     // MediaPipeline::m_statusReport is always nullptr in VP APO path right now.
-
+    pPacketPipe->SetGpuTiming(m_gpuTiming, m_gpuTimingFrame);
     eStatus = pPacketPipe->Execute(MediaPipeline::m_statusReport, m_scalability, m_mediaContext, MOS_VE_SUPPORTED(m_osInterface), m_numVebox, gpuCtxOnHybridCmd, frameCounter);
 
     MT_LOG1(MT_VP_HAL_VEBOXNUM_CHECK, MT_NORMAL, MT_VP_HAL_VEBOX_NUMBER, m_numVebox)
@@ -473,6 +473,8 @@ protected:
     VphalFeatureReport    *m_reporting              = nullptr;  //!< vp Pipeline user feature report
 
     VPStatusReport        *m_statusReport           = nullptr;  //!< vp Pipeline status report
+    MediaGpuTiming        *m_gpuTiming              = nullptr;  //!< Per engine GPU time of the frames
+    uint32_t               m_gpuTimingFrame         = 0;        //!< Frame counter of m_gpuTiming
 
 #if (_DEBUG || _RELEASE_INTERNAL)
     VpDebugInterface      *m_debugInterface         = nullptr;
@@ -104,6 +104,8 @@ VAStatus DdiEncodeBase::AddToStatusReportQueue(void *codedBuf)
     m_encodeCtx->statusReportBuf.infos[idx].pCodedBuf = codedBuf;
     m_encodeCtx->statusReportBuf.infos[idx].uiSize    = 0;
     m_encodeCtx->statusReportBuf.infos[idx].uiStatus  = 0;
+    // The coded buffer is reused for a new picture
+    m_subregions.erase(codedBuf);
 #if 0 // TBD next PR common implementation
     MOS_STATUS status = m_encodeCtx->pCpDdiInterfaceNext->StoreCounterToStatusReport(&m_encodeCtx->statusReportBuf.infos[idx]);
     if (status != MOS_STATUS_SUCCESS)
@@ -157,6 +159,8 @@ void DdiEncodeBase::FreeCompBuffer()
     // free status report struct
     MOS_FreeMemory(bufMgr->pCodedBufferSegment);
     bufMgr->pCodedBufferSegment = nullptr;
+    MOS_FreeMemory(m_subregionSegments);
+    m_subregionSegments = nullptr;
 }
 
 VAStatus DdiEncodeBase::StatusReport(
@@ -168,6 +172,7 @@ VAStatus DdiEncodeBase::StatusReport(
     DDI_CODEC_CHK_NULL(buf, "Null buf", VA_STATUS_ERROR_INVALID_CONTEXT);
 
     m_encodeCtx->BufMgr.pCodedBufferSegment->status    = 0;
+    m_encodeCtx->BufMgr.pCodedBufferSegment->next      = nullptr;
 
     //when this function is called, there must be a frame is ready, will wait until get the right information.
     uint32_t size         = 0;
@@ -175,6 +180,8 @@ VAStatus DdiEncodeBase::StatusReport(
     uint32_t status       = 0;
     uint32_t timeOutCount = 0;
     VAStatus eStatus      = VA_STATUS_SUCCESS;
+    uint32_t maxTimeOut   = 100000;  //set max sleep times to 100000 = 1s, other wise return error.
+    uint32_t sleepTime    = 10;      //sleep 10 us when encode is not complete.
 
     // Get encoded frame information from status buffer queue.
     while (VA_STATUS_SUCCESS == (eStatus = GetSizeFromStatusReportBuffer(mediaBuf, &size, &status, &index)))
@@ -190,11 +197,42 @@ VAStatus DdiEncodeBase::StatusReport(
             {
                 return VA_STATUS_ERROR_ENCODING_ERROR;
             }
+
+            // Slices or tiles kept when the frame status was collected, until the buffer is reused
+            auto subregions = m_subregions.find(mediaBuf->bo);
+            if (subregions != m_subregions.end())
+            {
+                FillSubregionSegments(size, subregions->second.ends.data(), (uint32_t)subregions->second.ends.size());
+            }
             break;
         }
 
+        // Hand out the slices or tiles encoded so far instead of waiting for the picture
+        if ((index >= 0) && MapEncodedSubregions(mediaBuf))
+        {
+            *buf = m_encodeCtx->BufMgr.pCodedBufferSegment;
+            return VA_STATUS_SUCCESS;
+        }
+
         mos_bo_wait_rendering(mediaBuf->bo);
 
+        // The oldest pending picture is collected next, its subregions can only be queried until then
+        EncodeSubregionReport collected = {};
+        bool keepSubregions = (m_encodeCtx->pCodecHal->GetSubregionStatus(0, &collected) == MOS_STATUS_SUCCESS) &&
+                              (collected.subregionNum > 1);
+        if (keepSubregions && !collected.frameCompleted)
+        {
+            // Collect the picture once all of its subregions are written, else its split is lost
+            if (timeOutCount < maxTimeOut)
+            {
+                usleep(sleepTime);
+                timeOutCount++;
+                continue;
+            }
+            keepSubregions = false;
+        }
+        void *collectedBuf = m_encodeCtx->statusReportBuf.infos[m_encodeCtx->statusReportBuf.ulUpdatePosition].pCodedBuf;
+
         EncodeStatusReportData *encodeStatusReportData = (EncodeStatusReportData*)m_encodeCtx->pEncodeStatusReport;
         encodeStatusReportData->sequential = true;  //Query the encoded frame status in sequential.
 
@@ -238,6 +276,10 @@ VAStatus DdiEncodeBase::StatusReport(
                 m_encodeCtx->statusReportBuf.ulUpdatePosition = (m_encodeCtx->statusReportBuf.ulUpdatePosition + 1) % DDI_ENCODE_MAX_STATUS_REPORT_BUFFER;
                 return VA_STATUS_ERROR_ENCODING_ERROR;
             }
+            if (keepSubregions && (collected.completedNum == collected.subregionNum))
+            {
+                m_subregions[collectedBuf].ends.assign(collected.bitstreamEnd, collected.bitstreamEnd + collected.completedNum);
+            }
 
             // Report extra status for completed coded buffer
             eStatus = ReportExtraStatus(encodeStatusReportData, m_encodeCtx->BufMgr.pCodedBufferSegment);
@@ -252,11 +294,9 @@ VAStatus DdiEncodeBase::StatusReport(
         else if (CODECHAL_STATUS_INCOMPLETE == encodeStatusReportData[0].codecStatus)
         {
             // Wait until encode PAK complete, sometimes we application detect encoded buffer object is Idle, may Enc done, but Pak not.
-            uint32_t maxTimeOut                               = 100000;  //set max sleep times to 100000 = 1s, other wise return error.
             if (timeOutCount < maxTimeOut)
             {
                 //sleep 10 us to wait encode complete, it won't impact the performance.
-                uint32_t sleepTime                            = 10;      //sleep 10 us when encode is not complete.
                 usleep(sleepTime);
                 timeOutCount++;
                 continue;
@@ -639,6 +679,133 @@ VAStatus DdiEncodeBase::GetIndexFromPreEncStatusReportBuffer(
     return eStatus;
 }
 
+VAStatus DdiEncodeBase::QuerySubregionStatus(
+    DDI_MEDIA_BUFFER      *codedBuf,
+    EncodeSubregionReport &report)
+{
+    DDI_CODEC_CHK_NULL(m_encodeCtx, "Null m_encodeCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CODEC_CHK_NULL(m_encodeCtx->pCodecHal, "Null m_encodeCtx->pCodecHal", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CODEC_CHK_NULL(codedBuf, "Null codedBuf", VA_STATUS_ERROR_INVALID_BUFFER);
+
+    int32_t i = 0;
+    for (i = 0; i < DDI_ENCODE_MAX_STATUS_REPORT_BUFFER; i++)
+    {
+        if (m_encodeCtx->statusReportBuf.infos[i].pCodedBuf == (void *)codedBuf->bo)
+        {
+            break;
+        }
+    }
+    if (i >= DDI_ENCODE_MAX_STATUS_REPORT_BUFFER)
+    {
+        return VA_STATUS_ERROR_INVALID_BUFFER;
+    }
+
+    // Pictures are reported in submission order from ulUpdatePosition, the HAL counts
+    // unreported pictures the same way
+    uint32_t pendingIndex = (i + DDI_ENCODE_MAX_STATUS_REPORT_BUFFER - m_encodeCtx->statusReportBuf.ulUpdatePosition) %
+                            DDI_ENCODE_MAX_STATUS_REPORT_BUFFER;
+
+    MOS_STATUS mosStatus = m_encodeCtx->pCodecHal->GetSubregionStatus(pendingIndex, &report);
+    if (MOS_STATUS_UNIMPLEMENTED == mosStatus)
+    {
+        return VA_STATUS_ERROR_UNIMPLEMENTED;
+    }
+    else if (MOS_STATUS_SUCCESS != mosStatus)
+    {
+        return VA_STATUS_ERROR_INVALID_BUFFER;
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+
+bool DdiEncodeBase::MapEncodedSubregions(DDI_MEDIA_BUFFER *codedBuf)
+{
+    uint32_t mappedNum = 0;
+    auto     state     = m_subregions.find(codedBuf->bo);
+    if (state != m_subregions.end())
+    {
+        mappedNum = state->second.mappedNum;
+    }
+
+    EncodeSubregionReport report     = {};
+    uint32_t              maxTimeOut = 100000;  // same 1s bound as the frame status
+    for (uint32_t timeOutCount = 0; timeOutCount < maxTimeOut; timeOutCount++)
+    {
+        // A capped subregion count may be short, such pictures are only handed out whole
+        if (QuerySubregionStatus(codedBuf, report) != VA_STATUS_SUCCESS ||
+            report.frameCompleted ||
+            report.subregionNum < 2 ||
+            report.subregionNum >= ENCODE_SUBREGION_REPORT_MAX_NUM ||
+            report.completedNum >= report.subregionNum)
+        {
+            return false;
+        }
+        if (report.completedNum > mappedNum)
+        {
+            break;
+        }
+        usleep(10);
+    }
+    if (report.completedNum <= mappedNum)
+    {
+        return false;
+    }
+
+    VACodedBufferSegment *segment = m_encodeCtx->BufMgr.pCodedBufferSegment;
+    segment->buf = MediaLibvaUtilNext::LockBuffer(codedBuf, MOS_LOCKFLAG_READONLY);
+    if (segment->buf == nullptr)
+    {
+        return false;
+    }
+    segment->size   = report.bitstreamEnd[report.completedNum - 1];
+    segment->status = 0;
+    FillSubregionSegments(segment->size, report.bitstreamEnd, report.completedNum);
+
+    m_subregions[codedBuf->bo].mappedNum = report.completedNum;
+    return true;
+}
+
+void DdiEncodeBase::FillSubregionSegments(uint32_t size, const uint32_t *bitstreamEnd, uint32_t subregionNum)
+{
+    VACodedBufferSegment *segment = m_encodeCtx->BufMgr.pCodedBufferSegment;
+    if (subregionNum < 2 || bitstreamEnd == nullptr || segment->buf == nullptr)
+    {
+        return;
+    }
+
+    if (m_subregionSegments == nullptr)
+    {
+        m_subregionSegments = (VACodedBufferSegment *)MOS_AllocAndZeroMemory(
+            sizeof(VACodedBufferSegment) * (ENCODE_SUBREGION_REPORT_MAX_NUM - 1));
+        if (m_subregionSegments == nullptr)
+        {
+            return;
+        }
+    }
+
+    uint8_t *data   = (uint8_t *)segment->buf;
+    uint32_t status = segment->status;
+    uint32_t begin  = 0;
+    for (uint32_t i = 0; i < subregionNum; i++)
+    {
+        // The last subregion also carries what the PAK wrote after it
+        uint32_t end = (i + 1 == subregionNum) ? size : MOS_MIN(bitstreamEnd[i], size);
+        end          = MOS_MAX(end, begin);
+
+        if (i > 0)
+        {
+            segment->next = &m_subregionSegments[i - 1];
+            segment       = segment->next;
+        }
+        segment->buf        = data + begin;
+        segment->size       = end - begin;
+        segment->bit_offset = 0;
+        segment->status     = status;
+        segment->next       = nullptr;
+        begin               = end;
+    }
+}
+
 bool DdiEncodeBase::CodedBufferExistInStatusReport(DDI_MEDIA_BUFFER *buf)
 {
     if (nullptr == m_encodeCtx || nullptr == buf)
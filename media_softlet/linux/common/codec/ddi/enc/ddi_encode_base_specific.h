@@ -27,6 +27,8 @@
 #ifndef __DDI_ENCODE_BASE_SPECIFIC_H__
 #define __DDI_ENCODE_BASE_SPECIFIC_H__
 
+#include <map>
+#include <vector>
 #include <va/va.h>
 #include "ddi_codec_base_specific.h"
 #include "ddi_libva_encoder_specific.h"
@@ -154,6 +156,26 @@ public:
         DDI_MEDIA_BUFFER *mediaBuf,
         void             **buf);
 
+    //!
+    //! \brief    Query the slices or tiles already encoded into a coded buffer
+    //! \details  Does not wait, the picture may still be encoding. Offsets are
+    //!           relative to the start of the coded buffer data. Only pictures
+    //!           whose frame status was not collected yet can be queried, the
+    //!           slices of collected pictures are kept in m_subregions.
+    //!
+    //! \param    [in] codedBuf
+    //!           Pointer to DDI_MEDIA_BUFFER of the coded buffer
+    //! \param    [out] report
+    //!           Subregion report of the picture
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, VA_STATUS_ERROR_UNIMPLEMENTED if
+    //!           the encoder does not report subregions, else fail reason
+    //!
+    VAStatus QuerySubregionStatus(
+        DDI_MEDIA_BUFFER      *codedBuf,
+        EncodeSubregionReport &report);
+
     //!
     //! \brief    Report Status for Enc buffer.
     //!
@@ -610,6 +632,51 @@ protected:
     //! \return   void
     void CleanUpBufferandReturn(DDI_MEDIA_BUFFER *buf);
 
+    //!
+    //! \brief    Map the slices or tiles of a picture which are encoded already
+    //! \details  Polls the subregion status before the caller waits for the whole
+    //!           picture. Returns once slices beyond the ones mapped before are
+    //!           written, with one segment per completed slice. Fewer segments than
+    //!           slices in the picture tell the application to map the buffer again
+    //!           for the rest.
+    //!
+    //! \param    [in] codedBuf
+    //!           Pointer to DDI_MEDIA_BUFFER of the coded buffer
+    //!
+    //! \return   bool
+    //!           true if the segments hold a completed prefix of the picture, false
+    //!           if the caller has to wait for the whole picture
+    //!
+    bool MapEncodedSubregions(DDI_MEDIA_BUFFER *codedBuf);
+
+    //!
+    //! \brief    Split the coded buffer segment into one segment per slice or tile
+    //! \details  Lets the application send the slices of a picture separately. Left
+    //!           as a single segment for less than two subregions.
+    //!
+    //! \param    [in] size
+    //!           Bitstream size of the subregions, the last segment ends there
+    //! \param    [in] bitstreamEnd
+    //!           End of each subregion in the coded buffer
+    //! \param    [in] subregionNum
+    //!           Number of subregions to split into
+    //!
+    //! \return   void
+    //!
+    void FillSubregionSegments(uint32_t size, const uint32_t *bitstreamEnd, uint32_t subregionNum);
+
+    //!
+    //! \brief    Subregion state of a coded buffer in the status report queue
+    //!
+    struct SubregionState
+    {
+        uint32_t              mappedNum = 0;    //!< Subregions handed out by maps while the picture was encoding
+        std::vector<uint32_t> ends;             //!< Subregion ends, kept when the frame status was collected
+    };
+
+    VACodedBufferSegment *m_subregionSegments = nullptr;  //!< Segments after the first one, ENCODE_SUBREGION_REPORT_MAX_NUM - 1 entries
+    std::map<void *, SubregionState> m_subregions;        //!< Subregion state by coded buffer object
+
     bool    m_cpuFormat              = false;    //!< Flag for cpuFormat.
     bool    m_newSeqHeader           = false;    //!< Flag for new Sequence Header.
     bool    m_newPpsHeader           = false;    //!< Flag for new Pps Header.
@@ -137,13 +137,13 @@ VAStatus MediaLibvaInterfaceNext::HeapInitialize(PDDI_MEDIA_CONTEXT mediaCtx)
     mediaCtx->pProtCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
 
     // init the mutexs
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->SurfaceMutex);
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->BufferMutex);
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->ImageMutex);
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->DecoderMutex);
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->EncoderMutex);
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->VpMutex);
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->ProtMutex);
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->SurfaceMutex, "Ddi.SurfaceMutex");
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->BufferMutex, "Ddi.BufferMutex");
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->ImageMutex, "Ddi.ImageMutex");
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->DecoderMutex, "Ddi.DecoderMutex");
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->EncoderMutex, "Ddi.EncoderMutex");
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->VpMutex, "Ddi.VpMutex");
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->ProtMutex, "Ddi.ProtMutex");
 
     return VA_STATUS_SUCCESS;
 }
@@ -388,8 +388,8 @@ VAStatus MediaLibvaInterfaceNext::Initialize (
     ctx->max_image_formats = mediaCtx->m_capsNext->GetImageFormatsMaxNum();
 
 #if !defined(ANDROID) && defined(X11_FOUND)
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->PutSurfaceRenderMutex);
-    MediaLibvaUtilNext::InitMutex(&mediaCtx->PutSurfaceSwapBufferMutex);
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->PutSurfaceRenderMutex, "Ddi.PutSurfaceRenderMutex");
+    MediaLibvaUtilNext::InitMutex(&mediaCtx->PutSurfaceSwapBufferMutex, "Ddi.PutSurfaceSwapBufferMutex");
 
     // try to open X11 lib, if fail, assume no X11 environment
     if (VA_STATUS_SUCCESS != ConnectX11(mediaCtx))
@@ -743,6 +743,19 @@ VAStatus MediaLibvaInterfaceNext::Terminate(VADriverContextP ctx)
     FreeImageHeapElements(ctx);
     FreeContextHeapElements(ctx);
 
+    // Every context and its allocators are gone, the peak of the process is final so far
+    MosMemoryUsage::Usage memoryUsage;
+    MosInterface::GetMediaMemoryUsage(memoryUsage);
+    DDI_NORMALMESSAGE("Media memory peak %llu bytes, %llu bytes in use, %llu bytes spilled to system memory",
+        (unsigned long long)memoryUsage.peakBytes,
+        (unsigned long long)memoryUsage.usedBytes,
+        (unsigned long long)memoryUsage.spilledBytes);
+    ReportUserSetting(
+        mediaCtx->m_userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_PROCESS_MEMORY_PEAK,
+        uint32_t(MOS_ROUNDUP_DIVIDE(memoryUsage.peakBytes, 1024 * 1024)),
+        MediaUserSetting::Group::Device);
+
     HeapDestroy(mediaCtx);
     DdiMediaProtected::FreeInstances();
 
@@ -1119,6 +1132,23 @@ VAStatus MediaLibvaInterfaceNext::CreateContext (
         }
     }
 
+    // Admission control: while the media allocations of the process sit at the limit a new
+    // context is refused, the caller may retry once other contexts are destroyed
+    uint32_t memoryLimitMB = 0;
+    ReadUserSetting(
+        mediaDrvCtx->m_userSettingPtr,
+        memoryLimitMB,
+        __MEDIA_USER_FEATURE_VALUE_PROCESS_MEMORY_LIMIT,
+        MediaUserSetting::Group::Device);
+    if (MosMemoryUsage::IsOverLimit((uint64_t)memoryLimitMB * 1024 * 1024))
+    {
+        MosMemoryUsage::Usage memoryUsage;
+        MosInterface::GetMediaMemoryUsage(memoryUsage);
+        DDI_ASSERTMESSAGE("DDI: Media memory in use %llu bytes reached the limit of %u MB, context refused",
+            (unsigned long long)memoryUsage.usedBytes, memoryLimitMB);
+        return VA_STATUS_ERROR_ALLOCATION_FAILED;
+    }
+
     if(mediaDrvCtx->m_capsNext->m_capsTable->IsDecConfigId(configId) && REMOVE_CONFIG_ID_DEC_OFFSET(configId) < mediaDrvCtx->m_capsNext->m_capsTable->m_configList.size())
     {
         DDI_CHK_NULL(mediaDrvCtx->m_compList[CompDecode],  "nullptr complist",  VA_STATUS_ERROR_INVALID_CONTEXT);
@@ -2181,13 +2181,18 @@ GMM_RESOURCE_FORMAT MediaLibvaUtilNext::ConvertFourccToGmmFmt(uint32_t fourcc)
     }
 }
 
-void MediaLibvaUtilNext::InitMutex(PMEDIA_MUTEX_T mutex)
+void MediaLibvaUtilNext::InitMutex(PMEDIA_MUTEX_T mutex, const char *name)
 {
     pthread_mutex_init(mutex, nullptr);
+    if (name)
+    {
+        MosUtilities::MosSetMutexName(mutex, name);
+    }
 }
 
 void MediaLibvaUtilNext::DestroyMutex(PMEDIA_MUTEX_T mutex)
 {
+    MosUtilities::MosRetireMutex(mutex);
     int32_t ret = pthread_mutex_destroy(mutex);
     if(ret != 0)
     {
@@ -743,9 +743,11 @@ public:
     //!
     //! \param  [in] mutex
     //!         input mutex
+    //! \param  [in] name
+    //!         lock name reported by the MOS lock profiler, optional
     //! \return     void
     //!
-    static void InitMutex(PMEDIA_MUTEX_T mutex);
+    static void InitMutex(PMEDIA_MUTEX_T mutex, const char *name = nullptr);
 
     //!
     //! \brief  Dstroy a mutex
@@ -1050,7 +1050,7 @@ mos_gem_bo_alloc_internal(struct mos_bufmgr *bufmgr,
          */
         alloc->ext.pat_index = PAT_INDEX_INVALID;
     }
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
     /* Get a buffer out of the cache if available */
 retry:
     alloc_from_cache = false;
@@ -1107,7 +1107,7 @@ retry:
             }
         }
     }
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     if (!alloc_from_cache) {
 
@@ -1470,14 +1470,14 @@ mos_bufmgr_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
      * alternating names for the front/back buffer a linear search
      * provides a sufficiently fast match.
      */
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
     for (list = bufmgr_gem->named.next;
          list != &bufmgr_gem->named;
          list = list->next) {
         bo_gem = DRMLISTENTRY(struct mos_bo_gem, list, name_list);
         if (bo_gem->global_name == handle) {
             mos_gem_bo_reference(&bo_gem->bo);
-            pthread_mutex_unlock(&bufmgr_gem->lock);
+            MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
             return &bo_gem->bo;
         }
     }
@@ -1490,7 +1490,7 @@ mos_bufmgr_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
     if (ret != 0) {
         MOS_DBG("Couldn't reference %s handle 0x%08x: %s\n",
             name, handle, strerror(errno));
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
         return nullptr;
     }
         /* Now see if someone has used a prime handle to get this
@@ -1503,14 +1503,14 @@ mos_bufmgr_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
         bo_gem = DRMLISTENTRY(struct mos_bo_gem, list, name_list);
         if (bo_gem->gem_handle == open_arg.handle) {
             mos_gem_bo_reference(&bo_gem->bo);
-            pthread_mutex_unlock(&bufmgr_gem->lock);
+            MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
             return &bo_gem->bo;
         }
     }
 
     bo_gem = (struct mos_bo_gem *)calloc(1, sizeof(*bo_gem));
     if (!bo_gem) {
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
         return nullptr;
     }
 
@@ -1543,7 +1543,7 @@ mos_bufmgr_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
         if (ret != 0) {
             MOS_DBG("create_from_name: failed to get tiling: %s\n", strerror(errno));
             mos_gem_bo_unreference(&bo_gem->bo);
-            pthread_mutex_unlock(&bufmgr_gem->lock);
+            MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
             return nullptr;
         }
     }
@@ -1559,7 +1559,7 @@ mos_bufmgr_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
     mos_bo_gem_set_in_aperture_size(bufmgr_gem, bo_gem, 0);
 
     DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     if (bufmgr_gem->use_softpin)
     {
@@ -1771,14 +1771,14 @@ static void mos_gem_bo_unreference(struct mos_linux_bo *bo)
 
         clock_gettime(CLOCK_MONOTONIC, &time);
 
-        pthread_mutex_lock(&bufmgr_gem->lock);
+        MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
         if (atomic_dec_and_test(&bo_gem->refcount)) {
             mos_gem_bo_unreference_final(bo, time.tv_sec);
             mos_gem_cleanup_bo_cache(bufmgr_gem, time.tv_sec);
         }
 
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
     }
 }
 
@@ -1882,11 +1882,11 @@ mos_gem_bo_map_wc(struct mos_linux_bo *bo) {
     struct drm_i915_gem_wait wait;
     int ret;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
     ret = map_wc(bo);
     if (ret) {
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
         return ret;
     }
 
@@ -1925,7 +1925,7 @@ mos_gem_bo_map_wc(struct mos_linux_bo *bo) {
 
     mos_gem_bo_mark_mmaps_incoherent(bo);
     VG(VALGRIND_MAKE_MEM_DEFINED(bo_gem->mem_wc_virtual, bo->size));
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     return 0;
 }
@@ -1951,7 +1951,7 @@ drm_export int mos_gem_bo_map(struct mos_linux_bo *bo, int write_enable)
         return mos_gem_bo_map_wc(bo);
     }
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
     if (bufmgr_gem->has_mmap_offset) {
         struct drm_i915_gem_wait wait;
@@ -1980,7 +1980,7 @@ drm_export int mos_gem_bo_map(struct mos_linux_bo *bo, int write_enable)
                 MOS_DBG("%s:%d: Error mapping buffer %d (%s): %s .\n",
                     __FILE__, __LINE__, bo_gem->gem_handle,
                     bo_gem->name, strerror(errno));
-                pthread_mutex_unlock(&bufmgr_gem->lock);
+                MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
                 return ret;
             }
 
@@ -2027,7 +2027,7 @@ drm_export int mos_gem_bo_map(struct mos_linux_bo *bo, int write_enable)
                 MOS_DBG("%s:%d: Error mapping buffer %d (%s): %s .\n",
                     __FILE__, __LINE__, bo_gem->gem_handle,
                     bo_gem->name, strerror(errno));
-                pthread_mutex_unlock(&bufmgr_gem->lock);
+                MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
                 return ret;
             }
             VG(VALGRIND_MALLOCLIKE_BLOCK(mmap_arg.addr_ptr, mmap_arg.size, 0, 1));
@@ -2063,7 +2063,7 @@ drm_export int mos_gem_bo_map(struct mos_linux_bo *bo, int write_enable)
 
     mos_gem_bo_mark_mmaps_incoherent(bo);
     VG(VALGRIND_MAKE_MEM_DEFINED(bo_gem->mem_virtual, bo->size));
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     return 0;
 }
@@ -2157,11 +2157,11 @@ mos_gem_bo_map_gtt(struct mos_linux_bo *bo)
     struct drm_i915_gem_wait wait;
     int ret;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
     ret = map_gtt(bo);
     if (ret) {
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
         return ret;
     }
 
@@ -2200,7 +2200,7 @@ mos_gem_bo_map_gtt(struct mos_linux_bo *bo)
     }
     mos_gem_bo_mark_mmaps_incoherent(bo);
     VG(VALGRIND_MAKE_MEM_DEFINED(bo_gem->gtt_virtual, bo->size));
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     return 0;
 }
@@ -2238,7 +2238,7 @@ mos_gem_bo_map_unsynchronized(struct mos_linux_bo *bo)
     if (!bufmgr_gem->has_llc)
         return mos_gem_bo_map_gtt(bo);
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
     ret = map_gtt(bo);
     if (ret == 0) {
@@ -2246,7 +2246,7 @@ mos_gem_bo_map_unsynchronized(struct mos_linux_bo *bo)
         VG(VALGRIND_MAKE_MEM_DEFINED(bo_gem->gtt_virtual, bo->size));
     }
 
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     return ret;
 }
@@ -2265,11 +2265,11 @@ static int mos_gem_bo_unmap(struct mos_linux_bo *bo)
 
     bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
     if (bo_gem->map_count <= 0) {
         MOS_DBG("attempted to unmap an unmapped bo\n");
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
         /* Preserve the old behaviour of just treating this as a
          * no-op rather than reporting the error.
          */
@@ -2306,7 +2306,7 @@ static int mos_gem_bo_unmap(struct mos_linux_bo *bo)
         bo->virtual = nullptr;
 #endif
     }
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     return ret;
 }
@@ -2460,6 +2460,7 @@ mos_bufmgr_gem_destroy(struct mos_bufmgr *bufmgr)
     free(bufmgr_gem->exec2_objects);
     free(bufmgr_gem->exec_objects);
     free(bufmgr_gem->exec_bos);
+    MosUtilities::MosRetireMutex(&bufmgr_gem->lock);
     pthread_mutex_destroy(&bufmgr_gem->lock);
 
     /* Free any cached buffer objects we were going to reuse */
@@ -2801,7 +2802,7 @@ mos_gem_bo_clear_relocs(struct mos_linux_bo *bo, int start)
     assert(bo_gem->reloc_count >= start);
 
     /* Unreference the cleared target buffers */
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
     for (i = start; i < bo_gem->reloc_count; i++) {
         struct mos_bo_gem *target_bo_gem = (struct mos_bo_gem *) bo_gem->reloc_target_info[i].bo;
@@ -2821,7 +2822,7 @@ mos_gem_bo_clear_relocs(struct mos_linux_bo *bo, int start)
     }
     bo_gem->softpin_target_count = 0;
 
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
 }
 
@@ -2995,7 +2996,7 @@ do_exec2(struct mos_linux_bo *bo, int used, struct mos_linux_context *ctx,
         break;
     }
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
     /* Update indices and set up the validate list. */
     mos_gem_bo_process_reloc2(bo);
 
@@ -3071,7 +3072,7 @@ skip_execution:
         bufmgr_gem->exec_bos[i] = nullptr;
     }
     bufmgr_gem->exec_count = 0;
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     return ret;
 }
@@ -3094,7 +3095,7 @@ do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
     int                             ret = 0;
     int                             i;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
     struct mos_exec_info exec_info;
     memset(static_cast<void*>(&exec_info), 0, sizeof(exec_info));
@@ -3284,7 +3285,7 @@ skip_execution:
     }
     mos_safe_free(exec_info.obj);
     mos_safe_free(exec_info.batch_obj);
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     return ret;
 }
@@ -3438,14 +3439,14 @@ mos_gem_bo_set_softpin(MOS_LINUX_BO *bo)
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
     if (!mos_gem_bo_is_softpin(bo))
     {
         uint64_t alignment = (bufmgr_gem->softpin_va1Malign) ? PAGE_SIZE_1M : PAGE_SIZE_64K;
         uint64_t offset = mos_gem_bo_vma_alloc(bo->bufmgr, (enum mos_memory_zone)bo_gem->mem_region, bo->size, alignment);
         ret = mos_gem_bo_set_softpin_offset(bo, offset);
     }
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     if (ret == 0)
     {
@@ -3467,11 +3468,11 @@ mos_gem_bo_create_from_prime(struct mos_bufmgr *bufmgr, struct mos_drm_bo_alloc_
     int size = alloc_prime->size;
     drmMMListHead *list;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
     ret = drmPrimeFDToHandle(bufmgr_gem->fd, prime_fd, &handle);
     if (ret) {
         MOS_DBG("create_from_prime: failed to obtain handle from fd: %s\n", strerror(errno));
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
         return nullptr;
     }
 
@@ -3486,14 +3487,14 @@ mos_gem_bo_create_from_prime(struct mos_bufmgr *bufmgr, struct mos_drm_bo_alloc_
         bo_gem = DRMLISTENTRY(struct mos_bo_gem, list, name_list);
         if (bo_gem->gem_handle == handle) {
             mos_gem_bo_reference(&bo_gem->bo);
-            pthread_mutex_unlock(&bufmgr_gem->lock);
+            MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
             return &bo_gem->bo;
         }
     }
 
     bo_gem = (struct mos_bo_gem *)calloc(1, sizeof(*bo_gem));
     if (!bo_gem) {
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
         return nullptr;
     }
     /* Determine size of bo.  The fd-to-handle ioctl really should
@@ -3524,7 +3525,7 @@ mos_gem_bo_create_from_prime(struct mos_bufmgr *bufmgr, struct mos_drm_bo_alloc_
     bo_gem->use_48b_address_range = bufmgr_gem->bufmgr.bo_use_48b_address_range ? true : false;
 
     DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     memclear(get_tiling);
     if(bufmgr_gem->has_fence_reg) {
@@ -3561,10 +3562,10 @@ mos_gem_bo_export_to_prime(struct mos_linux_bo *bo, int *prime_fd)
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    MosUtilities::MosLockMutex(&bufmgr_gem->lock);
         if (DRMLISTEMPTY(&bo_gem->name_list))
                 DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
 
     if (drmPrimeHandleToFD(bufmgr_gem->fd, bo_gem->gem_handle,
                    DRM_CLOEXEC, prime_fd) != 0)
@@ -3588,11 +3589,11 @@ mos_gem_bo_flink(struct mos_linux_bo *bo, uint32_t * name)
         memclear(flink);
         flink.handle = bo_gem->gem_handle;
 
-        pthread_mutex_lock(&bufmgr_gem->lock);
+        MosUtilities::MosLockMutex(&bufmgr_gem->lock);
 
         ret = drmIoctl(bufmgr_gem->fd, DRM_IOCTL_GEM_FLINK, &flink);
         if (ret != 0) {
-            pthread_mutex_unlock(&bufmgr_gem->lock);
+            MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
             return -errno;
         }
 
@@ -3601,7 +3602,7 @@ mos_gem_bo_flink(struct mos_linux_bo *bo, uint32_t * name)
 
                 if (DRMLISTEMPTY(&bo_gem->name_list))
                         DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
-        pthread_mutex_unlock(&bufmgr_gem->lock);
+        MosUtilities::MosUnlockMutex(&bufmgr_gem->lock);
     }
 
     *name = bo_gem->global_name;
@@ -4355,14 +4356,14 @@ mos_bufmgr_gem_unref(struct mos_bufmgr *bufmgr)
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)bufmgr;
 
     if (atomic_add_unless(&bufmgr_gem->refcount, -1, 1)) {
-        pthread_mutex_lock(&bufmgr_list_mutex);
+        MosUtilities::MosLockMutex(&bufmgr_list_mutex);
 
         if (atomic_dec_and_test(&bufmgr_gem->refcount)) {
             DRMLISTDEL(&bufmgr_gem->managers);
             mos_bufmgr_gem_destroy(bufmgr);
         }
 
-        pthread_mutex_unlock(&bufmgr_list_mutex);
+        MosUtilities::MosUnlockMutex(&bufmgr_list_mutex);
     }
 }
 
@@ -5237,7 +5238,8 @@ mos_bufmgr_gem_init_i915(int fd, int batch_size)
     uint8_t alloc_mode;
     bool exec2 = false;
 
-    pthread_mutex_lock(&bufmgr_list_mutex);
+    MosUtilities::MosSetMutexName(&bufmgr_list_mutex, "i915.BufmgrList");
+    MosUtilities::MosLockMutex(&bufmgr_list_mutex);
 
     bufmgr_gem = mos_bufmgr_gem_find(fd);
     if (bufmgr_gem)
@@ -5255,6 +5257,7 @@ mos_bufmgr_gem_init_i915(int fd, int batch_size)
         bufmgr_gem = nullptr;
         goto exit;
     }
+    MosUtilities::MosSetMutexName(&bufmgr_gem->lock, "i915.Bufmgr");
 
     bufmgr_gem->bufmgr.bo_alloc = mos_gem_bo_alloc;
     bufmgr_gem->bufmgr.bo_alloc_tiled = mos_gem_bo_alloc_tiled;
@@ -5377,6 +5380,7 @@ mos_bufmgr_gem_init_i915(int fd, int batch_size)
     bufmgr_gem->pci_device = get_pci_device_id(bufmgr_gem);
 
     if (bufmgr_gem->pci_device == 0) {
+        MosUtilities::MosRetireMutex(&bufmgr_gem->lock);
         pthread_mutex_destroy(&bufmgr_gem->lock);
         if (bufmgr_gem->mem_profiler_fd != -1)
         {
@@ -5503,7 +5507,7 @@ mos_bufmgr_gem_init_i915(int fd, int batch_size)
     mos_vma_heap_init(&bufmgr_gem->vma_heap[MEMZONE_DEVICE], MEMZONE_DEVICE_START, MEMZONE_DEVICE_SIZE);
 
 exit:
-    pthread_mutex_unlock(&bufmgr_list_mutex);
+    MosUtilities::MosUnlockMutex(&bufmgr_list_mutex);
 
     return bufmgr_gem != nullptr ? &bufmgr_gem->bufmgr : nullptr;
 }
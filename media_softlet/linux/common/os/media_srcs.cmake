@@ -26,6 +26,7 @@ media_include_subdirectory(i915)
 media_include_subdirectory(levelzero)
 
 media_include_subdirectory(xe)
+media_include_subdirectory(sw)
 
 
 if(ENABLE_PRODUCTION_KMD)
@@ -53,6 +54,8 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_auxtable_mgr.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_interface.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_vdbox_balancer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_sysmem_placement.cpp
 )
 
 set(TMP_HEADERS_
@@ -70,6 +73,8 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_interface_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_auxtable_mgr.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_vma.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_vdbox_balancer.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_sysmem_placement.h
 )
 
 if(${Media_Scalability_Supported} STREQUAL "yes")
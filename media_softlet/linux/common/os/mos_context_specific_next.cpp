@@ -38,6 +38,7 @@
 #include <sys/sem.h>
 #include <sys/types.h>
 #include <time.h>
+#include <chrono>
 
 #if MOS_MEDIASOLO_SUPPORTED
 #include "mos_os_solo.h"
@@ -48,6 +49,8 @@
 #include "mos_cmdbufmgr_next.h"
 #include "mos_oca_rtlog_mgr.h"
 #include "mos_oca_interface_specific.h"
+#include "mos_bufmgr_sw.h"
+#include "mos_sysmem_placement.h"
 #define BATCH_BUFFER_SIZE 0x80000
 
 OsContextSpecificNext::OsContextSpecificNext()
@@ -82,23 +85,61 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
         MosUtilities::MosZeroMemory(&m_platformInfo, sizeof(m_platformInfo));
         MosUtilities::MosZeroMemory(&m_gtSystemInfo, sizeof(m_gtSystemInfo));
 
-        if( nullptr == osDriverContext  ||
-            0 > osDriverContext->fd )
+        if (nullptr == osDriverContext)
         {
             MOS_OS_ASSERT(false);
             return MOS_STATUS_INVALID_HANDLE;
         }
-        m_fd = osDriverContext->fd;
 
         userSettingPtr = MosInterface::MosGetUserSettingInstance(osDriverContext);
 
-        m_bufmgr = mos_bufmgr_gem_init(m_fd, BATCH_BUFFER_SIZE, &m_deviceType);
+        bool swBufmgrEnabled = false;
+#if (_DEBUG || _RELEASE_INTERNAL)
+        ReadUserSettingForDebug(
+            userSettingPtr,
+            swBufmgrEnabled,
+            __MEDIA_USER_FEATURE_VALUE_SW_BUFMGR_ENABLE,
+            MediaUserSetting::Group::Device);
+#endif
+
+        // The software bufmgr never touches the fd, so a GPU-less setup may not have one
+        if (0 > osDriverContext->fd && !swBufmgrEnabled)
+        {
+            MOS_OS_ASSERT(false);
+            return MOS_STATUS_INVALID_HANDLE;
+        }
+        m_fd = osDriverContext->fd;
+
+        // Startup phase durations in us, traced once the device is set up
+        struct
+        {
+            uint32_t bufmgrInit;
+            uint32_t gfxInfo;
+            uint32_t gmmInit;
+        } phaseTime = {};
+        auto phaseStart = std::chrono::steady_clock::now();
+        auto phaseEnd   = [&phaseStart]() {
+            auto now   = std::chrono::steady_clock::now();
+            auto time  = std::chrono::duration_cast<std::chrono::microseconds>(now - phaseStart).count();
+            phaseStart = now;
+            return (uint32_t)time;
+        };
+
+        if (swBufmgrEnabled)
+        {
+            m_bufmgr = mos_bufmgr_sw_init(m_fd, BATCH_BUFFER_SIZE, &m_deviceType);
+        }
+        else
+        {
+            m_bufmgr = mos_bufmgr_gem_init(m_fd, BATCH_BUFFER_SIZE, &m_deviceType);
+        }
         if (nullptr == m_bufmgr)
         {
             MOS_OS_ASSERTMESSAGE("Not able to allocate buffer manager, fd=0x%d", m_fd);
             return MOS_STATUS_INVALID_PARAMETER;
         }
         mos_bufmgr_enable_reuse(m_bufmgr);
+        phaseTime.bufmgrInit = phaseEnd();
 
         osDriverContext->bufmgr                 = m_bufmgr;
 
@@ -107,6 +148,12 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
         m_isAtomSOC = IS_ATOMSOC(iDeviceId);
 
         eStatus = NullHwInit((MOS_CONTEXT_HANDLE)osDriverContext);
+        if (swBufmgrEnabled && !GetNullHwIsEnabled())
+        {
+            // Platform, SKU and WA must come from MosMockAdaptor when there is no device to query
+            MOS_OS_ASSERTMESSAGE("Software bufmgr requires NULL HW to be enabled");
+            return MOS_STATUS_INVALID_PARAMETER;
+        }
         if (!GetNullHwIsEnabled())
         {
             eStatus = HWInfo_GetGfxInfo(m_fd, m_bufmgr, &m_platformInfo, &m_skuTable, &m_waTable, &m_gtSystemInfo, userSettingPtr);
@@ -119,6 +166,7 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
             m_gtSystemInfo  = osDriverContext->m_gtSystemInfo;
             iDeviceId       = osDriverContext->iDeviceId;
         }
+        phaseTime.gfxInfo = phaseEnd();
 
         // replace platform/sku/wa/gtsysinfo for os context
         if (Mos_Solo_IsEnabled(nullptr))
@@ -135,6 +183,8 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
             return eStatus;
         }
 
+        MosSysMemPlacement::Init(userSettingPtr, m_bufmgr, m_fd);
+
         if (m_platformInfo.eProductFamily == IGFX_METEORLAKE ||
             m_platformInfo.eProductFamily == IGFX_ARROWLAKE ||
             m_platformInfo.eProductFamily == IGFX_LUNARLAKE)
@@ -257,6 +307,8 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
             return MOS_STATUS_INVALID_PARAMETER;
         }
         m_gmmClientContext = gmmOutArgs.pGmmClientContext;
+        phaseTime.gmmInit  = phaseEnd();
+        MOS_TraceEventExt(EVENT_DDI_CREATE_DEVICE, EVENT_TYPE_INFO, &phaseTime, sizeof(phaseTime), nullptr, 0);
 
         m_auxTableMgr = AuxTableMgr::CreateAuxTableMgr(m_bufmgr, &m_skuTable, m_gmmClientContext);
 
@@ -359,8 +411,22 @@ void OsContextSpecificNext::Destroy()
         m_skuTable.reset();
         m_waTable.reset();
 
+        mos_bufmgr_sw_stats swStats = {};
+        if (mos_bufmgr_is_sw(m_bufmgr) && mos_bufmgr_sw_get_stats(m_bufmgr, &swStats) == 0)
+        {
+            MOS_OS_NORMALMESSAGE("sw bufmgr: %llu execs, %llu dwords parsed, %llu writes, %llu unresolved addresses, %llu of %llu bos alive",
+                (unsigned long long)swStats.exec_count,
+                (unsigned long long)swStats.dwords_parsed,
+                (unsigned long long)swStats.mem_writes,
+                (unsigned long long)swStats.unresolved_addrs,
+                (unsigned long long)swStats.bo_live_count,
+                (unsigned long long)swStats.bo_alloc_count);
+        }
+
         mos_bufmgr_destroy(m_bufmgr);
 
+        MosSysMemPlacement::Deinit();
+
         // Delete Gmm context
         GMM_INIT_OUT_ARGS gmmOutArgs = {};
         gmmOutArgs.pGmmClientContext = m_gmmClientContext;
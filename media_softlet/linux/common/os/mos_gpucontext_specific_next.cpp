@@ -528,6 +528,7 @@ MOS_STATUS GpuContextSpecificNext::Init(OsContextNext *osContext,
     if (m_cmdBufPoolMutex == nullptr)
     {
         m_cmdBufPoolMutex = MosUtilities::MosCreateMutex();
+        MosUtilities::MosSetMutexName(m_cmdBufPoolMutex, "GpuContext.CmdBufPool");
     }
 
     MOS_OS_CHK_NULL_RETURN(m_cmdBufPoolMutex);
@@ -30,6 +30,7 @@
 #include "mos_graphicsresource_specific_next.h"
 #include "mos_context_specific_next.h"
 #include "memory_policy_manager.h"
+#include "mos_sysmem_placement.h"
 
 GraphicsResourceSpecificNext::GraphicsResourceSpecificNext()
 {
@@ -282,14 +283,42 @@ MOS_STATUS GraphicsResourceSpecificNext::Allocate(OsContextNext* osContextPtr, C
     // Only Linear and Y TILE supported
     else if (tileFormatLinux == TILING_NONE)
     {
-        struct mos_drm_bo_alloc alloc;
-        alloc.name = bufName;
-        alloc.size = bufSize;
-        alloc.alignment = 4096;
-        alloc.ext.mem_type = mem_type;
-        alloc.ext.pat_index = patIndex;
-        alloc.ext.cpu_cacheable = isCpuCacheable;
-        boPtr = mos_bo_alloc(pOsContextSpecific->m_bufmgr, &alloc);
+        if (mem_type == MOS_MEMPOOL_SYSTEMMEMORY && params.m_type == MOS_GFXRES_BUFFER &&
+            MosSysMemPlacement::IsEnabled() && bufSize >= MosSysMemPlacement::m_hugePageSize)
+        {
+            // Back large system memory buffers with huge pages on the node of the GPU.
+            // Driver internal buffers are never exported, so a userptr BO can wrap them.
+            m_placedMemory = MosSysMemPlacement::Alloc(bufSize, pOsContextSpecific->GetFd());
+            if (MosSysMemPlacement::IsPlaced(m_placedMemory))
+            {
+                struct mos_drm_bo_alloc_userptr alloc_uptr;
+                alloc_uptr.name = bufName;
+                alloc_uptr.addr = m_placedMemory;
+                alloc_uptr.tiling_mode = tileFormatLinux;
+                alloc_uptr.stride = bufPitch;
+                alloc_uptr.size = MOS_ALIGN_CEIL(bufSize, MOS_PAGE_SIZE);
+                alloc_uptr.pat_index = patIndex;
+
+                boPtr = mos_bo_alloc_userptr(pOsContextSpecific->m_bufmgr, &alloc_uptr);
+            }
+            if (boPtr == nullptr)
+            {
+                MosSysMemPlacement::Free(m_placedMemory);
+                m_placedMemory = nullptr;
+            }
+        }
+
+        if (boPtr == nullptr)
+        {
+            struct mos_drm_bo_alloc alloc;
+            alloc.name = bufName;
+            alloc.size = bufSize;
+            alloc.alignment = 4096;
+            alloc.ext.mem_type = mem_type;
+            alloc.ext.pat_index = patIndex;
+            alloc.ext.cpu_cacheable = isCpuCacheable;
+            boPtr = mos_bo_alloc(pOsContextSpecific->m_bufmgr, &alloc);
+        }
     }
     else
     {
@@ -397,6 +426,11 @@ void GraphicsResourceSpecificNext::Free(OsContextNext* osContextPtr, uint32_t  f
         }
         mos_bo_unreference(boPtr);
         m_bo = nullptr;
+        if (m_placedMemory)
+        {
+            MosSysMemPlacement::Free(m_placedMemory);
+            m_placedMemory = nullptr;
+        }
         if (nullptr != m_gmmResInfo)
         {
             pOsContextSpecific->GetGmmClientContext()->DestroyResInfoObject(m_gmmResInfo);
@@ -518,7 +552,7 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
                         m_mmapOperation = MOS_MMAP_OPERATION_MMAP;
                         if (m_systemShadow == nullptr)
                         {
-                            m_systemShadow = (uint8_t *)MOS_AllocMemory(boPtr->size);
+                            m_systemShadow = (uint8_t *)MosSysMemPlacement::Alloc(boPtr->size, pOsContextSpecific->GetFd());
                             MOS_OS_CHECK_CONDITION((m_systemShadow == nullptr), "Failed to allocate shadow surface", nullptr);
                         }
                         if (m_systemShadow)
@@ -597,7 +631,7 @@ MOS_STATUS GraphicsResourceSpecificNext::Unlock(OsContextNext* osContextPtr)
                    MosUtilities::MosSwizzleData(m_systemShadow, (uint8_t*)boPtr->virt,
                                    MOS_TILE_LINEAR, MOS_TILE_Y,
                                    (int32_t)(surfSize / m_pitch), m_pitch, flags);
-                   MOS_FreeMemory(m_systemShadow);
+                   MosSysMemPlacement::Free(m_systemShadow);
                    m_systemShadow = nullptr;
                }
 
@@ -37,6 +37,7 @@
 #include "drm_device.h"
 #include "media_fourcc.h"
 #include "mos_oca_rtlog_mgr.h"
+#include "mos_lock_profiler.h"
 
 #if (_DEBUG || _RELEASE_INTERNAL)
 #include <stdlib.h>   //for simulate random OS API failure
@@ -311,6 +312,9 @@ MOS_STATUS MosInterface::CreateOsStreamState(
 
     MOS_OS_CHK_STATUS_RETURN(MosInterface::InitStreamParameters(*streamState, extraParams));
 
+    (*streamState)->asyncLockQueue = MOS_New(MosAsyncLockQueue, *streamState);
+    MOS_OS_CHK_NULL_RETURN((*streamState)->asyncLockQueue);
+
 #if MOS_COMMAND_BUFFER_DUMP_SUPPORTED
     DumpCommandBufferInit(*streamState);
 #endif  // MOS_COMMAND_BUFFER_DUMP_SUPPORTED
@@ -325,6 +329,9 @@ MOS_STATUS MosInterface::DestroyOsStreamState(
 
     MOS_OS_CHK_NULL_RETURN(streamState);
 
+    // Serves the locks still queued, their resources are about to go away
+    MOS_Delete(streamState->asyncLockQueue);
+
     if (streamState->mosDecompression)
     {
         MOS_Delete(streamState->mosDecompression);
@@ -1063,9 +1070,29 @@ MOS_STATUS MosInterface::SubmitCommandBuffer(
 
     gpuContext->UpdatePriority(streamState->ctxPriority);
 
+    // The commands may use resources of queued async locks, serve them first. A failed
+    // lock is reported to its callback and does not fail the submission.
+    if (streamState->asyncLockQueue)
+    {
+        streamState->asyncLockQueue->Process(nullptr, true);
+    }
+
     return (gpuContext->SubmitCommandBuffer(streamState, cmdBuffer, nullRendering));
 }
 
+MOS_STATUS MosInterface::SetVdboxWorkload(
+    MOS_STREAM_HANDLE streamState,
+    uint32_t          workload)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    MOS_OS_CHK_NULL_RETURN(streamState);
+    streamState->vdboxWorkload = workload;
+    streamState->vdboxFrameId++;
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS MosInterface::ResetCommandBuffer(
     MOS_STREAM_HANDLE     streamState,
     COMMAND_BUFFER_HANDLE cmdBuffer)
@@ -1880,6 +1907,11 @@ MOS_STATUS MosInterface::FreeResource(
     MOS_OS_CHK_NULL_RETURN(streamState);
     MOS_OS_CHK_NULL_RETURN(streamState->osDeviceContext);
 
+    if (streamState->asyncLockQueue)
+    {
+        streamState->asyncLockQueue->Process(resource, true);
+    }
+
     bool osContextValid = streamState->osDeviceContext->GetOsContextValid();
 
     bool byPassMod = !((!resource->bConvertedFromDDIResource) && (osContextValid == true) && (resource->pGfxResourceNext));
@@ -2121,31 +2153,79 @@ void *MosInterface::LockMosResource(
         return nullptr;
     }
 
-    if ((!resource->bConvertedFromDDIResource) && (resource->pGfxResourceNext))
+    bool isInternal = (!resource->bConvertedFromDDIResource) && (resource->pGfxResourceNext);
+    if (isInternal && nullptr == streamState->osDeviceContext)
     {
-        if (nullptr == streamState->osDeviceContext)
-        {
-            MOS_OS_ASSERTMESSAGE("invalid osDeviceContext, skip lock");
-            return nullptr;
-        }
+        MOS_OS_ASSERTMESSAGE("invalid osDeviceContext, skip lock");
+        return nullptr;
+    }
 
-        if (resource->pGfxResourceNext)
-        {
-            GraphicsResourceNext::LockParams params(flags);
-            pData = resource->pGfxResourceNext->Lock(streamState->osDeviceContext, params);
-        }
-        else
-        {
-            MOS_OS_ASSERTMESSAGE("Received an empty Graphics Resource, skip lock");
-            return nullptr;
-        }
-        return pData;
+    // Async locks queued earlier on the resource come first
+    if (streamState->asyncLockQueue)
+    {
+        streamState->asyncLockQueue->Process(resource, true);
+    }
+
+    // Account the time a lock of a busy resource waits for the GPU, every path
+    // below reaches EndResourceWait
+    uint64_t waitStart = 0;
+    if (MosLockProfiler::IsEnabled() && IsResourceBusy(streamState, resource))
+    {
+        waitStart = MosLockProfiler::BeginResourceWait();
+    }
+
+    if (isInternal)
+    {
+        GraphicsResourceNext::LockParams params(flags);
+        pData = resource->pGfxResourceNext->Lock(streamState->osDeviceContext, params);
+    }
+    else
+    {
+        pData = GraphicsResourceSpecificNext::LockExternalResource(streamState, resource, flags);
     }
 
-    pData = GraphicsResourceSpecificNext::LockExternalResource(streamState, resource, flags);
+    if (waitStart)
+    {
+        MosLockProfiler::EndResourceWait(resource->bufname, waitStart);
+    }
     return pData;
 }
 
+bool MosInterface::IsResourceBusy(
+    MOS_STREAM_HANDLE   streamState,
+    MOS_RESOURCE_HANDLE resource)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    if (nullptr == resource || nullptr == resource->bo)
+    {
+        return false;
+    }
+
+    return mos_bo_busy(resource->bo) != 0;
+}
+
+MOS_STATUS MosInterface::LockMosResourceAsync(
+    MOS_STREAM_HANDLE    streamState,
+    MOS_RESOURCE_HANDLE  resource,
+    PMOS_LOCK_PARAMS     flags,
+    MosAsyncLockCallback callback)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    MOS_OS_CHK_NULL_RETURN(streamState);
+    MOS_OS_CHK_NULL_RETURN(streamState->asyncLockQueue);
+    MOS_OS_CHK_NULL_RETURN(resource);
+    MOS_OS_CHK_NULL_RETURN(flags);
+
+    return streamState->asyncLockQueue->Add(resource, *flags, std::move(callback));
+}
+
+void MosInterface::GetMediaMemoryUsage(MosMemoryUsage::Usage &usage)
+{
+    MosMemoryUsage::Get(usage);
+}
+
 void *MosInterface::LockMosResource(
     OsDeviceContext    *osDeviceContext,
     MOS_RESOURCE_HANDLE resource,
@@ -0,0 +1,354 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_sysmem_placement.cpp
+//! \brief       Huge page and NUMA node placement of large system memory buffers
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include "mos_sysmem_placement.h"
+#include "mos_resource_defs.h"
+#include "mos_utilities.h"
+#include "mos_util_debug.h"
+#include "media_user_setting_specific.h"
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB     0x40000
+#endif
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED  1
+#endif
+
+// mbind is called through syscall to not depend on libnuma
+#define MOS_SYSMEM_MAX_NUMA_NODES   1024
+
+std::atomic<MosSysMemPlacement::Mode> MosSysMemPlacement::m_mode(MosSysMemPlacement::modeOff);
+std::atomic<uint32_t>           MosSysMemPlacement::m_deviceNum(0);
+std::mutex                      MosSysMemPlacement::m_mutex;
+std::map<void *, size_t>        MosSysMemPlacement::m_mappings;
+std::map<dev_t, int32_t>        MosSysMemPlacement::m_nodes;
+std::atomic<uint64_t>           MosSysMemPlacement::m_hugetlbAllocs(0);
+std::atomic<uint64_t>           MosSysMemPlacement::m_thpAllocs(0);
+std::atomic<uint64_t>           MosSysMemPlacement::m_localNodeAllocs(0);
+std::atomic<uint64_t>           MosSysMemPlacement::m_fallbackAllocs(0);
+std::atomic<uint64_t>           MosSysMemPlacement::m_smallAllocs(0);
+
+void MosSysMemPlacement::Init(MediaUserSettingSharedPtr userSettingPtr, MOS_BUFMGR *bufmgr, int32_t fd)
+{
+    m_deviceNum++;
+
+    static std::once_flag once;
+    std::call_once(once, [&]() {
+        uint32_t mode = modeOff;
+        ReadUserSetting(
+            userSettingPtr,
+            mode,
+            __MEDIA_USER_FEATURE_VALUE_SYSMEM_PLACEMENT,
+            MediaUserSetting::Group::Device);
+        m_mode = (mode == modeThp || mode == modeHugetlb) ? (Mode)mode : modeOff;
+        MOS_OS_NORMALMESSAGE("System memory placement mode %d", m_mode.load());
+    });
+
+    bool bench = false;
+    ReadUserSetting(
+        userSettingPtr,
+        bench,
+        __MEDIA_USER_FEATURE_VALUE_SYSMEM_PLACEMENT_BENCH,
+        MediaUserSetting::Group::Device);
+    if (bench)
+    {
+        static std::once_flag benchOnce;
+        std::call_once(benchOnce, [bufmgr, fd]() {
+            BenchResult result = {};
+            if (RunReadbackBenchmark(bufmgr, fd, result) == MOS_STATUS_SUCCESS)
+            {
+                MOS_OS_NORMALMESSAGE("Readback of %zu bytes: default %lu MB/s, %s%s %lu MB/s",
+                    m_benchSize,
+                    (unsigned long)result.defaultRate,
+                    result.hugetlb ? "hugetlb" : "thp",
+                    result.bound ? " on the GPU node" : "",
+                    (unsigned long)result.placedRate);
+            }
+        });
+    }
+}
+
+void MosSysMemPlacement::Deinit()
+{
+    if (m_deviceNum.fetch_sub(1) == 1 && IsEnabled())
+    {
+        ReportStats();
+    }
+}
+
+int32_t MosSysMemPlacement::GetNumaNode(int32_t fd)
+{
+    struct stat st = {};
+    if (fd < 0 || fstat(fd, &st) != 0 || !S_ISCHR(st.st_mode))
+    {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_nodes.find(st.st_rdev);
+    if (it != m_nodes.end())
+    {
+        return it->second;
+    }
+
+    int32_t node = -1;
+    char    sysPath[64];
+    snprintf(sysPath, sizeof(sysPath), "/sys/dev/char/%u:%u/device/numa_node", major(st.st_rdev), minor(st.st_rdev));
+    FILE *file = fopen(sysPath, "r");
+    if (file)
+    {
+        if (fscanf(file, "%d", &node) != 1 || node >= MOS_SYSMEM_MAX_NUMA_NODES)
+        {
+            node = -1;
+        }
+        fclose(file);
+    }
+
+    MOS_OS_NORMALMESSAGE("Device %u:%u is on NUMA node %d", major(st.st_rdev), minor(st.st_rdev), node);
+    m_nodes[st.st_rdev] = node;
+    return node;
+}
+
+void *MosSysMemPlacement::MapHuge(size_t size, int32_t node, bool tryHugetlb, bool &hugetlb, bool &bound)
+{
+    size_t alignedSize = MOS_ALIGN_CEIL(size, m_hugePageSize);
+    uint8_t *ptr       = nullptr;
+
+    hugetlb = false;
+    bound   = false;
+
+    if (tryHugetlb)
+    {
+        // Fails if the hugetlbfs pool does not have enough free pages
+        void *map = mmap(nullptr, alignedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (map != MAP_FAILED)
+        {
+            ptr     = (uint8_t *)map;
+            hugetlb = true;
+        }
+    }
+
+    if (ptr == nullptr)
+    {
+        // Over map by one huge page and trim both ends to get a 2MB aligned range
+        size_t mapSize = alignedSize + m_hugePageSize;
+        void  *map     = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        uint8_t *base = (uint8_t *)map;
+        ptr           = (uint8_t *)MOS_ALIGN_CEIL((uintptr_t)base, m_hugePageSize);
+        if (ptr > base)
+        {
+            munmap(base, ptr - base);
+        }
+        size_t tail = (base + mapSize) - (ptr + alignedSize);
+        if (tail)
+        {
+            munmap(ptr + alignedSize, tail);
+        }
+        madvise(ptr, alignedSize, MADV_HUGEPAGE);
+    }
+
+    // Pages are not faulted in yet, so the policy applies to all of them
+    if (node >= 0)
+    {
+        unsigned long nodeMask[MOS_SYSMEM_MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = {};
+        nodeMask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+        bound = syscall(SYS_mbind, ptr, alignedSize, MPOL_PREFERRED, nodeMask, (unsigned long)MOS_SYSMEM_MAX_NUMA_NODES + 1, 0) == 0;
+    }
+
+    return ptr;
+}
+
+void *MosSysMemPlacement::Alloc(size_t size, int32_t fd)
+{
+    if (!IsEnabled())
+    {
+        return MOS_AllocMemory(size);
+    }
+    if (size < m_hugePageSize)
+    {
+        m_smallAllocs++;
+        return MOS_AllocMemory(size);
+    }
+
+    bool  hugetlb = false;
+    bool  bound   = false;
+    void *ptr     = MapHuge(size, GetNumaNode(fd), m_mode == modeHugetlb, hugetlb, bound);
+    if (ptr == nullptr)
+    {
+        m_fallbackAllocs++;
+        return MOS_AllocMemory(size);
+    }
+
+    if (hugetlb)
+    {
+        m_hugetlbAllocs++;
+    }
+    else
+    {
+        m_thpAllocs++;
+    }
+    if (bound)
+    {
+        m_localNodeAllocs++;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mappings[ptr] = MOS_ALIGN_CEIL(size, m_hugePageSize);
+    return ptr;
+}
+
+void MosSysMemPlacement::Free(void *ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    if (IsEnabled())
+    {
+        size_t size = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_mappings.find(ptr);
+            if (it != m_mappings.end())
+            {
+                size = it->second;
+                m_mappings.erase(it);
+            }
+        }
+        if (size)
+        {
+            munmap(ptr, size);
+            return;
+        }
+    }
+    MOS_FreeMemory(ptr);
+}
+
+bool MosSysMemPlacement::IsPlaced(void *ptr)
+{
+    if (!IsEnabled() || ptr == nullptr)
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_mappings.find(ptr) != m_mappings.end();
+}
+
+void MosSysMemPlacement::GetStats(Stats &stats)
+{
+    stats.hugetlbAllocs   = m_hugetlbAllocs;
+    stats.thpAllocs       = m_thpAllocs;
+    stats.localNodeAllocs = m_localNodeAllocs;
+    stats.fallbackAllocs  = m_fallbackAllocs;
+    stats.smallAllocs     = m_smallAllocs;
+}
+
+void MosSysMemPlacement::ReportStats()
+{
+    Stats stats = {};
+    GetStats(stats);
+    MOS_OS_NORMALMESSAGE("System memory placement: hugetlb %lu, thp %lu, local node %lu, fallback %lu, small %lu",
+        (unsigned long)stats.hugetlbAllocs,
+        (unsigned long)stats.thpAllocs,
+        (unsigned long)stats.localNodeAllocs,
+        (unsigned long)stats.fallbackAllocs,
+        (unsigned long)stats.smallAllocs);
+}
+
+MOS_STATUS MosSysMemPlacement::RunReadbackBenchmark(MOS_BUFMGR *bufmgr, int32_t fd, BenchResult &result)
+{
+    MOS_OS_CHK_NULL_RETURN(bufmgr);
+    MOS_ZeroMemory(&result, sizeof(result));
+
+    size_t size = m_benchSize;
+
+    struct mos_drm_bo_alloc alloc;
+    alloc.name         = "SysMemPlacementBench";
+    alloc.size         = size;
+    alloc.alignment    = 4096;
+    alloc.ext.mem_type = MOS_MEMPOOL_VIDEOMEMORY;
+    MOS_LINUX_BO *bo   = mos_bo_alloc(bufmgr, &alloc);
+
+    uint8_t *dstDefault = (uint8_t *)MOS_AllocMemory(size);
+    uint8_t *dstPlaced  = (uint8_t *)MapHuge(size, GetNumaNode(fd), m_mode == modeHugetlb, result.hugetlb, result.bound);
+
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+    if (bo == nullptr || dstDefault == nullptr || dstPlaced == nullptr)
+    {
+        MOS_OS_NORMALMESSAGE("Readback benchmark skipped, cannot allocate %zu bytes", size);
+        status = MOS_STATUS_NO_SPACE;
+    }
+    else if (mos_bo_map(bo, 1) != 0 || bo->virt == nullptr)
+    {
+        MOS_OS_NORMALMESSAGE("Readback benchmark skipped, cannot map the buffer object");
+        status = MOS_STATUS_INVALID_HANDLE;
+    }
+    else
+    {
+        // Fault every page in first, only the copies are timed
+        memset(bo->virt, 0x5a, size);
+        memset(dstDefault, 0, size);
+        memset(dstPlaced, 0, size);
+
+        auto measure = [&](uint8_t *dst) {
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < m_benchLoops; i++)
+            {
+                MOS_SecureMemcpy(dst, size, bo->virt, size);
+            }
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+            return us > 0 ? (uint64_t)size * m_benchLoops / (uint64_t)us : 0;
+        };
+        result.defaultRate = measure(dstDefault);
+        result.placedRate  = measure(dstPlaced);
+        mos_bo_unmap(bo);
+    }
+
+    if (bo)
+    {
+        mos_bo_unreference(bo);
+    }
+    MOS_FreeMemory(dstDefault);
+    if (dstPlaced)
+    {
+        munmap(dstPlaced, MOS_ALIGN_CEIL(size, m_hugePageSize));
+    }
+    return status;
+}
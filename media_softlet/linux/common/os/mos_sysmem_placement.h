@@ -0,0 +1,209 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_sysmem_placement.h
+//! \brief       Huge page and NUMA node placement of large system memory buffers
+//! \details     Software untiling shadows and system memory pool buffers of 4K and 8K
+//!              frames span thousands of 4K pages, and on multi socket hosts they may
+//!              land on the node away from the GPU. "Media Sysmem Placement" selects
+//!              how buffers of 2MB and more are backed: 1 maps them 2MB aligned and
+//!              asks for transparent huge pages, 2 takes pages from the hugetlbfs
+//!              pool and falls back to transparent huge pages when the pool is empty.
+//!              In both modes the pages are preferred on the NUMA node of the GPU, as
+//!              reported by the PCI device in sysfs. Smaller buffers and the default 0
+//!              keep the regular allocator. "Media Sysmem Placement Bench" measures
+//!              the bandwidth of reading a GPU buffer into both kinds of buffers once
+//!              per process.
+//!
+#ifndef __MOS_SYSMEM_PLACEMENT_H__
+#define __MOS_SYSMEM_PLACEMENT_H__
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include "mos_defs.h"
+#include "mos_bufmgr_api.h"
+#include "media_class_trace.h"
+
+class MosSysMemPlacement
+{
+public:
+    //!
+    //! \brief  Values of "Media Sysmem Placement"
+    //!
+    enum Mode
+    {
+        modeOff = 0,
+        modeThp,
+        modeHugetlb
+    };
+
+    //!
+    //! \brief  Placement decisions since the process started
+    //!
+    struct Stats
+    {
+        uint64_t hugetlbAllocs;   //!< Buffers backed by the hugetlbfs pool
+        uint64_t thpAllocs;       //!< Buffers mapped 2MB aligned for transparent huge pages
+        uint64_t localNodeAllocs; //!< Huge page buffers preferred on the node of the GPU
+        uint64_t fallbackAllocs;  //!< Large buffers left to the regular allocator after a failure
+        uint64_t smallAllocs;     //!< Buffers below the huge page size
+    };
+
+    //!
+    //! \brief  Result of RunReadbackBenchmark
+    //!
+    struct BenchResult
+    {
+        uint64_t defaultRate;   //!< MB/s into a buffer of the regular allocator
+        uint64_t placedRate;    //!< MB/s into a huge page buffer
+        bool     hugetlb;       //!< The huge page buffer came from the hugetlbfs pool
+        bool     bound;         //!< The huge page buffer was preferred on the node of the GPU
+    };
+
+    //!
+    //! \brief    Read the placement user settings of a device
+    //! \details  The mode applies to the whole process, the first device opened sets
+    //!           it. Runs the readback benchmark once per process if "Media Sysmem
+    //!           Placement Bench" is set. Each call is paired with Deinit.
+    //! \param    [in] userSettingPtr
+    //!           User setting instance of the device
+    //! \param    [in] bufmgr
+    //!           Buffer manager of the device
+    //! \param    [in] fd
+    //!           DRM fd of the device
+    //!
+    static void Init(MediaUserSettingSharedPtr userSettingPtr, MOS_BUFMGR *bufmgr, int32_t fd);
+
+    //!
+    //! \brief    Release a device from Init
+    //! \details  The placement decisions are logged when the last device is released.
+    //!
+    static void Deinit();
+
+    //!
+    //! \brief    Check whether placement is enabled
+    //! \return   bool
+    //!           true if "Media Sysmem Placement" selects huge pages
+    //!
+    static bool IsEnabled()
+    {
+        return m_mode.load(std::memory_order_relaxed) != modeOff;
+    }
+
+    //!
+    //! \brief    Get the NUMA node of a device
+    //! \param    [in] fd
+    //!           DRM fd of the device
+    //! \return   int32_t
+    //!           node of the PCI device, -1 if unknown
+    //!
+    static int32_t GetNumaNode(int32_t fd);
+
+    //!
+    //! \brief    Allocate a system memory buffer
+    //! \details  The buffer is not zeroed. Without placement it comes from MOS_AllocMemory.
+    //! \param    [in] size
+    //!           Buffer size in bytes
+    //! \param    [in] fd
+    //!           DRM fd of the device reading or writing the buffer
+    //! \return   void *
+    //!           Buffer, page aligned when at least one huge page large, nullptr on failure
+    //!
+    static void *Alloc(size_t size, int32_t fd);
+
+    //!
+    //! \brief    Free a buffer returned by Alloc
+    //!
+    static void Free(void *ptr);
+
+    //!
+    //! \brief    Check whether a buffer returned by Alloc is a huge page mapping
+    //! \details  Only those are page aligned and can back a userptr BO.
+    //!
+    static bool IsPlaced(void *ptr);
+
+    //!
+    //! \brief    Get the placement decisions since the process started
+    //! \param    [out] stats
+    //!           Counters of the decisions
+    //!
+    static void GetStats(Stats &stats);
+
+    //!
+    //! \brief    Log the placement decisions
+    //!
+    static void ReportStats();
+
+    //!
+    //! \brief    Compare the readback bandwidth of regular and placed buffers
+    //! \details  A frame sized buffer object of the device is mapped the way Lock
+    //!           maps it and copied into a destination from each allocator. On
+    //!           discrete parts the source is in local memory, so the copies read
+    //!           across the bus into the node of the destination.
+    //! \param    [in] bufmgr
+    //!           Buffer manager of the device
+    //! \param    [in] fd
+    //!           DRM fd of the device
+    //! \param    [out] result
+    //!           MB/s of each destination
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    static MOS_STATUS RunReadbackBenchmark(MOS_BUFMGR *bufmgr, int32_t fd, BenchResult &result);
+
+    static constexpr size_t   m_hugePageSize   = 2 * 1024 * 1024;
+    //! \brief  8K NV12 frame
+    static constexpr size_t   m_benchSize      = 7680 * 4320 * 3 / 2;
+    static constexpr uint32_t m_benchLoops     = 8;
+
+protected:
+    //!
+    //! \brief    Map 2MB aligned anonymous memory, preferred on node
+    //! \param    [in] tryHugetlb
+    //!           take the pages from the hugetlbfs pool if it has enough
+    //! \param    [out] hugetlb
+    //!           the pages come from the hugetlbfs pool
+    //! \param    [out] bound
+    //!           the pages are preferred on node
+    //! \return   void *
+    //!           nullptr if the mapping failed, the mapping is size rounded up to 2MB
+    //!
+    static void *MapHuge(size_t size, int32_t node, bool tryHugetlb, bool &hugetlb, bool &bound);
+
+    static std::atomic<Mode>            m_mode;
+    static std::atomic<uint32_t>        m_deviceNum;  // devices between Init and Deinit
+    static std::mutex                   m_mutex;
+    static std::map<void *, size_t>     m_mappings;  // huge page mappings and their length
+    static std::map<dev_t, int32_t>     m_nodes;
+    static std::atomic<uint64_t>        m_hugetlbAllocs;
+    static std::atomic<uint64_t>        m_thpAllocs;
+    static std::atomic<uint64_t>        m_localNodeAllocs;
+    static std::atomic<uint64_t>        m_fallbackAllocs;
+    static std::atomic<uint64_t>        m_smallAllocs;
+
+MEDIA_CLASS_DEFINE_END(MosSysMemPlacement)
+};
+
+#endif  // __MOS_SYSMEM_PLACEMENT_H__
@@ -52,6 +52,36 @@ MOS_STATUS MosUserSetting::InitMosUserSettingSpecific(MediaUserSettingSharedPtr
         0,
         true); //"Enable VM Bind."
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_ENABLE_VDBOX_BALANCER,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Place single pipe decode streams on the least loaded VDBox, Xe only."
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    DeclareUserSettingKeyForDebug(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_VDBOX_BALANCER_LOAD,
+        MediaUserSetting::Group::Device,
+        uint64_t(0),
+        true); //"Recent load share in percent of each VDBox, 8 bits per VDBox, reported when a balanced stream ends."
+#endif
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_SYSMEM_PLACEMENT,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Backing of system memory buffers of 2MB and more. 0: regular allocator, 1: transparent huge pages, 2: hugetlbfs pool, falling back to transparent huge pages."
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_SYSMEM_PLACEMENT_BENCH,
+        MediaUserSetting::Group::Device,
+        false,
+        false); //"Log the readback bandwidth of regular and placed system memory buffers once per process."
+
     DeclareUserSettingKey(
         userSettingPtr,
         "INTEL MEDIA ALLOC MODE",
@@ -0,0 +1,253 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_vdbox_balancer.cpp
+//! \brief       Process wide placement of single pipe decode streams on VDBoxes
+//!
+
+#include <chrono>
+#include <cmath>
+#include "mos_vdbox_balancer.h"
+#include "mos_util_debug.h"
+
+static uint64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+MosVdboxBalancer &MosVdboxBalancer::GetInstance()
+{
+    static MosVdboxBalancer balancer;
+    return balancer;
+}
+
+void MosVdboxBalancer::DecayLoads(Device &device, Stream *stream, uint64_t nowUs)
+{
+    if (nowUs > device.loadTime)
+    {
+        double factor = exp(-(double)(nowUs - device.loadTime) / (m_loadDecayMs * 1000));
+        for (auto &engine : device.engines)
+        {
+            engine.load *= factor;
+        }
+        device.loadTime = nowUs;
+    }
+
+    if (stream && nowUs > stream->loadTime)
+    {
+        stream->load *= exp(-(double)(nowUs - stream->loadTime) / (m_loadDecayMs * 1000));
+        stream->loadTime = nowUs;
+    }
+}
+
+uint32_t MosVdboxBalancer::GetLeastLoadedEngine(const Device &device)
+{
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < device.engines.size(); i++)
+    {
+        const Engine &engine = device.engines[i];
+        const Engine &bestEngine = device.engines[best];
+        // Streams registered together have no load yet, spread them by count
+        if (engine.load < bestEngine.load ||
+            (engine.load == bestEngine.load && engine.stats.streamNum < bestEngine.stats.streamNum))
+        {
+            best = i;
+        }
+    }
+    return best;
+}
+
+uint32_t MosVdboxBalancer::GetTargetEngine(const Device &device, const Stream &stream)
+{
+    if (stream.frameNum < m_minFramesToMove || stream.engine >= device.engines.size())
+    {
+        return stream.engine;
+    }
+
+    uint32_t      best    = GetLeastLoadedEngine(device);
+    const Engine &current = device.engines[stream.engine];
+    const Engine &target  = device.engines[best];
+
+    // A stream alone on its engine never moves, it would only carry its load along
+    if (best != stream.engine && target.load + stream.load < current.load * m_moveLoadRatio)
+    {
+        return best;
+    }
+    return stream.engine;
+}
+
+int32_t MosVdboxBalancer::RegisterStream(void *device, uint32_t engineNum)
+{
+    if (device == nullptr || engineNum < 2)
+    {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Device &dev = m_devices[device];
+    if (dev.engines.size() != engineNum)
+    {
+        if (dev.streamNum > 0)
+        {
+            MOS_OS_NORMALMESSAGE("VDBox number mismatch %d vs %d, stream not balanced", engineNum, (uint32_t)dev.engines.size());
+            return -1;
+        }
+        dev.engines.assign(engineNum, Engine());
+    }
+    DecayLoads(dev, nullptr, NowUs());
+
+    int32_t streamId = m_nextStreamId++;
+    Stream &stream   = m_streams[streamId];
+    stream.device    = device;
+    stream.engine    = GetLeastLoadedEngine(dev);
+    stream.loadTime  = dev.loadTime;
+
+    dev.streamNum++;
+    dev.engines[stream.engine].stats.streamNum++;
+
+    MOS_OS_NORMALMESSAGE("Stream %d pinned to VDBox %d", streamId, stream.engine);
+    return streamId;
+}
+
+void MosVdboxBalancer::UnregisterStream(int32_t streamId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end())
+    {
+        return;
+    }
+
+    auto devIt = m_devices.find(it->second.device);
+    if (devIt != m_devices.end())
+    {
+        Device &dev = devIt->second;
+        DecayLoads(dev, &it->second, NowUs());
+
+        Engine &engine = dev.engines[it->second.engine];
+        engine.stats.streamNum--;
+        engine.load = MOS_MAX(engine.load - it->second.load, 0.0);
+
+        if (--dev.streamNum == 0)
+        {
+            ReportDevice(devIt->first, dev);
+            m_devices.erase(devIt);
+        }
+    }
+    m_streams.erase(it);
+}
+
+uint32_t MosVdboxBalancer::SelectEngine(int32_t streamId, uint32_t workload, bool newFrame)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end())
+    {
+        return 0;
+    }
+    Stream &stream = it->second;
+    if (!newFrame)
+    {
+        return stream.engine;
+    }
+    Device &dev = m_devices[stream.device];
+
+    DecayLoads(dev, &stream, NowUs());
+
+    ++stream.frameNum;
+    uint32_t best = GetTargetEngine(dev, stream);
+    if (best != stream.engine)
+    {
+        Engine &current = dev.engines[stream.engine];
+        Engine &target  = dev.engines[best];
+        current.load = MOS_MAX(current.load - stream.load, 0.0);
+        target.load += stream.load;
+        current.stats.streamNum--;
+        target.stats.streamNum++;
+        dev.migrateNum++;
+
+        MOS_OS_NORMALMESSAGE("Stream %d moved from VDBox %d to VDBox %d", streamId, stream.engine, best);
+        stream.engine   = best;
+        stream.frameNum = 0;
+    }
+
+    workload = workload ? workload : m_defaultWorkload;
+
+    Engine &engine = dev.engines[stream.engine];
+    engine.load += workload;
+    engine.stats.frameNum++;
+    engine.stats.workload += workload;
+    stream.load += workload;
+
+    return stream.engine;
+}
+
+void MosVdboxBalancer::GetEngineStats(void *device, std::vector<EngineStats> &stats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    stats.clear();
+    auto devIt = m_devices.find(device);
+    if (devIt == m_devices.end())
+    {
+        return;
+    }
+
+    Device &dev = devIt->second;
+    DecayLoads(dev, nullptr, NowUs());
+
+    double totalLoad = 0;
+    for (auto &engine : dev.engines)
+    {
+        totalLoad += engine.load;
+    }
+    for (auto &engine : dev.engines)
+    {
+        engine.stats.loadPercent = totalLoad > 0 ? (uint32_t)(engine.load * 100 / totalLoad + 0.5) : 0;
+        stats.push_back(engine.stats);
+    }
+}
+
+void MosVdboxBalancer::ReportDevice(void *deviceKey, const Device &device)
+{
+    uint64_t totalWorkload = 0;
+    for (auto &engine : device.engines)
+    {
+        totalWorkload += engine.stats.workload;
+    }
+
+    MOS_OS_NORMALMESSAGE("VDBox balancer of device %p: %d stream moves", deviceKey, device.migrateNum);
+    for (uint32_t i = 0; i < device.engines.size(); i++)
+    {
+        const EngineStats &stats = device.engines[i].stats;
+        MOS_OS_NORMALMESSAGE("  VDBox %d: %llu frames, workload %llu (%d%%)",
+            i,
+            (unsigned long long)stats.frameNum,
+            (unsigned long long)stats.workload,
+            totalWorkload ? (uint32_t)(stats.workload * 100 / totalWorkload) : 0);
+    }
+    MOS_UNUSED(totalWorkload);
+}
@@ -0,0 +1,167 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_vdbox_balancer.h
+//! \brief       Process wide placement of single pipe decode streams on VDBoxes
+//! \details     Every stream is pinned to one engine of its device. The load of an
+//!              engine is the frames submitted to it, decayed over time, so engines
+//!              fed by heavy or fast streams look busy. A new stream goes to the
+//!              least loaded engine. A stream is moved only after it ran a while on
+//!              its engine and only if the move clearly evens out the loads, so two
+//!              engines with similar load do not trade streams back and forth.
+//!              Off by default, the KMD picks the engine unless the "Enable VDBox
+//!              Balancer" user setting is 1.
+//!
+#ifndef __MOS_VDBOX_BALANCER_H__
+#define __MOS_VDBOX_BALANCER_H__
+
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+#include "mos_defs.h"
+#include "media_class_trace.h"
+
+class MosVdboxBalancer
+{
+public:
+    //!
+    //! \brief  Utilization counters of one engine
+    //!
+    struct EngineStats
+    {
+        uint32_t streamNum   = 0;  //!< Streams pinned to the engine
+        uint64_t frameNum    = 0;  //!< Frames placed on the engine
+        uint64_t workload    = 0;  //!< Sum of the workload of those frames
+        uint32_t loadPercent = 0;  //!< Share of the recent device load carried by the engine
+    };
+
+    //!
+    //! \brief    Get the balancer shared by all devices of the process
+    //!
+    static MosVdboxBalancer &GetInstance();
+
+    //!
+    //! \brief    Register a stream and pin it to the least loaded engine
+    //! \param    [in] device
+    //!           Device the stream submits to, streams of one device share the engines
+    //! \param    [in] engineNum
+    //!           Number of engines of the device
+    //! \return   int32_t
+    //!           Stream id, -1 if the stream cannot be balanced
+    //!
+    int32_t RegisterStream(void *device, uint32_t engineNum);
+
+    //!
+    //! \brief    Unregister a stream
+    //! \details  The counters of a device are logged and dropped with its last stream.
+    //! \param    [in] streamId
+    //!           Id returned by RegisterStream
+    //!
+    void UnregisterStream(int32_t streamId);
+
+    //!
+    //! \brief    Get the engine to run a submission of a stream on
+    //! \details  Only the first submission of a frame is accounted and may move the
+    //!           stream, the other submissions of the frame follow it.
+    //! \param    [in] streamId
+    //!           Id returned by RegisterStream
+    //! \param    [in] workload
+    //!           Size of the frame, see MosInterface::SetVdboxWorkload,
+    //!           0 if the stream does not report it
+    //! \param    [in] newFrame
+    //!           true for the first submission of a frame
+    //! \return   uint32_t
+    //!           Engine index, 0 for unknown streams
+    //!
+    uint32_t SelectEngine(int32_t streamId, uint32_t workload, bool newFrame);
+
+    //!
+    //! \brief    Get the utilization counters of the engines of a device
+    //! \param    [in] device
+    //!           Device passed to RegisterStream
+    //! \param    [out] stats
+    //!           One entry per engine, empty if the device has no stream
+    //!
+    void GetEngineStats(void *device, std::vector<EngineStats> &stats);
+
+    //! \brief  Workload assumed for frames not reporting one, a 1080p frame in MBs
+    static constexpr uint32_t m_defaultWorkload  = 8160;
+    //! \brief  Time constant of the load decay
+    static constexpr double   m_loadDecayMs      = 100.0;
+    //! \brief  Frames a stream stays on an engine before it may move
+    static constexpr uint32_t m_minFramesToMove  = 30;
+    //! \brief  A move must bring the load of the stream below this part of the current engine load
+    static constexpr double   m_moveLoadRatio    = 0.75;
+
+protected:
+    struct Engine
+    {
+        EngineStats stats;
+        double      load = 0;
+    };
+
+    struct Device
+    {
+        std::vector<Engine> engines;
+        uint64_t            loadTime   = 0;
+        uint32_t            streamNum  = 0;
+        uint32_t            migrateNum = 0;
+    };
+
+    struct Stream
+    {
+        void    *device     = nullptr;
+        uint32_t engine     = 0;
+        uint32_t frameNum   = 0;  //!< Frames since the stream was pinned to engine
+        double   load       = 0;
+        uint64_t loadTime   = 0;
+    };
+
+    MosVdboxBalancer() = default;
+
+    //!
+    //! \brief    Decay the loads of a device and its stream up to now
+    //!
+    void     DecayLoads(Device &device, Stream *stream, uint64_t nowUs);
+    void     ReportDevice(void *deviceKey, const Device &device);
+
+    static uint32_t GetLeastLoadedEngine(const Device &device);
+
+    //!
+    //! \brief    Get the engine a stream runs its next frame on
+    //! \details  Pure on the loads, the stream stays until it ran m_minFramesToMove
+    //!           frames on its engine and a move clearly evens out the loads.
+    //! \return   uint32_t
+    //!           Engine index, stream.engine if the stream stays
+    //!
+    static uint32_t GetTargetEngine(const Device &device, const Stream &stream);
+
+    std::mutex                 m_mutex;
+    std::map<void *, Device>   m_devices;
+    std::map<int32_t, Stream>  m_streams;
+    int32_t                    m_nextStreamId = 0;
+
+MEDIA_CLASS_DEFINE_END(MosVdboxBalancer)
+};
+
+#endif  // __MOS_VDBOX_BALANCER_H__
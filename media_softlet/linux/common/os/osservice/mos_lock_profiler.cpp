@@ -0,0 +1,390 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_lock_profiler.cpp
+//! \brief       Contention profiler for MOS mutexes on Linux
+//!
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include "mos_lock_profiler.h"
+
+// Slot keys: 0 is a never-used slot, 1 a retired one. Mutex addresses are
+// aligned, so neither value can be a real key.
+#define MOS_LOCK_PROFILER_KEY_EMPTY   ((uintptr_t)0)
+#define MOS_LOCK_PROFILER_KEY_RETIRED ((uintptr_t)1)
+
+bool MosLockProfiler::m_enabled = (getenv(MOS_LOCK_PROFILER_ENV) != nullptr);
+MosLockProfiler::LockStats MosLockProfiler::m_locks[MOS_LOCK_PROFILER_MAX_LOCKS];
+
+namespace
+{
+struct LockTotals
+{
+    uint64_t instances = 0;
+    uint64_t acquires  = 0;
+    uint64_t contended = 0;
+    uint64_t waitNs    = 0;
+    uint64_t holdNs    = 0;
+    uint64_t maxWaitNs = 0;
+    uint64_t maxHoldNs = 0;
+};
+
+// Serializes slot insertion/retirement and protects the retired totals. It is a
+// plain pthread mutex so that it is never itself routed through the profiler.
+pthread_mutex_t g_registryMutex = PTHREAD_MUTEX_INITIALIZER;
+
+std::map<std::string, LockTotals> &RetiredTotals()
+{
+    static std::map<std::string, LockTotals> retired;
+    return retired;
+}
+
+struct ResourceWaitTotals
+{
+    uint64_t waits     = 0;
+    uint64_t waitNs    = 0;
+    uint64_t maxWaitNs = 0;
+};
+
+// Resource waits last as long as GPU work, so a mutex and a map keyed by name
+// cost nothing next to them.
+pthread_mutex_t g_resourceWaitMutex = PTHREAD_MUTEX_INITIALIZER;
+
+std::map<std::string, ResourceWaitTotals> &ResourceWaitTotalsByName()
+{
+    static std::map<std::string, ResourceWaitTotals> waits;
+    return waits;
+}
+
+inline uint32_t HashSlot(uintptr_t key)
+{
+    uint64_t h = (uint64_t)key * 0x9E3779B97F4A7C15ull;
+    return (uint32_t)(h >> 32) & (MOS_LOCK_PROFILER_MAX_LOCKS - 1);
+}
+}  // namespace
+
+static_assert((MOS_LOCK_PROFILER_MAX_LOCKS & (MOS_LOCK_PROFILER_MAX_LOCKS - 1)) == 0,
+    "MOS_LOCK_PROFILER_MAX_LOCKS must be a power of two");
+
+uint64_t MosLockProfiler::NowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void MosLockProfiler::UpdateMax(std::atomic<uint64_t> &max, uint64_t value)
+{
+    uint64_t cur = max.load(std::memory_order_relaxed);
+    while (value > cur && !max.compare_exchange_weak(cur, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+MosLockProfiler::LockStats *MosLockProfiler::Find(pthread_mutex_t *mutex, bool insert)
+{
+    uintptr_t  key       = (uintptr_t)mutex;
+    uint32_t   slot      = HashSlot(key);
+    LockStats *firstFree = nullptr;
+
+    for (uint32_t i = 0; i < MOS_LOCK_PROFILER_MAX_LOCKS; i++)
+    {
+        LockStats &stats = m_locks[(slot + i) & (MOS_LOCK_PROFILER_MAX_LOCKS - 1)];
+        uintptr_t  cur   = stats.key.load(std::memory_order_acquire);
+        if (cur == key)
+        {
+            return &stats;
+        }
+        if (cur == MOS_LOCK_PROFILER_KEY_RETIRED)
+        {
+            if (firstFree == nullptr)
+            {
+                firstFree = &stats;
+            }
+            continue;
+        }
+        if (cur == MOS_LOCK_PROFILER_KEY_EMPTY)
+        {
+            if (firstFree == nullptr)
+            {
+                firstFree = &stats;
+            }
+            break;
+        }
+    }
+
+    if (!insert || firstFree == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Caller holds g_registryMutex, lock-free readers only ever compare keys.
+    firstFree->acquires.store(0, std::memory_order_relaxed);
+    firstFree->contended.store(0, std::memory_order_relaxed);
+    firstFree->waitNs.store(0, std::memory_order_relaxed);
+    firstFree->holdNs.store(0, std::memory_order_relaxed);
+    firstFree->maxWaitNs.store(0, std::memory_order_relaxed);
+    firstFree->maxHoldNs.store(0, std::memory_order_relaxed);
+    firstFree->acquireTs.store(0, std::memory_order_relaxed);
+    firstFree->name[0] = '\0';
+    firstFree->key.store(key, std::memory_order_release);
+    return firstFree;
+}
+
+void MosLockProfiler::ReclaimRetired(uint32_t slot)
+{
+    // A retired slot followed by an empty one ends every probe chain through it, so
+    // it can be emptied, and so can the retired slots before it. Otherwise lookups
+    // of untracked mutexes would scan the whole table once every slot was used.
+    // Caller holds g_registryMutex, lookups racing with this stop at the new empty
+    // slot and no live key lies behind it.
+    const uint32_t mask = MOS_LOCK_PROFILER_MAX_LOCKS - 1;
+    if (m_locks[(slot + 1) & mask].key.load(std::memory_order_acquire) != MOS_LOCK_PROFILER_KEY_EMPTY)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < MOS_LOCK_PROFILER_MAX_LOCKS; i++)
+    {
+        LockStats &stats = m_locks[(slot - i) & mask];
+        if (stats.key.load(std::memory_order_acquire) != MOS_LOCK_PROFILER_KEY_RETIRED)
+        {
+            break;
+        }
+        stats.key.store(MOS_LOCK_PROFILER_KEY_EMPTY, std::memory_order_release);
+    }
+}
+
+void MosLockProfiler::SetName(pthread_mutex_t *mutex, const char *name)
+{
+    if (!m_enabled || mutex == nullptr || name == nullptr)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&g_registryMutex);
+    LockStats *stats = Find(mutex, true);
+    if (stats)
+    {
+        strncpy(stats->name, name, MOS_LOCK_PROFILER_MAX_NAME_LEN - 1);
+        stats->name[MOS_LOCK_PROFILER_MAX_NAME_LEN - 1] = '\0';
+    }
+    pthread_mutex_unlock(&g_registryMutex);
+}
+
+int MosLockProfiler::Lock(pthread_mutex_t *mutex)
+{
+    LockStats *stats = Find(mutex, false);
+    if (stats == nullptr)
+    {
+        // Unnamed mutexes are not tracked.
+        return pthread_mutex_lock(mutex);
+    }
+
+    uint64_t waitNs = 0;
+    int      ret    = pthread_mutex_trylock(mutex);
+    if (ret == EBUSY)
+    {
+        uint64_t start = NowNs();
+        ret            = pthread_mutex_lock(mutex);
+        waitNs         = NowNs() - start;
+        stats->contended.fetch_add(1, std::memory_order_relaxed);
+        stats->waitNs.fetch_add(waitNs, std::memory_order_relaxed);
+        UpdateMax(stats->maxWaitNs, waitNs);
+    }
+    if (ret == 0)
+    {
+        stats->acquires.fetch_add(1, std::memory_order_relaxed);
+        stats->acquireTs.store(NowNs(), std::memory_order_relaxed);
+    }
+    return ret;
+}
+
+int MosLockProfiler::Unlock(pthread_mutex_t *mutex)
+{
+    LockStats *stats     = Find(mutex, false);
+    uint64_t   acquireTs = stats ? stats->acquireTs.exchange(0, std::memory_order_relaxed) : 0;
+    if (acquireTs)
+    {
+        uint64_t holdNs = NowNs() - acquireTs;
+        stats->holdNs.fetch_add(holdNs, std::memory_order_relaxed);
+        UpdateMax(stats->maxHoldNs, holdNs);
+    }
+    return pthread_mutex_unlock(mutex);
+}
+
+void MosLockProfiler::Retire(pthread_mutex_t *mutex)
+{
+    if (!m_enabled || mutex == nullptr)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&g_registryMutex);
+    LockStats *stats = Find(mutex, false);
+    if (stats)
+    {
+        LockTotals &totals = RetiredTotals()[stats->name];
+        totals.instances++;
+        totals.acquires += stats->acquires.load(std::memory_order_relaxed);
+        totals.contended += stats->contended.load(std::memory_order_relaxed);
+        totals.waitNs += stats->waitNs.load(std::memory_order_relaxed);
+        totals.holdNs += stats->holdNs.load(std::memory_order_relaxed);
+        totals.maxWaitNs = std::max(totals.maxWaitNs, stats->maxWaitNs.load(std::memory_order_relaxed));
+        totals.maxHoldNs = std::max(totals.maxHoldNs, stats->maxHoldNs.load(std::memory_order_relaxed));
+        stats->key.store(MOS_LOCK_PROFILER_KEY_RETIRED, std::memory_order_release);
+        ReclaimRetired((uint32_t)(stats - m_locks));
+    }
+    pthread_mutex_unlock(&g_registryMutex);
+}
+
+void MosLockProfiler::EndResourceWait(const char *name, uint64_t startNs)
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    uint64_t waitNs = NowNs() - startNs;
+
+    pthread_mutex_lock(&g_resourceWaitMutex);
+    ResourceWaitTotals &totals = ResourceWaitTotalsByName()[name ? name : "unnamed"];
+    totals.waits++;
+    totals.waitNs += waitNs;
+    totals.maxWaitNs = std::max(totals.maxWaitNs, waitNs);
+    pthread_mutex_unlock(&g_resourceWaitMutex);
+}
+
+void MosLockProfiler::Reset()
+{
+    pthread_mutex_lock(&g_registryMutex);
+    RetiredTotals().clear();
+    for (LockStats &stats : m_locks)
+    {
+        stats.acquires.store(0, std::memory_order_relaxed);
+        stats.contended.store(0, std::memory_order_relaxed);
+        stats.waitNs.store(0, std::memory_order_relaxed);
+        stats.holdNs.store(0, std::memory_order_relaxed);
+        stats.maxWaitNs.store(0, std::memory_order_relaxed);
+        stats.maxHoldNs.store(0, std::memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&g_registryMutex);
+
+    pthread_mutex_lock(&g_resourceWaitMutex);
+    ResourceWaitTotalsByName().clear();
+    pthread_mutex_unlock(&g_resourceWaitMutex);
+}
+
+int MosLockProfiler::Report(const char *path)
+{
+    if (!m_enabled)
+    {
+        return -1;
+    }
+    if (path == nullptr)
+    {
+        path = getenv(MOS_LOCK_PROFILER_ENV);
+    }
+    if (path == nullptr || path[0] == '\0')
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&g_registryMutex);
+    std::map<std::string, LockTotals> merged = RetiredTotals();
+    for (LockStats &stats : m_locks)
+    {
+        uintptr_t key = stats.key.load(std::memory_order_acquire);
+        if (key == MOS_LOCK_PROFILER_KEY_EMPTY || key == MOS_LOCK_PROFILER_KEY_RETIRED)
+        {
+            continue;
+        }
+        LockTotals &totals = merged[stats.name];
+        totals.instances++;
+        totals.acquires += stats.acquires.load(std::memory_order_relaxed);
+        totals.contended += stats.contended.load(std::memory_order_relaxed);
+        totals.waitNs += stats.waitNs.load(std::memory_order_relaxed);
+        totals.holdNs += stats.holdNs.load(std::memory_order_relaxed);
+        totals.maxWaitNs = std::max(totals.maxWaitNs, stats.maxWaitNs.load(std::memory_order_relaxed));
+        totals.maxHoldNs = std::max(totals.maxHoldNs, stats.maxHoldNs.load(std::memory_order_relaxed));
+    }
+    pthread_mutex_unlock(&g_registryMutex);
+
+    std::vector<std::pair<std::string, LockTotals>> sorted(merged.begin(), merged.end());
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, LockTotals> &a, const std::pair<std::string, LockTotals> &b) {
+        return a.second.waitNs > b.second.waitNs;
+    });
+
+    FILE *fp = fopen(path, "w");
+    if (fp == nullptr)
+    {
+        return -1;
+    }
+
+    fprintf(fp, "%-40s %9s %12s %12s %8s %14s %12s %14s %12s\n",
+        "lock", "instances", "acquires", "contended", "cont%", "wait_us", "max_wait_us", "hold_us", "max_hold_us");
+    for (auto &entry : sorted)
+    {
+        const LockTotals &t = entry.second;
+        fprintf(fp, "%-40s %9lu %12lu %12lu %7.2f%% %14.1f %12.1f %14.1f %12.1f\n",
+            entry.first.c_str(),
+            (unsigned long)t.instances,
+            (unsigned long)t.acquires,
+            (unsigned long)t.contended,
+            t.acquires ? 100.0 * t.contended / t.acquires : 0.0,
+            t.waitNs / 1000.0,
+            t.maxWaitNs / 1000.0,
+            t.holdNs / 1000.0,
+            t.maxHoldNs / 1000.0);
+    }
+
+    pthread_mutex_lock(&g_resourceWaitMutex);
+    std::vector<std::pair<std::string, ResourceWaitTotals>> waits(
+        ResourceWaitTotalsByName().begin(), ResourceWaitTotalsByName().end());
+    pthread_mutex_unlock(&g_resourceWaitMutex);
+
+    if (!waits.empty())
+    {
+        std::sort(waits.begin(), waits.end(), [](const std::pair<std::string, ResourceWaitTotals> &a, const std::pair<std::string, ResourceWaitTotals> &b) {
+            return a.second.waitNs > b.second.waitNs;
+        });
+
+        fprintf(fp, "\n%-40s %12s %14s %12s\n", "resource lock-wait", "waits", "wait_us", "max_wait_us");
+        for (auto &entry : waits)
+        {
+            const ResourceWaitTotals &t = entry.second;
+            fprintf(fp, "%-40s %12lu %14.1f %12.1f\n",
+                entry.first.c_str(),
+                (unsigned long)t.waits,
+                t.waitNs / 1000.0,
+                t.maxWaitNs / 1000.0);
+        }
+    }
+    fclose(fp);
+    return 0;
+}
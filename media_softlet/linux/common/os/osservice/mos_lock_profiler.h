@@ -0,0 +1,155 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_lock_profiler.h
+//! \brief       Contention profiler for MOS mutexes on Linux
+//! \details     Records acquire count, contended acquire count, wait time and
+//!              hold time for every mutex locked through MosUtilities::MosLockMutex.
+//!              Mutexes are tracked by address; MosUtilities::MosSetMutexName
+//!              attaches a readable name which is used to aggregate the report.
+//!              CPU locks of GPU resources which had to wait for the GPU are
+//!              reported too, by resource name.
+//!              Profiling is off unless MEDIA_LOCK_PROFILER_LOG is set in the
+//!              environment, in which case the report is written to that path
+//!              when MOS utilities are closed.
+//!
+#ifndef __MOS_LOCK_PROFILER_H__
+#define __MOS_LOCK_PROFILER_H__
+
+#include <atomic>
+#include <pthread.h>
+#include <stdint.h>
+
+#define MOS_LOCK_PROFILER_ENV            "MEDIA_LOCK_PROFILER_LOG"
+#define MOS_LOCK_PROFILER_MAX_LOCKS      4096
+#define MOS_LOCK_PROFILER_MAX_NAME_LEN   64
+
+class MosLockProfiler
+{
+public:
+    //!
+    //! \brief    Check whether lock profiling is enabled for this process
+    //! \return   bool
+    //!           true if MEDIA_LOCK_PROFILER_LOG was set when the driver was loaded
+    //!
+    static bool IsEnabled()
+    {
+        return m_enabled;
+    }
+
+    //!
+    //! \brief    Attach a name to a mutex
+    //! \details  Mutexes sharing a name are merged in the report, so per-instance
+    //!           locks (e.g. one per VA context) can use the same name.
+    //! \param    [in] mutex
+    //!           Pointer of mutex
+    //! \param    [in] name
+    //!           Name of the lock, truncated to MOS_LOCK_PROFILER_MAX_NAME_LEN
+    //!
+    static void SetName(pthread_mutex_t *mutex, const char *name);
+
+    //!
+    //! \brief    Lock mutex and account wait time and contention
+    //! \param    [in] mutex
+    //!           Pointer of mutex
+    //! \return   int
+    //!           Return value of pthread_mutex_lock
+    //!
+    static int Lock(pthread_mutex_t *mutex);
+
+    //!
+    //! \brief    Unlock mutex and account hold time
+    //! \param    [in] mutex
+    //!           Pointer of mutex
+    //! \return   int
+    //!           Return value of pthread_mutex_unlock
+    //!
+    static int Unlock(pthread_mutex_t *mutex);
+
+    //!
+    //! \brief    Retire a mutex before it is destroyed
+    //! \details  Folds its statistics into the named totals so that a later mutex
+    //!           allocated at the same address does not inherit them.
+    //! \param    [in] mutex
+    //!           Pointer of mutex
+    //!
+    static void Retire(pthread_mutex_t *mutex);
+
+    //!
+    //! \brief    Start timing a CPU lock of a resource the GPU still uses
+    //! \return   uint64_t
+    //!           Start time to pass to EndResourceWait
+    //!
+    static uint64_t BeginResourceWait()
+    {
+        return NowNs();
+    }
+
+    //!
+    //! \brief    Account the time a resource lock waited for the GPU
+    //! \details  Waits are aggregated by resource name in a second table of the
+    //!           report, so buffers stalling the submission thread stand out.
+    //! \param    [in] name
+    //!           Resource name, nullptr for unnamed resources
+    //! \param    [in] startNs
+    //!           Value returned by BeginResourceWait
+    //!
+    static void EndResourceWait(const char *name, uint64_t startNs);
+
+    //!
+    //! \brief    Write the contention report
+    //! \param    [in] path
+    //!           Output file, nullptr to use MEDIA_LOCK_PROFILER_LOG
+    //! \return   int
+    //!           0 on success, -1 if the file cannot be written or profiling is disabled
+    //!
+    static int Report(const char *path);
+
+    //!
+    //! \brief    Clear all collected statistics, names are kept
+    //!
+    static void Reset();
+
+private:
+    struct LockStats
+    {
+        std::atomic<uintptr_t> key;
+        char                   name[MOS_LOCK_PROFILER_MAX_NAME_LEN];
+        std::atomic<uint64_t>  acquires;
+        std::atomic<uint64_t>  contended;
+        std::atomic<uint64_t>  waitNs;
+        std::atomic<uint64_t>  holdNs;
+        std::atomic<uint64_t>  maxWaitNs;
+        std::atomic<uint64_t>  maxHoldNs;
+        std::atomic<uint64_t>  acquireTs;  //!< set by the owner, reset when the slot is reused
+    };
+
+    static LockStats *Find(pthread_mutex_t *mutex, bool insert);
+    static void       ReclaimRetired(uint32_t slot);
+    static uint64_t   NowNs();
+    static void       UpdateMax(std::atomic<uint64_t> &max, uint64_t value);
+
+    static bool      m_enabled;
+    static LockStats m_locks[MOS_LOCK_PROFILER_MAX_LOCKS];
+};
+
+#endif  // __MOS_LOCK_PROFILER_H__
@@ -45,6 +45,7 @@
 #include "mos_utilities_specific.h"
 #include "mos_utilities.h"
 #include "mos_util_debug.h"
+#include "mos_lock_profiler.h"
 #include "inttypes.h"
 
 int32_t g_mosMemAllocCounter         = 0;
@@ -1458,6 +1459,10 @@ MOS_STATUS MosUtilities::MosOsUtilitiesClose(MediaUserSettingSharedPtr userSetti
     if (m_mosUtilInitCount == 0)
     {
         MosTraceEventClose();
+        if (MosLockProfiler::IsEnabled())
+        {
+            MosLockProfiler::Report(nullptr);
+        }
         if (m_mosMemAllocCounter &&
             m_mosMemAllocCounterGfx &&
             m_mosMemAllocFakeCounter)
@@ -2322,6 +2327,10 @@ MOS_STATUS MosUtilities::MosDestroyMutex(PMOS_MUTEX &pMutex)
 
     if (pMutex)
     {
+        if (MosLockProfiler::IsEnabled())
+        {
+            MosLockProfiler::Retire(pMutex);
+        }
         if (pthread_mutex_destroy(pMutex))
         {
             eStatus = MOS_STATUS_UNKNOWN;
@@ -2338,6 +2347,15 @@ MOS_STATUS MosUtilities::MosLockMutex(PMOS_MUTEX pMutex)
 
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
+    if (MosLockProfiler::IsEnabled())
+    {
+        if (MosLockProfiler::Lock(pMutex))
+        {
+            eStatus = MOS_STATUS_UNKNOWN;
+        }
+        return eStatus;
+    }
+
     if (pthread_mutex_lock(pMutex))
     {
         eStatus = MOS_STATUS_UNKNOWN;
@@ -2352,6 +2370,15 @@ MOS_STATUS MosUtilities::MosUnlockMutex(PMOS_MUTEX pMutex)
 
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
+    if (MosLockProfiler::IsEnabled())
+    {
+        if (MosLockProfiler::Unlock(pMutex))
+        {
+            eStatus = MOS_STATUS_UNKNOWN;
+        }
+        return eStatus;
+    }
+
     if (pthread_mutex_unlock(pMutex))
     {
         eStatus = MOS_STATUS_UNKNOWN;
@@ -2360,6 +2387,21 @@ MOS_STATUS MosUtilities::MosUnlockMutex(PMOS_MUTEX pMutex)
     return eStatus;
 }
 
+void MosUtilities::MosSetMutexName(PMOS_MUTEX pMutex, const char *name)
+{
+    MosLockProfiler::SetName(pMutex, name);
+}
+
+void MosUtilities::MosRetireMutex(PMOS_MUTEX pMutex)
+{
+    MosLockProfiler::Retire(pMutex);
+}
+
+MOS_STATUS MosUtilities::MosReportLockContention(const char *path)
+{
+    return MosLockProfiler::Report(path) ? MOS_STATUS_UNKNOWN : MOS_STATUS_SUCCESS;
+}
+
 PMOS_SEMAPHORE MosUtilities::MosCreateSemaphore(
     uint32_t            uiInitialCount,
     uint32_t            uiMaximumCount)
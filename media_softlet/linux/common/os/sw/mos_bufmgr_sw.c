@@ -0,0 +1,1416 @@
+/*
+ * Copyright © 2024 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/** @file mos_bufmgr_sw.c
+ *
+ * Software implementation of the mos_bufmgr interface, see mos_bufmgr_sw.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <map>
+#include <new>
+
+#include "libdrm_macros.h"
+#include "xf86atomic.h"
+#include "i915_drm.h"
+#include "mos_bufmgr.h"
+#include "mos_bufmgr_priv.h"
+#include "mos_bufmgr_sw.h"
+#include "mos_vma.h"
+#include "mos_util_debug.h"
+#include "mos_oca_defs_specific.h"
+#include "linux_system_info.h"
+#include "mos_os_specific.h"
+#include "mos_utilities.h"
+
+#define SW_BUFMGR_PAGE_SIZE             PAGE_SIZE_4K
+#define SW_BUFMGR_MAX_BATCH_DEPTH       4
+#define SW_BUFMGR_TS_FREQUENCY          19200000
+#define SW_BUFMGR_VDBOX_NUM             2
+#define SW_BUFMGR_VEBOX_NUM             1
+
+/* Instruction decoding helpers */
+#define SW_CMD_TYPE(dw)                 (((dw) >> 29) & 0x7)
+#define SW_CMD_TYPE_MI                  0x0
+#define SW_CMD_TYPE_BLT                 0x2
+#define SW_CMD_TYPE_GFX                 0x3
+#define SW_MI_OPCODE(dw)                (((dw) >> 23) & 0x3f)
+#define SW_GFX_PIPELINE(dw)             (((dw) >> 27) & 0x3)
+#define SW_GFX_OPCODE(dw)               (((dw) >> 24) & 0x7)
+#define SW_GFX_SUBOPCODE(dw)            (((dw) >> 16) & 0xff)
+
+#define SW_MI_BATCH_BUFFER_END          0x0a
+#define SW_MI_STORE_DATA_IMM            0x20
+#define SW_MI_STORE_REGISTER_MEM        0x24
+#define SW_MI_FLUSH_DW                  0x26
+#define SW_MI_COPY_MEM_MEM              0x2e
+#define SW_MI_BATCH_BUFFER_START        0x31
+#define SW_MI_BBS_SECOND_LEVEL          (1u << 22)
+
+#define SW_POST_SYNC_WRITE_IMM          1
+#define SW_POST_SYNC_WRITE_TIMESTAMP    3
+
+struct mos_sw_bo {
+    struct mos_linux_bo bo;
+
+    atomic_t refcount;
+    const char *name;
+    bool is_userptr;
+    bool is_async;
+    uint32_t tiling_mode;
+    uint32_t stride;
+    int mem_region;
+
+    /** Softpin targets recorded for this buffer when used as a batch */
+    struct mos_linux_bo **softpin_target;
+    int softpin_target_count;
+    int softpin_target_size;
+};
+
+struct mos_bufmgr_sw {
+    struct mos_bufmgr bufmgr;
+
+    int fd;
+    uint32_t device_id;
+    pthread_mutex_t lock;
+
+    mos_vma_heap vma_heap[MEMZONE_COUNT];
+    /** Live buffer objects keyed by their softpin address */
+    std::map<uint64_t, struct mos_sw_bo *> va_map;
+
+    uint32_t next_handle;
+    uint32_t next_ctx_id;
+    uint32_t next_vm_id;
+
+    struct mos_bufmgr_sw_stats stats;
+};
+
+static inline struct mos_bufmgr_sw *
+to_sw_bufmgr(struct mos_bufmgr *bufmgr)
+{
+    return (struct mos_bufmgr_sw *)bufmgr;
+}
+
+static inline struct mos_sw_bo *
+to_sw_bo(struct mos_linux_bo *bo)
+{
+    return (struct mos_sw_bo *)bo;
+}
+
+static uint64_t
+mos_sw_get_timestamp(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    /* Convert to ticks of the reported timestamp frequency */
+    return ((uint64_t)ts.tv_sec * SW_BUFMGR_TS_FREQUENCY) +
+           ((uint64_t)ts.tv_nsec * SW_BUFMGR_TS_FREQUENCY / 1000000000);
+}
+
+static struct mos_linux_bo *
+mos_sw_bo_create(struct mos_bufmgr *bufmgr,
+                 const char *name,
+                 unsigned long size,
+                 unsigned long alignment,
+                 int mem_type,
+                 void *user_addr)
+{
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bufmgr);
+    struct mos_sw_bo *bo_sw = nullptr;
+    unsigned long bo_size = ALIGN(size, SW_BUFMGR_PAGE_SIZE);
+    int zone = (mem_type == MOS_MEMPOOL_VIDEOMEMORY || mem_type == MOS_MEMPOOL_DEVICEMEMORY) ? MEMZONE_DEVICE : MEMZONE_SYS;
+    void *addr = user_addr;
+
+    if (bo_size == 0)
+    {
+        return nullptr;
+    }
+
+    bo_sw = (struct mos_sw_bo *)calloc(1, sizeof(*bo_sw));
+    if (bo_sw == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (addr == nullptr)
+    {
+        addr = mmap(nullptr, bo_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED)
+        {
+            MOS_OS_ASSERTMESSAGE("sw bufmgr: failed to allocate %lu bytes for %s", bo_size, name);
+            free(bo_sw);
+            return nullptr;
+        }
+    }
+    else
+    {
+        bo_size = size;
+        bo_sw->is_userptr = true;
+    }
+
+    bo_sw->bo.size    = bo_size;
+    bo_sw->bo.align   = alignment;
+    bo_sw->bo.virt    = addr;
+    bo_sw->bo.bufmgr  = bufmgr;
+    bo_sw->name       = name;
+    bo_sw->mem_region = zone;
+    bo_sw->tiling_mode = I915_TILING_NONE;
+    atomic_set(&bo_sw->refcount, 1);
+
+    MosUtilities::MosLockMutex(&bufmgr_sw->lock);
+    bo_sw->bo.handle   = bufmgr_sw->next_handle++;
+    bo_sw->bo.offset64 = mos_vma_heap_alloc(&bufmgr_sw->vma_heap[zone],
+                                            ALIGN(bo_size, PAGE_SIZE_64K),
+                                            alignment > PAGE_SIZE_64K ? alignment : PAGE_SIZE_64K);
+    bo_sw->bo.offset   = (unsigned long)bo_sw->bo.offset64;
+    if (bo_sw->bo.offset64 != 0)
+    {
+        bufmgr_sw->va_map[bo_sw->bo.offset64] = bo_sw;
+        bufmgr_sw->stats.bo_alloc_count++;
+        bufmgr_sw->stats.bo_alloc_bytes += bo_size;
+        bufmgr_sw->stats.bo_live_count++;
+    }
+    MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+
+    if (bo_sw->bo.offset64 == 0)
+    {
+        MOS_OS_ASSERTMESSAGE("sw bufmgr: out of virtual address space for %s", name);
+        if (!bo_sw->is_userptr)
+        {
+            munmap(addr, bo_size);
+        }
+        free(bo_sw);
+        return nullptr;
+    }
+
+    return &bo_sw->bo;
+}
+
+static struct mos_linux_bo *
+mos_sw_bo_alloc(struct mos_bufmgr *bufmgr, struct mos_drm_bo_alloc *alloc)
+{
+    struct mos_linux_bo *bo = mos_sw_bo_create(bufmgr,
+                                               alloc->name,
+                                               alloc->size,
+                                               alloc->alignment,
+                                               alloc->ext.mem_type,
+                                               nullptr);
+    if (bo)
+    {
+        to_sw_bo(bo)->tiling_mode = alloc->ext.tiling_mode;
+        to_sw_bo(bo)->stride      = alloc->stride;
+    }
+    return bo;
+}
+
+static struct mos_linux_bo *
+mos_sw_bo_alloc_userptr(struct mos_bufmgr *bufmgr, struct mos_drm_bo_alloc_userptr *alloc_uptr)
+{
+    if (alloc_uptr->addr == nullptr)
+    {
+        return nullptr;
+    }
+
+    struct mos_linux_bo *bo = mos_sw_bo_create(bufmgr,
+                                               alloc_uptr->name,
+                                               alloc_uptr->size,
+                                               0,
+                                               MOS_MEMPOOL_SYSTEMMEMORY,
+                                               alloc_uptr->addr);
+    if (bo)
+    {
+        to_sw_bo(bo)->tiling_mode = alloc_uptr->tiling_mode;
+        to_sw_bo(bo)->stride      = alloc_uptr->stride;
+    }
+    return bo;
+}
+
+static struct mos_linux_bo *
+mos_sw_bo_alloc_tiled(struct mos_bufmgr *bufmgr, struct mos_drm_bo_alloc_tiled *alloc_tiled)
+{
+    unsigned long pitch = ALIGN((unsigned long)alloc_tiled->x * alloc_tiled->cpp, 64);
+    unsigned long size  = pitch * alloc_tiled->y;
+
+    struct mos_linux_bo *bo = mos_sw_bo_create(bufmgr,
+                                               alloc_tiled->name,
+                                               size,
+                                               alloc_tiled->alignment,
+                                               alloc_tiled->ext.mem_type,
+                                               nullptr);
+    if (bo)
+    {
+        to_sw_bo(bo)->tiling_mode = alloc_tiled->ext.tiling_mode;
+        to_sw_bo(bo)->stride      = pitch;
+        alloc_tiled->pitch        = pitch;
+    }
+    return bo;
+}
+
+static struct mos_linux_bo *
+mos_sw_bo_create_from_prime(struct mos_bufmgr *bufmgr, struct mos_drm_bo_alloc_prime *alloc_prime)
+{
+    /* There is no exporter, back the imported buffer with fresh memory */
+    return mos_sw_bo_create(bufmgr,
+                            alloc_prime->name,
+                            alloc_prime->size,
+                            0,
+                            MOS_MEMPOOL_SYSTEMMEMORY,
+                            nullptr);
+}
+
+static void
+mos_sw_bo_reference(struct mos_linux_bo *bo)
+{
+    atomic_inc(&to_sw_bo(bo)->refcount);
+}
+
+static void
+mos_sw_bo_free_locked(struct mos_bufmgr_sw *bufmgr_sw, struct mos_sw_bo *bo_sw)
+{
+    bufmgr_sw->va_map.erase(bo_sw->bo.offset64);
+    mos_vma_heap_free(&bufmgr_sw->vma_heap[bo_sw->mem_region],
+                      bo_sw->bo.offset64,
+                      ALIGN(bo_sw->bo.size, PAGE_SIZE_64K));
+    bufmgr_sw->stats.bo_live_count--;
+}
+
+static void
+mos_sw_bo_unreference(struct mos_linux_bo *bo)
+{
+    struct mos_sw_bo *bo_sw = to_sw_bo(bo);
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bo->bufmgr);
+
+    /* Only the last reference is dropped under the lock, so create_from_name
+     * never picks up a buffer which is being freed */
+    if (!atomic_add_unless(&bo_sw->refcount, -1, 1))
+    {
+        return;
+    }
+
+    MosUtilities::MosLockMutex(&bufmgr_sw->lock);
+    if (!atomic_dec_and_test(&bo_sw->refcount))
+    {
+        MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+        return;
+    }
+    mos_sw_bo_free_locked(bufmgr_sw, bo_sw);
+    MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+
+    for (int i = 0; i < bo_sw->softpin_target_count; i++)
+    {
+        mos_sw_bo_unreference(bo_sw->softpin_target[i]);
+    }
+    free(bo_sw->softpin_target);
+
+    if (!bo_sw->is_userptr)
+    {
+        munmap(bo->virt, bo->size);
+    }
+    free(bo_sw);
+}
+
+static int
+mos_sw_bo_map(struct mos_linux_bo *bo, int write_enable)
+{
+    MOS_UNUSED(write_enable);
+    /* Memory is permanently mapped and execution is synchronous */
+    return bo->virt ? 0 : -ENOMEM;
+}
+
+static int
+mos_sw_bo_map_nowait(struct mos_linux_bo *bo)
+{
+    return mos_sw_bo_map(bo, 1);
+}
+
+static int
+mos_sw_bo_unmap(struct mos_linux_bo *bo)
+{
+    MOS_UNUSED(bo);
+    return 0;
+}
+
+static void
+mos_sw_bo_start_gtt_access(struct mos_linux_bo *bo, int write_enable)
+{
+    MOS_UNUSED(bo);
+    MOS_UNUSED(write_enable);
+}
+
+static void
+mos_sw_bo_wait_rendering(struct mos_linux_bo *bo)
+{
+    MOS_UNUSED(bo);
+}
+
+static int
+mos_sw_bo_wait(struct mos_linux_bo *bo, int64_t timeout_ns)
+{
+    MOS_UNUSED(bo);
+    MOS_UNUSED(timeout_ns);
+    return 0;
+}
+
+static int
+mos_sw_bo_busy(struct mos_linux_bo *bo)
+{
+    MOS_UNUSED(bo);
+    return 0;
+}
+
+static int
+mos_sw_bo_set_tiling(struct mos_linux_bo *bo, uint32_t *tiling_mode, uint32_t stride)
+{
+    to_sw_bo(bo)->tiling_mode = *tiling_mode;
+    to_sw_bo(bo)->stride      = stride;
+    return 0;
+}
+
+static int
+mos_sw_bo_get_tiling(struct mos_linux_bo *bo, uint32_t *tiling_mode, uint32_t *swizzle_mode)
+{
+    *tiling_mode  = to_sw_bo(bo)->tiling_mode;
+    *swizzle_mode = I915_BIT_6_SWIZZLE_NONE;
+    return 0;
+}
+
+static int
+mos_sw_bo_flink(struct mos_linux_bo *bo, uint32_t *name)
+{
+    *name = bo->handle;
+    return 0;
+}
+
+static struct mos_linux_bo *
+mos_sw_bo_create_from_name(struct mos_bufmgr *bufmgr, const char *name, unsigned int handle)
+{
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bufmgr);
+    struct mos_linux_bo *bo = nullptr;
+
+    MOS_UNUSED(name);
+
+    MosUtilities::MosLockMutex(&bufmgr_sw->lock);
+    for (auto &it : bufmgr_sw->va_map)
+    {
+        if (it.second->bo.handle == (int)handle)
+        {
+            bo = &it.second->bo;
+            mos_sw_bo_reference(bo);
+            break;
+        }
+    }
+    MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+
+    return bo;
+}
+
+static int
+mos_sw_bo_export_to_prime(struct mos_linux_bo *bo, int *prime_fd)
+{
+    MOS_UNUSED(bo);
+    *prime_fd = -1;
+    return -ENODEV;
+}
+
+static int
+mos_sw_bo_set_softpin(struct mos_linux_bo *bo)
+{
+    /* Every buffer receives its address at allocation time */
+    MOS_UNUSED(bo);
+    return 0;
+}
+
+static bool
+mos_sw_bo_is_softpin(struct mos_linux_bo *bo)
+{
+    MOS_UNUSED(bo);
+    return true;
+}
+
+static int
+mos_sw_bo_add_softpin_target(struct mos_linux_bo *bo, struct mos_linux_bo *target_bo, bool write_flag)
+{
+    struct mos_sw_bo *bo_sw = to_sw_bo(bo);
+
+    MOS_UNUSED(write_flag);
+
+    if (target_bo == nullptr || target_bo == bo)
+    {
+        return -EINVAL;
+    }
+
+    if (bo_sw->softpin_target_count == bo_sw->softpin_target_size)
+    {
+        int new_size = bo_sw->softpin_target_size ? bo_sw->softpin_target_size * 2 : ARRAY_INIT_SIZE;
+        struct mos_linux_bo **target = (struct mos_linux_bo **)realloc(bo_sw->softpin_target,
+                                                                        new_size * sizeof(*target));
+        if (target == nullptr)
+        {
+            return -ENOMEM;
+        }
+        bo_sw->softpin_target      = target;
+        bo_sw->softpin_target_size = new_size;
+    }
+
+    mos_sw_bo_reference(target_bo);
+    bo_sw->softpin_target[bo_sw->softpin_target_count++] = target_bo;
+    return 0;
+}
+
+static int
+mos_sw_bo_emit_reloc(struct mos_linux_bo *bo, uint32_t offset,
+                     struct mos_linux_bo *target_bo, uint32_t target_offset,
+                     uint32_t read_domains, uint32_t write_domain,
+                     uint64_t presumed_offset)
+{
+    MOS_UNUSED(read_domains);
+    MOS_UNUSED(write_domain);
+    MOS_UNUSED(presumed_offset);
+
+    if (offset + sizeof(uint64_t) > bo->size)
+    {
+        return -EINVAL;
+    }
+    *(uint64_t *)((uint8_t *)bo->virt + offset) = target_bo->offset64 + target_offset;
+
+    return (target_bo == bo) ? 0 : mos_sw_bo_add_softpin_target(bo, target_bo, write_domain != 0);
+}
+
+static void
+mos_sw_bo_clear_relocs(struct mos_linux_bo *bo, int start)
+{
+    struct mos_sw_bo *bo_sw = to_sw_bo(bo);
+
+    MOS_UNUSED(start);
+
+    for (int i = 0; i < bo_sw->softpin_target_count; i++)
+    {
+        mos_sw_bo_unreference(bo_sw->softpin_target[i]);
+    }
+    bo_sw->softpin_target_count = 0;
+}
+
+static int
+mos_sw_bo_references(struct mos_linux_bo *bo, struct mos_linux_bo *target_bo)
+{
+    struct mos_sw_bo *bo_sw = to_sw_bo(bo);
+
+    for (int i = 0; i < bo_sw->softpin_target_count; i++)
+    {
+        if (bo_sw->softpin_target[i] == target_bo)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static mos_oca_exec_list_info *
+mos_sw_bo_get_softpin_targets_info(struct mos_linux_bo *bo, int *count)
+{
+    struct mos_sw_bo *bo_sw = to_sw_bo(bo);
+    int num = bo_sw->softpin_target_count + 1;
+
+    mos_oca_exec_list_info *info = (mos_oca_exec_list_info *)malloc(num * sizeof(*info));
+    if (info == nullptr)
+    {
+        *count = 0;
+        return nullptr;
+    }
+
+    for (int i = 0; i < num; i++)
+    {
+        struct mos_linux_bo *target = (i < bo_sw->softpin_target_count) ? bo_sw->softpin_target[i] : bo;
+        info[i].handle     = target->handle;
+        info[i].size       = target->size;
+        info[i].offset64   = target->offset64;
+        info[i].flags      = 0;
+        info[i].mem_region = to_sw_bo(target)->mem_region;
+        info[i].is_batch   = (target == bo);
+    }
+    *count = num;
+    return info;
+}
+
+static void
+mos_sw_bo_set_object_async(struct mos_linux_bo *bo)
+{
+    to_sw_bo(bo)->is_async = true;
+}
+
+static void
+mos_sw_bo_set_exec_object_async(struct mos_linux_bo *bo, struct mos_linux_bo *target_bo)
+{
+    MOS_UNUSED(bo);
+    MOS_UNUSED(target_bo);
+}
+
+static bool
+mos_sw_bo_is_exec_object_async(struct mos_linux_bo *bo)
+{
+    return to_sw_bo(bo)->is_async;
+}
+
+static void
+mos_sw_bo_set_object_capture(struct mos_linux_bo *bo)
+{
+    MOS_UNUSED(bo);
+}
+
+static int
+mos_sw_bo_disable_reuse(struct mos_linux_bo *bo)
+{
+    MOS_UNUSED(bo);
+    return 0;
+}
+
+static int
+mos_sw_bo_is_reusable(struct mos_linux_bo *bo)
+{
+    MOS_UNUSED(bo);
+    return 0;
+}
+
+static int
+mos_sw_bo_madvise(struct mos_linux_bo *bo, int madv)
+{
+    MOS_UNUSED(bo);
+    MOS_UNUSED(madv);
+    return 1;
+}
+
+static int
+mos_sw_bo_pad_to_size(struct mos_linux_bo *bo, uint64_t pad_to_size)
+{
+    return (pad_to_size > bo->size) ? -EINVAL : 0;
+}
+
+static void
+mos_sw_bo_use_48b_address_range(struct mos_linux_bo *bo, uint32_t enable)
+{
+    MOS_UNUSED(bo);
+    MOS_UNUSED(enable);
+}
+
+static int
+mos_sw_check_aperture_space(struct mos_linux_bo **bo_array, int count)
+{
+    MOS_UNUSED(bo_array);
+    MOS_UNUSED(count);
+    return 0;
+}
+
+/**
+ * Resolve a GPU virtual address to a CPU pointer with at least \p len bytes
+ * available. Caller must hold bufmgr_sw->lock.
+ */
+static void *
+mos_sw_resolve_addr(struct mos_bufmgr_sw *bufmgr_sw, uint64_t gpu_addr, uint32_t len)
+{
+    /* Strip the canonical form sign extension */
+    gpu_addr &= (MEMZONE_TOTAL - 1);
+
+    auto it = bufmgr_sw->va_map.upper_bound(gpu_addr);
+    if (it != bufmgr_sw->va_map.begin())
+    {
+        --it;
+        struct mos_sw_bo *bo_sw = it->second;
+        uint64_t offset = gpu_addr - bo_sw->bo.offset64;
+        if (offset + len <= bo_sw->bo.size)
+        {
+            return (uint8_t *)bo_sw->bo.virt + offset;
+        }
+    }
+
+    bufmgr_sw->stats.unresolved_addrs++;
+    return nullptr;
+}
+
+static void
+mos_sw_write_mem(struct mos_bufmgr_sw *bufmgr_sw, uint64_t gpu_addr, const uint32_t *data, uint32_t dwords)
+{
+    void *dst = mos_sw_resolve_addr(bufmgr_sw, gpu_addr, dwords * sizeof(uint32_t));
+    if (dst)
+    {
+        memcpy(dst, data, dwords * sizeof(uint32_t));
+        bufmgr_sw->stats.mem_writes++;
+    }
+}
+
+static inline uint64_t
+mos_sw_cmd_addr(const uint32_t *cmd, uint32_t dw)
+{
+    return ((uint64_t)cmd[dw + 1] << 32) | (cmd[dw] & ~0x3u);
+}
+
+static uint32_t
+mos_sw_cmd_length(uint32_t header)
+{
+    switch (SW_CMD_TYPE(header))
+    {
+    case SW_CMD_TYPE_MI:
+        return (SW_MI_OPCODE(header) < 0x10) ? 1 : (header & 0xff) + 2;
+    case SW_CMD_TYPE_BLT:
+        return (header & 0xff) + 2;
+    case SW_CMD_TYPE_GFX:
+        switch (SW_GFX_PIPELINE(header))
+        {
+        case 1:
+            return 1;
+        case 2:
+            return (SW_GFX_OPCODE(header) <= 1) ? (header & 0xffff) + 2 : (header & 0xfff) + 2;
+        default:
+            return (header & 0xff) + 2;
+        }
+    default:
+        return 1;
+    }
+}
+
+static void
+mos_sw_post_sync(struct mos_bufmgr_sw *bufmgr_sw, uint32_t op, uint64_t gpu_addr,
+                 const uint32_t *imm, uint32_t imm_dwords)
+{
+    if (op == SW_POST_SYNC_WRITE_IMM)
+    {
+        mos_sw_write_mem(bufmgr_sw, gpu_addr, imm, imm_dwords);
+    }
+    else if (op == SW_POST_SYNC_WRITE_TIMESTAMP)
+    {
+        uint64_t ts = mos_sw_get_timestamp();
+        mos_sw_write_mem(bufmgr_sw, gpu_addr, (const uint32_t *)&ts, 2);
+    }
+}
+
+/**
+ * Walk a batch buffer and emulate the memory side effects of the commands
+ * status reporting relies on. Everything else is skipped by length.
+ * Caller must hold bufmgr_sw->lock.
+ */
+static void
+mos_sw_execute_batch(struct mos_bufmgr_sw *bufmgr_sw, uint64_t gpu_addr, int depth)
+{
+    while (depth < SW_BUFMGR_MAX_BATCH_DEPTH)
+    {
+        uint64_t bo_addr = gpu_addr & (MEMZONE_TOTAL - 1);
+        auto it = bufmgr_sw->va_map.upper_bound(bo_addr);
+        if (it == bufmgr_sw->va_map.begin())
+        {
+            bufmgr_sw->stats.unresolved_addrs++;
+            return;
+        }
+        --it;
+
+        struct mos_sw_bo *batch = it->second;
+        const uint32_t *cmd = (const uint32_t *)((uint8_t *)batch->bo.virt + (bo_addr - batch->bo.offset64));
+        const uint32_t *end = (const uint32_t *)((uint8_t *)batch->bo.virt + batch->bo.size);
+        bool chained = false;
+
+        while (cmd < end)
+        {
+            uint32_t header = *cmd;
+            uint32_t len    = mos_sw_cmd_length(header);
+
+            if (cmd + len > end)
+            {
+                return;
+            }
+            bufmgr_sw->stats.dwords_parsed += len;
+
+            if (SW_CMD_TYPE(header) == SW_CMD_TYPE_MI)
+            {
+                switch (SW_MI_OPCODE(header))
+                {
+                case SW_MI_BATCH_BUFFER_END:
+                    return;
+                case SW_MI_STORE_DATA_IMM:
+                    if (len > 3)
+                    {
+                        mos_sw_write_mem(bufmgr_sw, mos_sw_cmd_addr(cmd, 1), cmd + 3, len - 3);
+                    }
+                    break;
+                case SW_MI_FLUSH_DW:
+                    if (len >= 4)
+                    {
+                        mos_sw_post_sync(bufmgr_sw, (header >> 14) & 0x3, mos_sw_cmd_addr(cmd, 1), cmd + 3, len - 3);
+                    }
+                    break;
+                case SW_MI_STORE_REGISTER_MEM:
+                    if (len >= 4)
+                    {
+                        /* No registers to read, report an idle/error-free value */
+                        const uint32_t zero = 0;
+                        mos_sw_write_mem(bufmgr_sw, mos_sw_cmd_addr(cmd, 2), &zero, 1);
+                    }
+                    break;
+                case SW_MI_COPY_MEM_MEM:
+                    if (len >= 5)
+                    {
+                        const uint32_t *src = (const uint32_t *)mos_sw_resolve_addr(bufmgr_sw, mos_sw_cmd_addr(cmd, 3), sizeof(uint32_t));
+                        if (src)
+                        {
+                            uint32_t value = *src;
+                            mos_sw_write_mem(bufmgr_sw, mos_sw_cmd_addr(cmd, 1), &value, 1);
+                        }
+                    }
+                    break;
+                case SW_MI_BATCH_BUFFER_START:
+                    if (len >= 3)
+                    {
+                        if (header & SW_MI_BBS_SECOND_LEVEL)
+                        {
+                            mos_sw_execute_batch(bufmgr_sw, mos_sw_cmd_addr(cmd, 1), depth + 1);
+                        }
+                        else
+                        {
+                            gpu_addr = mos_sw_cmd_addr(cmd, 1);
+                            chained  = true;
+                        }
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+            else if (SW_CMD_TYPE(header) == SW_CMD_TYPE_GFX &&
+                     SW_GFX_PIPELINE(header) == 3 &&
+                     SW_GFX_OPCODE(header) == 2 &&
+                     SW_GFX_SUBOPCODE(header) == 0 &&
+                     len >= 6)
+            {
+                /* PIPE_CONTROL */
+                mos_sw_post_sync(bufmgr_sw, (cmd[1] >> 14) & 0x3, mos_sw_cmd_addr(cmd, 2), cmd + 4, len - 4);
+            }
+
+            if (chained)
+            {
+                break;
+            }
+            cmd += len;
+        }
+
+        if (!chained)
+        {
+            return;
+        }
+        depth++;
+    }
+}
+
+static int
+mos_sw_bo_context_exec2(struct mos_linux_bo *bo, int used, struct mos_linux_context *ctx,
+                        struct drm_clip_rect *cliprects, int num_cliprects, int DR4,
+                        unsigned int flags, int *fence)
+{
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bo->bufmgr);
+
+    MOS_UNUSED(used);
+    MOS_UNUSED(ctx);
+    MOS_UNUSED(cliprects);
+    MOS_UNUSED(num_cliprects);
+    MOS_UNUSED(DR4);
+    MOS_UNUSED(flags);
+
+    MosUtilities::MosLockMutex(&bufmgr_sw->lock);
+    bufmgr_sw->stats.exec_count++;
+    mos_sw_execute_batch(bufmgr_sw, bo->offset64, 0);
+    MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+
+    /* Execution already completed, there is nothing to wait on */
+    if (fence)
+    {
+        *fence = -1;
+    }
+    return 0;
+}
+
+static int
+mos_sw_bo_context_exec3(struct mos_linux_bo **bo, int num_bo, struct mos_linux_context *ctx,
+                        struct drm_clip_rect *cliprects, int num_cliprects, int DR4,
+                        unsigned int flags, int *fence)
+{
+    for (int i = 0; i < num_bo; i++)
+    {
+        int ret = mos_sw_bo_context_exec2(bo[i], bo[i]->size, ctx, cliprects, num_cliprects, DR4, flags, fence);
+        if (ret)
+        {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+static int
+mos_sw_bo_exec(struct mos_linux_bo *bo, int used,
+               drm_clip_rect_t *cliprects, int num_cliprects, int DR4)
+{
+    return mos_sw_bo_context_exec2(bo, used, nullptr, cliprects, num_cliprects, DR4, 0, nullptr);
+}
+
+static int
+mos_sw_bo_mrb_exec(struct mos_linux_bo *bo, int used,
+                   drm_clip_rect_t *cliprects, int num_cliprects, int DR4, unsigned flags)
+{
+    return mos_sw_bo_context_exec2(bo, used, nullptr, cliprects, num_cliprects, DR4, flags, nullptr);
+}
+
+static struct mos_linux_context *
+mos_sw_context_create_ext(struct mos_bufmgr *bufmgr, __u32 flags, bool bContextProtected)
+{
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bufmgr);
+
+    MOS_UNUSED(flags);
+    MOS_UNUSED(bContextProtected);
+
+    struct mos_linux_context *ctx = (struct mos_linux_context *)calloc(1, sizeof(*ctx));
+    if (ctx == nullptr)
+    {
+        return nullptr;
+    }
+
+    MosUtilities::MosLockMutex(&bufmgr_sw->lock);
+    ctx->ctx_id = bufmgr_sw->next_ctx_id++;
+    MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+    ctx->bufmgr = bufmgr;
+    return ctx;
+}
+
+static struct mos_linux_context *
+mos_sw_context_create(struct mos_bufmgr *bufmgr)
+{
+    return mos_sw_context_create_ext(bufmgr, 0, false);
+}
+
+static struct mos_linux_context *
+mos_sw_context_create_shared(struct mos_bufmgr *bufmgr, mos_linux_context *ctx, __u32 flags,
+                             bool bContextProtected, void *engine_map, uint8_t ctx_width,
+                             uint8_t num_placements, uint32_t ctx_type)
+{
+    MOS_UNUSED(engine_map);
+    MOS_UNUSED(ctx_width);
+    MOS_UNUSED(num_placements);
+    MOS_UNUSED(ctx_type);
+
+    struct mos_linux_context *shared = mos_sw_context_create_ext(bufmgr, flags, bContextProtected);
+    if (shared && ctx)
+    {
+        shared->vm_id = ctx->vm_id;
+    }
+    return shared;
+}
+
+static void
+mos_sw_context_destroy(struct mos_linux_context *ctx)
+{
+    free(ctx);
+}
+
+static __u32
+mos_sw_vm_create(struct mos_bufmgr *bufmgr)
+{
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bufmgr);
+    __u32 vm_id;
+
+    MosUtilities::MosLockMutex(&bufmgr_sw->lock);
+    vm_id = bufmgr_sw->next_vm_id++;
+    MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+    return vm_id;
+}
+
+static void
+mos_sw_vm_destroy(struct mos_bufmgr *bufmgr, __u32 vm_id)
+{
+    MOS_UNUSED(bufmgr);
+    MOS_UNUSED(vm_id);
+}
+
+static int
+mos_sw_set_context_param(struct mos_linux_context *ctx, uint32_t size, uint64_t param, uint64_t value)
+{
+    MOS_UNUSED(ctx);
+    MOS_UNUSED(size);
+    MOS_UNUSED(param);
+    MOS_UNUSED(value);
+    return 0;
+}
+
+static int
+mos_sw_get_context_param(struct mos_linux_context *ctx, uint32_t size, uint64_t param, uint64_t *value)
+{
+    MOS_UNUSED(ctx);
+    MOS_UNUSED(size);
+    MOS_UNUSED(param);
+    *value = 0;
+    return 0;
+}
+
+static int
+mos_sw_set_context_param_engines(struct mos_linux_context *ctx,
+                                 struct i915_engine_class_instance *ci,
+                                 unsigned int count)
+{
+    MOS_UNUSED(ctx);
+    return (ci == nullptr || count == 0) ? -EINVAL : 0;
+}
+
+static int
+mos_sw_set_context_param_bond(struct mos_linux_context *ctx,
+                              struct i915_engine_class_instance master_ci,
+                              struct i915_engine_class_instance *bond_ci,
+                              unsigned int bond_count)
+{
+    MOS_UNUSED(ctx);
+    MOS_UNUSED(master_ci);
+    MOS_UNUSED(bond_ci);
+    MOS_UNUSED(bond_count);
+    return 0;
+}
+
+static int
+mos_sw_get_context_param_sseu(struct mos_linux_context *ctx, struct drm_i915_gem_context_param_sseu *sseu)
+{
+    MOS_UNUSED(ctx);
+    memset(sseu, 0, sizeof(*sseu));
+    sseu->slice_mask      = 0x1;
+    sseu->subslice_mask   = 0xff;
+    sseu->min_eus_per_subslice = 8;
+    sseu->max_eus_per_subslice = 8;
+    return 0;
+}
+
+static int
+mos_sw_set_context_param_sseu(struct mos_linux_context *ctx, struct drm_i915_gem_context_param_sseu sseu)
+{
+    MOS_UNUSED(ctx);
+    MOS_UNUSED(sseu);
+    return 0;
+}
+
+static int
+mos_sw_get_reset_stats(struct mos_linux_context *ctx, uint32_t *reset_count, uint32_t *active, uint32_t *pending)
+{
+    MOS_UNUSED(ctx);
+    if (reset_count)
+        *reset_count = 0;
+    if (active)
+        *active = 0;
+    if (pending)
+        *pending = 0;
+    return 0;
+}
+
+static int
+mos_sw_reg_read(struct mos_bufmgr *bufmgr, uint32_t offset, uint64_t *result)
+{
+    MOS_UNUSED(bufmgr);
+    MOS_UNUSED(offset);
+    *result = 0;
+    return 0;
+}
+
+static unsigned int
+mos_sw_engine_count(__u16 engine_class)
+{
+    switch (engine_class)
+    {
+    case I915_ENGINE_CLASS_RENDER:
+    case I915_ENGINE_CLASS_COPY:
+        return 1;
+    case I915_ENGINE_CLASS_VIDEO:
+        return SW_BUFMGR_VDBOX_NUM;
+    case I915_ENGINE_CLASS_VIDEO_ENHANCE:
+        return SW_BUFMGR_VEBOX_NUM;
+    default:
+        return 0;
+    }
+}
+
+static int
+mos_sw_query_engines_count(struct mos_bufmgr *bufmgr, unsigned int *nengine)
+{
+    MOS_UNUSED(bufmgr);
+    *nengine = 2 + SW_BUFMGR_VDBOX_NUM + SW_BUFMGR_VEBOX_NUM;
+    return 0;
+}
+
+static int
+mos_sw_query_engines(struct mos_bufmgr *bufmgr, __u16 engine_class, __u64 caps,
+                     unsigned int *nengine, void *engine_map)
+{
+    struct i915_engine_class_instance *ci = (struct i915_engine_class_instance *)engine_map;
+    unsigned int num = mos_sw_engine_count(engine_class);
+
+    MOS_UNUSED(bufmgr);
+    MOS_UNUSED(caps);
+
+    if (nengine == nullptr || ci == nullptr)
+    {
+        return -EINVAL;
+    }
+    if (num > *nengine)
+    {
+        return -EINVAL;
+    }
+
+    for (unsigned int i = 0; i < num; i++)
+    {
+        ci[i].engine_class    = engine_class;
+        ci[i].engine_instance = i;
+    }
+    *nengine = num;
+    return 0;
+}
+
+static size_t
+mos_sw_get_engine_class_size()
+{
+    return sizeof(struct i915_engine_class_instance);
+}
+
+static void
+mos_sw_select_fixed_engine(struct mos_bufmgr *bufmgr, void *engine_map,
+                           uint32_t *nengine, uint32_t fixed_instance_mask)
+{
+    MOS_UNUSED(bufmgr);
+    MOS_UNUSED(engine_map);
+    MOS_UNUSED(nengine);
+    MOS_UNUSED(fixed_instance_mask);
+}
+
+static int
+mos_sw_query_sys_engines(struct mos_bufmgr *bufmgr, MEDIA_SYSTEM_INFO *gfx_info)
+{
+    MOS_UNUSED(bufmgr);
+
+    if (gfx_info == nullptr)
+    {
+        return -EINVAL;
+    }
+
+    if (gfx_info->VDBoxInfo.NumberOfVDBoxEnabled == 0)
+    {
+        gfx_info->VDBoxInfo.NumberOfVDBoxEnabled = SW_BUFMGR_VDBOX_NUM;
+        gfx_info->VDBoxInfo.Instances.VDBoxEnableMask = (1 << SW_BUFMGR_VDBOX_NUM) - 1;
+    }
+    if (gfx_info->VEBoxInfo.NumberOfVEBoxEnabled == 0)
+    {
+        gfx_info->VEBoxInfo.NumberOfVEBoxEnabled = SW_BUFMGR_VEBOX_NUM;
+    }
+    return 0;
+}
+
+static int
+mos_sw_query_device_blob(struct mos_bufmgr *bufmgr, MEDIA_SYSTEM_INFO *gfx_info)
+{
+    MOS_UNUSED(bufmgr);
+    MOS_UNUSED(gfx_info);
+    return -ENODEV;
+}
+
+static int
+mos_sw_query_hw_ip_version(struct mos_bufmgr *bufmgr, __u16 engine_class, void *ip_ver_info)
+{
+    MOS_UNUSED(bufmgr);
+    MOS_UNUSED(engine_class);
+    MOS_UNUSED(ip_ver_info);
+    return -ENODEV;
+}
+
+static int
+mos_sw_get_driver_info(struct mos_bufmgr *bufmgr, struct LinuxDriverInfo *drvInfo)
+{
+    if (bufmgr == nullptr || drvInfo == nullptr)
+    {
+        return -EINVAL;
+    }
+
+    memset(drvInfo, 0, sizeof(*drvInfo));
+    drvInfo->devId         = to_sw_bufmgr(bufmgr)->device_id;
+    drvInfo->hasBsd        = 1;
+    drvInfo->hasBsd2       = SW_BUFMGR_VDBOX_NUM > 1;
+    drvInfo->hasVebox      = 1;
+    drvInfo->hasBltRing    = 1;
+    drvInfo->hasHuc        = 1;
+    drvInfo->hasPpgtt      = 1;
+    drvInfo->hasPreemption = 1;
+    drvInfo->euCount       = 96;
+    drvInfo->subSliceCount = 6;
+    drvInfo->sliceCount    = 1;
+    return 0;
+}
+
+static int
+mos_sw_get_devid(struct mos_bufmgr *bufmgr)
+{
+    return to_sw_bufmgr(bufmgr)->device_id;
+}
+
+static int
+mos_sw_get_memory_info(struct mos_bufmgr *bufmgr, char *info, uint32_t length)
+{
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bufmgr);
+
+    MosUtilities::MosLockMutex(&bufmgr_sw->lock);
+    snprintf(info, length, "sw bufmgr: %lu live bo, %lu bytes allocated",
+             (unsigned long)bufmgr_sw->stats.bo_live_count,
+             (unsigned long)bufmgr_sw->stats.bo_alloc_bytes);
+    MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+    return 0;
+}
+
+static int
+mos_sw_get_ts_frequency(struct mos_bufmgr *bufmgr, uint32_t *ts_freq)
+{
+    MOS_UNUSED(bufmgr);
+    *ts_freq = SW_BUFMGR_TS_FREQUENCY;
+    return 0;
+}
+
+static bool
+mos_sw_has_bsd2(struct mos_bufmgr *bufmgr)
+{
+    MOS_UNUSED(bufmgr);
+    return SW_BUFMGR_VDBOX_NUM > 1;
+}
+
+static uint64_t
+mos_sw_get_platform_information(struct mos_bufmgr *bufmgr)
+{
+    return bufmgr->platform_information;
+}
+
+static void
+mos_sw_set_platform_information(struct mos_bufmgr *bufmgr, uint64_t p)
+{
+    bufmgr->platform_information |= p;
+}
+
+static void
+mos_sw_bufmgr_noop(struct mos_bufmgr *bufmgr)
+{
+    MOS_UNUSED(bufmgr);
+}
+
+static void
+mos_sw_enable_softpin(struct mos_bufmgr *bufmgr, bool va1m_align)
+{
+    MOS_UNUSED(bufmgr);
+    MOS_UNUSED(va1m_align);
+}
+
+static void
+mos_sw_realloc_cache(struct mos_bufmgr *bufmgr, uint8_t alloc_mode)
+{
+    MOS_UNUSED(bufmgr);
+    MOS_UNUSED(alloc_mode);
+}
+
+static unsigned int
+mos_sw_hweight8(struct mos_linux_context *ctx, uint8_t w)
+{
+    MOS_UNUSED(ctx);
+    return __builtin_popcount(w);
+}
+
+static uint8_t
+mos_sw_switch_off_n_bits(struct mos_linux_context *ctx, uint8_t in_mask, int n)
+{
+    uint8_t out_mask = in_mask;
+
+    MOS_UNUSED(ctx);
+
+    for (int i = 0; i < 8 && n > 0; i++)
+    {
+        if (in_mask & (1u << i))
+        {
+            out_mask &= ~(1u << i);
+            n--;
+        }
+    }
+    return out_mask;
+}
+
+static void
+mos_sw_bufmgr_destroy(struct mos_bufmgr *bufmgr)
+{
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bufmgr);
+
+    if (!bufmgr_sw->va_map.empty())
+    {
+        MOS_OS_NORMALMESSAGE("sw bufmgr: %zu buffer objects leaked", bufmgr_sw->va_map.size());
+    }
+
+    for (int i = 0; i < MEMZONE_COUNT; i++)
+    {
+        mos_vma_heap_finish(&bufmgr_sw->vma_heap[i]);
+    }
+    MosUtilities::MosRetireMutex(&bufmgr_sw->lock);
+    pthread_mutex_destroy(&bufmgr_sw->lock);
+    delete bufmgr_sw;
+}
+
+bool
+mos_bufmgr_is_sw(struct mos_bufmgr *bufmgr)
+{
+    return bufmgr && bufmgr->destroy == mos_sw_bufmgr_destroy;
+}
+
+int
+mos_bufmgr_sw_get_stats(struct mos_bufmgr *bufmgr, struct mos_bufmgr_sw_stats *stats)
+{
+    if (!mos_bufmgr_is_sw(bufmgr) || stats == nullptr)
+    {
+        return -EINVAL;
+    }
+
+    struct mos_bufmgr_sw *bufmgr_sw = to_sw_bufmgr(bufmgr);
+    MosUtilities::MosLockMutex(&bufmgr_sw->lock);
+    *stats = bufmgr_sw->stats;
+    MosUtilities::MosUnlockMutex(&bufmgr_sw->lock);
+    return 0;
+}
+
+struct mos_bufmgr *
+mos_bufmgr_sw_init(int fd, int batch_size, int *device_type)
+{
+    MOS_UNUSED(batch_size);
+
+    struct mos_bufmgr_sw *bufmgr_sw = new (std::nothrow) mos_bufmgr_sw();
+    if (bufmgr_sw == nullptr)
+    {
+        return nullptr;
+    }
+
+    bufmgr_sw->fd          = fd;
+    bufmgr_sw->next_handle = 1;
+    bufmgr_sw->next_ctx_id = 1;
+    bufmgr_sw->next_vm_id  = 1;
+    memset(&bufmgr_sw->stats, 0, sizeof(bufmgr_sw->stats));
+    pthread_mutex_init(&bufmgr_sw->lock, nullptr);
+    MosUtilities::MosSetMutexName(&bufmgr_sw->lock, "Sw.Bufmgr");
+
+    const char *devid_override = getenv("INTEL_DEVID_OVERRIDE");
+    bufmgr_sw->device_id = devid_override ? strtoul(devid_override, nullptr, 0) : 0;
+
+    mos_vma_heap_init(&bufmgr_sw->vma_heap[MEMZONE_SYS], MEMZONE_SYS_START, MEMZONE_SYS_SIZE);
+    mos_vma_heap_init(&bufmgr_sw->vma_heap[MEMZONE_DEVICE], MEMZONE_DEVICE_START, MEMZONE_DEVICE_SIZE);
+    mos_vma_heap_init(&bufmgr_sw->vma_heap[MEMZONE_PRIME], MEMZONE_PRIME_START, MEMZONE_PRIME_SIZE);
+
+    struct mos_bufmgr *bufmgr = &bufmgr_sw->bufmgr;
+    bufmgr->bo_alloc                       = mos_sw_bo_alloc;
+    bufmgr->bo_alloc_userptr               = mos_sw_bo_alloc_userptr;
+    bufmgr->bo_alloc_tiled                 = mos_sw_bo_alloc_tiled;
+    bufmgr->bo_reference                   = mos_sw_bo_reference;
+    bufmgr->bo_unreference                 = mos_sw_bo_unreference;
+    bufmgr->bo_map                         = mos_sw_bo_map;
+    bufmgr->bo_unmap                       = mos_sw_bo_unmap;
+    bufmgr->bo_wait_rendering              = mos_sw_bo_wait_rendering;
+    bufmgr->destroy                        = mos_sw_bufmgr_destroy;
+    bufmgr->bo_use_48b_address_range       = mos_sw_bo_use_48b_address_range;
+    bufmgr->bo_pad_to_size                 = mos_sw_bo_pad_to_size;
+    bufmgr->bo_emit_reloc                  = mos_sw_bo_emit_reloc;
+    bufmgr->bo_exec                        = mos_sw_bo_exec;
+    bufmgr->bo_mrb_exec                    = mos_sw_bo_mrb_exec;
+    bufmgr->bo_set_tiling                  = mos_sw_bo_set_tiling;
+    bufmgr->bo_get_tiling                  = mos_sw_bo_get_tiling;
+    bufmgr->bo_set_softpin                 = mos_sw_bo_set_softpin;
+    bufmgr->bo_add_softpin_target          = mos_sw_bo_add_softpin_target;
+    bufmgr->bo_flink                       = mos_sw_bo_flink;
+    bufmgr->bo_busy                        = mos_sw_bo_busy;
+    bufmgr->bo_madvise                     = mos_sw_bo_madvise;
+    bufmgr->check_aperture_space           = mos_sw_check_aperture_space;
+    bufmgr->bo_disable_reuse               = mos_sw_bo_disable_reuse;
+    bufmgr->bo_is_reusable                 = mos_sw_bo_is_reusable;
+    bufmgr->bo_references                  = mos_sw_bo_references;
+    bufmgr->set_object_async               = mos_sw_bo_set_object_async;
+    bufmgr->set_exec_object_async          = mos_sw_bo_set_exec_object_async;
+    bufmgr->set_object_capture             = mos_sw_bo_set_object_capture;
+    bufmgr->bo_wait                        = mos_sw_bo_wait;
+    bufmgr->bo_clear_relocs                = mos_sw_bo_clear_relocs;
+    bufmgr->context_create                 = mos_sw_context_create;
+    bufmgr->context_create_ext             = mos_sw_context_create_ext;
+    bufmgr->context_create_shared          = mos_sw_context_create_shared;
+    bufmgr->context_destroy                = mos_sw_context_destroy;
+    bufmgr->vm_create                      = mos_sw_vm_create;
+    bufmgr->vm_destroy                     = mos_sw_vm_destroy;
+    bufmgr->bo_context_exec2               = mos_sw_bo_context_exec2;
+    bufmgr->bo_context_exec3               = mos_sw_bo_context_exec3;
+    bufmgr->bo_is_exec_object_async        = mos_sw_bo_is_exec_object_async;
+    bufmgr->bo_is_softpin                  = mos_sw_bo_is_softpin;
+    bufmgr->bo_map_gtt                     = mos_sw_bo_map_nowait;
+    bufmgr->bo_unmap_gtt                   = mos_sw_bo_unmap;
+    bufmgr->bo_map_wc                      = mos_sw_bo_map_nowait;
+    bufmgr->bo_unmap_wc                    = mos_sw_bo_unmap;
+    bufmgr->bo_map_unsynchronized          = mos_sw_bo_map_nowait;
+    bufmgr->bo_start_gtt_access            = mos_sw_bo_start_gtt_access;
+    bufmgr->bo_get_softpin_targets_info    = mos_sw_bo_get_softpin_targets_info;
+    bufmgr->bo_create_from_name            = mos_sw_bo_create_from_name;
+    bufmgr->enable_reuse                   = mos_sw_bufmgr_noop;
+    bufmgr->enable_softpin                 = mos_sw_enable_softpin;
+    bufmgr->enable_vmbind                  = mos_sw_bufmgr_noop;
+    bufmgr->disable_object_capture         = mos_sw_bufmgr_noop;
+    bufmgr->get_memory_info                = mos_sw_get_memory_info;
+    bufmgr->get_devid                      = mos_sw_get_devid;
+    bufmgr->realloc_cache                  = mos_sw_realloc_cache;
+    bufmgr->query_engines_count            = mos_sw_query_engines_count;
+    bufmgr->query_engines                  = mos_sw_query_engines;
+    bufmgr->get_engine_class_size          = mos_sw_get_engine_class_size;
+    bufmgr->select_fixed_engine            = mos_sw_select_fixed_engine;
+    bufmgr->set_context_param              = mos_sw_set_context_param;
+    bufmgr->set_context_param_parallel     = mos_sw_set_context_param_engines;
+    bufmgr->set_context_param_load_balance = mos_sw_set_context_param_engines;
+    bufmgr->set_context_param_bond         = mos_sw_set_context_param_bond;
+    bufmgr->get_context_param              = mos_sw_get_context_param;
+    bufmgr->bo_create_from_prime           = mos_sw_bo_create_from_prime;
+    bufmgr->bo_export_to_prime             = mos_sw_bo_export_to_prime;
+    bufmgr->reg_read                       = mos_sw_reg_read;
+    bufmgr->get_reset_stats                = mos_sw_get_reset_stats;
+    bufmgr->get_context_param_sseu         = mos_sw_get_context_param_sseu;
+    bufmgr->set_context_param_sseu         = mos_sw_set_context_param_sseu;
+    bufmgr->query_sys_engines              = mos_sw_query_sys_engines;
+    bufmgr->query_device_blob              = mos_sw_query_device_blob;
+    bufmgr->get_driver_info                = mos_sw_get_driver_info;
+    bufmgr->query_hw_ip_version            = mos_sw_query_hw_ip_version;
+    bufmgr->get_platform_information       = mos_sw_get_platform_information;
+    bufmgr->set_platform_information       = mos_sw_set_platform_information;
+    bufmgr->get_ts_frequency               = mos_sw_get_ts_frequency;
+    bufmgr->has_bsd2                       = mos_sw_has_bsd2;
+    bufmgr->enable_turbo_boost             = mos_sw_bufmgr_noop;
+    bufmgr->switch_off_n_bits              = mos_sw_switch_off_n_bits;
+    bufmgr->hweight8                       = mos_sw_hweight8;
+    bufmgr->has_full_vd                    = true;
+
+    if (device_type != nullptr)
+    {
+        *device_type = DEVICE_TYPE_I915;
+    }
+
+    MOS_OS_NORMALMESSAGE("sw bufmgr: created, fd %d, device id 0x%x", fd, bufmgr_sw->device_id);
+    return bufmgr;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright © 2024 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/** @file mos_bufmgr_sw.h
+ *
+ * Pure software buffer manager.
+ *
+ * Buffer objects live in anonymous process memory, GEM handles and softpin
+ * addresses come from a private allocator and "execbuffer" walks the batch on
+ * the CPU, performing the memory writes the status trackers rely on
+ * (MI_STORE_DATA_IMM, MI_FLUSH_DW / PIPE_CONTROL post-sync writes,
+ * MI_COPY_MEM_MEM, MI_STORE_REGISTER_MEM) before signalling completion
+ * immediately. Together with MosMockAdaptor platform injection this lets the
+ * driver run complete submissions without a GPU or a DRM device.
+ */
+
+#ifndef __MOS_BUFMGR_SW__
+#define __MOS_BUFMGR_SW__
+
+#include <stdint.h>
+
+struct mos_bufmgr;
+
+struct mos_bufmgr_sw_stats
+{
+    uint64_t exec_count;        /**< number of execbuffer calls */
+    uint64_t bo_alloc_count;    /**< number of buffer objects allocated */
+    uint64_t bo_alloc_bytes;    /**< total bytes of buffer objects allocated */
+    uint64_t bo_live_count;     /**< buffer objects currently alive */
+    uint64_t dwords_parsed;     /**< batch dwords walked by the software executor */
+    uint64_t mem_writes;        /**< post-sync / store writes emulated */
+    uint64_t unresolved_addrs;  /**< GPU addresses that did not hit any buffer object */
+};
+
+/**
+ * Create a software buffer manager.
+ *
+ * \param fd          DRM fd if one is available, otherwise -1. It is only kept
+ *                    for reporting and never used for ioctls.
+ * \param batch_size  Unused, kept for signature parity with mos_bufmgr_gem_init.
+ * \param device_type Returns DEVICE_TYPE_I915 so the i915 submission path is used.
+ */
+struct mos_bufmgr *mos_bufmgr_sw_init(int fd, int batch_size, int *device_type);
+
+/**
+ * Returns true if \p bufmgr was created by mos_bufmgr_sw_init.
+ */
+bool mos_bufmgr_is_sw(struct mos_bufmgr *bufmgr);
+
+/**
+ * Snapshot the software executor counters.
+ */
+int mos_bufmgr_sw_get_stats(struct mos_bufmgr *bufmgr, struct mos_bufmgr_sw_stats *stats);
+
+#endif /* __MOS_BUFMGR_SW__ */
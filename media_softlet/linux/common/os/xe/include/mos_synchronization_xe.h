@@ -63,6 +63,65 @@ struct mos_xe_bo_dep
     uint64_t exec_timeline_index;
 };
 
+/**
+ * Number of exec queues whose read dep is saved inline in the bo.
+ */
+#define MOS_XE_BO_DEP_INLINE_NUM 4
+
+struct mos_xe_bo_dep_slot
+{
+    /**
+     * Indicate to the dummy exec queue id which accessed the bo.
+     */
+    uint32_t exec_queue_id;
+
+    struct mos_xe_bo_dep bo_dep;
+};
+
+struct mos_xe_bo_deps
+{
+    /**
+     * Read deps, one slot per exec queue which read the bo.
+     * The first MOS_XE_BO_DEP_INLINE_NUM slots are inline, further ones go to read_overflow,
+     * which only allocates memory once a bo is read by more exec queues.
+     */
+    uint32_t read_num = 0;
+    struct mos_xe_bo_dep_slot read_slots[MOS_XE_BO_DEP_INLINE_NUM];
+    std::vector<struct mos_xe_bo_dep_slot> read_overflow;
+
+    /**
+     * Write dep on the last write exec queue.
+     * Older write deps are never waited: a new write always waits the previous writer's deps.
+     */
+    struct mos_xe_bo_dep_slot write_slot = {};
+};
+
+struct mos_xe_exec_queue_ids
+{
+    /**
+     * Valid flag indexed by dummy exec queue id.
+     * Dummy ids are never reused, so a dep saved in a bo is only safe to access while its id is valid.
+     */
+    std::vector<uint8_t> valid;
+
+    /**
+     * Scratch data used while building the syncs array of one exec, indexed by dummy exec queue id:
+     * position of the wait sync already added for this exec queue, valid when its exec_index matches.
+     */
+    struct wait_sync_pos
+    {
+        uint64_t exec_index;
+        uint32_t sync_index;
+    };
+    std::vector<wait_sync_pos> wait_syncs;
+    uint64_t exec_index = 0;
+};
+
+static inline bool mos_sync_is_exec_queue_valid(struct mos_xe_exec_queue_ids &ids, uint32_t exec_queue_id)
+{
+    return exec_queue_id < ids.valid.size() && ids.valid[exec_queue_id];
+}
+
 int mos_sync_syncobj_create(int fd, uint32_t flags);
 int mos_sync_syncobj_destroy(int fd, uint32_t handle);
 int mos_sync_syncobj_reset(int fd, uint32_t *handles, uint32_t count);
@@ -80,11 +139,13 @@ int mos_sync_syncobj_timeline_to_binary(int fd, uint32_t binary_handle,
         uint64_t point,
         uint32_t flags);
 void mos_sync_update_timeline_dep(struct mos_xe_dep *dep);
+void mos_sync_add_exec_queue_id(struct mos_xe_exec_queue_ids &ids, uint32_t exec_queue_id);
+void mos_sync_remove_exec_queue_id(struct mos_xe_exec_queue_ids &ids, uint32_t exec_queue_id);
+void mos_sync_begin_exec_syncs(struct mos_xe_exec_queue_ids &ids);
 int mos_sync_update_exec_syncs_from_timeline_deps(uint32_t curr_engine,
-            uint32_t lst_write_engine, uint32_t flags,
-            std::set<uint32_t> &engine_ids,
-            std::map<uint32_t, struct mos_xe_bo_dep> &read_deps,
-            std::map<uint32_t, struct mos_xe_bo_dep> &write_deps,
+            uint32_t flags,
+            struct mos_xe_exec_queue_ids &engine_ids,
+            struct mos_xe_bo_deps &deps,
             std::vector<drm_xe_sync> &syncs);
 int mos_sync_update_exec_syncs_from_handle(int fd,
             uint32_t bo_handle, uint32_t flags,
@@ -96,13 +157,10 @@ void mos_sync_update_exec_syncs_from_timeline_dep(int fd,
             std::vector<struct drm_xe_sync> &syncs);
 int mos_sync_update_bo_deps(uint32_t curr_engine,
             uint32_t flags, mos_xe_dep *dep,
-            std::map<uint32_t, struct mos_xe_bo_dep> &read_deps,
-            std::map<uint32_t, struct mos_xe_bo_dep> &write_deps);
-void mos_sync_get_bo_wait_timeline_deps(std::set<uint32_t> &engine_ids,
-            std::map<uint32_t, struct mos_xe_bo_dep> &read_deps,
-            std::map<uint32_t, struct mos_xe_bo_dep> &write_deps,
+            struct mos_xe_bo_deps &deps);
+void mos_sync_get_bo_wait_timeline_deps(struct mos_xe_exec_queue_ids &engine_ids,
+            struct mos_xe_bo_deps &deps,
             std::map<uint32_t, uint64_t> &max_timeline_data,
-            uint32_t lst_write_engine,
             uint32_t rw_flags);
 void mos_sync_destroy_timeline_dep(int fd, struct mos_xe_dep *dep);
 
@@ -224,6 +224,12 @@ typedef struct mos_xe_bufmgr_gem {
      */
     std::map<uint32_t, struct mos_xe_context*> global_ctx_info;
 
+    /**
+     * Valid dummy exec_queue ids, the keys of global_ctx_info.
+     * Kept up to date with it so exec and bo wait check a dep in constant time.
+     */
+    struct mos_xe_exec_queue_ids global_exec_queue_ids;
+
     uint32_t vm_id;
 
     /**
@@ -412,20 +418,12 @@ typedef struct mos_xe_bo_gem {
     uint32_t last_exec_read_exec_queue;
 
     /**
-     * Read dependents, pair of dummy EXEC_QUEUE_ID and mos_xe_bo_dep
-     * This map saves read deps of this bo on all exec exec_queue;
-     * Exec will check opration flags to get the dep from the map to add into exec sync array and updated the map after exec.
+     * Read deps of this bo on all exec_queue and write dep on last write exec_queue,
+     * saved as pairs of dummy EXEC_QUEUE_ID and mos_xe_bo_dep.
+     * Exec will check opration flags to get the deps to add into exec sync array and update them after exec.
      * Refer to exec call to get more details.
      */
-    std::map<uint32_t, struct mos_xe_bo_dep> read_deps;
-
-    /**
-     * Write dependents, pair of dummy EXEC_QUEUE_ID and mos_xe_bo_dep
-     * This map saves write deps of this bo on all exec exec_queue;
-     * Exec will check opration flags to get the dep from the map to add into exec sync array and updated the map after exec.
-     * Refer to exec call to get more details.
-     */
-    std::map<uint32_t, struct mos_xe_bo_dep> write_deps;
+    struct mos_xe_bo_deps deps;
 
 } mos_xe_bo_gem;
 
@@ -1018,6 +1016,7 @@ mos_context_create_shared_xe(
     bufmgr_gem->m_lock.lock();
     context->dummy_exec_queue_id = ++dummy_exec_queue_id;
     bufmgr_gem->global_ctx_info[context->dummy_exec_queue_id] = context;
+    mos_sync_add_exec_queue_id(bufmgr_gem->global_exec_queue_ids, context->dummy_exec_queue_id);
     bufmgr_gem->m_lock.unlock();
     return &context->ctx;
 }
@@ -1078,6 +1077,7 @@ mos_context_destroy_xe(struct mos_linux_context *ctx)
     mos_sync_destroy_timeline_dep(bufmgr_gem->fd, context->timeline_dep);
     context->timeline_dep = nullptr;
     bufmgr_gem->global_ctx_info.erase(context->dummy_exec_queue_id);
+    mos_sync_remove_exec_queue_id(bufmgr_gem->global_exec_queue_ids, context->dummy_exec_queue_id);
     bufmgr_gem->sync_obj_rw_lock.unlock();
     bufmgr_gem->m_lock.unlock();
 
@@ -1933,16 +1933,12 @@ __mos_gem_bo_wait_timeline_rendering_with_flags_xe(struct mos_linux_bo *bo,
     std::map<uint32_t, uint64_t> timeline_data; //pair(syncobj, point)
     std::vector<uint32_t> handles;
     std::vector<uint64_t> points;
-    std::set<uint32_t> exec_queue_ids;
     bufmgr_gem->m_lock.lock();
     bufmgr_gem->sync_obj_rw_lock.lock_shared();
-    MOS_XE_GET_KEYS_FROM_MAP(bufmgr_gem->global_ctx_info, exec_queue_ids);
 
-    mos_sync_get_bo_wait_timeline_deps(exec_queue_ids,
-                bo_gem->read_deps,
-                bo_gem->write_deps,
+    mos_sync_get_bo_wait_timeline_deps(bufmgr_gem->global_exec_queue_ids,
+                bo_gem->deps,
                 timeline_data,
-                bo_gem->last_exec_write_exec_queue,
                 rw_flags);
     bufmgr_gem->m_lock.unlock();
 
@@ -2266,34 +2262,30 @@ __mos_dump_bo_deps_map_xe(struct mos_linux_bo **bo,
                                     curr_exec_queue_id,
                                     exec_flags);
 
-                    auto it =  exec_bo_gem->read_deps.begin();
-                    while (it != exec_bo_gem->read_deps.end())
+                    struct mos_xe_bo_deps &deps = exec_bo_gem->deps;
+                    for (uint32_t j = 0; j < deps.read_num; j++)
                     {
-                        if (ctx_infos.count(it->first) > 0)
+                        struct mos_xe_bo_dep_slot &slot = j < MOS_XE_BO_DEP_INLINE_NUM ?
+                                    deps.read_slots[j] : deps.read_overflow[j - MOS_XE_BO_DEP_INLINE_NUM];
+                        if (ctx_infos.count(slot.exec_queue_id) > 0)
                         {
                             offset += MOS_SecureStringPrint(log_msg + offset, MOS_MAX_MSG_BUF_SIZE,
                                             MOS_MAX_MSG_BUF_SIZE - offset,
                                             "\n\t\t\t-read deps: execed_exec_queue_id=%d, syncobj_handle=%d", "timeline = %ld",
-                                            it->first,
-                                            it->second.dep ? it->second.dep->syncobj_handle : INVALID_HANDLE,
-                                            it->second.dep ? it->second.exec_timeline_index : INVALID_HANDLE);
+                                            slot.exec_queue_id,
+                                            slot.bo_dep.dep ? slot.bo_dep.dep->syncobj_handle : INVALID_HANDLE,
+                                            slot.bo_dep.dep ? slot.bo_dep.exec_timeline_index : INVALID_HANDLE);
                         }
-                        it++;
                     }
 
-                    it = exec_bo_gem->write_deps.begin();
-                    while (it != exec_bo_gem->write_deps.end())
+                    if (deps.write_slot.bo_dep.dep && ctx_infos.count(deps.write_slot.exec_queue_id) > 0)
                     {
-                        if (ctx_infos.count(it->first) > 0)
-                        {
-                            offset += MOS_SecureStringPrint(log_msg + offset, MOS_MAX_MSG_BUF_SIZE,
-                                            MOS_MAX_MSG_BUF_SIZE - offset,
-                                            "\n\t\t\t-write deps: execed_exec_queue_id=%d, syncobj_handle=%d", "timeline = %ld",
-                                            it->first,
-                                            it->second.dep ? it->second.dep->syncobj_handle : INVALID_HANDLE,
-                                            it->second.dep ? it->second.exec_timeline_index : INVALID_HANDLE);
-                        }
-                        it++;
+                        offset += MOS_SecureStringPrint(log_msg + offset, MOS_MAX_MSG_BUF_SIZE,
+                                        MOS_MAX_MSG_BUF_SIZE - offset,
+                                        "\n\t\t\t-write deps: execed_exec_queue_id=%d, syncobj_handle=%d", "timeline = %ld",
+                                        deps.write_slot.exec_queue_id,
+                                        deps.write_slot.bo_dep.dep->syncobj_handle,
+                                        deps.write_slot.bo_dep.exec_timeline_index);
                     }
                     offset > MOS_MAX_MSG_BUF_SIZE ?
                         MOS_DRM_NORMALMESSAGE("imcomplete dump since log msg buffer overwrite %s", log_msg) : MOS_DRM_NORMALMESSAGE("%s", log_msg);
@@ -2318,9 +2310,8 @@ __mos_context_exec_update_syncs_xe(struct mos_xe_bufmgr_gem *bufmgr_gem,
     uint32_t curr_dummy_exec_queue_id = ctx->dummy_exec_queue_id;
     uint32_t exec_list_size = exec_list.size();
     int ret = 0;
-    std::set<uint32_t> exec_queue_ids;
     MOS_DRM_CHK_NULL_RETURN_VALUE(bufmgr_gem, -EINVAL);
-    MOS_XE_GET_KEYS_FROM_MAP(bufmgr_gem->global_ctx_info, exec_queue_ids);
+    mos_sync_begin_exec_syncs(bufmgr_gem->global_exec_queue_ids);
 
     for (int i = 0; i < exec_list_size + num_bo; i++)
     {
@@ -2384,11 +2375,9 @@ __mos_context_exec_update_syncs_xe(struct mos_xe_bufmgr_gem *bufmgr_gem,
                 //internal bo
                 ret = mos_sync_update_exec_syncs_from_timeline_deps(
                             curr_dummy_exec_queue_id,
-                            exec_bo_gem->last_exec_write_exec_queue,
                             exec_flags,
-                            exec_queue_ids,
-                            exec_bo_gem->read_deps,
-                            exec_bo_gem->write_deps,
+                            bufmgr_gem->global_exec_queue_ids,
+                            exec_bo_gem->deps,
                             syncs);
             }
         }
@@ -2423,7 +2412,7 @@ __mos_context_exec_update_bo_deps_xe(struct mos_linux_bo **bo,
         }
         if (exec_bo_gem)
         {
-            mos_sync_update_bo_deps(curr_exec_queue_id, exec_flags, dep, exec_bo_gem->read_deps, exec_bo_gem->write_deps);
+            mos_sync_update_bo_deps(curr_exec_queue_id, exec_flags, dep, exec_bo_gem->deps);
             if (exec_flags & EXEC_OBJECT_READ_XE)
             {
                 exec_bo_gem->last_exec_read_exec_queue = curr_exec_queue_id;
@@ -2499,15 +2488,16 @@ __mos_bo_context_exec_retry_xe(struct mos_bufmgr *bufmgr,
 
  *GPU<->GPU synchronization:
  * Exec must ensure the synchronization between GPU->GPU with bellow 8 steps:
- * 1. Get the deps from read_deps and write_deps by checking bo's op flags and add it into syncs array;
- *     a) if flags & READ: get write_deps[last_write_exec_queue != ctx->dummy_exec_queue_id] & STATUS_DEP_BUSY only;
- *     b) if flags & WRITE: get read_deps[all_exec_queue exclude ctx->dummy_exec_queue_id] & STATUS_DEP_BUSY
- *        and write_deps[last_write_exec_queue != ctx->dummy_exec_queue_id] & STATUS_DEP_BUSY;
+ * 1. Get the deps from bo read deps and write dep by checking bo's op flags and add it into syncs array,
+ *    keeping one wait with the max timeline point per syncobj;
+ *     a) if flags & READ: get write dep[last_write_exec_queue != ctx->dummy_exec_queue_id] & STATUS_DEP_BUSY only;
+ *     b) if flags & WRITE: get read deps[all_exec_queue exclude ctx->dummy_exec_queue_id] & STATUS_DEP_BUSY
+ *        and write dep[last_write_exec_queue != ctx->dummy_exec_queue_id] & STATUS_DEP_BUSY;
  *  2. Export a syncobj from external bo as dep and add it indo syncs array.
  *  3. Initial a new timeline dep object for exec queue if it doesn't have and add it to syncs array, otherwise add timeline
  *     dep from context->timeline_dep directly while it has latest avaiable timeline point in it;
  *  4. Exec submittion with batches and syncs.
- *  5. Update read_deps[ctx->dummy_exec_queue_id] and write_deps[ctx->dummy_exec_queue_id] with the new deps from the dep_queue;
+ *  5. Update read deps[ctx->dummy_exec_queue_id] and write dep with the new deps from the dep_queue;
  *  6. Update timeline dep's timeline index to be latest avaiable one for currect exec queue.
  *  7. Import syncobj from batch bo for each external bo's DMA buffer for external process to wait media process on demand.
  *  8. Close syncobj handle and syncobj fd for external bo to avoid leak.
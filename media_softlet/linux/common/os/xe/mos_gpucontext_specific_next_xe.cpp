@@ -34,6 +34,7 @@
 #include "mos_os_virtualengine_next.h"
 #include "mos_interface.h"
 #include "mos_os_cp_interface_specific.h"
+#include "mos_vdbox_balancer.h"
 
 #define MI_BATCHBUFFER_END 0x05000000
 static pthread_mutex_t command_dump_mutex = PTHREAD_MUTEX_INITIALIZER;
@@ -42,6 +43,59 @@ static pthread_mutex_t command_dump_mutex = PTHREAD_MUTEX_INITIALIZER;
 GpuContextSpecificNextXe::~GpuContextSpecificNextXe()
 {
     MOS_OS_FUNCTION_ENTER;
+
+    // The base destructor only runs the base Clear
+    Clear();
+}
+
+void GpuContextSpecificNextXe::Clear()
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    // Base Clear waits for the pending command buffers, the pinned queues are idle after it
+    GpuContextSpecificNext::Clear();
+    ReleaseVdboxBalancing();
+}
+
+void GpuContextSpecificNextXe::ReleaseVdboxBalancing()
+{
+    for (auto &queue : m_vdboxQueues)
+    {
+        if (queue)
+        {
+            mos_context_destroy(queue);
+            queue = nullptr;
+        }
+    }
+
+    if (m_vdboxStreamId >= 0)
+    {
+        ReportVdboxLoad();
+        MosVdboxBalancer::GetInstance().UnregisterStream(m_vdboxStreamId);
+        m_vdboxStreamId = -1;
+    }
+    m_vdboxEngines.clear();
+    m_vdboxDevice         = nullptr;
+    m_vdboxUserSettingPtr = nullptr;
+}
+
+void GpuContextSpecificNextXe::ReportVdboxLoad()
+{
+#if (_DEBUG || _RELEASE_INTERNAL)
+    std::vector<MosVdboxBalancer::EngineStats> stats;
+    MosVdboxBalancer::GetInstance().GetEngineStats(m_vdboxDevice, stats);
+
+    uint64_t load = 0;
+    for (uint32_t i = 0; i < stats.size() && i < sizeof(load); i++)
+    {
+        load |= (uint64_t)stats[i].loadPercent << (i * 8);
+    }
+    ReportUserSettingForDebug(
+        m_vdboxUserSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_VDBOX_BALANCER_LOAD,
+        load,
+        MediaUserSetting::Group::Device);
+#endif
 }
 
 MOS_STATUS GpuContextSpecificNextXe::Init3DCtx(PMOS_CONTEXT osParameters,
@@ -176,6 +230,26 @@ MOS_STATUS GpuContextSpecificNextXe::InitVdVeCtx(PMOS_CONTEXT osParameters,
 
     m_i915Context[0]->pOsContext = osParameters;
 
+    // Single pipe decode picks its VDBox through the balancer unless the user fixed the engine
+    bool balancerEnabled = false;
+    if (gpuNode != MOS_GPU_NODE_VE && streamState->component == COMPONENT_Decode && !*isEngineSelectEnable &&
+        *nengine >= 2 && *nengine <= MAX_ENGINE_INSTANCE_NUM)
+    {
+        ReadUserSetting(
+            osParameters->m_userSettingPtr,
+            balancerEnabled,
+            __MEDIA_USER_FEATURE_VALUE_ENABLE_VDBOX_BALANCER,
+            MediaUserSetting::Group::Device);
+    }
+    if (balancerEnabled)
+    {
+        auto engines = (struct drm_xe_engine_class_instance *)engine_map;
+        m_vdboxEngines.assign(engines, engines + *nengine);
+        m_vdboxStreamId = MosVdboxBalancer::GetInstance().RegisterStream(osParameters->bufmgr, *nengine);
+        m_vdboxDevice         = osParameters->bufmgr;
+        m_vdboxUserSettingPtr = osParameters->m_userSettingPtr;
+    }
+
     if (*nengine >= 2 && *nengine <= MAX_ENGINE_INSTANCE_NUM)
     {
         //if ctxWidth > 1, numPlacement should always be 1
@@ -481,6 +555,10 @@ MOS_STATUS GpuContextSpecificNextXe::SubmitCommandBuffer(
                 it++;
             }
 #endif
+            // Every submission of a frame goes to the engine its first one picked
+            m_vdboxWorkload = streamState->vdboxWorkload;
+            m_vdboxNewFrame = streamState->vdboxFrameId == 0 || streamState->vdboxFrameId != m_vdboxFrameId;
+            m_vdboxFrameId  = streamState->vdboxFrameId;
             ret = ParallelSubmitCommands(m_secondaryCmdBufs,
                                  perStreamParameters,
                                  execFlag,
@@ -545,7 +623,7 @@ int32_t GpuContextSpecificNextXe::ParallelSubmitCommands(
                     || it->second->iSubmissionType & SUBMISSION_TYPE_SINGLE_PIPE
                     || m_secondaryCmdBufs.size() == 1)
         {
-            queue = m_i915Context[0];
+            queue = GetSinglePipeQueue(osContext);
             MOS_OS_CHK_NULL_RETURN(queue);
             numBatch = 1;
             cmdBos[0] = it->second->OsResource.bo;
@@ -594,6 +672,44 @@ int32_t GpuContextSpecificNextXe::ParallelSubmitCommands(
     return ret;
 }
 
+MOS_LINUX_CONTEXT *GpuContextSpecificNextXe::GetSinglePipeQueue(PMOS_CONTEXT osContext)
+{
+    if (m_vdboxStreamId < 0 || osContext == nullptr)
+    {
+        return m_i915Context[0];
+    }
+
+    uint32_t engine = MosVdboxBalancer::GetInstance().SelectEngine(m_vdboxStreamId, m_vdboxWorkload, m_vdboxNewFrame);
+    m_vdboxNewFrame = false;
+    if (engine >= m_vdboxEngines.size())
+    {
+        return m_i915Context[0];
+    }
+
+    if (m_vdboxQueues[engine] == nullptr)
+    {
+        // Work on different queues is ordered by the bo dependencies, as for scalability
+        m_vdboxQueues[engine] = mos_context_create_shared(osContext->bufmgr,
+                                                          nullptr,
+                                                          0,
+                                                          m_bProtectedContext,
+                                                          &m_vdboxEngines[engine],
+                                                          1,
+                                                          1,
+                                                          0);
+        if (m_vdboxQueues[engine] == nullptr)
+        {
+            MOS_OS_NORMALMESSAGE("Failed to create queue of VDBox %d, stop balancing.", engine);
+            MosVdboxBalancer::GetInstance().UnregisterStream(m_vdboxStreamId);
+            m_vdboxStreamId = -1;
+            return m_i915Context[0];
+        }
+        m_vdboxQueues[engine]->pOsContext = osContext;
+    }
+
+    return m_vdboxQueues[engine];
+}
+
 void GpuContextSpecificNextXe::UpdatePriority(int32_t priority)
 {
     MOS_OS_FUNCTION_ENTER;
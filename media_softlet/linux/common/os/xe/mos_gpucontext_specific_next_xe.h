@@ -27,6 +27,7 @@
 #ifndef __GPU_CONTEXT_SPECIFIC_NEXT_XE_H__
 #define __GPU_CONTEXT_SPECIFIC_NEXT_XE_H__
 
+#include <vector>
 #include "mos_bufmgr_xe.h"
 #include "mos_gpucontext_specific_next.h"
 
@@ -63,6 +64,11 @@ public:
     //!
     virtual void UpdatePriority(int32_t priority) override;
 
+    //!
+    //! \brief  Release the exec queues and the VDBox balancing of the context
+    //!
+    virtual void Clear(void) override;
+
     //!
     //! \brief    Allocate gpu status buffer for gpu sync
     //! \return   MOS_STATUS
@@ -113,6 +119,30 @@ protected:
 private:
     void ClearSecondaryCmdBuffer(bool cmdBufMapIsReused);
 
+    //!
+    //! \brief    Get the exec queue of a single pipe submission
+    //! \details  Balanced streams get a queue pinned to the VDBox chosen by
+    //!           MosVdboxBalancer, others the queue spanning all VDBoxes.
+    //!
+    MOS_LINUX_CONTEXT *GetSinglePipeQueue(PMOS_CONTEXT osContext);
+    void               ReleaseVdboxBalancing();
+
+    //!
+    //! \brief    Report the load share of the VDBoxes of the device
+    //! \details  Written to "VDBox Balancer Load" when a balanced stream ends,
+    //!           debug and release internal builds only.
+    //!
+    void               ReportVdboxLoad();
+
+    int32_t  m_vdboxStreamId = -1;  //!< Stream id in MosVdboxBalancer, -1 if not balanced
+    void    *m_vdboxDevice   = nullptr;  //!< Device the stream is registered on
+    MediaUserSettingSharedPtr m_vdboxUserSettingPtr = nullptr;  //!< Where ReportVdboxLoad writes
+    uint32_t m_vdboxWorkload = 0;   //!< Workload of the frame in flight
+    uint32_t m_vdboxFrameId  = 0;   //!< Frame id of the last submission, see MosStreamState::vdboxFrameId
+    bool     m_vdboxNewFrame = false;  //!< The next single pipe submission starts a frame
+    std::vector<drm_xe_engine_class_instance> m_vdboxEngines;       //!< VDBoxes the balancer picks from
+    MOS_LINUX_CONTEXT *m_vdboxQueues[MAX_ENGINE_INSTANCE_NUM] = {};  //!< Queues pinned to one VDBox, created on first use
+
 MEDIA_CLASS_DEFINE_END(GpuContextSpecificNextXe)
 };
 #endif  // __GPU_CONTEXT_SPECIFIC_NEXT_XE_H__
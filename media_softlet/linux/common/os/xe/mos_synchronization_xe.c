@@ -484,67 +484,142 @@ void mos_sync_destroy_timeline_dep(int fd, struct mos_xe_dep* dep)
 }
 
 /**
- * Add the timeline dep from read and write dep map into exec syncs array.
+ * Mark a dummy exec queue id valid once its context is created.
+ */
+void mos_sync_add_exec_queue_id(struct mos_xe_exec_queue_ids &ids, uint32_t exec_queue_id)
+{
+    if (exec_queue_id >= ids.valid.size())
+    {
+        ids.valid.resize(exec_queue_id + 1, 0);
+        ids.wait_syncs.resize(exec_queue_id + 1, {0, 0});
+    }
+    ids.valid[exec_queue_id] = 1;
+}
+
+/**
+ * Mark a dummy exec queue id invalid when its context is destroyed.
+ */
+void mos_sync_remove_exec_queue_id(struct mos_xe_exec_queue_ids &ids, uint32_t exec_queue_id)
+{
+    if (exec_queue_id < ids.valid.size())
+    {
+        ids.valid[exec_queue_id] = 0;
+    }
+}
+
+/**
+ * Start building the syncs array of a new exec, forgetting waits added for the previous one.
+ */
+void mos_sync_begin_exec_syncs(struct mos_xe_exec_queue_ids &ids)
+{
+    ids.exec_index++;
+}
+
+/**
+ * Add a timeline wait on an exec queue into exec syncs array.
+ *
+ * Each exec queue owns one timeline syncobj, so several bos touched on the same queue
+ * would add the same syncobj again. Keep a single wait per exec queue with the max point,
+ * which also covers the lower points on that timeline.
+ */
+static void
+__mos_sync_add_timeline_wait_sync(struct mos_xe_exec_queue_ids &ids,
+            uint32_t exec_queue_id,
+            struct mos_xe_bo_dep &bo_dep,
+            std::vector<drm_xe_sync> &syncs)
+{
+    struct mos_xe_exec_queue_ids::wait_sync_pos &pos = ids.wait_syncs[exec_queue_id];
+    if (pos.exec_index == ids.exec_index)
+    {
+        drm_xe_sync &sync = syncs[pos.sync_index];
+        sync.timeline_value = std::max(sync.timeline_value, (__u64)bo_dep.exec_timeline_index);
+        return;
+    }
+
+    drm_xe_sync sync;
+    memclear(sync);
+    sync.handle = bo_dep.dep->syncobj_handle;
+    sync.type = DRM_XE_SYNC_TYPE_TIMELINE_SYNCOBJ;
+    sync.timeline_value = bo_dep.exec_timeline_index;
+    syncs.push_back(sync);
+
+    pos.exec_index = ids.exec_index;
+    pos.sync_index = syncs.size() - 1;
+}
+
+static inline struct mos_xe_bo_dep_slot *
+__mos_sync_get_read_slot(struct mos_xe_bo_deps &deps, uint32_t i)
+{
+    return i < MOS_XE_BO_DEP_INLINE_NUM ? &deps.read_slots[i] : &deps.read_overflow[i - MOS_XE_BO_DEP_INLINE_NUM];
+}
+
+/**
+ * Remove read dep slot i by moving the last slot into it.
+ */
+static inline void
+__mos_sync_remove_read_slot(struct mos_xe_bo_deps &deps, uint32_t i)
+{
+    uint32_t last = deps.read_num - 1;
+    if (i != last)
+    {
+        *__mos_sync_get_read_slot(deps, i) = *__mos_sync_get_read_slot(deps, last);
+    }
+    if (last >= MOS_XE_BO_DEP_INLINE_NUM)
+    {
+        deps.read_overflow.pop_back();
+    }
+    deps.read_num--;
+}
+
+/**
+ * Add the timeline dep from read and write deps into exec syncs array.
  *
  * @curr_engine indicates to current exec engine id;
- * @lst_write_engine indicates to last exec engine id for writing;
  * @flags indicates to operation flags(read or write) for current exec;
  * @engine_ids indicates to valid engine IDs;
- * @read_deps indicates to read deps on previous exec;
- * @write_deps indicates to write deps on previous exec;
+ * @deps indicates to read and write deps on previous exec;
  * @syncs indicates to exec syncs array for current exec.
  *
- * Note: all deps from bo dep map are used as fence in, in this case,
+ * Read deps of destroyed exec queues are dropped here, their dep object is already freed.
+ *
+ * Note: all deps from bo deps are used as fence in, in this case,
  *     we should never set DRM_XE_SYNC_FLAG_SIGNAL for sync, otherwise kmd will
  *     not wait this sync.
  *
  * @return indicates to update status.
  */
 int mos_sync_update_exec_syncs_from_timeline_deps(uint32_t curr_engine,
-            uint32_t lst_write_engine, uint32_t flags,
-            std::set<uint32_t> &engine_ids,
-            std::map<uint32_t, struct mos_xe_bo_dep> &read_deps,
-            std::map<uint32_t, struct mos_xe_bo_dep> &write_deps,
+            uint32_t flags,
+            struct mos_xe_exec_queue_ids &engine_ids,
+            struct mos_xe_bo_deps &deps,
             std::vector<drm_xe_sync> &syncs)
 {
-    if (lst_write_engine != curr_engine)
+    struct mos_xe_bo_dep_slot &write_slot = deps.write_slot;
+    if (write_slot.bo_dep.dep
+            && write_slot.exec_queue_id != curr_engine
+            && mos_sync_is_exec_queue_valid(engine_ids, write_slot.exec_queue_id))
     {
-        if (write_deps.count(lst_write_engine) > 0
-                && engine_ids.count(lst_write_engine) > 0)
-        {
-            if (write_deps[lst_write_engine].dep)
-            {
-                drm_xe_sync sync;
-                memclear(sync);
-                sync.handle = write_deps[lst_write_engine].dep->syncobj_handle;
-                sync.type = DRM_XE_SYNC_TYPE_TIMELINE_SYNCOBJ;
-                sync.timeline_value = write_deps[lst_write_engine].exec_timeline_index;
-                syncs.push_back(sync);
-            }
-        }
+        __mos_sync_add_timeline_wait_sync(engine_ids, write_slot.exec_queue_id, write_slot.bo_dep, syncs);
     }
 
-    //For flags & write, we need to add all sync in read_deps into syncs.
+    //For flags & write, we need to add all sync in read deps into syncs.
     if (flags & EXEC_OBJECT_WRITE_XE)
     {
-        auto it = read_deps.begin();
-        while (it != read_deps.end())
+        uint32_t i = 0;
+        while (i < deps.read_num)
         {
-            uint32_t engine_id = it->first;
-            if (engine_id != curr_engine
-                    && engine_ids.count(engine_id) > 0)
+            struct mos_xe_bo_dep_slot *slot = __mos_sync_get_read_slot(deps, i);
+            if (!mos_sync_is_exec_queue_valid(engine_ids, slot->exec_queue_id))
+            {
+                __mos_sync_remove_read_slot(deps, i);
+                continue;
+            }
+
+            if (slot->exec_queue_id != curr_engine && slot->bo_dep.dep)
             {
-                if (it->second.dep)
-                {
-                    drm_xe_sync sync;
-                    memclear(sync);
-                    sync.handle = it->second.dep->syncobj_handle;
-                    sync.type = DRM_XE_SYNC_TYPE_TIMELINE_SYNCOBJ;
-                    sync.timeline_value = it->second.exec_timeline_index;
-                    syncs.push_back(sync);
-                }
+                __mos_sync_add_timeline_wait_sync(engine_ids, slot->exec_queue_id, slot->bo_dep, syncs);
             }
-            it++;
+            i++;
         }
     }
 
@@ -614,48 +689,65 @@ void mos_sync_update_exec_syncs_from_timeline_dep(int fd,
  *
  * @curr_engine indicates to current exec dummy engine id;
  * @flags indicates to operation flags(read or write) for current exec;
- * @dep indicates to the fence out dep that needs to update into the deps map;
- * @read_deps indicates to read deps on previous exec;
- * @write_deps indicates to write deps on previous exec;
+ * @dep indicates to the fence out dep that needs to update into the deps;
+ * @deps indicates to read and write deps on previous exec;
  */
 int mos_sync_update_bo_deps(uint32_t curr_engine,
             uint32_t flags, mos_xe_dep *dep,
-            std::map<uint32_t, struct mos_xe_bo_dep> &read_deps,
-            std::map<uint32_t, struct mos_xe_bo_dep> &write_deps)
+            struct mos_xe_bo_deps &deps)
 {
     MOS_DRM_CHK_NULL_RETURN_VALUE(dep, -EINVAL)
-    mos_xe_bo_dep bo_dep;
-    bo_dep.dep = dep;
-    bo_dep.exec_timeline_index = dep->timeline_index;
+    mos_xe_bo_dep_slot slot;
+    slot.exec_queue_id = curr_engine;
+    slot.bo_dep.dep = dep;
+    slot.bo_dep.exec_timeline_index = dep->timeline_index;
     if(flags & EXEC_OBJECT_READ_XE)
     {
-        read_deps[curr_engine] = bo_dep;
+        uint32_t i = 0;
+        for (; i < deps.read_num; i++)
+        {
+            struct mos_xe_bo_dep_slot *read_slot = __mos_sync_get_read_slot(deps, i);
+            if (read_slot->exec_queue_id == curr_engine)
+            {
+                *read_slot = slot;
+                break;
+            }
+        }
+
+        if (i == deps.read_num)
+        {
+            if (deps.read_num < MOS_XE_BO_DEP_INLINE_NUM)
+            {
+                deps.read_slots[deps.read_num] = slot;
+            }
+            else
+            {
+                deps.read_overflow.push_back(slot);
+            }
+            deps.read_num++;
+        }
     }
 
     if(flags & EXEC_OBJECT_WRITE_XE)
     {
-        write_deps[curr_engine] = bo_dep;
+        deps.write_slot = slot;
     }
 
     return MOS_XE_SUCCESS;
 }
 
 /**
- * Get busy timeline deps from read and write deps map for bo wait.
+ * Get busy timeline deps from read and write deps for bo wait.
  *
  * @engine_ids indicates to valid engine IDs;
- * @read_deps indicates to read deps on previous exec;
- * @write_deps indicates to write deps on previous exec;
+ * @deps indicates to read and write deps on previous exec;
  * @max_timeline_data max exec timeline value on each context for this bo resource;
- * @lst_write_engine indicates to last exec engine id for writing;
  * @rw_flags indicates to read/write operation:
  *     if rw_flags & EXEC_OBJECT_WRITE_XE, means bo write. Otherwise it means bo read.
  */
-void mos_sync_get_bo_wait_timeline_deps(std::set<uint32_t> &engine_ids,
-            std::map<uint32_t, struct mos_xe_bo_dep> &read_deps,
-            std::map<uint32_t, struct mos_xe_bo_dep> &write_deps,
+void mos_sync_get_bo_wait_timeline_deps(struct mos_xe_exec_queue_ids &engine_ids,
+            struct mos_xe_bo_deps &deps,
             std::map<uint32_t, uint64_t> &max_timeline_data,
-            uint32_t lst_write_engine,
             uint32_t rw_flags)
 {
     max_timeline_data.clear();
@@ -663,26 +755,24 @@ void mos_sync_get_bo_wait_timeline_deps(std::set<uint32_t> &engine_ids,
     //case1: get all timeline dep from read dep on all engines
     if(rw_flags & EXEC_OBJECT_WRITE_XE)
     {
-        for(auto it = read_deps.begin(); it != read_deps.end(); it++)
+        for (uint32_t i = 0; i < deps.read_num; i++)
         {
-            uint32_t engine_id = it->first;
-            uint64_t bo_exec_timeline = it->second.exec_timeline_index;
-            // Get the valid busy dep in this read dep map for this bo.
-            if (it->second.dep && engine_ids.count(engine_id) > 0)
+            struct mos_xe_bo_dep_slot *slot = __mos_sync_get_read_slot(deps, i);
+            // Get the valid busy dep in read deps for this bo.
+            if (slot->bo_dep.dep && mos_sync_is_exec_queue_valid(engine_ids, slot->exec_queue_id))
             {
                 // Save the max timeline data
-                max_timeline_data[it->second.dep->syncobj_handle] = bo_exec_timeline;
+                max_timeline_data[slot->bo_dep.dep->syncobj_handle] = slot->bo_dep.exec_timeline_index;
             }
         }
     }
 
     //case2: get timeline dep from write dep on last write engine.
-    if (engine_ids.count(lst_write_engine) > 0
-        && write_deps.count(lst_write_engine) > 0
-       && write_deps[lst_write_engine].dep)
+    struct mos_xe_bo_dep_slot &write_slot = deps.write_slot;
+    if (write_slot.bo_dep.dep && mos_sync_is_exec_queue_valid(engine_ids, write_slot.exec_queue_id))
     {
-        uint32_t syncobj_handle = write_deps[lst_write_engine].dep->syncobj_handle;
-        uint64_t bo_exec_timeline = write_deps[lst_write_engine].exec_timeline_index;
+        uint32_t syncobj_handle = write_slot.bo_dep.dep->syncobj_handle;
+        uint64_t bo_exec_timeline = write_slot.bo_dep.exec_timeline_index;
         if (max_timeline_data.count(syncobj_handle) == 0
                 || max_timeline_data[syncobj_handle] < bo_exec_timeline)
         {